@@ -58,6 +58,9 @@ settings.video_defaults = {}
 settings.video_defaults.full_screen = true
 settings.video_defaults.screen_resx = 1280
 settings.video_defaults.screen_resy = 1024
+settings.video_defaults.vsync = true
+settings.video_defaults.target_fps = 0
+settings.video_defaults.core_profile = false
 settings.audio_settings = {}
 settings.audio_settings.sound_vol = 1
 settings.audio_settings.music_vol = 1
@@ -65,6 +68,9 @@ settings.video_settings = {}
 settings.video_settings.full_screen = false
 settings.video_settings.screen_resx = 1024
 settings.video_settings.screen_resy = 768
+settings.video_settings.vsync = true
+settings.video_settings.target_fps = 0
+settings.video_settings.core_profile = false
 settings.language_settings = 0
 settings.audio_defaults = {}
 settings.audio_defaults.sound_vol = 1
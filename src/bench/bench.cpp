@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    bench.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for timing benchmarks and reporting their statistics
+*** ***************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+
+#include "bench.h"
+
+using namespace std;
+using namespace hoa_utils;
+
+namespace hoa_bench {
+
+bool BENCH_DEBUG = false;
+
+namespace {
+
+//! \brief The default number of samples to take of each benchmark
+const uint32 DEFAULT_SAMPLE_COUNT = 50;
+
+//! \brief The default length of each sample: 10 milliseconds
+const uint32 DEFAULT_SAMPLE_TIME = 10000000;
+
+//! \brief The number of untimed batches of operations run before the samples are taken
+const uint32 WARMUP_BATCHES = 2;
+
+//! \brief The limit on the number of operations in a sample, which stops empty operations from running forever
+const uint32 MAX_OPERATIONS_PER_SAMPLE = 1000000;
+
+/** \brief Returns a percentile of a sorted set of samples using the nearest-rank method
+*** \param sorted_samples The samples, sorted in ascending order. Must not be empty.
+*** \param percentile The percentile to retrieve, between 0 and 100
+**/
+double Percentile(const vector<double>& sorted_samples, double percentile) {
+	uint32 rank = static_cast<uint32>(ceil(percentile / 100.0 * sorted_samples.size()));
+	if (rank == 0)
+		rank = 1;
+	return sorted_samples[rank - 1];
+}
+
+//! \brief Writes a string as a JSON string literal, escaping the characters that require it
+void WriteJSONString(ostream& stream, const string& text) {
+	stream << '"';
+	for (uint32 i = 0; i < text.size(); ++i) {
+		if (text[i] == '"' || text[i] == '\\')
+			stream << '\\';
+		stream << text[i];
+	}
+	stream << '"';
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// BenchmarkRunner class methods
+// -----------------------------------------------------------------------------
+
+BenchmarkRunner::BenchmarkRunner() :
+	_sample_count(DEFAULT_SAMPLE_COUNT),
+	_sample_time(DEFAULT_SAMPLE_TIME)
+{}
+
+
+
+void BenchmarkRunner::Run(const string& name, const function<void()>& operation) {
+	if (IsSelected(name) == false)
+		return;
+
+	IF_PRINT_DEBUG(BENCH_DEBUG) << "running benchmark: " << name << endl;
+
+	uint32 operations = _CalibrateOperations(operation);
+	for (uint32 i = 0; i < WARMUP_BATCHES; ++i)
+		_TimeOperations(operation, operations);
+
+	vector<double> samples(_sample_count);
+	for (uint32 i = 0; i < _sample_count; ++i)
+		samples[i] = _TimeOperations(operation, operations) / operations;
+	sort(samples.begin(), samples.end());
+
+	BenchmarkResult result;
+	result.name = name;
+	result.samples = _sample_count;
+	result.operations_per_sample = operations;
+	result.minimum = samples.front();
+	result.median = Percentile(samples, 50.0);
+	result.percentile_90 = Percentile(samples, 90.0);
+	result.percentile_99 = Percentile(samples, 99.0);
+	result.maximum = samples.back();
+
+	double sum = 0.0;
+	for (uint32 i = 0; i < samples.size(); ++i)
+		sum += samples[i];
+	result.mean = sum / samples.size();
+
+	double squared_deviations = 0.0;
+	for (uint32 i = 0; i < samples.size(); ++i)
+		squared_deviations += (samples[i] - result.mean) * (samples[i] - result.mean);
+	result.standard_deviation = sqrt(squared_deviations / samples.size());
+
+	_results.push_back(result);
+}
+
+
+
+void BenchmarkRunner::WriteResults(ostream& stream) const {
+	stream << fixed << setprecision(1);
+	stream << "{" << endl;
+	stream << "\t\"version\": ";
+	WriteJSONString(stream, PACKAGE_VERSION);
+	stream << "," << endl;
+	stream << "\t\"unit\": \"ns/op\"," << endl;
+	stream << "\t\"benchmarks\": [" << endl;
+
+	for (uint32 i = 0; i < _results.size(); ++i) {
+		const BenchmarkResult& result = _results[i];
+		stream << "\t\t{\"name\": ";
+		WriteJSONString(stream, result.name);
+		stream << ", \"samples\": " << result.samples
+			<< ", \"operations_per_sample\": " << result.operations_per_sample
+			<< ", \"min\": " << result.minimum
+			<< ", \"median\": " << result.median
+			<< ", \"p90\": " << result.percentile_90
+			<< ", \"p99\": " << result.percentile_99
+			<< ", \"max\": " << result.maximum
+			<< ", \"mean\": " << result.mean
+			<< ", \"stddev\": " << result.standard_deviation << "}";
+		if (i + 1 < _results.size())
+			stream << ",";
+		stream << endl;
+	}
+
+	stream << "\t]" << endl;
+	stream << "}" << endl;
+}
+
+
+
+uint32 BenchmarkRunner::_CalibrateOperations(const function<void()>& operation) const {
+	// Double the batch until it takes at least a tenth of the sample time, then scale it up to the full sample time
+	uint32 operations = 1;
+	double elapsed = _TimeOperations(operation, operations);
+	while (elapsed * 10.0 < _sample_time && operations < MAX_OPERATIONS_PER_SAMPLE) {
+		operations *= 2;
+		elapsed = _TimeOperations(operation, operations);
+	}
+
+	double scaled = (elapsed > 0.0) ? operations * (_sample_time / elapsed) : MAX_OPERATIONS_PER_SAMPLE;
+	if (scaled < 1.0)
+		return 1;
+	if (scaled > MAX_OPERATIONS_PER_SAMPLE)
+		return MAX_OPERATIONS_PER_SAMPLE;
+	return static_cast<uint32>(scaled);
+}
+
+
+
+double BenchmarkRunner::_TimeOperations(const function<void()>& operation, uint32 count) {
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	for (uint32 i = 0; i < count; ++i)
+		operation();
+	chrono::steady_clock::time_point end = chrono::steady_clock::now();
+	return static_cast<double>(chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+}
+
+} // namespace hoa_bench
@@ -0,0 +1,148 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    bench.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for timing benchmarks and reporting their statistics
+***
+*** A benchmark is a function that performs one operation of the code being
+*** measured each time it is called. The runner calls it repeatedly in batches
+*** and records the average time of one operation in each batch as a sample.
+*** Batches are sized so that each takes roughly the same length of time, which
+*** keeps the resolution of the clock from affecting the results.
+***
+*** The results are written as JSON, with each benchmark on its own line and
+*** its fields always in the same order, so that the output of two runs can be
+*** compared with a line-based diff as well as read by other tools.
+*** ***************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <ostream>
+
+#include "defs.h"
+#include "utils.h"
+
+//! \brief All code for the allacrost-bench executable is wrapped in this namespace
+namespace hoa_bench {
+
+//! \brief Set to true to print the progress of each benchmark as it runs
+extern bool BENCH_DEBUG;
+
+/** ****************************************************************************
+*** \brief The statistics recorded for a single benchmark
+***
+*** All times are the average number of nanoseconds that one operation took
+*** within a sample.
+*** ***************************************************************************/
+class BenchmarkResult {
+public:
+	BenchmarkResult() :
+		samples(0), operations_per_sample(0), minimum(0.0), median(0.0), percentile_90(0.0),
+		percentile_99(0.0), maximum(0.0), mean(0.0), standard_deviation(0.0) {}
+
+	//! \brief The name of the benchmark
+	std::string name;
+
+	//! \brief The number of samples that were taken
+	uint32 samples;
+
+	//! \brief The number of operations timed in each sample
+	uint32 operations_per_sample;
+
+	//! \name Sample statistics, in nanoseconds per operation
+	//@{
+	double minimum;
+	double median;
+	double percentile_90;
+	double percentile_99;
+	double maximum;
+	double mean;
+	double standard_deviation;
+	//@}
+}; // class BenchmarkResult
+
+
+/** ****************************************************************************
+*** \brief Times benchmarks and collects their results
+*** ***************************************************************************/
+class BenchmarkRunner {
+public:
+	BenchmarkRunner();
+
+	/** \brief Sets the number of samples to take of each benchmark
+	*** More samples make the percentiles more stable but take proportionally longer to run.
+	**/
+	void SetSampleCount(uint32 samples)
+		{ _sample_count = (samples > 0) ? samples : 1; }
+
+	/** \brief Sets the approximate length of each sample
+	*** \param nanoseconds The target time for one batch of operations
+	**/
+	void SetSampleTime(uint32 nanoseconds)
+		{ _sample_time = nanoseconds; }
+
+	/** \brief Only benchmarks whose names contain this text will be run
+	*** \param filter The text to search for. An empty string runs every benchmark.
+	**/
+	void SetFilter(const std::string& filter)
+		{ _filter = filter; }
+
+	/** \brief Returns true if a benchmark with the given name passes the filter and should be set up and run
+	*** This allows benchmarks with expensive setup to skip it when they are filtered out.
+	**/
+	bool IsSelected(const std::string& name) const
+		{ return (_filter.empty() == true || name.find(_filter) != std::string::npos); }
+
+	/** \brief Times a benchmark and records its result
+	*** \param name The name of the benchmark, which must be unique and should not change between versions
+	*** \param operation A function that performs one operation each time it is called
+	***
+	*** The operation is first called without being timed to warm up caches and to determine how many
+	*** operations fit into each sample. Nothing is done if the name does not pass the filter.
+	**/
+	void Run(const std::string& name, const std::function<void()>& operation);
+
+	//! \brief Returns the results of every benchmark that has been run
+	const std::vector<BenchmarkResult>& GetResults() const
+		{ return _results; }
+
+	/** \brief Writes the results of every benchmark that has been run
+	*** \param stream The stream to write the JSON document to
+	**/
+	void WriteResults(std::ostream& stream) const;
+
+private:
+	//! \brief The number of samples to take of each benchmark
+	uint32 _sample_count;
+
+	//! \brief The approximate length of each sample, in nanoseconds
+	uint32 _sample_time;
+
+	//! \brief Benchmarks whose names do not contain this text are not run
+	std::string _filter;
+
+	//! \brief The results of every benchmark that has been run, in the order that they were run
+	std::vector<BenchmarkResult> _results;
+
+	/** \brief Determines how many operations to time in each sample
+	*** \param operation The operation that will be timed
+	*** \return The number of operations that take approximately the sample time, which is at least one
+	**/
+	uint32 _CalibrateOperations(const std::function<void()>& operation) const;
+
+	/** \brief Times a batch of operations
+	*** \return The total number of nanoseconds that the batch took
+	**/
+	static double _TimeOperations(const std::function<void()>& operation, uint32 count);
+}; // class BenchmarkRunner
+
+} // namespace hoa_bench
@@ -0,0 +1,445 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    bench_cases.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for the benchmarks of the game engine
+***
+*** Every benchmark uses fixed data and a fixed random seed so that each run
+*** performs exactly the same work.
+*** ***************************************************************************/
+
+#include <cstdio>
+
+#include "bench_cases.h"
+
+#include "mode_manager.h"
+#include "particle_system.h"
+#include "script.h"
+#include "video.h"
+
+#include "global.h"
+#include "textbox.h"
+
+#include "map.h"
+#include "map_objects.h"
+
+using namespace std;
+using namespace hoa_utils;
+using namespace hoa_mode_manager;
+using namespace hoa_script;
+using namespace hoa_video;
+using namespace hoa_video::private_video;
+using namespace hoa_global;
+using namespace hoa_gui;
+using namespace hoa_map;
+using namespace hoa_map::private_map;
+
+namespace hoa_bench {
+
+namespace {
+
+//! \brief The largest map data file in the game
+const string BENCH_MAP_DATA_FILE = "lua/data/maps/harrvah_capital.lua";
+
+//! \brief The settings file of the game, which holds values of every basic type in a number of small tables
+const string BENCH_SETTINGS_FILE = "lua/data/config/settings.lua";
+
+//! \brief A map script that uses the map data file above
+const string BENCH_MAP_SCRIPT_FILE = "lua/scripts/maps/a01_harrvah_capital_attack.lua";
+
+//! \brief The IDs of the characters in the party: Claudius, Mark, and Lukar
+const uint32 BENCH_CHARACTERS[] = { 1, 2, 4 };
+
+//! \brief The number of positions and destinations that the map benchmarks cycle through
+const uint32 BENCH_MAP_POSITIONS = 1024;
+const uint32 BENCH_PATH_DESTINATIONS = 32;
+
+//! \brief The farthest that a path destination may be from the player, in collision grid elements along each axis
+const int32 BENCH_PATH_RANGE = 40;
+
+//! \brief The length of one frame when updating particle systems, in seconds
+const float BENCH_PARTICLE_FRAME_TIME = 1.0f / 60.0f;
+
+//! \brief The number of frames particle systems are updated for before they are timed, so that they are full of particles
+const uint32 BENCH_PARTICLE_WARMUP_FRAMES = 600;
+
+//! \brief Dialogue text used for the text benchmarks, which includes both ASCII and multibyte characters
+const string BENCH_TEXT =
+	"The capital has stood against the desert for three hundred years, but tonight its walls are burning. "
+	"Claudius, take Mark and Lukar to the eastern gate and hold it until the civilians have reached the palace. "
+	"Ne laissez personne derri\xC3\xA8re vous \xE2\x80\x94 the Harrvah guard does not abandon its own. "
+	"If the gate falls, fall back through the market square and make your stand at the Caf\xC3\xA9 of the Seven Winds. "
+	"Whatever happens, do not let them reach the underground river. \xC2\xBFEntiendes? Then go, and may Zhel watch over you.";
+
+//! \brief Generates a deterministic sequence of pseudo-random numbers so that every run uses the same data
+class BenchRandom {
+public:
+	BenchRandom() :
+		_state(1) {}
+
+	//! \brief Returns a random integer in the range [0, limit)
+	uint32 Next(uint32 limit) {
+		_state = _state * 1103515245 + 12345;
+		return ((_state >> 16) & 0x7FFF) % limit;
+	}
+
+private:
+	uint32 _state;
+}; // class BenchRandom
+
+} // namespace
+
+bool PrepareGlobalData() {
+	const uint32 character_count = sizeof(BENCH_CHARACTERS) / sizeof(BENCH_CHARACTERS[0]);
+
+	GlobalManager->ClearAllData();
+	for (uint32 i = 0; i < character_count; ++i) {
+		GlobalManager->AddCharacter(BENCH_CHARACTERS[i]);
+	}
+	GlobalManager->AddNewRecordGroup("global_records");
+	GlobalManager->SetDrunes(200);
+	GlobalManager->AddToInventory(1, 5);
+
+	return (GlobalManager->GetActiveParty()->GetPartySize() == character_count);
+}
+
+// -----------------------------------------------------------------------------
+// Script benchmarks
+// -----------------------------------------------------------------------------
+
+namespace {
+
+//! \brief Benchmarks reading values of each type and listing table keys in the settings file
+void RunSettingsScriptBenchmarks(BenchmarkRunner& runner) {
+	if (runner.IsSelected("script/read_settings_values") == false && runner.IsSelected("script/read_table_keys") == false)
+		return;
+
+	ReadScriptDescriptor settings;
+	if (settings.OpenFile(BENCH_SETTINGS_FILE) == false) {
+		PRINT_ERROR << "failed to open the settings file: " << BENCH_SETTINGS_FILE << endl;
+		return;
+	}
+	settings.OpenTable("settings");
+
+	// Reads the same values of each type that the boot mode reads when it loads the settings
+	const char* key_names[] = { "up", "down", "left", "right", "confirm", "cancel", "menu", "swap", "left_select",
+		"right_select", "pause" };
+	const char* joystick_names[] = { "index", "confirm", "cancel", "menu", "swap", "left_select", "right_select",
+		"pause", "quit", "x_axis", "y_axis", "threshold" };
+	string key_value;
+	int32 int_value = 0;
+	bool bool_value = false;
+	float float_value = 0.0f;
+	runner.Run("script/read_settings_values", [&]() {
+		settings.OpenTable("key_settings");
+		for (uint32 i = 0; i < sizeof(key_names) / sizeof(key_names[0]); ++i)
+			key_value = settings.ReadString(key_names[i]);
+		settings.CloseTable();
+
+		settings.OpenTable("joystick_settings");
+		if (settings.DoesBoolExist("input_disabled") == true)
+			bool_value = settings.ReadBool("input_disabled");
+		for (uint32 i = 0; i < sizeof(joystick_names) / sizeof(joystick_names[0]); ++i)
+			int_value = settings.ReadInt(joystick_names[i]);
+		settings.CloseTable();
+
+		settings.OpenTable("video_settings");
+		bool_value = settings.ReadBool("full_screen");
+		int_value = settings.ReadInt("screen_resx");
+		int_value = settings.ReadInt("screen_resy");
+		if (settings.DoesBoolExist("vsync") == true)
+			bool_value = settings.ReadBool("vsync");
+		if (settings.DoesIntExist("target_fps") == true)
+			int_value = settings.ReadInt("target_fps");
+		settings.CloseTable();
+
+		settings.OpenTable("audio_settings");
+		float_value = settings.ReadFloat("music_vol");
+		float_value = settings.ReadFloat("sound_vol");
+		settings.CloseTable();
+	});
+
+	// Lists the keys of the settings table and of every table inside it
+	vector<string> table_names;
+	settings.ReadTableKeys(table_names);
+	vector<string> keys;
+	runner.Run("script/read_table_keys", [&]() {
+		for (uint32 i = 0; i < table_names.size(); ++i) {
+			if (settings.DoesTableExist(table_names[i]) == false)
+				continue;
+
+			settings.OpenTable(table_names[i]);
+			keys.clear();
+			settings.ReadTableKeys(keys);
+			settings.CloseTable();
+		}
+	});
+
+	if (settings.IsErrorDetected() == true) {
+		PRINT_ERROR << "errors occurred while reading the settings file: " << BENCH_SETTINGS_FILE << endl
+			<< settings.GetErrorMessages() << endl;
+	}
+
+	settings.CloseAllTables();
+	settings.CloseFile();
+}
+
+
+
+//! \brief Benchmarks reading the large tables of a map data file
+void RunMapScriptBenchmarks(BenchmarkRunner& runner) {
+	if (runner.IsSelected("script/read_collision_grid") == false && runner.IsSelected("script/read_map_tiles") == false)
+		return;
+
+	ReadScriptDescriptor map_file;
+	if (map_file.OpenFile(BENCH_MAP_DATA_FILE) == false) {
+		PRINT_ERROR << "failed to open the map data file: " << BENCH_MAP_DATA_FILE << endl;
+		return;
+	}
+	map_file.OpenTable(DetermineLuaFileTablespaceName(BENCH_MAP_DATA_FILE));
+
+	vector<uint32> grid;
+	runner.Run("script/read_collision_grid", [&]() {
+		uint32 num_rows = 0;
+		uint32 num_cols = 0;
+		map_file.ReadUIntGrid("collision_grid", grid, num_rows, num_cols);
+	});
+
+	uint32 row_count = map_file.ReadUInt("map_height");
+	uint32 column_count = map_file.ReadUInt("map_length");
+	vector<int32> tile_data(map_file.ReadUInt("number_map_contexts") * map_file.ReadUInt("number_tile_layers"));
+	runner.Run("script/read_map_tiles", [&]() {
+		map_file.OpenTable("map_tiles");
+		for (uint32 y = 0; y < row_count; ++y) {
+			map_file.OpenTable(y);
+			for (uint32 x = 0; x < column_count; ++x) {
+				map_file.ReadIntArray(x, &tile_data[0], tile_data.size());
+			}
+			map_file.CloseTable();
+		}
+		map_file.CloseTable();
+	});
+
+	map_file.CloseAllTables();
+	map_file.CloseFile();
+}
+
+} // namespace
+
+void RunScriptBenchmarks(BenchmarkRunner& runner) {
+	RunSettingsScriptBenchmarks(runner);
+	RunMapScriptBenchmarks(runner);
+}
+
+// -----------------------------------------------------------------------------
+// Saved game benchmarks
+// -----------------------------------------------------------------------------
+
+void RunSaveGameBenchmarks(BenchmarkRunner& runner) {
+	if (runner.IsSelected("global/save_load_round_trip") == false)
+		return;
+
+	const string filename = GetUserDataPath() + "benchmark_saved_game.lua";
+	if (GlobalManager->SaveGame(filename, 0) == false || GlobalManager->LoadGame(filename, 0) == false) {
+		PRINT_ERROR << "failed to save and load the game: " << filename << endl;
+		return;
+	}
+
+	// Loading a game always reloads the file, which leaves a new Lua thread on the global stack. The threads left by
+	// the timed loads are discarded after each round trip so that the stack does not overflow.
+	lua_State* global_state = ScriptManager->GetGlobalState();
+	int32 stack_top = lua_gettop(global_state);
+	runner.Run("global/save_load_round_trip", [&]() {
+		GlobalManager->SaveGame(filename, 0);
+		GlobalManager->LoadGame(filename, 0);
+		lua_settop(global_state, stack_top);
+	});
+
+	remove(filename.c_str());
+	remove(GlobalManager->GetSaveHeaderFilename(filename).c_str());
+}
+
+// -----------------------------------------------------------------------------
+// Map benchmarks
+// -----------------------------------------------------------------------------
+
+void RunMapBenchmarks(BenchmarkRunner& runner) {
+	if (runner.IsSelected("map/detect_collision") == false && runner.IsSelected("map/find_path") == false)
+		return;
+
+	// The map is made the active game mode as it is in the game, which runs its Reset() function and its first update
+	MapMode* map_mode = new MapMode(BENCH_MAP_SCRIPT_FILE);
+	ModeManager->Push(map_mode);
+	ModeManager->Update();
+	if (ModeManager->GetTop() != map_mode || MapMode::CurrentInstance() != map_mode) {
+		PRINT_ERROR << "the map did not become the active game mode: " << BENCH_MAP_SCRIPT_FILE << endl;
+		ModeManager->SingletonInitialize();
+		return;
+	}
+
+	ObjectSupervisor* objects = map_mode->GetObjectSupervisor();
+	VirtualSprite* sprite = map_mode->GetCamera();
+	const CollisionGrid& grid = objects->GetCollisionGrid();
+	BenchRandom random;
+
+	uint16 start_x, start_y;
+	float start_x_offset, start_y_offset;
+	sprite->GetXPosition(start_x, start_x_offset);
+	sprite->GetYPosition(start_y, start_y_offset);
+
+	// Positions are spread over the entire map, so they include both open and blocked areas
+	vector<pair<uint16, uint16> > positions;
+	for (uint32 i = 0; i < BENCH_MAP_POSITIONS; ++i) {
+		uint16 x = 1 + random.Next(grid.GetNumberColumns() - 2);
+		uint16 y = 1 + random.Next(grid.GetNumberRows() - 2);
+		positions.push_back(make_pair(x, y));
+	}
+
+	uint32 next_position = 0;
+	runner.Run("map/detect_collision", [&]() {
+		sprite->SetPosition(positions[next_position].first, start_x_offset, positions[next_position].second, start_y_offset);
+		objects->DetectCollision(sprite, nullptr);
+		next_position = (next_position + 1) % positions.size();
+	});
+	sprite->SetPosition(start_x, start_x_offset, start_y, start_y_offset);
+
+	// Only destinations that a path was found to are timed, since failed searches are not representative
+	vector<PathNode> destinations;
+	vector<PathNode> path;
+	if (runner.IsSelected("map/find_path") == true) {
+		for (uint32 i = 0; i < BENCH_MAP_POSITIONS && destinations.size() < BENCH_PATH_DESTINATIONS; ++i) {
+			int32 x = start_x - BENCH_PATH_RANGE + static_cast<int32>(random.Next(BENCH_PATH_RANGE * 2 + 1));
+			int32 y = start_y - BENCH_PATH_RANGE + static_cast<int32>(random.Next(BENCH_PATH_RANGE * 2 + 1));
+			if (x <= 0 || y <= 0 || x >= grid.GetNumberColumns() - 1 || y >= grid.GetNumberRows() - 1)
+				continue;
+			if (x == start_x && y == start_y)
+				continue;
+
+			sprite->SetPosition(x, start_x_offset, y, start_y_offset);
+			bool open = (objects->DetectCollision(sprite, nullptr, true) == NO_COLLISION);
+			sprite->SetPosition(start_x, start_x_offset, start_y, start_y_offset);
+
+			PathNode destination(y, x);
+			if (open == true && objects->FindPath(sprite, path, destination) == true)
+				destinations.push_back(destination);
+			sprite->SetPosition(start_x, start_x_offset, start_y, start_y_offset);
+		}
+	}
+
+	if (destinations.empty() == false) {
+		uint32 next_destination = 0;
+		runner.Run("map/find_path", [&]() {
+			objects->FindPath(sprite, path, destinations[next_destination]);
+			sprite->SetPosition(start_x, start_x_offset, start_y, start_y_offset);
+			next_destination = (next_destination + 1) % destinations.size();
+		});
+	}
+	else if (runner.IsSelected("map/find_path") == true) {
+		PRINT_ERROR << "no reachable path destinations were found on the map" << endl;
+	}
+
+	// Popping the only game mode on the stack would end the game, so the mode manager is reset to delete the map instead
+	ModeManager->SingletonInitialize();
+}
+
+// -----------------------------------------------------------------------------
+// Text benchmarks
+// -----------------------------------------------------------------------------
+
+void RunTextBenchmarks(BenchmarkRunner& runner) {
+	vector<uint16> utf16_text(BENCH_TEXT.size() + 1);
+	runner.Run("utils/utf8_to_utf16", [&]() {
+		UTF8ToUTF16(BENCH_TEXT.c_str(), &utf16_text[0], BENCH_TEXT.size());
+	});
+
+	// The text box ignores text that is the same as its current text, so two slightly different texts are alternated
+	TextBox textbox(0.0f, 0.0f, 600.0f, 200.0f, VIDEO_TEXT_INSTANT);
+	textbox.SetTextStyle(TextStyle("text22"));
+	ustring texts[2] = { MakeUnicodeString(BENCH_TEXT), MakeUnicodeString(BENCH_TEXT + " Go!") };
+	uint32 next_text = 0;
+	runner.Run("gui/textbox_word_wrap", [&]() {
+		textbox.SetDisplayText(texts[next_text]);
+		next_text = 1 - next_text;
+	});
+}
+
+// -----------------------------------------------------------------------------
+// Particle benchmarks
+// -----------------------------------------------------------------------------
+
+void RunParticleBenchmarks(BenchmarkRunner& runner) {
+	const char* effect_names[] = { "snow", "fire" };
+	ParticleManager particle_manager;
+	EffectParameters parameters;
+	parameters.orientation = 0.0f;
+	parameters.attractor_x = 0.0f;
+	parameters.attractor_y = 0.0f;
+
+	for (uint32 i = 0; i < sizeof(effect_names) / sizeof(effect_names[0]); ++i) {
+		string name = string("video/particle_system_update_") + effect_names[i];
+		if (runner.IsSelected(name) == false)
+			continue;
+
+		string filename = string("lua/graphics/particles/") + effect_names[i] + ".lua";
+		const ParticleEffectDef* definition = particle_manager.LoadEffect(filename);
+		if (definition == nullptr) {
+			PRINT_ERROR << "failed to load particle effect: " << filename << endl;
+			continue;
+		}
+
+		// Only systems with emitters that never stop are timed, since the others would die during the warm-up
+		vector<ParticleSystem*> systems;
+		for (list<ParticleSystemDef*>::const_iterator j = definition->_systems.begin(); j != definition->_systems.end(); ++j) {
+			if ((*j)->enabled == false)
+				continue;
+			EMITTER_MODE mode = (*j)->emitter._emitter_mode;
+			if (mode != EMITTER_MODE_LOOPING && mode != EMITTER_MODE_ALWAYS)
+				continue;
+
+			ParticleSystem* system = new ParticleSystem();
+			if (system->Create(*j) == false) {
+				delete system;
+				continue;
+			}
+			systems.push_back(system);
+		}
+
+		for (uint32 frame = 0; frame < BENCH_PARTICLE_WARMUP_FRAMES; ++frame) {
+			for (uint32 j = 0; j < systems.size(); ++j)
+				systems[j]->Update(BENCH_PARTICLE_FRAME_TIME, parameters);
+		}
+
+		bool alive = (systems.empty() == false);
+		for (uint32 j = 0; j < systems.size(); ++j) {
+			if (systems[j]->IsAlive() == false || systems[j]->GetNumParticles() == 0)
+				alive = false;
+		}
+
+		if (alive == true) {
+			runner.Run(name, [&]() {
+				for (uint32 j = 0; j < systems.size(); ++j)
+					systems[j]->Update(BENCH_PARTICLE_FRAME_TIME, parameters);
+			});
+		}
+		else {
+			PRINT_ERROR << "the particle systems of the effect were not all alive and emitting after the warm-up: " << filename << endl;
+		}
+
+		for (uint32 j = 0; j < systems.size(); ++j) {
+			systems[j]->Destroy();
+			delete systems[j];
+		}
+	}
+
+	particle_manager.Destroy();
+}
+
+} // namespace hoa_bench
@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    bench_cases.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for the benchmarks of the game engine
+***
+*** Each function sets up the data needed by a group of related benchmarks,
+*** runs them, and releases the data again. They require the game engine to be
+*** initialized without a window. The benchmark names are used to compare
+*** results between runs, so an existing name should never be changed unless
+*** the meaning of its benchmark changes as well.
+*** ***************************************************************************/
+
+#pragma once
+
+#include "bench.h"
+
+namespace hoa_bench {
+
+/** \brief Creates the party and inventory used by the saved game and map benchmarks
+*** \return False if the party could not be created
+**/
+bool PrepareGlobalData();
+
+/** \brief Benchmarks reading the values of the settings file and the tables of a large map data file
+***
+*** - script/read_settings_values: reads strings, integers, booleans, and floats from the tables of the settings file
+*** - script/read_table_keys: lists the keys of the settings table and of every table inside it
+*** - script/read_collision_grid: reads the entire collision grid table
+*** - script/read_map_tiles: reads every row of the tile table, as the map tile supervisor does when loading
+**/
+void RunScriptBenchmarks(BenchmarkRunner& runner);
+
+/** \brief Benchmarks saving the game and loading it again
+***
+*** - global/save_load_round_trip: saves a party with items to a file and loads it back
+**/
+void RunSaveGameBenchmarks(BenchmarkRunner& runner);
+
+/** \brief Benchmarks collision detection and path finding on a large map
+*** The map is pushed onto the game mode stack and made active before it is timed.
+***
+*** - map/detect_collision: tests the player sprite for collisions at one of a fixed set of positions
+*** - map/find_path: finds a path from the player sprite to one of a fixed set of reachable destinations
+**/
+void RunMapBenchmarks(BenchmarkRunner& runner);
+
+/** \brief Benchmarks text conversion and layout
+***
+*** - utils/utf8_to_utf16: converts a paragraph of text that includes non-ASCII characters
+*** - gui/textbox_word_wrap: sets the text of a text box, which splits the text into lines that fit its width
+**/
+void RunTextBenchmarks(BenchmarkRunner& runner);
+
+/** \brief Benchmarks updating particle systems that have reached their steady number of particles
+***
+*** - video/particle_system_update_snow: advances every system of the snow effect by one frame
+*** - video/particle_system_update_fire: advances every system of the fire effect by one frame
+***
+*** Only the systems whose emitters keep running are timed. A benchmark is skipped with an error if any of its
+*** systems has died or has no particles after the warm-up.
+**/
+void RunParticleBenchmarks(BenchmarkRunner& runner);
+
+} // namespace hoa_bench
@@ -0,0 +1,242 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    bench_main.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for the main function of the allacrost-bench executable
+***
+*** The benchmark executable initializes the game engine without a window or
+*** audio, runs every benchmark whose name passes the filter, and writes the
+*** results as JSON to the standard output or to a file.
+*** ***************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+	#include <unistd.h>
+#endif
+
+#include "utils.h"
+#include "defs.h"
+
+#include "audio.h"
+#include "input.h"
+#include "mode_manager.h"
+#include "notification.h"
+#include "script.h"
+#include "system.h"
+#include "video.h"
+
+#include "global.h"
+#include "gui.h"
+
+#include "bench.h"
+#include "bench_cases.h"
+
+using namespace std;
+using namespace hoa_utils;
+using namespace hoa_audio;
+using namespace hoa_video;
+using namespace hoa_gui;
+using namespace hoa_mode_manager;
+using namespace hoa_notification;
+using namespace hoa_input;
+using namespace hoa_system;
+using namespace hoa_global;
+using namespace hoa_script;
+using namespace hoa_bench;
+
+namespace {
+
+//! \brief Destroys the engine singletons in the reverse order of their dependencies
+void QuitBenchmarks() {
+	ModeEngine::SingletonDestroy();
+	GameGlobal::SingletonDestroy();
+	NotificationEngine::SingletonDestroy();
+	ScriptEngine::SingletonDestroy();
+	GUISystem::SingletonDestroy();
+	AudioEngine::SingletonDestroy();
+	InputEngine::SingletonDestroy();
+	SystemEngine::SingletonDestroy();
+	VideoEngine::SingletonDestroy();
+}
+
+
+
+/** \brief Initializes the engine components needed by the benchmarks, without a window or audio
+*** \return False if any component failed to initialize
+**/
+bool InitializeEngine() {
+	if (SDL_Init(SDL_INIT_TIMER) != 0) {
+		PRINT_ERROR << "unable to initialize SDL: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	AUDIO_ENABLE = false;
+
+	// The ScriptManager is initialized first as other managers may utilize it in their own initialization routines
+	ScriptManager = ScriptEngine::SingletonCreate();
+	AudioManager = AudioEngine::SingletonCreate();
+	InputManager = InputEngine::SingletonCreate();
+	VideoManager = VideoEngine::SingletonCreate();
+	SystemManager = SystemEngine::SingletonCreate();
+	ModeManager = ModeEngine::SingletonCreate();
+	NotificationManager = NotificationEngine::SingletonCreate();
+	GUIManager = GUISystem::SingletonCreate();
+	GlobalManager = GameGlobal::SingletonCreate();
+
+	VideoManager->SetTarget(VIDEO_TARGET_NULL);
+
+	if (VideoManager->SingletonInitialize() == false || AudioManager->SingletonInitialize() == false ||
+		ScriptManager->SingletonInitialize() == false)
+	{
+		PRINT_ERROR << "unable to initialize the video, audio, or script engine" << endl;
+		return false;
+	}
+
+	hoa_defs::BindEngineCode();
+	hoa_defs::BindCommonCode();
+	hoa_defs::BindModeCode();
+
+	if (SystemManager->SingletonInitialize() == false || InputManager->SingletonInitialize() == false ||
+		ModeManager->SingletonInitialize() == false || GlobalManager->SingletonInitialize() == false)
+	{
+		PRINT_ERROR << "unable to initialize the system, input, mode, or global manager" << endl;
+		return false;
+	}
+
+	if (VideoManager->ApplySettings() == false || VideoManager->FinalizeInitialization() == false) {
+		PRINT_ERROR << "unable to apply video settings" << endl;
+		return false;
+	}
+
+	if (GUIManager->LoadMenuSkin("black_sleet", "img/menus/black_sleet_skin.png", "img/menus/black_sleet_texture.png") == false) {
+		PRINT_ERROR << "failed to load the 'Black Sleet' MenuSkin images" << endl;
+		return false;
+	}
+
+	// Only the fonts used by the benchmarks and by the map dialogue windows are loaded
+	if (VideoManager->Text()->LoadFont("img/fonts/libertine.ttf", "text20", 20) == false ||
+		VideoManager->Text()->LoadFont("img/fonts/libertine.ttf", "text22", 22) == false)
+	{
+		PRINT_ERROR << "failed to load libertine.ttf fonts" << endl;
+		return false;
+	}
+	VideoManager->Text()->SetDefaultStyle(TextStyle("text22", Color::white, VIDEO_TEXT_SHADOW_BLACK, 1, -2));
+
+	if (GUIManager->SingletonInitialize() == false) {
+		PRINT_ERROR << "unable to initialize GUIManager" << endl;
+		return false;
+	}
+
+	SystemManager->InitializeTimers();
+	return true;
+}
+
+
+
+//! \brief Prints the command-line options of the benchmark executable
+void PrintUsage() {
+	cout << "usage: allacrost-bench [options]" << endl;
+	cout << "  --filter <text>      :: only run benchmarks whose names contain the text" << endl;
+	cout << "  --output <file>      :: write the results to a file instead of the standard output" << endl;
+	cout << "  --samples <count>    :: the number of samples to take of each benchmark (default 50)" << endl;
+	cout << "  --sample-time <ms>   :: the approximate length of each sample in milliseconds (default 10)" << endl;
+	cout << "  --debug              :: print the name of each benchmark as it runs" << endl;
+	cout << "  --help               :: print this help message" << endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+	atexit(SDL_Quit);
+	atexit(QuitBenchmarks);
+
+	BenchmarkRunner runner;
+	string output_filename;
+
+	for (int32 i = 1; i < argc; ++i) {
+		string option = argv[i];
+		bool has_value = (i + 1 < argc);
+
+		if (option == "--filter" && has_value == true) {
+			runner.SetFilter(argv[++i]);
+		}
+		else if (option == "--output" && has_value == true) {
+			output_filename = argv[++i];
+		}
+		else if (option == "--samples" && has_value == true) {
+			runner.SetSampleCount(atoi(argv[++i]));
+		}
+		else if (option == "--sample-time" && has_value == true) {
+			runner.SetSampleTime(atoi(argv[++i]) * 1000000);
+		}
+		else if (option == "--debug") {
+			BENCH_DEBUG = true;
+		}
+		else if (option == "--help" || option == "-h") {
+			PrintUsage();
+			return EXIT_SUCCESS;
+		}
+		else {
+			cerr << "invalid option: " << option << endl;
+			PrintUsage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	// The output file is opened before changing directories so that its name is relative to where the program was run from
+	ofstream output_file;
+	if (output_filename.empty() == false) {
+		output_file.open(output_filename.c_str());
+		if (output_file.is_open() == false) {
+			PRINT_ERROR << "failed to open output file: " << output_filename << endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+#if (defined(__linux__) || defined(__FreeBSD__)) && !defined(RELEASE_BUILD)
+	// Look for data files in DATADIR only if they are not available in the current directory
+	if (!ifstream("lua/data/config/settings.lua")) {
+		if (chdir(DATADIR) != 0) {
+			PRINT_ERROR << "failed to change directory to data location" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+#endif
+
+	if (InitializeEngine() == false)
+		return EXIT_FAILURE;
+
+	if (PrepareGlobalData() == false) {
+		PRINT_ERROR << "failed to create the party used by the benchmarks" << endl;
+		return EXIT_FAILURE;
+	}
+
+	RunScriptBenchmarks(runner);
+	RunSaveGameBenchmarks(runner);
+	RunMapBenchmarks(runner);
+	RunTextBenchmarks(runner);
+	RunParticleBenchmarks(runner);
+
+	if (runner.GetResults().empty() == true) {
+		PRINT_ERROR << "no benchmarks were run" << endl;
+		return EXIT_FAILURE;
+	}
+
+	if (output_file.is_open() == true)
+		runner.WriteResults(output_file);
+	else
+		runner.WriteResults(cout);
+
+	return EXIT_SUCCESS;
+}
@@ -173,6 +173,9 @@ bool GameGlobal::_LoadGlobalScripts() {
 
 
 void GameGlobal::_CloseGlobalScripts() {
+	// The definitions hold references to functions in the scripts, so release them first
+	ClearDefinitions();
+
 	if (_global_script.IsFileOpen() == true) {
 		_global_script.CloseFile();
 	}
@@ -242,6 +245,108 @@ void GameGlobal::_CloseGlobalScripts() {
 	}
 } // void GameGlobal::_CloseGlobalScripts()
 
+
+
+GlobalObjectDefinition* GameGlobal::GetObjectDefinition(uint32 id) {
+	map<uint32, GlobalObjectDefinition*>::iterator it = _object_definitions.find(id);
+	if (it != _object_definitions.end()) {
+		return it->second;
+	}
+
+	GlobalObjectDefinition* definition = new GlobalObjectDefinition(id);
+	definition->AddReference();
+	_object_definitions.insert(make_pair(id, definition));
+	return definition;
+}
+
+
+
+GlobalSkillDefinition* GameGlobal::GetSkillDefinition(uint32 id) {
+	map<uint32, GlobalSkillDefinition*>::iterator it = _skill_definitions.find(id);
+	if (it != _skill_definitions.end()) {
+		return it->second;
+	}
+
+	GlobalSkillDefinition* definition = new GlobalSkillDefinition(id);
+	definition->AddReference();
+	_skill_definitions.insert(make_pair(id, definition));
+	return definition;
+}
+
+
+
+GlobalEnemyDefinition* GameGlobal::GetEnemyDefinition(uint32 id) {
+	map<uint32, GlobalEnemyDefinition*>::iterator it = _enemy_definitions.find(id);
+	if (it != _enemy_definitions.end()) {
+		return it->second;
+	}
+
+	// Read every enemy in the set file that the enemy belongs to, unless that file has already been read
+	string filename = GlobalEnemyDefinition::GetEnemySetFilename(id);
+	if (filename.empty() == false && _enemy_set_files.find(filename) == _enemy_set_files.end()) {
+		_enemy_set_files.insert(filename);
+
+		ReadScriptDescriptor enemy_data;
+		if (enemy_data.OpenFile(filename) == false) {
+			PRINT_ERROR << "failed to open enemy data file: " << filename << endl;
+		}
+		else {
+			vector<uint32> enemy_ids;
+			enemy_data.OpenTable("enemies");
+			enemy_data.ReadTableKeys(enemy_ids);
+			for (uint32 i = 0; i < enemy_ids.size(); i++) {
+				if (_enemy_definitions.find(enemy_ids[i]) != _enemy_definitions.end())
+					continue;
+
+				GlobalEnemyDefinition* definition = new GlobalEnemyDefinition(enemy_ids[i], enemy_data);
+				definition->AddReference();
+				_enemy_definitions.insert(make_pair(enemy_ids[i], definition));
+			}
+			enemy_data.CloseTable();
+
+			if (enemy_data.IsErrorDetected()) {
+				if (GLOBAL_DEBUG) {
+					PRINT_WARNING << "one or more errors occurred while reading the enemy data - they are listed below" << endl;
+					cerr << enemy_data.GetErrorMessages() << endl;
+				}
+			}
+			enemy_data.CloseFile();
+		}
+
+		it = _enemy_definitions.find(id);
+		if (it != _enemy_definitions.end()) {
+			return it->second;
+		}
+	}
+
+	// Remember that the ID has no valid data so that the set file is not searched for it again
+	GlobalEnemyDefinition* definition = new GlobalEnemyDefinition(id);
+	definition->AddReference();
+	_enemy_definitions.insert(make_pair(id, definition));
+	return definition;
+}
+
+
+
+void GameGlobal::ClearDefinitions() {
+	// Definitions still referenced by existing objects or skills are deleted once those are destroyed
+	for (map<uint32, GlobalObjectDefinition*>::iterator i = _object_definitions.begin(); i != _object_definitions.end(); i++) {
+		i->second->RemoveReference();
+	}
+	_object_definitions.clear();
+
+	for (map<uint32, GlobalSkillDefinition*>::iterator i = _skill_definitions.begin(); i != _skill_definitions.end(); i++) {
+		i->second->RemoveReference();
+	}
+	_skill_definitions.clear();
+
+	for (map<uint32, GlobalEnemyDefinition*>::iterator i = _enemy_definitions.begin(); i != _enemy_definitions.end(); i++) {
+		i->second->RemoveReference();
+	}
+	_enemy_definitions.clear();
+	_enemy_set_files.clear();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // GameGlobal class - Character Functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -693,6 +798,13 @@ void GameGlobal::SetLocation(const ustring& location_name, const string& locatio
 
 
 bool GameGlobal::SaveGame(const string& filename, uint32 slot_used, uint32 x_position, uint32 y_position) {
+	// Remove the header of any previous save first. If the game is interrupted before the new header is written,
+	// save mode falls back to reading the saved game file itself instead of displaying a stale header.
+	string header_filename = GetSaveHeaderFilename(filename);
+	if (DoesFileExist(header_filename) == true) {
+		DeleteFile(header_filename);
+	}
+
 	WriteScriptDescriptor file;
 	if (file.OpenFile(filename) == false) {
 		return false;
@@ -775,6 +887,10 @@ bool GameGlobal::SaveGame(const string& filename, uint32 slot_used, uint32 x_pos
 	}
 
 	file.CloseFile();
+
+	if (_SaveGameHeader(filename) == false) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed to write the header file for the saved game: " << filename << endl;
+	}
 	return true;
 } // bool GameGlobal::SaveGame(string& filename)
 
@@ -848,10 +964,71 @@ bool GameGlobal::LoadGame(const string& filename, uint32 slot_used) {
 	return true;
 } // bool GameGlobal::LoadGame(string& filename)
 
+
+
+string GameGlobal::GetSaveHeaderFilename(const string& filename) const {
+	const string extension = ".lua";
+	if (filename.size() > extension.size() && filename.compare(filename.size() - extension.size(), extension.size(), extension) == 0) {
+		return filename.substr(0, filename.size() - extension.size()) + "_header" + extension;
+	}
+	return filename + "_header" + extension;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // GameGlobal class - Private Methods
 ////////////////////////////////////////////////////////////////////////////////
 
+bool GameGlobal::_SaveGameHeader(const string& filename) {
+	WriteScriptDescriptor file;
+	if (file.OpenFile(GetSaveHeaderFilename(filename)) == false) {
+		return false;
+	}
+
+	file.WriteComment("Preview data for the saved game file: " + filename);
+	file.BeginTable("save_header");
+	file.WriteString("location_name", MakeStandardString(_location_name));
+	file.WriteUInt("play_hours", SystemManager->GetPlayHours());
+	file.WriteUInt("play_minutes", SystemManager->GetPlayMinutes());
+	file.WriteUInt("play_seconds", SystemManager->GetPlaySeconds());
+	file.WriteUInt("drunes", _drunes);
+
+	file.BeginTable("characters");
+	vector<uint32> character_ids;
+	for (uint32 i = 0; i < _character_order.size(); i++) {
+		character_ids.push_back(_character_order[i]->GetID());
+	}
+	if (character_ids.empty() == false) {
+		file.WriteUIntVector("order", character_ids);
+	}
+	for (uint32 i = 0; i < _character_order.size(); i++) {
+		GlobalCharacter* character = _character_order[i];
+		file.BeginTable(character->GetID());
+		file.WriteUInt("experience_level", character->GetExperienceLevel());
+		file.WriteUInt("hit_points", character->GetHitPoints());
+		file.WriteUInt("max_hit_points", character->GetMaxHitPoints());
+		file.WriteUInt("skill_points", character->GetSkillPoints());
+		file.WriteUInt("max_skill_points", character->GetMaxSkillPoints());
+		file.EndTable();
+	}
+	file.EndTable();
+	file.EndTable();
+
+	if (file.IsErrorDetected()) {
+		if (GLOBAL_DEBUG) {
+			PRINT_WARNING << "one or more errors occurred while writing the save game header file - they are listed below" << endl;
+			cerr << file.GetErrorMessages() << endl;
+		}
+		file.CloseFile();
+		DeleteFile(GetSaveHeaderFilename(filename));
+		return false;
+	}
+
+	file.CloseFile();
+	return true;
+} // bool GameGlobal::_SaveGameHeader(const string& filename)
+
+
+
 void GameGlobal::_SaveCharacter(WriteScriptDescriptor& file, GlobalCharacter* character, bool last) {
 	if (file.IsFileOpen() == false) {
 		IF_PRINT_WARNING(GLOBAL_DEBUG) << "the file provided in the function argument was not open" << endl;
@@ -87,6 +87,27 @@ public:
 	bool ReloadGlobalScripts()
 		{ _CloseGlobalScripts(); return _LoadGlobalScripts(); }
 
+	/** \name Definition Functions
+	*** \brief Return the shared definition of an object, skill, or enemy, reading it from the definition scripts if needed
+	*** \param id The ID of the object, skill, or enemy
+	*** \return A pointer to the definition. This is never nullptr, but the definition may be invalid.
+	***
+	*** Definitions are read lazily the first time that they are requested and kept until the global scripts are
+	*** closed. Callers that retain the returned pointer must call AddReference() on it, and RemoveReference()
+	*** when they no longer need it.
+	***
+	*** The first request for an enemy reads the definitions of every enemy in the same enemy set file, so that
+	*** each set file is only opened and run once.
+	**/
+	//@{
+	private_global::GlobalObjectDefinition* GetObjectDefinition(uint32 id);
+	private_global::GlobalSkillDefinition* GetSkillDefinition(uint32 id);
+	private_global::GlobalEnemyDefinition* GetEnemyDefinition(uint32 id);
+	//@}
+
+	//! \brief Releases all cached object, skill, and enemy definitions so that they are read again when next needed
+	void ClearDefinitions();
+
 	//! \name Character Functions
 	//@{
 	/** \brief Adds a new character to the party with its initial settings
@@ -347,6 +368,16 @@ public:
 	**/
 	bool LoadGame(const std::string& filename, uint32 slot_used);
 
+	/** \brief Returns the name of the header file that summarizes a saved game file
+	*** \param filename The filename of the saved game file
+	***
+	*** Every call to SaveGame() also writes a small header file next to the saved game. It contains only the
+	*** data needed to preview the saved game (location, play time, drunes, and a summary of each character
+	*** in the party), so that save mode can display it without executing the full saved game file. For example,
+	*** the header file for "saved_game_1.lua" is "saved_game_1_header.lua".
+	**/
+	std::string GetSaveHeaderFilename(const std::string& filename) const;
+
 	//! \name Class Member Access Functions
 	//@{
 	void SetDrunes(uint32 amount)
@@ -573,6 +604,16 @@ private:
 	**/
 	std::map<std::string, hoa_common::CommonRecordGroup*> _record_groups;
 
+	//! \brief The definitions of all objects, skills, and enemies that have been read from the definition scripts, keyed by ID
+	//@{
+	std::map<uint32, private_global::GlobalObjectDefinition*> _object_definitions;
+	std::map<uint32, private_global::GlobalSkillDefinition*> _skill_definitions;
+	std::map<uint32, private_global::GlobalEnemyDefinition*> _enemy_definitions;
+	//@}
+
+	//! \brief The filenames of the enemy set scripts whose definitions have all been read into _enemy_definitions
+	std::set<std::string> _enemy_set_files;
+
 	// ----- Private methods
 
 	/** \brief A helper template function that finds and removes an object from the inventory
@@ -598,6 +639,12 @@ private:
 	**/
 	template <class T> void _SaveInventory(hoa_script::WriteScriptDescriptor& file, std::string name, std::vector<T*>& inv);
 
+	/** \brief A helper function to GameGlobal::SaveGame() that writes the header file of a saved game
+	*** \param filename The filename of the saved game file that the header describes
+	*** \return True if the header file was written successfully
+	**/
+	bool _SaveGameHeader(const std::string& filename);
+
 	/** \brief A helper function to GameGlobal::SaveGame() that writes character data to the saved game file
 	*** \param file A reference to the open and valid file where to write the character data
 	*** \param objects A ponter to the character whose data should be saved
@@ -14,6 +14,7 @@
 *** ***************************************************************************/
 
 #include "video.h"
+#include "global.h"
 #include "global_actors.h"
 #include "global_objects.h"
 #include "global_effects.h"
@@ -1296,110 +1297,196 @@ void GlobalCharacter::_ConstructPeriodicGrowth() {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-// GlobalEnemy class
+// GlobalEnemyDefinition class
 ////////////////////////////////////////////////////////////////////////////////
 
-GlobalEnemy::GlobalEnemy(uint32 id) :
-	GlobalActor(),
-	_no_stat_randomization(false),
-	_sprite_width(0),
-	_sprite_height(0),
-	_drunes_dropped(0)
+namespace private_global {
+
+GlobalEnemyDefinition::GlobalEnemyDefinition(uint32 id) :
+	valid(false),
+	id(id),
+	sprite_width(0),
+	sprite_height(0),
+	no_stat_randomization(false),
+	hit_points(0),
+	skill_points(0),
+	experience_points(0),
+	strength(0),
+	vigor(0),
+	fortitude(0),
+	protection(0),
+	stamina(0),
+	resilience(0),
+	agility(0),
+	evade(0.0f),
+	drunes_dropped(0),
+	_reference_count(0)
+{}
+
+
+
+GlobalEnemyDefinition::GlobalEnemyDefinition(uint32 id, ReadScriptDescriptor& script) :
+	valid(false),
+	id(id),
+	sprite_width(0),
+	sprite_height(0),
+	no_stat_randomization(false),
+	hit_points(0),
+	skill_points(0),
+	experience_points(0),
+	strength(0),
+	vigor(0),
+	fortitude(0),
+	protection(0),
+	stamina(0),
+	resilience(0),
+	agility(0),
+	evade(0.0f),
+	drunes_dropped(0),
+	_reference_count(0)
 {
-	_id = id;
+	script.OpenTable(id);
+
+	// ----- (1): Load the enemy's name and sprite data
+	name = MakeUnicodeString(script.ReadString("name"));
+	filename = script.ReadString("filename");
+	sprite_width = script.ReadInt("sprite_width");
+	sprite_height = script.ReadInt("sprite_height");
+
+	// ----- (2): Load the enemy's base stats
+	if (script.DoesBoolExist("no_stat_randomization") == true) {
+		no_stat_randomization = script.ReadBool("no_stat_randomization");
+	}
+
+	script.OpenTable("base_stats");
+	hit_points = script.ReadUInt("hit_points");
+	skill_points = script.ReadUInt("skill_points");
+	experience_points = script.ReadUInt("experience_points");
+	strength = script.ReadUInt("strength");
+	vigor = script.ReadUInt("vigor");
+	fortitude = script.ReadUInt("fortitude");
+	protection = script.ReadUInt("protection");
+	stamina = hit_points;
+	if (script.DoesUIntExist("stamina") == true) {
+		stamina = script.ReadUInt("stamina");
+	}
+	resilience = skill_points;
+	if (script.DoesUIntExist("resilience") == true) {
+		resilience = script.ReadUInt("resilience");
+	}
+	agility = script.ReadUInt("agility");
+	evade = script.ReadFloat("evade");
+	drunes_dropped = script.ReadUInt("drunes");
+	script.CloseTable();
+
+	// ----- (3): Create a prototype of each skill that the enemy may use
+	script.OpenTable("skills");
+	for (uint32 i = 1; i <= script.GetTableSize(); i++) {
+		uint32 skill_id = script.ReadUInt(i);
+		GlobalSkill* skill = new GlobalSkill(skill_id);
+		if (skill->IsValid() == false) {
+			IF_PRINT_WARNING(GLOBAL_DEBUG) << "enemy " << id << " had a skill that failed to load: " << skill_id << endl;
+			delete skill;
+			continue;
+		}
+		skills.push_back(skill);
+	}
+	script.CloseTable();
+
+	// ----- (4): Load the possible items that the enemy may drop
+	script.OpenTable("drop_objects");
+	for (uint32 i = 1; i <= script.GetTableSize(); i++) {
+		script.OpenTable(i);
+		dropped_objects.push_back(script.ReadUInt(1));
+		dropped_chance.push_back(script.ReadFloat(2));
+		script.CloseTable();
+	}
+	script.CloseTable();
 
-	// ----- (1): Use the id member to determine the name of the data file that the enemy is defined in
-	string file_ext;
-	string filename;
+	script.CloseTable(); // enemies[id]
 
-	if (_id == 0)
-		PRINT_ERROR << "invalid id for loading enemy data: " << _id << endl;
-	else if ((_id > 0) && (_id <= 100))
-		file_ext = "01";
-	else if ((_id > 100) && (_id <= 200))
-		file_ext = "02";
+	valid = true;
+} // GlobalEnemyDefinition::GlobalEnemyDefinition(uint32 id, ReadScriptDescriptor& script)
 
-	filename = "lua/data/actors/enemies_set_" + file_ext + ".lua";
 
-	// ----- (2): Open the script file and table that store the enemy data
-	ReadScriptDescriptor enemy_data;
-	if (enemy_data.OpenFile(filename) == false) {
-		PRINT_ERROR << "failed to open enemy data file: " << filename << endl;
-		return;
+
+GlobalEnemyDefinition::~GlobalEnemyDefinition() {
+	for (uint32 i = 0; i < skills.size(); i++) {
+		delete skills[i];
 	}
+	skills.clear();
+}
+
 
-	enemy_data.OpenTable("enemies");
-	enemy_data.OpenTable(_id);
 
-	// ----- (3): Load the enemy's name and sprite data
-	_name = MakeUnicodeString(enemy_data.ReadString("name"));
-	_filename = enemy_data.ReadString("filename");
-	_sprite_width = enemy_data.ReadInt("sprite_width");
-	_sprite_height = enemy_data.ReadInt("sprite_height");
+vector<StillImage>& GlobalEnemyDefinition::GetBattleSpriteFrames() {
+	if (_battle_sprite_frames.empty() == false || valid == false) {
+		return _battle_sprite_frames;
+	}
 
-	// ----- (4): Attempt to load the MultiImage for the sprite's frames, which should contain one row and four columns of images
+	// The sprite's frames should be contained in one row and four columns of images
 	_battle_sprite_frames.assign(4, StillImage());
-	string sprite_filename = "img/sprites/enemies/" + _filename + ".png";
+	string sprite_filename = "img/sprites/enemies/" + filename + ".png";
 	if (ImageDescriptor::LoadMultiImageFromElementGrid(_battle_sprite_frames, sprite_filename, 1, 4) == false) {
 		IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed to load sprite frames for enemy: " << sprite_filename << endl;
 	}
+	return _battle_sprite_frames;
+}
 
-	// ----- (5): Load the enemy's base stats
-	if (enemy_data.DoesBoolExist("no_stat_randomization") == true) {
-		_no_stat_randomization = enemy_data.ReadBool("no_stat_randomization");
+
+
+string GlobalEnemyDefinition::GetEnemySetFilename(uint32 id) {
+	if ((id > 0) && (id <= 100))
+		return "lua/data/actors/enemies_set_01.lua";
+	else if ((id > 100) && (id <= 200))
+		return "lua/data/actors/enemies_set_02.lua";
+	else
+		return "";
+}
+
+} // namespace private_global
+
+////////////////////////////////////////////////////////////////////////////////
+// GlobalEnemy class
+////////////////////////////////////////////////////////////////////////////////
+
+GlobalEnemy::GlobalEnemy(uint32 id) :
+	GlobalActor(),
+	_drunes_dropped(0),
+	_definition(nullptr)
+{
+	_id = id;
+	if (_id == 0) {
+		PRINT_ERROR << "invalid id for loading enemy data: " << _id << endl;
 	}
 
-	enemy_data.OpenTable("base_stats");
-	_max_hit_points = enemy_data.ReadUInt("hit_points");
-	_hit_points = _max_hit_points;
-	_max_skill_points = enemy_data.ReadUInt("skill_points");
-	_skill_points = _max_skill_points;
-	_experience_points = enemy_data.ReadUInt("experience_points");
-	_strength = enemy_data.ReadUInt("strength");
-	_vigor = enemy_data.ReadUInt("vigor");
-	_fortitude = enemy_data.ReadUInt("fortitude");
-	_protection = enemy_data.ReadUInt("protection");
-	_stamina = _max_hit_points;
-	if (enemy_data.DoesUIntExist("stamina") == true) {
-		_stamina = enemy_data.ReadUInt("stamina");
-	}
-	_resilience = _max_skill_points;
-	if (enemy_data.DoesUIntExist("resilience") == true) {
-		_resilience = enemy_data.ReadUInt("resilience");
-	}
-	_agility = enemy_data.ReadUInt("agility");
-	_evade = enemy_data.ReadFloat("evade");
-	_drunes_dropped = enemy_data.ReadUInt("drunes");
-	enemy_data.CloseTable();
-
-	// ----- (6): Add the set of skills for the enemy
-	enemy_data.OpenTable("skills");
-	for (uint32 i = 1; i <= enemy_data.GetTableSize(); i++) {
-		_skill_set.push_back(enemy_data.ReadUInt(i));
-	}
-	enemy_data.CloseTable();
-
-	// ----- (7): Load the possible items that the enemy may drop
-	enemy_data.OpenTable("drop_objects");
-	for (uint32 i = 1; i <= enemy_data.GetTableSize(); i++) {
-		enemy_data.OpenTable(i);
-		_dropped_objects.push_back(enemy_data.ReadUInt(1));
-		_dropped_chance.push_back(enemy_data.ReadFloat(2));
-		enemy_data.CloseTable();
-	}
-	enemy_data.CloseTable();
-
-	enemy_data.CloseTable(); // enemies[_id]
-	enemy_data.CloseTable(); // enemies
-
-	if (enemy_data.IsErrorDetected()) {
-		if (GLOBAL_DEBUG) {
-			PRINT_WARNING << "one or more errors occurred while reading the enemy data - they are listed below" << endl;
-			cerr << enemy_data.GetErrorMessages() << endl;
-		}
+	_definition = GlobalManager->GetEnemyDefinition(_id);
+	_definition->AddReference();
+	if (_definition->valid == false) {
+		PRINT_ERROR << "no valid definition exists for enemy: " << _id << endl;
+		return;
 	}
 
-	enemy_data.CloseFile();
+	_name = _definition->name;
+	_filename = _definition->filename;
+
+	// Load the sprite frames now if no other enemy of this type has done so already, rather than when the enemy is first drawn
+	_definition->GetBattleSpriteFrames();
+
+	_max_hit_points = _definition->hit_points;
+	_hit_points = _max_hit_points;
+	_max_skill_points = _definition->skill_points;
+	_skill_points = _max_skill_points;
+	_experience_points = _definition->experience_points;
+	_strength = _definition->strength;
+	_vigor = _definition->vigor;
+	_fortitude = _definition->fortitude;
+	_protection = _definition->protection;
+	_stamina = _definition->stamina;
+	_resilience = _definition->resilience;
+	_agility = _definition->agility;
+	_evade = _definition->evade;
+	_drunes_dropped = _definition->drunes_dropped;
 
 	_CalculateAttackRatings();
 	_CalculateDefenseRatings();
@@ -1407,6 +1494,36 @@ GlobalEnemy::GlobalEnemy(uint32 id) :
 
 
 
+GlobalEnemy::~GlobalEnemy() {
+	_definition->RemoveReference();
+}
+
+
+
+GlobalEnemy::GlobalEnemy(const GlobalEnemy& copy) :
+	GlobalActor(copy),
+	_drunes_dropped(copy._drunes_dropped),
+	_definition(copy._definition)
+{
+	_definition->AddReference();
+}
+
+
+
+GlobalEnemy& GlobalEnemy::operator=(const GlobalEnemy& copy) {
+	if (this == &copy) // Handle self-assignment case
+		return *this;
+
+	GlobalActor::operator=(copy);
+	_drunes_dropped = copy._drunes_dropped;
+	copy._definition->AddReference();
+	_definition->RemoveReference();
+	_definition = copy._definition;
+	return *this;
+}
+
+
+
 void GlobalEnemy::AddSkill(uint32 skill_id) {
 	if (skill_id == 0) {
 		IF_PRINT_WARNING(GLOBAL_DEBUG) << "function received an invalid skill_id argument: " << skill_id << endl;
@@ -1438,9 +1555,9 @@ void GlobalEnemy::Initialize() {
 	// TODO: we may wish to actually define XP levels for enemies in their data table, though I don't know what purpose it may serve
 	_experience_level = 1;
 
-	// ----- (1): Add all new skills that should be available at the current experience level
-	for (uint32 i = 0; i < _skill_set.size(); i++) {
-		AddSkill(_skill_set[i]);
+	// ----- (1): Add all of the skills in the definition, which have already been validated
+	for (uint32 i = 0; i < _definition->skills.size(); i++) {
+		_skills.push_back(new GlobalSkill(*_definition->skills[i]));
 	}
 
 	if (_skills.empty()) {
@@ -1448,7 +1565,7 @@ void GlobalEnemy::Initialize() {
 	}
 
 	// ----- (3): Randomize the stats by using a guassian random variable
-	if (_no_stat_randomization == false) {
+	if (_definition->no_stat_randomization == false) {
 		// Use the base stats as the means and a standard deviation of 10% of the mean
 		_max_hit_points     = GaussianRandomValue(_max_hit_points, _max_hit_points / 10.0f);
 		_max_skill_points   = GaussianRandomValue(_max_skill_points, _max_skill_points / 10.0f);
@@ -1482,9 +1599,9 @@ void GlobalEnemy::Initialize() {
 void GlobalEnemy::DetermineDroppedObjects(vector<GlobalObject*>& objects) {
 	objects.clear();
 
-	for (uint32 i = 0; i < _dropped_objects.size(); i++) {
-		if (RandomFloat() < _dropped_chance[i]) {
-			objects.push_back(GlobalCreateNewObject(_dropped_objects[i]));
+	for (uint32 i = 0; i < _definition->dropped_objects.size(); i++) {
+		if (RandomFloat() < _definition->dropped_chance[i]) {
+			objects.push_back(GlobalCreateNewObject(_definition->dropped_objects[i]));
 		}
 	}
 }
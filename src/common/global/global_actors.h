@@ -887,6 +887,116 @@ private:
 }; // class GlobalCharacter : public GlobalActor
 
 
+namespace private_global {
+
+/** ****************************************************************************
+*** \brief The unchanging data shared by every instance of the same enemy
+***
+*** Like GlobalSkillDefinition, an enemy definition is read from its definition
+*** script only once and then shared by every GlobalEnemy with the same ID. All of
+*** the enemies in an enemy set file are read together the first time that any
+*** of them is requested, as opening the file runs the script for the entire set.
+*** Definitions are reference counted the same way that skill definitions are.
+***
+*** The battle sprite frames are not loaded until the first enemy that uses the
+*** definition is constructed, so that reading a set does not load the images of
+*** enemies that never appear.
+***
+*** \note A definition is also created for IDs that have no valid data. The valid
+*** member of these definitions is false.
+*** ***************************************************************************/
+class GlobalEnemyDefinition {
+public:
+	//! \brief Constructs an invalid definition for an enemy with no valid data
+	GlobalEnemyDefinition(uint32 id);
+
+	/** \brief Reads the definition of an enemy from its enemy set script
+	*** \param id The ID of the enemy to read the definition for
+	*** \param script The enemy set script, with the "enemies" table open
+	**/
+	GlobalEnemyDefinition(uint32 id, hoa_script::ReadScriptDescriptor& script);
+
+	~GlobalEnemyDefinition();
+
+	//! \brief Increments the number of references to this definition
+	void AddReference()
+		{ ++_reference_count; }
+
+	//! \brief Decrements the number of references to this definition and deletes it when none remain
+	void RemoveReference()
+		{ if (--_reference_count == 0) delete this; }
+
+	//! \brief Returns the battle sprite frames of the enemy, loading them if this has not yet been done
+	std::vector<hoa_video::StillImage>& GetBattleSpriteFrames();
+
+	//! \brief Returns the name of the enemy set script that an enemy is defined in
+	static std::string GetEnemySetFilename(uint32 id);
+
+	//! \brief Set to false if the definition could not be read successfully
+	bool valid;
+
+	//! \brief The ID, name, and image filename of the enemy
+	//@{
+	uint32 id;
+	hoa_utils::ustring name;
+	std::string filename;
+	//@}
+
+	//! \brief The dimensions of the enemy's battle sprite in pixels
+	uint32 sprite_width, sprite_height;
+
+	//! \brief If set to true, when initialized the enemy will not randomize its statistic values
+	bool no_stat_randomization;
+
+	//! \brief The base stats of the enemy, which are randomized for each enemy when it is initialized
+	//@{
+	uint32 hit_points;
+	uint32 skill_points;
+	uint32 experience_points;
+	uint32 strength;
+	uint32 vigor;
+	uint32 fortitude;
+	uint32 protection;
+	uint32 stamina;
+	uint32 resilience;
+	uint32 agility;
+	float evade;
+	uint32 drunes_dropped;
+	//@}
+
+	/** \brief The skills that the enemy may use in battle
+	*** These are valid skill prototypes that each enemy copies when it is initialized, so that initializing an
+	*** enemy does not need to look up and validate each of its skills.
+	**/
+	std::vector<GlobalSkill*> skills;
+
+	/** \brief Dropped object containers
+	*** These two vectors are of the same size. dropped_objects contains the IDs of the objects that the enemy
+	*** may drop. dropped_chance contains a value from 0.0f to 1.0f that determines the probability of the
+	*** enemy dropping that object.
+	**/
+	//@{
+	std::vector<uint32> dropped_objects;
+	std::vector<float> dropped_chance;
+	//@}
+
+private:
+	//! \brief The number of enemies and containers that retain a pointer to this definition
+	uint32 _reference_count;
+
+	/** \brief The battle sprite frame images for the enemy
+	*** Each enemy has four frames representing damage levels of 0%, 33%, 66%, and 100%. This vector is empty
+	*** until the frames are first requested, and then always has a size of four holding each of these image frames.
+	**/
+	std::vector<hoa_video::StillImage> _battle_sprite_frames;
+
+	GlobalEnemyDefinition(const GlobalEnemyDefinition&);
+	GlobalEnemyDefinition& operator=(const GlobalEnemyDefinition&);
+}; // class GlobalEnemyDefinition
+
+} // namespace private_global
+
+
 /** ****************************************************************************
 *** \brief Representation of enemies that fight in battles
 ***
@@ -904,13 +1014,19 @@ private:
 *** has to have at least one skill defined for it, otherwise they would not be able to
 *** perform any action in battle. Enemy's may also carry a small chance of dropping an
 *** item or other object after they are defeated.
+***
+*** The data that does not change between enemies of the same type is held in a shared
+*** GlobalEnemyDefinition. Each enemy holds only its own randomized stats and skills.
 *** ***************************************************************************/
 class GlobalEnemy : public GlobalActor {
 public:
 	GlobalEnemy(uint32 id);
 
-	virtual ~GlobalEnemy()
-		{}
+	virtual ~GlobalEnemy();
+
+	GlobalEnemy(const GlobalEnemy& copy);
+
+	GlobalEnemy& operator=(const GlobalEnemy& copy);
 
 	/** \brief Initializes the enemy and prepares it for battle
 	***
@@ -951,47 +1067,22 @@ public:
 		{ return _drunes_dropped; }
 
 	uint32 GetSpriteWidth() const
-		{ return _sprite_width; }
+		{ return _definition->sprite_width; }
 
 	uint32 GetSpriteHeight() const
-		{ return _sprite_height; }
+		{ return _definition->sprite_height; }
 
+	//! \note The frames are shared by every enemy with the same ID and should not be modified
 	std::vector<hoa_video::StillImage>* GetBattleSpriteFrames()
-		{ return &_battle_sprite_frames; }
+		{ return &_definition->GetBattleSpriteFrames(); }
 	//@}
 
 protected:
-	//! \brief If set to true, when initialized the enemy will not randomize its statistic values
-	bool _no_stat_randomization;
-
-	//! \brief The dimensions of the enemy's battle sprite in pixels
-	uint32 _sprite_width, _sprite_height;
-
 	//! \brief The amount of drunes that the enemy will drop
 	uint32 _drunes_dropped;
 
-	/** \brief Dropped object containers
-	*** These two vectors are of the same size. _dropped_objects contains the IDs of the objects that the enemy
-	*** may drop. _dropped_chance contains a value from 0.0f to 1.0f that determines the probability of the
-	*** enemy dropping that object.
-	**/
-	//@{
-	std::vector<uint32> _dropped_objects;
-	std::vector<float> _dropped_chance;
-	//@}
-
-	/** \brief Contains all of the possible skills that the enemy may possess
-	*** This container holds the IDs of all skills that the enemy may execute in battle.
-	*** The Initialize() function uses this data to populates the GlobalActor _skills container.
-	**/
-	std::vector<uint32> _skill_set;
-
-	/** \brief The battle sprite frame images for the enemy
-	*** Each enemy has four frames representing damage levels of 0%, 33%, 66%, and 100%. This vector thus
-	*** always has a size of four holding each of these image frames. The first element contains the 0%
-	*** damage frame, the second element contains the 33% damage frame, and so on.
-	**/
-	std::vector<hoa_video::StillImage> _battle_sprite_frames;
+	//! \brief A pointer to the definition data shared by all enemies with this ID
+	private_global::GlobalEnemyDefinition* _definition;
 }; // class GlobalEnemy : public GlobalActor
 
 
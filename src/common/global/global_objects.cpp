@@ -30,124 +30,180 @@ using namespace hoa_global::private_global;
 
 namespace hoa_global {
 
-////////////////////////////////////////////////////////////////////////////////
-// GlobalObject class
-////////////////////////////////////////////////////////////////////////////////
-
-void GlobalObject::_LoadObjectData(hoa_script::ReadScriptDescriptor& script) {
-	_name = MakeUnicodeString(script.ReadString("name"));
-	_description = MakeUnicodeString(script.ReadString("description"));
-	_price = script.ReadUInt("standard_price");
-	string icon_file = script.ReadString("icon");
-	if (_icon_image.Load(icon_file) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed to load icon image for item: " << _id << endl;
-		_InvalidateObject();
-	}
-}
+namespace private_global {
 
 ////////////////////////////////////////////////////////////////////////////////
-// GlobalItem class
+// GlobalObjectDefinition class
 ////////////////////////////////////////////////////////////////////////////////
 
-GlobalItem::GlobalItem(uint32 id, uint32 count) :
-	GlobalObject(id, count),
-	_target_type(GLOBAL_TARGET_INVALID),
-	_battle_use_function(nullptr),
-	_field_use_function(nullptr)
+GlobalObjectDefinition::GlobalObjectDefinition(uint32 id) :
+	id(id),
+	valid(false),
+	price(0),
+	target_type(GLOBAL_TARGET_INVALID),
+	battle_use_function(nullptr),
+	field_use_function(nullptr),
+	physical_rating(0),
+	ethereal_rating(0),
+	usable_by(0),
+	_reference_count(0)
 {
-	if ((_id == 0) || (_id > MAX_ITEM_ID)) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << endl;
-		_InvalidateObject();
+	// Figure out the appropriate script to read the definition from based on the id value
+	ReadScriptDescriptor* script_file = nullptr;
+	if ((id > 0) && (id <= MAX_ITEM_ID))
+		script_file = &(GlobalManager->GetItemsScript());
+	else if ((id > MAX_ITEM_ID) && (id <= MAX_WEAPON_ID))
+		script_file = &(GlobalManager->GetWeaponsScript());
+	else if ((id > MAX_WEAPON_ID) && (id <= MAX_HEAD_ARMOR_ID))
+		script_file = &(GlobalManager->GetHeadArmorScript());
+	else if ((id > MAX_HEAD_ARMOR_ID) && (id <= MAX_TORSO_ARMOR_ID))
+		script_file = &(GlobalManager->GetTorsoArmorScript());
+	else if ((id > MAX_TORSO_ARMOR_ID) && (id <= MAX_ARM_ARMOR_ID))
+		script_file = &(GlobalManager->GetArmArmorScript());
+	else if ((id > MAX_ARM_ARMOR_ID) && (id <= MAX_LEG_ARMOR_ID))
+		script_file = &(GlobalManager->GetLegArmorScript());
+	else if ((id > MAX_LEG_ARMOR_ID) && (id <= MAX_SHARD_ID)) {
+		// TODO: read the shard definition when shards scripts are available
+		valid = true;
+		return;
+	}
+	else if ((id > MAX_SHARD_ID) && (id <= MAX_KEY_ITEM_ID))
+		script_file = &(GlobalManager->GetKeyItemsScript());
+	else {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid object id: " << id << endl;
 		return;
 	}
 
-	ReadScriptDescriptor& script_file = GlobalManager->GetItemsScript();
-	if (script_file.DoesTableExist(_id) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for item in definition file: " << _id << endl;
-		_InvalidateObject();
+	if (script_file->DoesTableExist(id) == false) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for object in definition file: " << id << endl;
 		return;
 	}
 
-	// Load the item data from the script
-	script_file.OpenTable(_id);
-	_LoadObjectData(script_file);
+	valid = true;
+	script_file->OpenTable(id);
+	_LoadObjectData(*script_file);
 
-	_target_type = static_cast<GLOBAL_TARGET>(script_file.ReadInt("target_type"));
-	if (script_file.DoesFunctionExist("BattleUse") == true) {
-		_battle_use_function = new ScriptObject();
-		*_battle_use_function = script_file.ReadFunctionPointer("BattleUse");
+	if (id <= MAX_ITEM_ID) {
+		target_type = static_cast<GLOBAL_TARGET>(script_file->ReadInt("target_type"));
+		if (script_file->DoesFunctionExist("BattleUse") == true) {
+			battle_use_function = new ScriptObject();
+			*battle_use_function = script_file->ReadFunctionPointer("BattleUse");
+		}
+		if (script_file->DoesFunctionExist("FieldUse") == true) {
+			field_use_function = new ScriptObject();
+			*field_use_function = script_file->ReadFunctionPointer("FieldUse");
+		}
 	}
-	if (script_file.DoesFunctionExist("FieldUse") == true) {
-		_field_use_function = new ScriptObject();
-		*_field_use_function = script_file.ReadFunctionPointer("FieldUse");
+	else if (id <= MAX_WEAPON_ID) {
+		physical_rating = script_file->ReadUInt("physical_attack");
+		ethereal_rating = script_file->ReadUInt("ethereal_attack");
+		usable_by = script_file->ReadUInt("usable_by");
+	}
+	else if (id <= MAX_LEG_ARMOR_ID) {
+		physical_rating = script_file->ReadUInt("physical_defense");
+		ethereal_rating = script_file->ReadUInt("ethereal_defense");
+		usable_by = script_file->ReadUInt("usable_by");
 	}
 
-
-	script_file.CloseTable();
-	if (script_file.IsErrorDetected()) {
+	script_file->CloseTable();
+	if (script_file->IsErrorDetected()) {
 		if (GLOBAL_DEBUG) {
-			PRINT_WARNING << "one or more errors occurred while reading item data - they are listed below" << endl;
-			cerr << script_file.GetErrorMessages() << endl;
+			PRINT_WARNING << "one or more errors occurred while reading object data - they are listed below" << endl;
+			cerr << script_file->GetErrorMessages() << endl;
 		}
-		_InvalidateObject();
+		valid = false;
 	}
-} // void GlobalItem::GlobalItem(uint32 id, uint32 count = 1)
+} // GlobalObjectDefinition::GlobalObjectDefinition(uint32 id)
 
 
 
-GlobalItem::~GlobalItem() {
-	if (_battle_use_function != nullptr) {
-		delete _battle_use_function;
-		_battle_use_function = nullptr;
+GlobalObjectDefinition::~GlobalObjectDefinition() {
+	if (battle_use_function != nullptr) {
+		delete battle_use_function;
+		battle_use_function = nullptr;
 	}
-	if (_field_use_function != nullptr) {
-		delete _field_use_function;
-		_field_use_function = nullptr;
+	if (field_use_function != nullptr) {
+		delete field_use_function;
+		field_use_function = nullptr;
 	}
 }
 
 
 
-GlobalItem::GlobalItem(const GlobalItem& copy) :
-	GlobalObject(copy)
+void GlobalObjectDefinition::_LoadObjectData(hoa_script::ReadScriptDescriptor& script) {
+	name = MakeUnicodeString(script.ReadString("name"));
+	description = MakeUnicodeString(script.ReadString("description"));
+	price = script.ReadUInt("standard_price");
+	string icon_file = script.ReadString("icon");
+	if (icon_image.Load(icon_file) == false) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "failed to load icon image for item: " << id << endl;
+		valid = false;
+	}
+}
+
+} // namespace private_global
+
+////////////////////////////////////////////////////////////////////////////////
+// GlobalObject class
+////////////////////////////////////////////////////////////////////////////////
+
+GlobalObject::GlobalObject(uint32 id, uint32 count) :
+	_id(id),
+	_definition(GlobalManager->GetObjectDefinition(id)),
+	_count(count)
 {
-	_target_type = copy._target_type;
+	_definition->AddReference();
+	if (_definition->valid == false) {
+		_InvalidateObject();
+	}
+}
 
-	// Make copies of valid ScriptObject function pointers
-	if (copy._battle_use_function == nullptr)
-		_battle_use_function = nullptr;
-	else
-		_battle_use_function = new ScriptObject(*copy._battle_use_function);
 
-	if (copy._field_use_function == nullptr)
-		_field_use_function = nullptr;
-	else
-		_field_use_function = new ScriptObject(*copy._field_use_function);
+
+GlobalObject::GlobalObject(const GlobalObject& copy) :
+	_id(copy._id),
+	_definition(copy._definition),
+	_lore(copy._lore),
+	_count(copy._count)
+{
+	_definition->AddReference();
 }
 
 
 
-GlobalItem& GlobalItem::operator=(const GlobalItem& copy) {
+GlobalObject& GlobalObject::operator=(const GlobalObject& copy) {
 	if (this == &copy) // Handle self-assignment case
 		return *this;
 
-	GlobalObject::operator=(copy);
-	_target_type = copy._target_type;
+	copy._definition->AddReference();
+	_definition->RemoveReference();
 
-	// Make copies of valid ScriptObject function pointers
-	if (copy._battle_use_function == nullptr)
-		_battle_use_function = nullptr;
-	else
-		_battle_use_function = new ScriptObject(*copy._battle_use_function);
+	_id = copy._id;
+	_definition = copy._definition;
+	_lore = copy._lore;
+	_count = copy._count;
+	return *this;
+}
 
-	if (copy._field_use_function == nullptr)
-		_field_use_function = nullptr;
-	else
-		_field_use_function = new ScriptObject(*copy._field_use_function);
 
-	return *this;
+
+GlobalObject::~GlobalObject() {
+	_definition->RemoveReference();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// GlobalItem class
+////////////////////////////////////////////////////////////////////////////////
+
+GlobalItem::GlobalItem(uint32 id, uint32 count) :
+	GlobalObject(id, count)
+{
+	if ((id == 0) || (id > MAX_ITEM_ID)) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << id << endl;
+		_InvalidateObject();
+	}
+} // void GlobalItem::GlobalItem(uint32 id, uint32 count = 1)
+
 ////////////////////////////////////////////////////////////////////////////////
 // GlobalWeapon class
 ////////////////////////////////////////////////////////////////////////////////
@@ -165,33 +221,8 @@ GlobalWeapon::GlobalWeapon(uint32 id, uint32 count) :
 	_elemental_effects.insert(pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY>(GLOBAL_ELEMENTAL_CRUSHING, GLOBAL_INTENSITY_NEUTRAL));
 	_elemental_effects.insert(pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY>(GLOBAL_ELEMENTAL_MAULING, GLOBAL_INTENSITY_NEUTRAL));
 
-	if ((_id <= MAX_ITEM_ID) || (_id > MAX_WEAPON_ID)) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	ReadScriptDescriptor& script_file = GlobalManager->GetWeaponsScript();
-	if (script_file.DoesTableExist(_id) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for weapon in definition file: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	// Load the weapon data from the script
-	script_file.OpenTable(_id);
-	_LoadObjectData(script_file);
-
-	_physical_attack = script_file.ReadUInt("physical_attack");
-	_ethereal_attack = script_file.ReadUInt("ethereal_attack");
-	_usable_by = script_file.ReadUInt("usable_by");
-
-	script_file.CloseTable();
-	if (script_file.IsErrorDetected()) {
-		if (GLOBAL_DEBUG) {
-			PRINT_WARNING << "one or more errors occurred while reading weapon data - they are listed below" << endl;
-			cerr << script_file.GetErrorMessages() << endl;
-		}
+	if ((id <= MAX_ITEM_ID) || (id > MAX_WEAPON_ID)) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << id << endl;
 		_InvalidateObject();
 	}
 } // void GlobalWeapon::GlobalWeapon(uint32 id, uint32 count = 1)
@@ -213,53 +244,8 @@ GlobalArmor::GlobalArmor(uint32 id, uint32 count) :
 	_elemental_effects.insert(pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY>(GLOBAL_ELEMENTAL_CRUSHING, GLOBAL_INTENSITY_NEUTRAL));
 	_elemental_effects.insert(pair<GLOBAL_ELEMENTAL, GLOBAL_INTENSITY>(GLOBAL_ELEMENTAL_MAULING, GLOBAL_INTENSITY_NEUTRAL));
 
-	if ((_id <= MAX_WEAPON_ID) || (_id > MAX_LEG_ARMOR_ID)) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	// Figure out the appropriate script reference to grab based on the id value
-	ReadScriptDescriptor* script_file;
-	switch (GetObjectType()) {
-		case GLOBAL_OBJECT_HEAD_ARMOR:
-			script_file = &(GlobalManager->GetHeadArmorScript());
-			break;
-		case GLOBAL_OBJECT_TORSO_ARMOR:
-			script_file = &(GlobalManager->GetTorsoArmorScript());
-			break;
-		case GLOBAL_OBJECT_ARM_ARMOR:
-			script_file = &(GlobalManager->GetArmArmorScript());
-			break;
-		case GLOBAL_OBJECT_LEG_ARMOR:
-			script_file = &(GlobalManager->GetLegArmorScript());
-			break;
-		default:
-			IF_PRINT_WARNING(GLOBAL_DEBUG) << "could not determine armor type: " << _id << endl;
-			_InvalidateObject();
-			return;
-	}
-
-	if (script_file->DoesTableExist(_id) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for armor in definition file: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	// Load the armor data from the script
-	script_file->OpenTable(_id);
-	_LoadObjectData(*script_file);
-
-	_physical_defense = script_file->ReadUInt("physical_defense");
-	_ethereal_defense = script_file->ReadUInt("ethereal_defense");
-	_usable_by = script_file->ReadUInt("usable_by");
-
-	script_file->CloseTable();
-	if (script_file->IsErrorDetected()) {
-		if (GLOBAL_DEBUG) {
-			PRINT_WARNING << "one or more errors occurred while reading armor data - they are listed below" << endl;
-			cerr << script_file->GetErrorMessages() << endl;
-		}
+	if ((id <= MAX_WEAPON_ID) || (id > MAX_LEG_ARMOR_ID)) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << id << endl;
 		_InvalidateObject();
 	}
 } // void GlobalArmor::GlobalArmor(uint32 id, uint32 count = 1)
@@ -286,32 +272,10 @@ GLOBAL_OBJECT GlobalArmor::GetObjectType() const {
 GlobalShard::GlobalShard(uint32 id, uint32 count) :
 	GlobalObject(id, count)
 {
-	if ((_id <= MAX_LEG_ARMOR_ID) || (_id > MAX_SHARD_ID)) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << endl;
+	if ((id <= MAX_LEG_ARMOR_ID) || (id > MAX_SHARD_ID)) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << id << endl;
 		_InvalidateObject();
-		return;
 	}
-
-	// TODO: uncomment the code below when shards scripts are available
-// 	ReadScriptDescriptor& script_file = GlobalManager->GetShardsScript();
-// 	if (script_file.DoesTableExist(_id) == false) {
-// 		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for shard in definition file: " << _id << endl;
-// 		_InvalidateObject();
-// 		return;
-// 	}
-//
-// 	// Load the shard data from the script
-// 	script_file.OpenTable(_id);
-// 	_LoadObjectData(script_file);
-//
-// 	script_file.CloseTable();
-// 	if (script_file.IsErrorDetected()) {
-// 		if (GLOBAL_DEBUG) {
-// 			PRINT_WARNING << "one or more errors occurred while reading shard data - they are listed below" << endl;
-// 			cerr << script_file.GetErrorMessages() << endl;
-// 		}
-// 		_InvalidateObject();
-// 	}
 } // void GlobalShard::GlobalShard(uint32 id, uint32 count = 1)
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -321,29 +285,8 @@ GlobalShard::GlobalShard(uint32 id, uint32 count) :
 GlobalKeyItem::GlobalKeyItem(uint32 id, uint32 count) :
 	GlobalObject(id, count)
 {
-	if ((_id <= MAX_SHARD_ID) || (_id > MAX_KEY_ITEM_ID)) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	ReadScriptDescriptor& script_file = GlobalManager->GetKeyItemsScript();
-	if (script_file.DoesTableExist(_id) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for key item in definition file: " << _id << endl;
-		_InvalidateObject();
-		return;
-	}
-
-	// Load the key item data from the script
-	script_file.OpenTable(_id);
-	_LoadObjectData(script_file);
-
-	script_file.CloseTable();
-	if (script_file.IsErrorDetected()) {
-		if (GLOBAL_DEBUG) {
-			PRINT_WARNING << "one or more errors occurred while reading key item data - they are listed below" << endl;
-			cerr << script_file.GetErrorMessages() << endl;
-		}
+	if ((id <= MAX_SHARD_ID) || (id > MAX_KEY_ITEM_ID)) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "invalid id in constructor: " << id << endl;
 		_InvalidateObject();
 	}
 } // void GlobalKeyItem::GlobalKeyItem(uint32 id, uint32 count = 1)
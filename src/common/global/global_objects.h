@@ -28,6 +28,94 @@
 
 namespace hoa_global {
 
+namespace private_global {
+
+/** ****************************************************************************
+*** \brief The unchanging data shared by every instance of the same game object
+***
+*** An object's definition is read from its Lua definition script only once, the
+*** first time that an object with its ID is constructed. Every GlobalObject with
+*** that ID shares the same definition afterwards, so constructing or copying an
+*** object does not read the definition scripts, load icon images, or create new
+*** references to script functions. Objects only retain their per-instance state,
+*** such as their count and any attached shards.
+***
+*** Definitions are reference counted. GameGlobal holds one reference to each
+*** definition that it has read and every object holds another. When the global
+*** scripts are reloaded GameGlobal releases its references, so existing objects
+*** keep the definition they were constructed with while new objects receive a
+*** freshly read one.
+***
+*** \note A definition is also created for IDs that have no valid data so that
+*** repeatedly requesting an invalid ID does not search the scripts again. The
+*** valid member of these definitions is false.
+*** ***************************************************************************/
+class GlobalObjectDefinition {
+public:
+	/** \brief Reads the definition of an object from the appropriate definition script
+	*** \param id The ID of the object to read the definition for
+	**/
+	GlobalObjectDefinition(uint32 id);
+
+	~GlobalObjectDefinition();
+
+	//! \brief Increments the number of references to this definition
+	void AddReference()
+		{ ++_reference_count; }
+
+	//! \brief Decrements the number of references to this definition and deletes it when none remain
+	void RemoveReference()
+		{ if (--_reference_count == 0) delete this; }
+
+	//! \brief The ID of the object that this definition was read for
+	uint32 id;
+
+	//! \brief Set to false if the definition could not be read successfully
+	bool valid;
+
+	//! \brief The name and description of the object as displayed on the screen
+	//@{
+	hoa_utils::ustring name;
+	hoa_utils::ustring description;
+	//@}
+
+	//! \brief The base price of the object
+	uint32 price;
+
+	//! \brief The icon image of the object at its original size of 60x60 pixels
+	hoa_video::StillImage icon_image;
+
+	//! \brief The type of target for items
+	GLOBAL_TARGET target_type;
+
+	//! \brief Pointers to the script functions that perform an item's effect, or nullptr if the item has no such use
+	//@{
+	ScriptObject* battle_use_function;
+	ScriptObject* field_use_function;
+	//@}
+
+	//! \brief The physical and ethereal attack rating of weapons, or defense rating of armor
+	//@{
+	uint32 physical_rating;
+	uint32 ethereal_rating;
+	//@}
+
+	//! \brief A bit-mask that determines which characters can equip a weapon or armor
+	uint32 usable_by;
+
+private:
+	//! \brief The number of objects and containers that retain a pointer to this definition
+	uint32 _reference_count;
+
+	//! \brief Reads the data common to all object types from the open table of a definition script
+	void _LoadObjectData(hoa_script::ReadScriptDescriptor& script);
+
+	GlobalObjectDefinition(const GlobalObjectDefinition&);
+	GlobalObjectDefinition& operator=(const GlobalObjectDefinition&);
+}; // class GlobalObjectDefinition
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief An abstract base class for representing a game object
 ***
@@ -39,9 +127,10 @@ namespace hoa_global {
 *** class object rather than having to create and managed 50 class objects, one for
 *** each potion. The _count member achieves this convenient function.
 ***
-*** A GlobalObject with an ID value of zero is considered invalid. Most of the
-*** protected members of this class can only be set by the constructors or methods
-*** of deriving classes.
+*** A GlobalObject with an ID value of zero is considered invalid. The properties
+*** that are the same for every instance of an object, such as its name and icon,
+*** are held by a private_global::GlobalObjectDefinition which all instances with
+*** the same ID share.
 ***
 *** \note The price of an object is not actually the price it is bought or sold
 *** at in the game. It is a "base price" from which all levels of buy and sell
@@ -53,14 +142,17 @@ namespace hoa_global {
 *** ***************************************************************************/
 class GlobalObject {
 public:
-	GlobalObject() :
-		_id(0), _count(0), _price(0) {}
+	/** \param id The unique ID number of the object
+	*** \param count The number of objects to initialize this class object as representing (default value == 1)
+	*** \note The object becomes invalid if no valid definition exists for the ID
+	**/
+	GlobalObject(uint32 id, uint32 count = 1);
 
-	GlobalObject(uint32 id, uint32 count = 1) :
-		_id(id), _count(count), _price(0) {}
+	GlobalObject(const GlobalObject& copy);
 
-	virtual ~GlobalObject()
-		{}
+	GlobalObject& operator=(const GlobalObject& copy);
+
+	virtual ~GlobalObject();
 
 	//! \brief Returns true if the object is properly initialized and ready to be used
 	bool IsValid() const
@@ -91,10 +183,10 @@ public:
 		{ return _id; }
 
 	const hoa_utils::ustring& GetName() const
-		{ return _name; }
+		{ return _definition->name; }
 
 	const hoa_utils::ustring& GetDescription() const
-		{ return _description; }
+		{ return _definition->description; }
 
 	const hoa_utils::ustring& GetLore() const
 		{ return _lore; }
@@ -106,10 +198,10 @@ public:
 		{ return _count; }
 
 	uint32 GetPrice() const
-		{ return _price; }
+		{ return _definition->price; }
 
 	const hoa_video::StillImage& GetIconImage() const
-		{ return _icon_image; }
+		{ return _definition->icon_image; }
 	//@}
 
 protected:
@@ -118,11 +210,8 @@ protected:
 	**/
 	uint32 _id;
 
-	//! \brief The name of the object as it would be displayed on a screen
-	hoa_utils::ustring _name;
-
-	//! \brief A short description of the item to display on the screen
-	hoa_utils::ustring _description;
+	//! \brief The shared definition of the object. This is never nullptr, but the definition may be invalid.
+	private_global::GlobalObjectDefinition* _definition;
 
 	//! \brief A detailed description of the object's history, culture, and how it fits into the game world
 	hoa_utils::ustring _lore;
@@ -130,25 +219,9 @@ protected:
 	//! \brief Retains how many occurences of the object are represented by this class object instance
 	uint32 _count;
 
-	//! \brief The base price of the object for purchase/sale in the game
-	uint32 _price;
-
-	//! \brief A loaded icon image of the object at its original size of 60x60 pixels
-	hoa_video::StillImage _icon_image;
-
 	//! \brief Causes the object to become invalid due to a loading error or other significant issue
 	void _InvalidateObject()
 		{ _id = 0; }
-
-	/** \brief Reads object data from an open script file
-	*** \param script A reference to a script file that has been opened and prepared
-	***
-	*** This method does not do any of its own error case checking. Only dervied classes may call this
-	*** protected function and they are expected to have the script file successfully opened and the correct
-	*** table context prepared. This function will do nothing more but read the expected key/values of
-	*** the open table in the script file and return.
-	**/
-	void _LoadObjectData(hoa_script::ReadScriptDescriptor& script);
 }; // class GlobalObject
 
 
@@ -168,50 +241,34 @@ public:
 	**/
 	GlobalItem(uint32 id, uint32 count = 1);
 
-	~GlobalItem();
-
-	GlobalItem(const GlobalItem& copy);
-
-	GlobalItem& operator=(const GlobalItem& copy);
-
 	GLOBAL_OBJECT GetObjectType() const
 		{ return GLOBAL_OBJECT_ITEM; }
 
 	//! \brief Returns true if the item can be used in battle
 	bool IsUsableInBattle()
-		{ return (_battle_use_function != nullptr); }
+		{ return (_definition->battle_use_function != nullptr); }
 
 	//! \brief Returns true if the item can be used in the field
 	bool IsUsableInField()
-		{ return (_field_use_function != nullptr); }
+		{ return (_definition->field_use_function != nullptr); }
 
 	//! \name Class Member Access Functions
 	//@{
 	GLOBAL_TARGET GetTargetType() const
-		{ return _target_type; }
+		{ return _definition->target_type; }
 
 	/** \brief Returns a pointer to the ScriptObject of the battle use function
 	*** \note This function will return nullptr if the skill is not usable in battle
 	**/
 	const ScriptObject* GetBattleUseFunction() const
-		{ return _battle_use_function; }
+		{ return _definition->battle_use_function; }
 
 	/** \brief Returns a pointer to the ScriptObject of the field use function
 	*** \note This function will return nullptr if the skill is not usable in the field
 	**/
 	const ScriptObject* GetFieldUseFunction() const
-		{ return _field_use_function; }
+		{ return _definition->field_use_function; }
 	//@}
-
-private:
-	//! \brief The type of target for the item
-	GLOBAL_TARGET _target_type;
-
-	//! \brief A pointer to the script function that performs the item's effect while in battle
-	ScriptObject* _battle_use_function;
-
-	//! \brief A pointer to the script function that performs the item's effect while in a menu
-	ScriptObject* _field_use_function;
 }; // class GlobalItem : public GlobalObject
 
 
@@ -244,13 +301,13 @@ public:
 	//! \name Class Member Access Functions
 	//@{
 	uint32 GetPhysicalAttack() const
-		{ return _physical_attack; }
+		{ return _definition->physical_rating; }
 
 	uint32 GetEtherealAttack() const
-		{ return _ethereal_attack; }
+		{ return _definition->ethereal_rating; }
 
 	uint32 GetUsableBy() const
-		{ return _usable_by; }
+		{ return _definition->usable_by; }
 
 	const std::vector<GlobalShard*>& GetSockets() const
 		{ return _sockets; }
@@ -260,17 +317,6 @@ public:
 	//@}
 
 private:
-	//! \brief The amount of physical damage that the weapon causes
-	uint32 _physical_attack;
-
-	//! \brief The amount of ethereal damage that the weapon causes
-	uint32 _ethereal_attack;
-
-	/** \brief A bit-mask that determines which characters can use or equip the object
-	*** See the game character ID constants in global_actors.h for more information
-	**/
-	uint32 _usable_by;
-
 	/** \brief Sockets which may be used to place shards on the weapon
 	*** Weapons may have no sockets, so it is not uncommon for the size of this vector to be zero.
 	*** When a socket is available but empty (has no attached shard), the pointer at that index
@@ -315,13 +361,13 @@ public:
 	GLOBAL_OBJECT GetObjectType() const;
 
 	uint32 GetPhysicalDefense() const
-		{ return _physical_defense; }
+		{ return _definition->physical_rating; }
 
 	uint32 GetEtherealDefense() const
-		{ return _ethereal_defense; }
+		{ return _definition->ethereal_rating; }
 
 	uint32 GetUsableBy() const
-		{ return _usable_by; }
+		{ return _definition->usable_by; }
 
 	const std::vector<GlobalShard*>& GetSockets() const
 		{ return _sockets; }
@@ -330,17 +376,6 @@ public:
 		{ return _elemental_effects; }
 
 private:
-	//! \brief The amount of physical defense that the armor provides
-	uint32 _physical_defense;
-
-	//! \brief The amount of ethereal defense that the armor provides
-	uint32 _ethereal_defense;
-
-	/** \brief A bit-mask that determines which characters can use or equip the object
-	*** See the game character ID constants in global_actors.h for more information
-	**/
-	uint32 _usable_by;
-
 	/** \brief Sockets which may be used to place shards on the armor
 	*** Armor may have no sockets, so it is not uncommon for the size of this vector to be zero.
 	*** When a socket is available but empty (has no attached shard), the pointer at that index
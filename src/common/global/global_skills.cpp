@@ -29,64 +29,66 @@ namespace hoa_global {
 
 using namespace private_global;
 
+namespace private_global {
+
 ////////////////////////////////////////////////////////////////////////////////
-// GlobalSkill class
+// GlobalSkillDefinition class
 ////////////////////////////////////////////////////////////////////////////////
 
-GlobalSkill::GlobalSkill(uint32 id) :
-	_id(id),
-	_type(GLOBAL_SKILL_INVALID),
-	_sp_required(0),
-	_warmup_time(0),
-	_target_type(GLOBAL_TARGET_INVALID),
-	_battle_execute_function(nullptr),
-	_field_execute_function(nullptr)
+GlobalSkillDefinition::GlobalSkillDefinition(uint32 id) :
+	valid(false),
+	type(GLOBAL_SKILL_INVALID),
+	sp_required(0),
+	warmup_time(0),
+	target_type(GLOBAL_TARGET_INVALID),
+	battle_execute_function(nullptr),
+	field_execute_function(nullptr),
+	_reference_count(0)
 {
 	// A pointer to the skill script which will be used to load this skill
 	ReadScriptDescriptor *skill_script = nullptr;
 
-	if ((_id > 0) && (_id <= MAX_ATTACK_ID)) {
-		_type = GLOBAL_SKILL_ATTACK;
+	if ((id > 0) && (id <= MAX_ATTACK_ID)) {
+		type = GLOBAL_SKILL_ATTACK;
 		skill_script = &(GlobalManager->GetAttackSkillsScript());
 	}
-	else if ((_id > MAX_ATTACK_ID) && (_id <= MAX_DEFEND_ID)) {
-		_type = GLOBAL_SKILL_DEFEND;
+	else if ((id > MAX_ATTACK_ID) && (id <= MAX_DEFEND_ID)) {
+		type = GLOBAL_SKILL_DEFEND;
 		skill_script = &(GlobalManager->GetDefendSkillsScript());
 	}
-	else if ((_id > MAX_DEFEND_ID) && (_id <= MAX_SUPPORT_ID)) {
-		_type = GLOBAL_SKILL_SUPPORT;
+	else if ((id > MAX_DEFEND_ID) && (id <= MAX_SUPPORT_ID)) {
+		type = GLOBAL_SKILL_SUPPORT;
 		skill_script = &(GlobalManager->GetSupportSkillsScript());
 	}
 	else {
 		IF_PRINT_WARNING(GLOBAL_DEBUG) << "constructor received an invalid id argument: " << id << endl;
-		_id = 0; // Indicate that this skill is invalid
 		return;
 	}
 
 	// Load the skill properties from the script
-	if (skill_script->DoesTableExist(_id) == false) {
-		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for skill in definition file: " << _id << endl;
-		_id = 0; // Indicate that this skill is invalid
+	if (skill_script->DoesTableExist(id) == false) {
+		IF_PRINT_WARNING(GLOBAL_DEBUG) << "no valid data for skill in definition file: " << id << endl;
 		return;
 	}
 
-	skill_script->OpenTable(_id);
-	_name = MakeUnicodeString(skill_script->ReadString("name"));
+	valid = true;
+	skill_script->OpenTable(id);
+	name = MakeUnicodeString(skill_script->ReadString("name"));
 	if (skill_script->DoesStringExist("description") == true)
-		_description = MakeUnicodeString(skill_script->ReadString("description"));
-	_sp_required = skill_script->ReadUInt("sp_required");
-	_warmup_time = skill_script->ReadUInt("warmup_time");
-	_target_type = static_cast<GLOBAL_TARGET>(skill_script->ReadInt("target_type"));
+		description = MakeUnicodeString(skill_script->ReadString("description"));
+	sp_required = skill_script->ReadUInt("sp_required");
+	warmup_time = skill_script->ReadUInt("warmup_time");
+	target_type = static_cast<GLOBAL_TARGET>(skill_script->ReadInt("target_type"));
 	if (skill_script->DoesStringExist("action_name") == true)
-		_action_name = skill_script->ReadString("action_name");
+		action_name = skill_script->ReadString("action_name");
 
 	if (skill_script->DoesFunctionExist("BattleExecute")) {
-		_battle_execute_function = new ScriptObject();
-		*_battle_execute_function = skill_script->ReadFunctionPointer("BattleExecute");
+		battle_execute_function = new ScriptObject();
+		*battle_execute_function = skill_script->ReadFunctionPointer("BattleExecute");
 	}
 	if (skill_script->DoesFunctionExist("FieldExecute")) {
-		_field_execute_function = new ScriptObject();
-		*_field_execute_function = skill_script->ReadFunctionPointer("FieldExecute");
+		field_execute_function = new ScriptObject();
+		*field_execute_function = skill_script->ReadFunctionPointer("FieldExecute");
 	}
 
 	skill_script->CloseTable();
@@ -95,46 +97,53 @@ GlobalSkill::GlobalSkill(uint32 id) :
 			PRINT_WARNING << "one or more errors occurred while reading skill data - they are listed below" << endl;
 			cerr << skill_script->GetErrorMessages() << endl;
 		}
-		_id = 0; // Indicate that this skill is invalid
+		valid = false;
 	}
-} // GlobalSkill::GlobalSkill()
+} // GlobalSkillDefinition::GlobalSkillDefinition(uint32 id)
 
 
 
-GlobalSkill::~GlobalSkill() {
-	if (_battle_execute_function != nullptr) {
-		delete _battle_execute_function;
-		_battle_execute_function = nullptr;
+GlobalSkillDefinition::~GlobalSkillDefinition() {
+	if (battle_execute_function != nullptr) {
+		delete battle_execute_function;
+		battle_execute_function = nullptr;
 	}
 
-	if (_field_execute_function != nullptr) {
-		delete _field_execute_function;
-		_field_execute_function = nullptr;
+	if (field_execute_function != nullptr) {
+		delete field_execute_function;
+		field_execute_function = nullptr;
 	}
 }
 
+} // namespace private_global
 
+////////////////////////////////////////////////////////////////////////////////
+// GlobalSkill class
+////////////////////////////////////////////////////////////////////////////////
 
-GlobalSkill::GlobalSkill(const GlobalSkill& copy) {
-	_name = copy._name;
-	_description = copy._description;
-	_id = copy._id;
-	_type = copy._type;
-	_sp_required = copy._sp_required;
-	_warmup_time = copy._warmup_time;
-	_target_type = copy._target_type;
-	_action_name = copy._action_name;
-
-	// Make copies of valid ScriptObject function pointers
-	if (copy._battle_execute_function == nullptr)
-		_battle_execute_function = nullptr;
-	else
-		_battle_execute_function = new ScriptObject(*copy._battle_execute_function);
-
-	if (copy._field_execute_function == nullptr)
-		_field_execute_function = nullptr;
-	else
-		_field_execute_function = new ScriptObject(*copy._field_execute_function);
+GlobalSkill::GlobalSkill(uint32 id) :
+	_id(id),
+	_definition(GlobalManager->GetSkillDefinition(id))
+{
+	_definition->AddReference();
+	if (_definition->valid == false) {
+		_id = 0; // Indicate that this skill is invalid
+	}
+}
+
+
+
+GlobalSkill::~GlobalSkill() {
+	_definition->RemoveReference();
+}
+
+
+
+GlobalSkill::GlobalSkill(const GlobalSkill& copy) :
+	_id(copy._id),
+	_definition(copy._definition)
+{
+	_definition->AddReference();
 }
 
 
@@ -143,26 +152,11 @@ GlobalSkill& GlobalSkill::operator=(const GlobalSkill& copy) {
 	if (this == &copy) // Handle self-assignment case
 		return *this;
 
-	_name = copy._name;
-	_description = copy._description;
-	_id = copy._id;
-	_type = copy._type;
-	_sp_required = copy._sp_required;
-	_warmup_time = copy._warmup_time;
-	_target_type = copy._target_type;
-	_action_name = copy._action_name;
-
-	// Make copies of valid ScriptObject function pointers
-	if (copy._battle_execute_function == nullptr)
-		_battle_execute_function = nullptr;
-	else
-		_battle_execute_function = new ScriptObject(*copy._battle_execute_function);
-
-	if (copy._field_execute_function == nullptr)
-		_field_execute_function = nullptr;
-	else
-		_field_execute_function = new ScriptObject(*copy._field_execute_function);
+	copy._definition->AddReference();
+	_definition->RemoveReference();
 
+	_id = copy._id;
+	_definition = copy._definition;
 	return *this;
 }
 
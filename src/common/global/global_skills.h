@@ -28,6 +28,89 @@
 
 namespace hoa_global {
 
+namespace private_global {
+
+/** ****************************************************************************
+*** \brief The unchanging data shared by every instance of the same skill
+***
+*** Like GlobalObjectDefinition, a skill definition is read from its definition
+*** script only once and then shared by every GlobalSkill with the same ID. It is
+*** reference counted the same way: GameGlobal holds one reference to every
+*** definition that it has read and each skill holds another.
+*** ***************************************************************************/
+class GlobalSkillDefinition {
+public:
+	/** \brief Reads the definition of a skill from the appropriate definition script
+	*** \param id The ID of the skill to read the definition for
+	**/
+	GlobalSkillDefinition(uint32 id);
+
+	~GlobalSkillDefinition();
+
+	//! \brief Increments the number of references to this definition
+	void AddReference()
+		{ ++_reference_count; }
+
+	//! \brief Decrements the number of references to this definition and deletes it when none remain
+	void RemoveReference()
+		{ if (--_reference_count == 0) delete this; }
+
+	//! \brief Set to false if the definition could not be read successfully
+	bool valid;
+
+	//! \brief The name of the skill as it will be displayed on the screen.
+	hoa_utils::ustring name;
+
+	/** \brief A short description of what the skill does when executed
+	*** \note Not all defined skills have a description. For example, skills used only by enemies are
+	*** typically missing a description
+	**/
+	hoa_utils::ustring description;
+
+	//! \brief The type identifier for the skill
+	GLOBAL_SKILL type;
+
+	/** \brief The amount of skill points (SP) that the skill requires to be used
+	*** Zero is a valid value for this member and means that no skill points are required to use the
+	*** skill. Skills with this property are known as "innate skills".
+	**/
+	uint32 sp_required;
+
+	/** \brief The amount of time (in milliseconds) that must expire before a skill can be used after it is selected
+	*** When a character or enemy has selected to use the skill in a battle, this value instructs how
+	*** much time must pass before the skill may be executed. It is acceptable for this member to be zero.
+	**/
+	uint32 warmup_time;
+
+	/** \brief The type of target for the skill
+	*** Target types include single actors and parties. This enum type is defined in global_utils.h
+	**/
+	GLOBAL_TARGET target_type;
+
+	/** \brief The identifier name of the sprite animation to play when it executes the function
+	***
+	*** \note This identifier is only valid for characters who are executing the skill, as enemies are not animated
+	*** in a battle. If an enemy executes the skill, this information will be ignored. It is fine to leave the action
+	*** name undefined ("") for skills which no character is able to execute (skills specific to enemies).
+	**/
+	std::string action_name;
+
+	//! \brief Pointers to the skill's execution functions, or nullptr if the skill can not be executed there
+	//@{
+	ScriptObject* battle_execute_function;
+	ScriptObject* field_execute_function;
+	//@}
+
+private:
+	//! \brief The number of skills and containers that retain a pointer to this definition
+	uint32 _reference_count;
+
+	GlobalSkillDefinition(const GlobalSkillDefinition&);
+	GlobalSkillDefinition& operator=(const GlobalSkillDefinition&);
+}; // class GlobalSkillDefinition
+
+} // namespace private_global
+
 /** ****************************************************************************
 *** \brief Represents skills that are used in the game by both characters and enemies
 ***
@@ -48,7 +131,8 @@ namespace hoa_global {
 *** Because skills are scripted and can achieve almost any possible effect, this class
 *** only retains the common properties that all skills share. For example, the skill's
 *** name, type of target, and the amount of time it takes an actor to "warmup" to use
-*** the skill.
+*** the skill. These properties are held in a private_global::GlobalSkillDefinition
+*** that is shared by all skills with the same ID.
 *** ***************************************************************************/
 class GlobalSkill {
 public:
@@ -67,99 +151,59 @@ public:
 
 	//! \brief Returns true if the skill can be executed in battles
 	bool IsExecutableInBattle() const
-		{ return (_battle_execute_function != nullptr); }
+		{ return (_definition->battle_execute_function != nullptr); }
 
 	//! \brief Returns true if the skill can be executed in menus
 	bool IsExecutableInField() const
-		{ return (_field_execute_function != nullptr); }
+		{ return (_definition->field_execute_function != nullptr); }
 
 	/** \name Class member access functions
 	*** \note No set functions are defined because the class members should only be intialized within Lua
 	**/
 	//@{
 	hoa_utils::ustring GetName() const
-		{ return _name; }
+		{ return _definition->name; }
 
 	hoa_utils::ustring GetDescription() const
-		{ return _description; }
+		{ return _definition->description; }
 
 	uint32 GetID() const
 		{ return _id; }
 
 	GLOBAL_SKILL GetType() const
-		{ return _type; }
+		{ return _definition->type; }
 
 	uint32 GetSPRequired() const
-		{ return _sp_required; }
+		{ return _definition->sp_required; }
 
 	uint32 GetWarmupTime() const
-		{ return _warmup_time; }
+		{ return _definition->warmup_time; }
 
 	GLOBAL_TARGET GetTargetType() const
-		{ return _target_type; }
+		{ return _definition->target_type; }
 
 	const std::string& GetActionName() const
-		{ return _action_name; }
+		{ return _definition->action_name; }
 
 	/** \brief Returns a pointer to the ScriptObject of the battle execution function
 	*** \note This function will return nullptr if the skill is not executable in battle
 	**/
 	const ScriptObject* GetBattleExecuteFunction() const
-		{ return _battle_execute_function; }
+		{ return _definition->battle_execute_function; }
 
 	/** \brief Returns a pointer to the ScriptObject of the menu execution function
 	*** \note This function will return nullptr if the skill is not executable in menus
 	**/
 	const ScriptObject* GetFieldExecuteFunction() const
-		{ return _field_execute_function; }
+		{ return _definition->field_execute_function; }
 	//@}
 
 private:
 	//! \brief The unique identifier number of the skill.
 	uint32 _id;
 
-	//! \brief The name of the skill as it will be displayed on the screen.
-	hoa_utils::ustring _name;
-
-	/** \brief A short description of what the skill does when executed
-	*** \note Not all defined skills have a description. For example, skills used only by enemies are
-	*** typically missing a description
-	**/
-	hoa_utils::ustring _description;
-
-	//! \brief The type identifier for the skill
-	GLOBAL_SKILL _type;
-
-	/** \brief The amount of skill points (SP) that the skill requires to be used
-	*** Zero is a valid value for this member and means that no skill points are required to use the
-	*** skill. Skills with this property are known as "innate skills".
-	**/
-	uint32 _sp_required;
-
-	/** \brief The amount of time (in milliseconds) that must expire before a skill can be used after it is selected
-	*** When a character or enemy has selected to use the skill in a battle, this value instructs how
-	*** much time must pass before the skill may be executed. It is acceptable for this member to be zero.
-	**/
-	uint32 _warmup_time;
-
-	/** \brief The type of target for the skill
-	*** Target types include single actors and parties. This enum type is defined in global_utils.h
-	**/
-	GLOBAL_TARGET _target_type;
-
-	/** \brief The identifier name of the sprite animation to play when it executes the function
-	***
-	*** \note This identifier is only valid for characters who are executing the skill, as enemies are not animated
-	*** in a battle. If an enemy executes the skill, this information will be ignored. It is fine to leave the action
-	*** name undefined ("") for skills which no character is able to execute (skills specific to enemies).
-	**/
-	std::string _action_name;
-
-	//! \brief A pointer to the skill's execution function for battles
-	ScriptObject* _battle_execute_function;
-
-	//! \brief A pointer to the skill's execution function for menus
-	ScriptObject* _field_execute_function;
+	//! \brief The shared definition of the skill. This is never nullptr, but the definition may be invalid.
+	private_global::GlobalSkillDefinition* _definition;
 }; // class GlobalSkill
 
 } // namespace hoa_global
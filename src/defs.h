@@ -164,6 +164,7 @@ namespace hoa_system {
 	extern bool SYSTEM_DEBUG;
 	class SystemEngine;
 	class Timer;
+	class TimerWheel;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -228,6 +229,7 @@ namespace hoa_gui {
 namespace hoa_battle {
 	extern bool BATTLE_DEBUG;
 	class BattleMode;
+	class BattlePreload;
 
 	namespace private_battle {
 		class BattleMedia;
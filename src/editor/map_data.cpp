@@ -244,8 +244,7 @@ bool MapData::LoadData(QString filename) {
 	data_file.CloseTable();
 
 	// ---------- (7): Read the map tile data into the appropriate layers of each tile context
-	vector<int32> tile_data; // Container used to read in all the data for a tile corresponding to one X, Y coordinate
-	tile_data.reserve(_tile_context_count * _tile_layer_count);
+	vector<int32> tile_data(_tile_context_count * _tile_layer_count); // Holds all the data for a tile corresponding to one X, Y coordinate
 
 	vector<vector<std::vector<int32> >* > layer_tiles; // Holds pointers to the tile vectors within each context and layer
 	for (uint32 c = 0; c < _tile_context_count; ++c) {
@@ -258,9 +257,8 @@ bool MapData::LoadData(QString filename) {
 	for (uint32 y = 0; y < _map_height; ++y) {
 		data_file.OpenTable(y);
 		for (uint32 x = 0; x < _map_length; ++x) {
-			tile_data.clear();
-			data_file.ReadIntVector(x, tile_data);
-			for (uint32 t = 0; t < tile_data.size(); ++t) {
+			uint32 tile_count = data_file.ReadIntArray(x, &tile_data[0], tile_data.size());
+			for (uint32 t = 0; t < tile_count; ++t) {
 				(*layer_tiles[t])[y][x] = tile_data[t];
 			}
 		}
@@ -352,12 +350,8 @@ bool MapData::SaveData(QString filename) {
 	data_file.InsertNewLine();
 
 	// ---------- (4): Write collision grid data
-	data_file.BeginTable("collision_grid");
 	_ComputeCollisionData();
-	for (uint32 i = 0; i < _collision_data.size(); ++i) {
-		data_file.WriteUIntVector(i, _collision_data[i]);
-	}
-	data_file.EndTable();
+	data_file.WriteUIntGrid("collision_grid", _collision_data);
 	data_file.InsertNewLine();
 
 	// ---------- (5): For each tile, write the tile value for each layer and each context
@@ -20,6 +20,7 @@
 #include <QGraphicsSceneContextMenuEvent>
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
+#include <QPainter>
 #include <QScrollBar>
 
 #ifndef QT_NO_OPENGL
@@ -35,6 +36,29 @@ using namespace std;
 
 namespace hoa_editor {
 
+///////////////////////////////////////////////////////////////////////////////
+// MapChunk class
+///////////////////////////////////////////////////////////////////////////////
+
+MapChunk::MapChunk(uint32 length, uint32 height) :
+	QGraphicsItem(),
+	_pixmap(length, height)
+{
+	_pixmap.fill(Qt::transparent);
+}
+
+
+
+void MapChunk::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+	Q_UNUSED(option);
+	Q_UNUSED(widget);
+	painter->drawPixmap(0, 0, _pixmap);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// MapView class
+///////////////////////////////////////////////////////////////////////////////
+
 MapView::MapView(QWidget* parent, MapData* data) :
 	QGraphicsScene(parent),
 	_map_data(data),
@@ -56,6 +80,15 @@ MapView::MapView(QWidget* parent, MapData* data) :
 	_selection_area_right(0),
 	_selection_area_top(data->GetMapHeight()),
 	_selection_area_bottom(0),
+	_preview_area_left(data->GetMapLength()),
+	_preview_area_right(0),
+	_preview_area_top(data->GetMapHeight()),
+	_preview_area_bottom(0),
+	_dirty_left(1),
+	_dirty_right(0),
+	_dirty_top(1),
+	_dirty_bottom(0),
+	_chunk_cols(0),
 	_right_click_menu(nullptr),
 	_insert_menu(nullptr),
 	_delete_menu(nullptr),
@@ -198,8 +231,8 @@ MapView::~MapView() {
 
 void MapView::SetEditMode(EDIT_MODE new_mode) {
 	if (_edit_mode == PAINT_MODE) {
-		_preview_layer.ClearLayer();
-		DrawMap();
+		_ClearPreviewLayer();
+		_DrawDirtyTiles();
 	}
 
 	_edit_mode = new_mode;
@@ -208,6 +241,7 @@ void MapView::SetEditMode(EDIT_MODE new_mode) {
 
 
 void MapView::SelectNoTiles() {
+	_MarkSelectionDirty();
 	_selection_area.ClearLayer();
 	_selection_area_active = false;
 	_selection_area_left = _map_data->GetMapLength();
@@ -218,9 +252,25 @@ void MapView::SelectNoTiles() {
 
 
 
+void MapView::SelectAllTiles() {
+	_selection_area.FillLayer(SELECTED_TILE);
+	_selection_area_active = true;
+	_selection_area_left = 0;
+	_selection_area_right = _map_data->GetMapLength() - 1;
+	_selection_area_top = 0;
+	_selection_area_bottom = _map_data->GetMapHeight() - 1;
+	_MarkSelectionDirty();
+}
+
+
+
 void MapView::UpdateAreaSizes() {
 	_preview_layer.ResizeLayer(_map_data->GetMapLength(), _map_data->GetMapHeight());
 	_preview_layer.ClearLayer();
+	_preview_area_left = _map_data->GetMapLength();
+	_preview_area_right = 0;
+	_preview_area_top = _map_data->GetMapHeight();
+	_preview_area_bottom = 0;
 
 	_selection_area.ResizeLayer(_map_data->GetMapLength(), _map_data->GetMapHeight());
 	SelectNoTiles();
@@ -290,6 +340,13 @@ void MapView::UpdateContextActions() {
 
 
 void MapView::DrawMap() {
+	// Clearing the scene deletes all of the chunks, so forget about them and any tiles waiting to be drawn to them
+	_chunks.clear();
+	_chunk_cols = 0;
+	_dirty_left = 1;
+	_dirty_right = 0;
+	_dirty_top = 1;
+	_dirty_bottom = 0;
 	clear();
 	if (_map_data->IsInitialized() == false) {
 		return;
@@ -299,71 +356,21 @@ void MapView::DrawMap() {
 	setSceneRect(0, 0, _map_data->GetMapLength() * TILE_LENGTH, _map_data->GetMapHeight() * TILE_HEIGHT);
 	setBackgroundBrush(QBrush(Qt::gray));
 
-	vector<TileLayer>* tile_layers = &(_map_data->GetSelectedTileContext()->GetTileLayers());
-	vector<TileLayer>* inherited_tile_layers = nullptr;
-	vector<TileLayerProperties>& layer_properties = _map_data->GetTileLayerProperties();
-
-	// If this is an inheriting context, we also want to pull in the tile layers for the inherited context
-	if (_map_data->GetSelectedTileContext()->IsInheritingContext() == true) {
-		// Inherited context should never be nullptr in this case
-		TileContext* inherited_context = _map_data->FindTileContextByID(_map_data->GetSelectedTileContext()->GetInheritedContextID());
-		inherited_tile_layers = &(inherited_context->GetTileLayers());
-	}
-
-	// Start drawing each tile from the tile layers in order
-	for (uint32 l = 0; l < tile_layers->size(); ++l) {
-		// Holds the value of the tile from a specific X/Y coordinate on this layer
-		int32 tile = MISSING_TILE;
-		// Set to true whenever we are dealing with an inherited tile
-		bool inherited_tile = false;
-		// Set to true if this layer is the currently selected layer that the user is viewing or editing
-		bool selected_layer = (_map_data->GetSelectedTileLayer() == &(*tile_layers)[l]);
-		// A pointer to the tile image that should be drawn
-		const QPixmap* tile_image = nullptr;
-		// Coordiantes to draw the current tile to
-		uint32 draw_x = 0, draw_y = 0;
-
-		if (layer_properties[l].IsVisible() == false)
-			continue;
-
-		for (uint32 x = 0; x < _map_data->GetMapLength(); ++x) {
-			for (uint32 y = 0; y < _map_data->GetMapHeight(); ++y) {
-				draw_x = x * TILE_LENGTH;
-				draw_y = y * TILE_HEIGHT;
-				tile = (*tile_layers)[l].GetTile(x, y);
-				inherited_tile = (tile == INHERITED_TILE);
-				if (inherited_tile == true) {
-					tile = (*inherited_tile_layers)[l].GetTile(x, y);
-				}
-				tile_image = _RetrieveTileImage(tile);
-				if (tile_image) {
-					addPixmap(*tile_image)->setPos(draw_x, draw_y);
-				}
-
-				if (selected_layer == true) {
-					// Draw the missing overlay if needed
-					if (inherited_tile == false && tile == MISSING_TILE && _missing_overlay_visible == true) {
-						addPixmap(_missing_tile)->setPos(draw_x, draw_y);
-					}
-					// Draw the inherited overlay over the inherited tile
-					else if (inherited_tile == true && _inherited_overlay_visible == true) {
-						addPixmap(_inherited_tile)->setPos(draw_x, draw_y);
-					}
-
-					// Draw the preview layer and overlay if it contains a tile at this location
-					tile = _preview_layer.GetTile(x, y);
-					if (tile >= 0) {
-						tile_image = _RetrieveTileImage(tile);
-						addPixmap(*tile_image)->setPos(draw_x, draw_y);
-						addPixmap(_preview_tile)->setPos(draw_x, draw_y);
-					}
-				}
-			}
+	// Create the chunks that cover the map. Chunks along the right and bottom edges of the map may contain fewer tiles than the rest.
+	_chunk_cols = (_map_data->GetMapLength() + CHUNK_LENGTH - 1) / CHUNK_LENGTH;
+	uint32 chunk_rows = (_map_data->GetMapHeight() + CHUNK_HEIGHT - 1) / CHUNK_HEIGHT;
+	for (uint32 r = 0; r < chunk_rows; ++r) {
+		for (uint32 c = 0; c < _chunk_cols; ++c) {
+			uint32 num_cols = min(CHUNK_LENGTH, _map_data->GetMapLength() - c * CHUNK_LENGTH);
+			uint32 num_rows = min(CHUNK_HEIGHT, _map_data->GetMapHeight() - r * CHUNK_HEIGHT);
+			MapChunk* chunk = new MapChunk(num_cols * TILE_LENGTH, num_rows * TILE_HEIGHT);
+			chunk->setPos(c * CHUNK_LENGTH * TILE_LENGTH, r * CHUNK_HEIGHT * TILE_HEIGHT);
+			addItem(chunk);
+			_chunks.push_back(chunk);
 		}
 	}
 
-	if (_selection_area_active == true)
-		_DrawSelectionArea();
+	_DrawTiles(0, 0, _map_data->GetMapLength() - 1, _map_data->GetMapHeight() - 1);
 
 	if (_grid_visible)
 		_DrawGrid();
@@ -416,7 +423,7 @@ void MapView::mousePressEvent(QGraphicsSceneMouseEvent* event) {
 		case PAINT_MODE:
 			_PaintTiles(_cursor_tile_x, _cursor_tile_y, false);
 			_map_data->SetMapModified(true);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		case SWAP_MODE:
@@ -425,13 +432,13 @@ void MapView::mousePressEvent(QGraphicsSceneMouseEvent* event) {
 		case ERASE_MODE:
 			_SetTile(_cursor_tile_x, _cursor_tile_y, MISSING_TILE);
 			_map_data->SetMapModified(true);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		case INHERIT_MODE:
 			_SetTile(_cursor_tile_x, _cursor_tile_y, INHERITED_TILE);
 			_map_data->SetMapModified(true);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		case SELECT_AREA_MODE: {
@@ -447,23 +454,25 @@ void MapView::mousePressEvent(QGraphicsSceneMouseEvent* event) {
 				_selection_area.SetTile(_press_tile_x, _press_tile_y, SELECTED_TILE);
 				_selection_area_active = true;
 			}
-			DrawMap();
+			// Both the set selection area and the tile where the new selection began may have changed
+			_MarkSelectionDirty();
+			_DrawDirtyTiles();
 			break;
 		}
 
 		case FILL_AREA_MODE:
 			_FillArea(_cursor_tile_x, _cursor_tile_y, _RetrieveCurrentTileValue());
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		case CLEAR_AREA_MODE:
 			_FillArea(_cursor_tile_x, _cursor_tile_y, MISSING_TILE);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		case INHERIT_AREA_MODE:
 			_FillArea(_cursor_tile_x, _cursor_tile_y, INHERITED_TILE);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 
 		default:
@@ -500,6 +509,11 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 
 	// Check if the user has moved the cursor over a different tile
 	if (tile_x != _cursor_tile_x || tile_y != _cursor_tile_y) {
+		// The area being selected by the user follows the cursor, so the tiles it covered before the move need to be drawn again
+		if (event->buttons() == Qt::LeftButton && _edit_mode == SELECT_AREA_MODE) {
+			_MarkSelectionDirty();
+		}
+
 		_cursor_tile_x = tile_x;
 		_cursor_tile_y = tile_y;
 
@@ -507,7 +521,7 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 			switch (_edit_mode) {
 				case PAINT_MODE:
 					_PaintTiles(_cursor_tile_x, _cursor_tile_y, false);
-					DrawMap();
+					_DrawDirtyTiles();
 					break;
 
 				case SWAP_MODE:
@@ -516,7 +530,7 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 				case ERASE_MODE: {
 					if (_IsTileEqualToPressSelection(_cursor_tile_x, _cursor_tile_y) == true) {
 						_SetTile(_cursor_tile_x, _cursor_tile_y, MISSING_TILE);
-						DrawMap();
+						_DrawDirtyTiles();
 					}
 					break;
 				}
@@ -524,7 +538,7 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 				case INHERIT_MODE: {
 					if (_IsTileEqualToPressSelection(_cursor_tile_x, _cursor_tile_y) == true) {
 						_SetTile(_cursor_tile_x, _cursor_tile_y, INHERITED_TILE);
-						DrawMap();
+						_DrawDirtyTiles();
 					}
 					break;
 				}
@@ -533,23 +547,24 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 					if (_selection_mode == NORMAL) {
 						_SetSelectionArea(_press_tile_x, _press_tile_y, _cursor_tile_x, _cursor_tile_y);
 					}
-					DrawMap();
+					_MarkSelectionDirty();
+					_DrawDirtyTiles();
 					break;
 				}
 
 				case FILL_AREA_MODE:
 					_FillArea(_cursor_tile_x, _cursor_tile_y, _RetrieveCurrentTileValue());
-					DrawMap();
+					_DrawDirtyTiles();
 					break;
 
 				case CLEAR_AREA_MODE:
 					_FillArea(_cursor_tile_x, _cursor_tile_y, MISSING_TILE);
-					DrawMap();
+					_DrawDirtyTiles();
 					break;
 
 				case INHERIT_AREA_MODE:
 					_FillArea(_cursor_tile_x, _cursor_tile_y, INHERITED_TILE);
-					DrawMap();
+					_DrawDirtyTiles();
 					break;
 
 				default:
@@ -559,7 +574,7 @@ void MapView::mouseMoveEvent(QGraphicsSceneMouseEvent* event) {
 		else if (_edit_mode == PAINT_MODE) {
 			// Paint the preview layer as the mouse is moved around
 			_PaintTiles(_cursor_tile_x, _cursor_tile_y, true);
-			DrawMap();
+			_DrawDirtyTiles();
 		}
 	}
 
@@ -583,14 +598,14 @@ void MapView::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
 
 	switch (_edit_mode) {
 		case PAINT_MODE: {
-			_preview_layer.ClearLayer();
-			DrawMap();
+			_ClearPreviewLayer();
+			_DrawDirtyTiles();
 			break;
 		}
 
 		case SWAP_MODE: {
 			_SwapTiles(_press_tile_x, _press_tile_y, _cursor_tile_x, _cursor_tile_y);
-			DrawMap();
+			_DrawDirtyTiles();
 			break;
 		}
 
@@ -606,7 +621,7 @@ void MapView::mouseReleaseEvent(QGraphicsSceneMouseEvent* event) {
 			// If only a single tile was selected in normal mode, deselect the area
 			if (_selection_mode == NORMAL && _cursor_tile_x == _press_tile_x && _cursor_tile_y == _press_tile_y) {
 				SelectNoTiles();
-				DrawMap();
+				_DrawDirtyTiles();
 			}
 			else {
 				_SetSelectionArea(_press_tile_x, _press_tile_y, _cursor_tile_x, _cursor_tile_y);
@@ -948,6 +963,7 @@ const QPixmap* MapView::_RetrieveTileImage(int32 tile_value) const {
 void MapView::_SetTile(int32 x, int32 y, int32 value) {
 	// TODO: Record information for undo/redo stack
 	_map_data->GetSelectedTileLayer()->SetTile(x, y, value);
+	_MarkTilesDirty(x, y, x, y);
 }
 
 
@@ -980,9 +996,13 @@ void MapView::_PaintTiles(uint32 x, uint32 y, bool preview) {
 	else {
 		// For the preview layer, we always clear any existing tiles in the layer before painting.
 		destination_layer = &_preview_layer;
-		destination_layer->ClearLayer();
+		_ClearPreviewLayer();
 	}
 
+	// The right-most and bottom-most tiles that may be painted by this operation
+	uint32 right = x;
+	uint32 bottom = y;
+
 	int32 start_tile = MISSING_TILE;
 	if (_selection_area_active == true) {
 		start_tile = _selection_area.GetTile(x, y);
@@ -1003,6 +1023,9 @@ void MapView::_PaintTiles(uint32 x, uint32 y, bool preview) {
 				destination_layer->SetTile(x + j, y + i, tileset_index + multiplier);
 			} // iterate through columns of selection
 		} // iterate through rows of selection
+
+		right = x + selection.columnCount() - 1;
+		bottom = y + selection.rowCount() - 1;
 	}
 	else { // A single tile is selected
 		// put selected tile from tileset into tile array at correct position
@@ -1015,6 +1038,14 @@ void MapView::_PaintTiles(uint32 x, uint32 y, bool preview) {
 
 		destination_layer->SetTile(x, y, tileset_index + multiplier);
 	}
+
+	_MarkTilesDirty(x, y, right, bottom);
+	if (preview == true) {
+		_preview_area_left = x;
+		_preview_area_right = right;
+		_preview_area_top = y;
+		_preview_area_bottom = bottom;
+	}
 }
 
 
@@ -1034,6 +1065,8 @@ void MapView::_SwapTiles(uint32 x1, uint32 y1, uint32 x2, uint32 y2) {
 		int32 temp = layer[_cursor_tile_y][_cursor_tile_x];
 		layer[_cursor_tile_y][_cursor_tile_x] = layer[_press_tile_y][_press_tile_x];
 		layer[_press_tile_y][_press_tile_x] = temp;
+		_MarkTilesDirty(_cursor_tile_x, _cursor_tile_y, _cursor_tile_x, _cursor_tile_y);
+		_MarkTilesDirty(_press_tile_x, _press_tile_y, _press_tile_x, _press_tile_y);
 	}
 	else {
 		// The x and y order in which we update the tiles needs to coincide with the direction of the swap movement.
@@ -1094,6 +1127,12 @@ void MapView::_SwapTiles(uint32 x1, uint32 y1, uint32 x2, uint32 y2) {
 
 			x = xstart;
 		}
+
+		// Every changed tile lies either in the selection area or in the selection area moved by the swap distance
+		int32 dirty_left = static_cast<int32>(_selection_area_left) + min(xdiff, 0);
+		int32 dirty_top = static_cast<int32>(_selection_area_top) + min(ydiff, 0);
+		_MarkTilesDirty(static_cast<uint32>(max(dirty_left, 0)), static_cast<uint32>(max(dirty_top, 0)),
+			_selection_area_right + max(xdiff, 0), _selection_area_bottom + max(ydiff, 0));
 	}
 
 	_map_data->SetMapModified(true);
@@ -1161,6 +1200,7 @@ void MapView::_FillArea(uint32 start_x, uint32 start_y, int32 value) {
 					nodes.push(make_pair(i, y + 1));
 				}
 			}
+			_MarkTilesDirty(x_left_end, y, x_right_end, y);
 		}
 	}
 	// In this case, the fill operation needs to take place within the selection area. All tiles within the area should be set regardless
@@ -1197,6 +1237,7 @@ void MapView::_FillArea(uint32 start_x, uint32 start_y, int32 value) {
 					nodes.push(make_pair(i, y + 1));
 				}
 			}
+			_MarkTilesDirty(x_left_end, y, x_right_end, y);
 		}
 	}
 
@@ -1240,6 +1281,7 @@ void MapView::_SetSelectionArea(uint32 x1, uint32 y1, uint32 x2, uint32 y2) {
 				_selection_area.SetTile(x, y, SELECTED_TILE);
 		}
 	}
+	_MarkTilesDirty(xmin, ymin, xmax, ymax);
 	_selection_area_active = true;
 
 	// When SUBTRACTIVE selection mode is active, we need to examine the entire area to make sure that at least one tile is still selected
@@ -1322,7 +1364,8 @@ void MapView::_SelectionToLayer(uint32 layer_id, bool copy_or_move) {
 		}
 	}
 
-	DrawMap();
+	_MarkSelectionDirty();
+	_DrawDirtyTiles();
 }
 
 
@@ -1369,7 +1412,8 @@ void MapView::_SelectionToContext(uint32 layer_id, bool copy_or_move) {
 			QString("These tiles were set to no tile in the destination context."));
 	}
 
-	DrawMap();
+	_MarkSelectionDirty();
+	_DrawDirtyTiles();
 }
 
 
@@ -1400,65 +1444,194 @@ void MapView::_UpdateStatusBar(QGraphicsSceneMouseEvent* event) {
 
 
 
-void MapView::_DrawSelectionArea() {
-	// Start by determining the bounds of the area currently being selected by the user. This information is
-	// necessary for ADDITIVE or SUBTRACTIVE selection modes, but not for normal mode.
-	uint32 xmin = _press_tile_x;
-	uint32 ymin = _press_tile_y;
-	uint32 xmax = _cursor_tile_x;
-	uint32 ymax = _cursor_tile_y;
-	if (xmax < xmin) {
-		xmin = _cursor_tile_x;
-		xmax = _press_tile_x;
-	}
-	if (ymax < ymin) {
-		ymin = _cursor_tile_y;
-		ymax = _press_tile_y;
-	}
-
-	// In these two cases, we can simply draw the set selected area and return
-	if (_edit_mode != SELECT_AREA_MODE || (_edit_mode == SELECT_AREA_MODE && _selection_mode == NORMAL)) {
-		for (uint32 x = 0; x < _map_data->GetMapLength(); ++x) {
-			for (uint32 y = 0; y < _map_data->GetMapHeight(); ++y) {
-				if (_selection_area.GetTile(x, y) == SELECTED_TILE) {
-					addPixmap(_selection_tile)->setPos(x * TILE_LENGTH, y * TILE_HEIGHT);
-				}
-			}
-		}
+void MapView::_MarkTilesDirty(uint32 left, uint32 top, uint32 right, uint32 bottom) {
+	if (_map_data->IsInitialized() == false)
 		return;
+
+	if (right >= _map_data->GetMapLength())
+		right = _map_data->GetMapLength() - 1;
+	if (bottom >= _map_data->GetMapHeight())
+		bottom = _map_data->GetMapHeight() - 1;
+	if (left > right || top > bottom)
+		return;
+
+	// If nothing is dirty yet, the rectangle becomes the dirty area. Otherwise the dirty area grows to contain it.
+	if (_dirty_left > _dirty_right) {
+		_dirty_left = left;
+		_dirty_right = right;
+		_dirty_top = top;
+		_dirty_bottom = bottom;
 	}
-	// Additive mode requires us to potentially draw more selection tiles than what is already set in the selection area
-	else if (_selection_mode == ADDITIVE) {
-		for (uint32 x = 0; x < _map_data->GetMapLength(); ++x) {
-			for (uint32 y = 0; y < _map_data->GetMapHeight(); ++y) {
-				if (_selection_area.GetTile(x, y) == SELECTED_TILE) {
-					addPixmap(_selection_tile)->setPos(x * TILE_LENGTH, y * TILE_HEIGHT);
-				}
-				// Determine if this tile is within the current additive selection area
-				else if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
-					addPixmap(_selection_tile)->setPos(x * TILE_LENGTH, y * TILE_HEIGHT);
-				}
-			}
-		}
+	else {
+		_dirty_left = min(_dirty_left, left);
+		_dirty_right = max(_dirty_right, right);
+		_dirty_top = min(_dirty_top, top);
+		_dirty_bottom = max(_dirty_bottom, bottom);
 	}
-	// Subtractive mode forces us to ignore tiles set in the selection area if they overlap with the active selection box
-	else if (_selection_mode == SUBTRACTIVE) {
-		for (uint32 x = 0; x < _map_data->GetMapLength(); ++x) {
-			for (uint32 y = 0; y < _map_data->GetMapHeight(); ++y) {
-				// Skip this tile if it is within the current subtractive selection area
-				if (x >= xmin && x <= xmax && y >= ymin && y <= ymax) {
-					continue;
-				}
-				else if (_selection_area.GetTile(x, y) == SELECTED_TILE) {
-					addPixmap(_selection_tile)->setPos(x * TILE_LENGTH, y * TILE_HEIGHT);
+}
+
+
+
+void MapView::_MarkSelectionDirty() {
+	_MarkTilesDirty(_selection_area_left, _selection_area_top, _selection_area_right, _selection_area_bottom);
+
+	// The box the user is currently dragging out may also be drawn with selection tiles
+	if (_press_tile_x >= 0 && _press_tile_y >= 0 && _cursor_tile_x >= 0 && _cursor_tile_y >= 0) {
+		_MarkTilesDirty(min(_press_tile_x, _cursor_tile_x), min(_press_tile_y, _cursor_tile_y),
+			max(_press_tile_x, _cursor_tile_x), max(_press_tile_y, _cursor_tile_y));
+	}
+}
+
+
+
+void MapView::_ClearPreviewLayer() {
+	_MarkTilesDirty(_preview_area_left, _preview_area_top, _preview_area_right, _preview_area_bottom);
+	_preview_layer.ClearLayer();
+
+	_preview_area_left = _map_data->GetMapLength();
+	_preview_area_right = 0;
+	_preview_area_top = _map_data->GetMapHeight();
+	_preview_area_bottom = 0;
+}
+
+
+
+void MapView::_DrawDirtyTiles() {
+	if (_dirty_left > _dirty_right || _dirty_top > _dirty_bottom)
+		return;
+
+	// If the chunks no longer match the size of the map, everything has to be rebuilt
+	QRectF map_rect(0, 0, _map_data->GetMapLength() * TILE_LENGTH, _map_data->GetMapHeight() * TILE_HEIGHT);
+	if (_chunks.empty() == true || sceneRect() != map_rect) {
+		DrawMap();
+		return;
+	}
+
+	_DrawTiles(_dirty_left, _dirty_top, _dirty_right, _dirty_bottom);
+	_dirty_left = 1;
+	_dirty_right = 0;
+	_dirty_top = 1;
+	_dirty_bottom = 0;
+}
+
+
+
+void MapView::_DrawTiles(uint32 left, uint32 top, uint32 right, uint32 bottom) {
+	vector<TileLayer>* tile_layers = &(_map_data->GetSelectedTileContext()->GetTileLayers());
+	vector<TileLayer>* inherited_tile_layers = nullptr;
+	vector<TileLayerProperties>& layer_properties = _map_data->GetTileLayerProperties();
+
+	// If this is an inheriting context, we also want to pull in the tile layers for the inherited context
+	if (_map_data->GetSelectedTileContext()->IsInheritingContext() == true) {
+		// Inherited context should never be nullptr in this case
+		TileContext* inherited_context = _map_data->FindTileContextByID(_map_data->GetSelectedTileContext()->GetInheritedContextID());
+		inherited_tile_layers = &(inherited_context->GetTileLayers());
+	}
+
+	// Redraw the tiles of every chunk that overlaps with the area, one chunk at a time
+	for (uint32 chunk_y = top / CHUNK_HEIGHT; chunk_y <= bottom / CHUNK_HEIGHT; ++chunk_y) {
+		for (uint32 chunk_x = left / CHUNK_LENGTH; chunk_x <= right / CHUNK_LENGTH; ++chunk_x) {
+			MapChunk* chunk = _chunks[chunk_y * _chunk_cols + chunk_x];
+			uint32 xmin = max(left, chunk_x * CHUNK_LENGTH);
+			uint32 xmax = min(right, chunk_x * CHUNK_LENGTH + CHUNK_LENGTH - 1);
+			uint32 ymin = max(top, chunk_y * CHUNK_HEIGHT);
+			uint32 ymax = min(bottom, chunk_y * CHUNK_HEIGHT + CHUNK_HEIGHT - 1);
+
+			QPainter painter(&chunk->GetPixmap());
+			for (uint32 x = xmin; x <= xmax; ++x) {
+				for (uint32 y = ymin; y <= ymax; ++y) {
+					// Coordinates to draw the current tile to, relative to the chunk
+					uint32 draw_x = (x - chunk_x * CHUNK_LENGTH) * TILE_LENGTH;
+					uint32 draw_y = (y - chunk_y * CHUNK_HEIGHT) * TILE_HEIGHT;
+
+					// Erase whatever was previously drawn for this tile
+					painter.setCompositionMode(QPainter::CompositionMode_Source);
+					painter.fillRect(draw_x, draw_y, TILE_LENGTH, TILE_HEIGHT, Qt::transparent);
+					painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+					// Draw the tile from each of the tile layers in order
+					for (uint32 l = 0; l < tile_layers->size(); ++l) {
+						if (layer_properties[l].IsVisible() == false)
+							continue;
+
+						int32 tile = (*tile_layers)[l].GetTile(x, y);
+						bool inherited_tile = (tile == INHERITED_TILE);
+						if (inherited_tile == true) {
+							tile = (*inherited_tile_layers)[l].GetTile(x, y);
+						}
+						const QPixmap* tile_image = _RetrieveTileImage(tile);
+						if (tile_image) {
+							painter.drawPixmap(draw_x, draw_y, *tile_image);
+						}
+
+						// Overlays and the preview are only drawn on the layer that the user is viewing or editing
+						if (_map_data->GetSelectedTileLayer() != &(*tile_layers)[l])
+							continue;
+
+						// Draw the missing overlay if needed
+						if (inherited_tile == false && tile == MISSING_TILE && _missing_overlay_visible == true) {
+							painter.drawPixmap(draw_x, draw_y, _missing_tile);
+						}
+						// Draw the inherited overlay over the inherited tile
+						else if (inherited_tile == true && _inherited_overlay_visible == true) {
+							painter.drawPixmap(draw_x, draw_y, _inherited_tile);
+						}
+
+						// Draw the preview layer and overlay if it contains a tile at this location
+						tile = _preview_layer.GetTile(x, y);
+						if (tile >= 0) {
+							tile_image = _RetrieveTileImage(tile);
+							if (tile_image) {
+								painter.drawPixmap(draw_x, draw_y, *tile_image);
+							}
+							painter.drawPixmap(draw_x, draw_y, _preview_tile);
+						}
+					}
+
+					if (_selection_area_active == true && _IsTileDrawnSelected(x, y) == true) {
+						painter.drawPixmap(draw_x, draw_y, _selection_tile);
+					}
 				}
 			}
+			painter.end();
+			chunk->update();
 		}
 	}
-	else {
-		qDebug("ERROR: unknown case reached in _DrawSelectionArea()");
+} // void MapView::_DrawTiles(uint32 left, uint32 top, uint32 right, uint32 bottom)
+
+
+
+bool MapView::_IsTileDrawnSelected(uint32 x, uint32 y) const {
+	bool selected = (_selection_area.GetTile(x, y) == SELECTED_TILE);
+
+	// In these two cases, only the set selected area is drawn
+	if (_edit_mode != SELECT_AREA_MODE || _selection_mode == NORMAL) {
+		return selected;
 	}
-} // void MapView::_DrawSelectionArea()
+
+	// Determine the bounds of the area currently being selected by the user. This information is
+	// necessary for ADDITIVE or SUBTRACTIVE selection modes, but not for normal mode.
+	bool in_box = false;
+	if (_press_tile_x >= 0 && _press_tile_y >= 0 && _cursor_tile_x >= 0 && _cursor_tile_y >= 0) {
+		uint32 xmin = min(_press_tile_x, _cursor_tile_x);
+		uint32 xmax = max(_press_tile_x, _cursor_tile_x);
+		uint32 ymin = min(_press_tile_y, _cursor_tile_y);
+		uint32 ymax = max(_press_tile_y, _cursor_tile_y);
+		in_box = (x >= xmin && x <= xmax && y >= ymin && y <= ymax);
+	}
+
+	// Additive mode may draw more selection tiles than what is already set in the selection area
+	if (_selection_mode == ADDITIVE) {
+		return (selected == true || in_box == true);
+	}
+	// Subtractive mode ignores tiles set in the selection area if they overlap with the active selection box
+	else if (_selection_mode == SUBTRACTIVE) {
+		return (selected == true && in_box == false);
+	}
+
+	qDebug("ERROR: unknown case reached in _IsTileDrawnSelected()");
+	return selected;
+} // bool MapView::_IsTileDrawnSelected(uint32 x, uint32 y) const
 
 
 
@@ -1466,10 +1639,10 @@ void MapView::_DrawGrid() {
 	QPen grid_pen(Qt::black);
 
 	for (uint32 x = 0; x < (_map_data->GetMapLength() * TILE_LENGTH); x+= TILE_LENGTH) {
-		for (uint32 y = 0; y < (_map_data->GetMapHeight() * TILE_HEIGHT); y+= TILE_HEIGHT) {
-			addLine(0, y, _map_data->GetMapLength() * TILE_LENGTH, y, grid_pen);
-			addLine(x, 0, x, _map_data->GetMapHeight() * TILE_HEIGHT, grid_pen);
-		}
+		addLine(x, 0, x, _map_data->GetMapHeight() * TILE_HEIGHT, grid_pen);
+	}
+	for (uint32 y = 0; y < (_map_data->GetMapHeight() * TILE_HEIGHT); y+= TILE_HEIGHT) {
+		addLine(0, y, _map_data->GetMapLength() * TILE_LENGTH, y, grid_pen);
 	}
 }
 
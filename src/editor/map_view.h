@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <QGraphicsItem>
 #include <QGraphicsScene>
 #include <QStringList>
 #include <QTreeWidgetItem>
@@ -24,6 +25,44 @@
 
 namespace hoa_editor {
 
+//! \brief The number of tile columns and rows that are drawn together in a single MapChunk
+//@{
+const uint32 CHUNK_LENGTH = 16;
+const uint32 CHUNK_HEIGHT = 16;
+//@}
+
+/** ***************************************************************************
+*** \brief A graphics item that displays a rectangular section of the map
+***
+*** Every tile of the map, including all visible layers and overlays, is drawn into the pixmap of the
+*** chunk that contains it. This keeps the number of items in the scene small for large maps, and when
+*** a tile changes only that tile needs to be drawn again into its chunk's pixmap.
+*** **************************************************************************/
+class MapChunk : public QGraphicsItem {
+public:
+	/** \param length The width of the chunk, in pixels
+	*** \param height The height of the chunk, in pixels
+	**/
+	MapChunk(uint32 length, uint32 height);
+
+	//! \brief Returns the pixmap that the chunk's tiles are drawn into
+	QPixmap& GetPixmap()
+		{ return _pixmap; }
+
+	//! \name Methods required by QGraphicsItem
+	//@{
+	QRectF boundingRect() const
+		{ return QRectF(0, 0, _pixmap.width(), _pixmap.height()); }
+
+	void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+	//@}
+
+private:
+	//! \brief Holds the drawn image of every tile in the chunk
+	QPixmap _pixmap;
+}; // class MapChunk : public QGraphicsItem
+
+
 /** ***************************************************************************
 *** \brief The GUI component where map tiles are drawn and edited
 ***
@@ -88,8 +127,7 @@ public:
 	void SelectNoTiles();
 
 	//! \brief Selects the entire map in the selection area
-	void SelectAllTiles()
-		{ _selection_area.FillLayer(SELECTED_TILE); _selection_area_active = true; }
+	void SelectAllTiles();
 
 	/** \brief This method should be called whenever the map size is modified so that the _selection_area can be resized accordingly
 	*** \note Calling this function will clear the selection area as well.
@@ -106,7 +144,11 @@ public:
 	**/
 	void UpdateContextActions();
 
-	//! \brief Draws all visible tile layers from the active context as well as overlays and other visual elements
+	/** \brief Draws all visible tile layers from the active context as well as overlays and other visual elements
+	*** This re-creates every item in the scene, so it should only be called when the map as a whole has changed, such as
+	*** when the map is resized, the active context changes, or a layer or overlay is shown or hidden. Edits to individual
+	*** tiles only redraw the tiles that they changed.
+	**/
     void DrawMap();
 
 protected:
@@ -204,6 +246,24 @@ private:
 	**/
 	uint32 _selection_area_left, _selection_area_right, _selection_area_top, _selection_area_bottom;
 
+	/** \brief Tracks the boundaries of the tiles that are currently painted in the preview layer
+	*** These follow the same convention as the selection area boundaries when the preview layer is empty.
+	**/
+	uint32 _preview_area_left, _preview_area_right, _preview_area_top, _preview_area_bottom;
+
+	/** \brief The boundaries of the tiles that have changed since they were last drawn
+	*** When no tiles need to be drawn, left is greater than right and top is greater than bottom.
+	**/
+	uint32 _dirty_left, _dirty_right, _dirty_top, _dirty_bottom;
+
+	/** \brief The chunks that the map is drawn to, stored in row-major order
+	*** \note These items are owned by the scene, which deletes them whenever it is cleared
+	**/
+	std::vector<MapChunk*> _chunks;
+
+	//! \brief The number of columns of chunks in the _chunks container
+	uint32 _chunk_cols;
+
 	//! \brief Menus for right-clicks events on the map
 	//@{
     QMenu* _right_click_menu;
@@ -349,8 +409,44 @@ private:
 	**/
 	void _UpdateStatusBar(QGraphicsSceneMouseEvent* event);
 
-	//! \brief A helper function to DrawMap() that draws the current selection area when the edit mode is SELECT_AREA
-	void _DrawSelectionArea();
+	/** \brief Adds a rectangle of tiles to the area that needs to be drawn by the next call to _DrawDirtyTiles()
+	*** \param left The x coordinate of the left-most tile
+	*** \param top The y coordinate of the top-most tile
+	*** \param right The x coordinate of the right-most tile
+	*** \param bottom The y coordinate of the bottom-most tile
+	***
+	*** Coordinates beyond the edges of the map are ignored, as are rectangles where left exceeds right or top exceeds bottom.
+	**/
+	void _MarkTilesDirty(uint32 left, uint32 top, uint32 right, uint32 bottom);
+
+	//! \brief Marks every tile that is currently drawn as selected so that it gets drawn again
+	void _MarkSelectionDirty();
+
+	//! \brief Removes all tiles from the preview layer and marks the tiles they were painted over to be drawn again
+	void _ClearPreviewLayer();
+
+	/** \brief Draws all tiles that have been marked as changed since they were last drawn
+	*** If the map has been resized since it was last drawn in full, this calls DrawMap() instead.
+	**/
+	void _DrawDirtyTiles();
+
+	/** \brief Draws a rectangle of tiles into the chunks that contain them
+	*** \param left The x coordinate of the left-most tile
+	*** \param top The y coordinate of the top-most tile
+	*** \param right The x coordinate of the right-most tile
+	*** \param bottom The y coordinate of the bottom-most tile
+	***
+	*** Each tile is drawn with all visible tile layers from the active context, the missing, inherited and preview overlays
+	*** of the selected layer, and the selection overlay.
+	**/
+	void _DrawTiles(uint32 left, uint32 top, uint32 right, uint32 bottom);
+
+	/** \brief Determines whether a tile should be drawn with the selection overlay
+	*** \param x The x coordinate of the tile to check
+	*** \param y The y coordinate of the tile to check
+	*** \return True if the tile is in the selection area, taking into account any area that is being added or subtracted by the user
+	**/
+	bool _IsTileDrawnSelected(uint32 x, uint32 y) const;
 
 	//! \brief A helper function to DrawMap() that draws the tile grid over the tiles
 	void _DrawGrid();
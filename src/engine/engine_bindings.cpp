@@ -37,6 +37,53 @@ using namespace luabind;
 
 namespace hoa_defs {
 
+namespace {
+
+/** \brief Subscribes a Lua function to notifications with a matching category and event
+*** \param notification_engine A pointer to the notification engine that the subscription is made with
+*** \param category The name of the category to match, or the empty string to match all categories
+*** \param event The name of the event to match, or the empty string to match all events
+*** \param handler The Lua function to call with each matching notification
+*** \param owner The game mode that the function belongs to, or nil if the subscription should last until it is cancelled
+*** \return The ID of the subscription, or zero if the arguments were invalid
+***
+*** Map scripts and other scripts loaded by a game mode should pass their game mode as the owner. The subscription is
+*** then cancelled when the game mode is destroyed or parked, before the functions of the script are no longer valid.
+**/
+uint32 SubscribeScriptFunction(hoa_notification::NotificationEngine* notification_engine, const std::string& category,
+	const std::string& event, object handler, object owner)
+{
+	if (type(handler) != LUA_TFUNCTION) {
+		IF_PRINT_WARNING(hoa_notification::NOTIFICATION_DEBUG) << "handler argument was not a function" << std::endl;
+		return 0;
+	}
+
+	hoa_mode_manager::GameMode* owner_mode = nullptr;
+	if (type(owner) != LUA_TNIL) {
+		try {
+			owner_mode = object_cast<hoa_mode_manager::GameMode*>(owner);
+		}
+		catch (luabind::cast_failed e) {
+			IF_PRINT_WARNING(hoa_notification::NOTIFICATION_DEBUG) << "owner argument was not a game mode" << std::endl;
+			return 0;
+		}
+	}
+
+	return notification_engine->Subscribe(category, event, [handler](hoa_notification::NotificationEvent* notification) {
+		try {
+			ScriptCallFunction<void>(handler, notification);
+		}
+		catch (luabind::error e) {
+			hoa_script::ScriptManager->HandleLuaError(e);
+		}
+		catch (luabind::cast_failed e) {
+			hoa_script::ScriptManager->HandleCastError(e);
+		}
+	}, owner_mode);
+}
+
+} // namespace
+
 void BindEngineCode() {
 	// ----- Audio Engine Bindings
 	{
@@ -144,14 +191,19 @@ void BindEngineCode() {
 	[
 		class_<NotificationEvent>("NotificationEvent")
 			.def(constructor<std::string, std::string>())
-			.def_readonly("category", &NotificationEvent::category)
-			.def_readonly("event", &NotificationEvent::event),
+			.property("category", &NotificationEvent::GetCategory)
+			.property("event", &NotificationEvent::GetEvent)
+			.def_readonly("category_id", &NotificationEvent::category_id)
+			.def_readonly("event_id", &NotificationEvent::event_id),
 
 		class_<NotificationEngine>("NotificationEngine")
 			.def("Notify", &NotificationEngine::Notify, adopt(_2))
 			.def("CreateAndNotify", &NotificationEngine::CreateAndNotify)
 			.def("GetNotificationCount", &NotificationEngine::GetNotificationCount)
 			.def("GetNotificationEvent", &NotificationEngine::GetNotificationEvent)
+			.def("GetNotificationID", &NotificationEngine::GetNotificationID)
+			.def("Subscribe", &SubscribeScriptFunction)
+			.def("Unsubscribe", &NotificationEngine::Unsubscribe)
 			.def("DEBUG_PrintNotificationEvents", &NotificationEngine::DEBUG_PrintNotificationEvents)
 	];
 
@@ -337,6 +389,7 @@ void BindEngineCode() {
 			.def("DisableLightning", &VideoEngine::DisableLightning)
 			.def("DrawOverlays", &VideoEngine::DrawOverlays)
 			.def("AddParticleEffect", &VideoEngine::AddParticleEffect)
+			.def("PreloadParticleEffect", &VideoEngine::PreloadParticleEffect)
 			.def("StopAllParticleEffects", &VideoEngine::StopAllParticleEffects)
 
 			// Namespace constants
@@ -101,6 +101,45 @@ InputEngine::InputEngine() {
 	_joystick.x_axis      = 0;
 	_joystick.y_axis      = 1;
 	_joystick.threshold   = 8192;
+
+	_recorded_frames      = 0;
+
+	_recorded_flags.push_back(&_any_key_press);
+	_recorded_flags.push_back(&_any_key_release);
+	_recorded_flags.push_back(&_unmapped_key_press);
+	_recorded_flags.push_back(&_up_state);
+	_recorded_flags.push_back(&_up_press);
+	_recorded_flags.push_back(&_up_release);
+	_recorded_flags.push_back(&_down_state);
+	_recorded_flags.push_back(&_down_press);
+	_recorded_flags.push_back(&_down_release);
+	_recorded_flags.push_back(&_left_state);
+	_recorded_flags.push_back(&_left_press);
+	_recorded_flags.push_back(&_left_release);
+	_recorded_flags.push_back(&_right_state);
+	_recorded_flags.push_back(&_right_press);
+	_recorded_flags.push_back(&_right_release);
+	_recorded_flags.push_back(&_confirm_state);
+	_recorded_flags.push_back(&_confirm_press);
+	_recorded_flags.push_back(&_confirm_release);
+	_recorded_flags.push_back(&_cancel_state);
+	_recorded_flags.push_back(&_cancel_press);
+	_recorded_flags.push_back(&_cancel_release);
+	_recorded_flags.push_back(&_menu_state);
+	_recorded_flags.push_back(&_menu_press);
+	_recorded_flags.push_back(&_menu_release);
+	_recorded_flags.push_back(&_swap_state);
+	_recorded_flags.push_back(&_swap_press);
+	_recorded_flags.push_back(&_swap_release);
+	_recorded_flags.push_back(&_left_select_state);
+	_recorded_flags.push_back(&_left_select_press);
+	_recorded_flags.push_back(&_left_select_release);
+	_recorded_flags.push_back(&_right_select_state);
+	_recorded_flags.push_back(&_right_select_press);
+	_recorded_flags.push_back(&_right_select_release);
+	_recorded_flags.push_back(&_pause_press);
+	_recorded_flags.push_back(&_quit_press);
+	_recorded_flags.push_back(&_help_press);
 }
 
 
@@ -108,6 +147,9 @@ InputEngine::InputEngine() {
 InputEngine::~InputEngine() {
 	IF_PRINT_DEBUG(INPUT_DEBUG) << "destructor invoked" << endl;
 
+	StopRecording();
+	StopReplay();
+
 	// If a joystick is open, close it before exiting
 	if (_joystick.js != nullptr) {
 		SDL_JoystickClose(_joystick.js);
@@ -223,35 +265,25 @@ bool InputEngine::RestoreDefaultJoyButtons() {
 void InputEngine::EventHandler() {
 	SDL_Event event; // Holds the game event
 
-	// Reset all of the press and release flags so that they don't get detected twice.
-	_any_key_press = false;
-	_any_key_release = false;
-	_unmapped_key_press = false;
+	ResetPressReleaseFlags();
 
-	_up_press             = false;
-	_up_release           = false;
-	_down_press           = false;
-	_down_release         = false;
-	_left_press           = false;
-	_left_release         = false;
-	_right_press          = false;
-	_right_release        = false;
-	_confirm_press        = false;
-	_confirm_release      = false;
-	_cancel_press         = false;
-	_cancel_release       = false;
-	_menu_press           = false;
-	_menu_release         = false;
-	_swap_press           = false;
-	_swap_release         = false;
-	_right_select_press   = false;
-	_right_select_release = false;
-	_left_select_press    = false;
-	_left_select_release  = false;
+	// When replaying, the flags come from the replay file and live input events are discarded
+	if (IsReplaying() == true) {
+		while (SDL_PollEvent(&event)) {
+			if (event.type == SDL_QUIT) {
+				StopReplay();
+				_quit_press = true;
+				return;
+			}
+		}
 
-	_pause_press = false;
-	_quit_press = false;
-	_help_press = false;
+		if (_ReplayFrame() == false) {
+			IF_PRINT_DEBUG(INPUT_DEBUG) << "input replay finished after " << _recorded_frames << " frames" << endl;
+			StopReplay();
+			SystemManager->ExitGame();
+		}
+		return;
+	}
 
 	// Loops until there are no remaining events to process
 	while (SDL_PollEvent(&event)) {
@@ -300,10 +332,147 @@ void InputEngine::EventHandler() {
 			_JoystickEventHandler(event);
 		}
 	} // while (SDL_PollEvent(&event)
+
+	if (IsRecording() == true) {
+		_RecordFrame();
+	}
 } // void InputEngine::EventHandler()
 
 
 
+void InputEngine::ResetPressReleaseFlags() {
+	_any_key_press = false;
+	_any_key_release = false;
+	_unmapped_key_press = false;
+
+	_up_press             = false;
+	_up_release           = false;
+	_down_press           = false;
+	_down_release         = false;
+	_left_press           = false;
+	_left_release         = false;
+	_right_press          = false;
+	_right_release        = false;
+	_confirm_press        = false;
+	_confirm_release      = false;
+	_cancel_press         = false;
+	_cancel_release       = false;
+	_menu_press           = false;
+	_menu_release         = false;
+	_swap_press           = false;
+	_swap_release         = false;
+	_right_select_press   = false;
+	_right_select_release = false;
+	_left_select_press    = false;
+	_left_select_release  = false;
+
+	_pause_press = false;
+	_quit_press = false;
+	_help_press = false;
+}
+
+
+
+bool InputEngine::StartRecording(const string& filename) {
+	if (IsReplaying() == true) {
+		IF_PRINT_WARNING(INPUT_DEBUG) << "can not record input while a replay is active" << endl;
+		return false;
+	}
+
+	StopRecording();
+	_record_file.open(filename.c_str(), ios::out | ios::trunc);
+	if (_record_file.is_open() == false) {
+		PRINT_ERROR << "failed to open input recording file for writing: " << filename << endl;
+		return false;
+	}
+
+	// The header records the fixed update time so that a replay can warn when its timing differs
+	_record_file << "ALLACROST_INPUT_RECORDING " << SystemManager->GetFixedUpdateTime() << endl;
+	_recorded_frames = 0;
+	return true;
+}
+
+
+
+void InputEngine::StopRecording() {
+	if (_record_file.is_open() == true) {
+		_record_file.close();
+	}
+}
+
+
+
+bool InputEngine::StartReplay(const string& filename) {
+	if (IsRecording() == true) {
+		IF_PRINT_WARNING(INPUT_DEBUG) << "can not replay input while a recording is active" << endl;
+		return false;
+	}
+
+	StopReplay();
+	_replay_file.open(filename.c_str(), ios::in);
+	if (_replay_file.is_open() == false) {
+		PRINT_ERROR << "failed to open input recording file for reading: " << filename << endl;
+		return false;
+	}
+
+	string header;
+	uint32 fixed_update_time = 0;
+	_replay_file >> header >> fixed_update_time;
+	if (header != "ALLACROST_INPUT_RECORDING" || _replay_file.fail() == true) {
+		PRINT_ERROR << "file was not a valid input recording: " << filename << endl;
+		_replay_file.close();
+		return false;
+	}
+
+	if (fixed_update_time != SystemManager->GetFixedUpdateTime()) {
+		PRINT_WARNING << "input was recorded with a fixed update time of " << fixed_update_time << "ms but is being replayed with "
+			<< SystemManager->GetFixedUpdateTime() << "ms. The replay will not be deterministic." << endl;
+	}
+
+	_recorded_frames = 0;
+	return true;
+}
+
+
+
+void InputEngine::StopReplay() {
+	if (_replay_file.is_open() == true) {
+		_replay_file.close();
+	}
+}
+
+
+
+void InputEngine::_RecordFrame() {
+	uint32 words[2] = { 0, 0 };
+	for (uint32 i = 0; i < _recorded_flags.size(); ++i) {
+		if (*_recorded_flags[i] == true) {
+			words[i / 32] |= (0x1u << (i % 32));
+		}
+	}
+
+	_record_file << hex << words[0] << ' ' << words[1] << dec << '\n';
+	++_recorded_frames;
+}
+
+
+
+bool InputEngine::_ReplayFrame() {
+	uint32 words[2] = { 0, 0 };
+	_replay_file >> hex >> words[0] >> words[1] >> dec;
+	if (_replay_file.fail() == true) {
+		return false;
+	}
+
+	for (uint32 i = 0; i < _recorded_flags.size(); ++i) {
+		*_recorded_flags[i] = ((words[i / 32] & (0x1u << (i % 32))) != 0);
+	}
+	++_recorded_frames;
+	return true;
+}
+
+
+
 string InputEngine::GetKeyName(INPUT_STANDARD_COMMAND command) const {
 	switch (command) {
 		case UP_COMMAND:
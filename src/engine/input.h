@@ -264,6 +264,12 @@ public:
 	**/
 	void EventHandler();
 
+	/** \brief Clears all of the press and release flags so that they are not detected more than once
+	*** EventHandler() calls this before processing each frame's input. The main game loop also calls it between
+	*** simulation steps that are processed in the same frame, so that only the first step sees the new presses.
+	**/
+	void ResetPressReleaseFlags();
+
 	/** \name Input state member access functions
 	*** \return True if the input event key/button is being held down
 	**/
@@ -585,6 +591,43 @@ public:
 	const SDL_Event& GetMostRecentEvent() const
 		{ return _event; }
 
+	/** \name Input recording and replay
+	*** While recording, the press, release, and state flags that EventHandler() determines for each frame are
+	*** appended to the recording file as a single line of text. While replaying, the keyboard and joystick are
+	*** ignored and EventHandler() instead restores these flags from the next line of the replay file, so the game
+	*** receives exactly the sequence of input that was recorded. The game exits once every recorded frame has
+	*** been replayed. For a replay to be deterministic the game must run with the same fixed update time that was
+	*** used when the input was recorded (see SystemEngine::SetFixedUpdateTime()).
+	***
+	*** \note Joystick axis motion and the raw SDL event returned by GetMostRecentEvent() are not recorded, so
+	*** menus that remap keys or joystick buttons can not be driven by a replay.
+	**/
+	//@{
+	/** \brief Begins recording the input of every frame to a file
+	*** \param filename The name of the file to record to. Any existing file will be overwritten
+	*** \return False if the file could not be opened or if input is currently being replayed
+	**/
+	bool StartRecording(const std::string& filename);
+
+	//! \brief Stops recording input and closes the recording file
+	void StopRecording();
+
+	/** \brief Begins replaying the input from a file created by StartRecording()
+	*** \param filename The name of the recording to replay
+	*** \return False if the file could not be opened, was not a valid recording, or if input is being recorded
+	**/
+	bool StartReplay(const std::string& filename);
+
+	//! \brief Stops replaying input and returns control to the keyboard and joystick
+	void StopReplay();
+
+	bool IsRecording() const
+		{ return _record_file.is_open(); }
+
+	bool IsReplaying() const
+		{ return _replay_file.is_open(); }
+	//@}
+
 private:
 	InputEngine();
 
@@ -671,6 +714,29 @@ private:
 	//! \brief Hold the most recent SDL event that was generated
 	SDL_Event _event;
 
+	/** \brief Pointers to every input flag that is saved in a recording
+	*** The position of each flag in this container determines which bit it occupies in a recording file, so
+	*** new flags must only ever be appended to the end.
+	**/
+	std::vector<bool*> _recorded_flags;
+
+	//! \brief The file that the input of each frame is written to while recording
+	std::ofstream _record_file;
+
+	//! \brief The file that the input of each frame is read from while replaying
+	std::ifstream _replay_file;
+
+	//! \brief The number of frames that have been written to or read from the active recording
+	uint32 _recorded_frames;
+
+	//! \brief Writes the flags of the current frame to the recording file
+	void _RecordFrame();
+
+	/** \brief Reads the flags of the next frame from the replay file
+	*** \return False if the replay file contains no more frames
+	**/
+	bool _ReplayFrame();
+
 	/** \brief Processes all keyboard input events
 	*** \param key_event The event to process
 	**/
@@ -14,12 +14,16 @@
 *** **************************************************************************/
 
 #include "mode_manager.h"
+#include "notification.h"
 #include "system.h"
+#include "video.h"
 
 using namespace std;
 
 using namespace hoa_utils;
+using namespace hoa_notification;
 using namespace hoa_system;
+using namespace hoa_video;
 
 template<> hoa_mode_manager::ModeEngine* Singleton<hoa_mode_manager::ModeEngine>::_singleton_reference = nullptr;
 
@@ -28,6 +32,17 @@ namespace hoa_mode_manager {
 ModeEngine* ModeManager = nullptr;
 bool MODE_MANAGER_DEBUG = false;
 
+////////////////////////////////////////////////////////////////////////////////
+// GameMode class methods
+////////////////////////////////////////////////////////////////////////////////
+
+GameMode::~GameMode() {
+	if (SystemManager != nullptr)
+		SystemManager->ReleaseTimerWheel(this);
+	if (NotificationManager != nullptr)
+		NotificationManager->ReleaseSubscriptions(this);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // ModeEngine class methods
 ////////////////////////////////////////////////////////////////////////////////
@@ -54,6 +69,8 @@ ModeEngine::~ModeEngine() {
 		delete _push_stack.back();
 		_push_stack.pop_back();
 	}
+
+	ClearModePool();
 }
 
 
@@ -71,6 +88,8 @@ bool ModeEngine::SingletonInitialize() {
 		_push_stack.pop_back();
 	}
 
+	ClearModePool();
+
 	// Reset the pop counter
 	_pop_count = 0;
 
@@ -165,6 +184,42 @@ bool ModeEngine::IsModeTypeInStack(GAME_MODE_TYPE type) {
 
 
 
+GameMode* ModeEngine::AcquirePooledMode(GAME_MODE_TYPE type) {
+	map<GAME_MODE_TYPE, GameMode*>::iterator it = _mode_pool.find(type);
+	if (it == _mode_pool.end())
+		return nullptr;
+
+	GameMode* mode = it->second;
+	_mode_pool.erase(it);
+	return mode;
+}
+
+
+
+void ModeEngine::ClearModePool() {
+	for (map<GAME_MODE_TYPE, GameMode*>::iterator i = _mode_pool.begin(); i != _mode_pool.end(); i++) {
+		delete i->second;
+	}
+	_mode_pool.clear();
+}
+
+
+
+void ModeEngine::_ReleaseMode(GameMode* mode) {
+	if (_mode_pool.find(mode->mode_type) != _mode_pool.end() || mode->Recycle() == false) {
+		delete mode;
+		return;
+	}
+
+	// Calls scheduled and handlers subscribed by the mode's last use must not be made if it is reused
+	SystemManager->ReleaseTimerWheel(mode);
+	NotificationManager->ReleaseSubscriptions(mode);
+	_mode_pool.insert(make_pair(mode->mode_type, mode));
+	IF_PRINT_DEBUG(MODE_MANAGER_DEBUG) << "parked game mode in the mode pool: " << mode->mode_type << endl;
+}
+
+
+
 void ModeEngine::Update() {
 	// If a Push() or Pop() function was called, we need to adjust the state of the game stack.
 	if (_state_change == true) {
@@ -175,7 +230,7 @@ void ModeEngine::Update() {
 				_pop_count = 0; // Reset the pop count so we don't continue to try to pop off more modes in future calls to Update()
 				break; // Exit the loop
 			}
-			delete _game_stack.back();
+			_ReleaseMode(_game_stack.back());
 			_game_stack.pop_back();
 			_pop_count--;
 		}
@@ -203,6 +258,10 @@ void ModeEngine::Update() {
 
 		// Re-initialize the game update timer so that the new active game mode does not begin with any update time to process
 		SystemManager->InitializeUpdateTimer();
+
+		// Game modes that mostly display a still screen do not need to be drawn at the full frame rate
+		GAME_MODE_TYPE active_type = _game_stack.back()->GetModeType();
+		VideoManager->SetLowPowerMode(active_type == PAUSE_MODE || active_type == MENU_MODE || active_type == SAVE_MODE);
 	} // if (_state_change == true)
 
 	// Call the Update function on the top stack mode (the active game mode)
@@ -66,7 +66,8 @@ class GameMode {
 	friend class ModeEngine;
 
 public:
-	virtual ~GameMode() {}
+	//! \brief Destroys the timer wheel owned by this game mode, if it has one, along with all of its scheduled calls
+	virtual ~GameMode();
 
 	GAME_MODE_TYPE GetModeType() const
 		{ return mode_type; }
@@ -90,6 +91,20 @@ public:
 	**/
 	virtual void Reset() = 0;
 
+	/** \brief Returns the game mode to the state of an unused instance so that it may be used again
+	*** \return True if the game mode may be parked in the mode pool, or false if it should be destroyed
+	***
+	*** This is called by ModeEngine in place of the destructor when the game mode is popped off the stack and
+	*** no other instance of the same type is already parked. An implementation must release all data that was
+	*** specific to its last use, but should keep the windows, images, and sounds that every use of the game mode
+	*** shares. Game modes that support reuse provide a static Create() function that takes a parked instance from
+	*** ModeEngine::AcquirePooledMode() and re-arms it, or constructs a new instance if none is parked.
+	***
+	*** The default implementation returns false, so game modes are destroyed when popped unless they support reuse.
+	**/
+	virtual bool Recycle()
+		{ return false; }
+
 	//! \brief Updates the state of the game mode.
 	virtual void Update() = 0;
 
@@ -138,6 +153,10 @@ protected:
 *** GameModeManager#pop_count member retains how many modes to delete and pop off the ModeEngine#game_stack. Pop operations
 *** are always performed before push operations.
 ***
+*** Game modes that are popped off the stack are normally destroyed. Those that support reuse (see GameMode#Recycle())
+*** are instead parked in a mode pool, which holds at most one instance of each type of game mode. Parked modes are
+*** not updated or drawn, and remain in the pool until they are acquired again or the pool is cleared.
+***
 *** \note You might be wondering why the game stack uses a vector container rather than a stack container.
 *** There are two reasons: the first being that we can't do a debug printout of the game_stack without
 *** removing elements if a stack is used. The second reason is "just in case" we need to access a stack
@@ -201,6 +220,18 @@ public:
 	**/
 	bool IsModeTypeInStack(GAME_MODE_TYPE type);
 
+	/** \brief Removes a parked game mode from the mode pool
+	*** \param type The type of game mode to retrieve
+	*** \return A pointer to the parked game mode, or nullptr if no game mode of this type is parked
+	***
+	*** The caller takes ownership of the returned game mode and should either push it onto the stack or delete it.
+	*** It is in the state that its Recycle() function left it in.
+	**/
+	GameMode* AcquirePooledMode(GAME_MODE_TYPE type);
+
+	//! \brief Destroys all game modes that are parked in the mode pool
+	void ClearModePool();
+
 	//! \brief Checks if the game stack needs modes pushed or popped, then calls Update on the active game mode.
 	void Update();
 
@@ -242,6 +273,14 @@ private:
 
 	//! \brief Set to true if game modes should draw graphical debugging information
 	bool _debug_graphics_enabled;
+
+	//! \brief Game modes that were popped off the stack and are waiting to be reused, keyed by their type
+	std::map<GAME_MODE_TYPE, GameMode*> _mode_pool;
+
+	/** \brief Parks a game mode that was popped off the stack in the mode pool, or destroys it
+	*** \param mode The game mode that was popped
+	**/
+	void _ReleaseMode(GameMode* mode);
 }; // class ModeEngine : public hoa_utils::Singleton<ModeEngine>
 
 } // namespace hoa_mode_manager
@@ -13,11 +13,16 @@
 *** \brief  Source file for notification event management
 *** **************************************************************************/
 
+#include <cstddef>
+#include <deque>
+#include <unordered_map>
+
 #include "notification.h"
 
 using namespace std;
 
 using namespace hoa_utils;
+using namespace hoa_mode_manager;
 
 template<> hoa_notification::NotificationEngine* Singleton<hoa_notification::NotificationEngine>::_singleton_reference = nullptr;
 
@@ -26,11 +31,104 @@ namespace hoa_notification {
 NotificationEngine* NotificationManager = nullptr;
 bool NOTIFICATION_DEBUG = false;
 
+namespace {
+
+//! \brief Holds every interned name. The names are kept in a deque so that references to them are never invalidated.
+class NotificationNameTable {
+public:
+	NotificationNameTable()
+		{ names.push_back(""); ids[""] = NOTIFICATION_ANY; }
+
+	std::unordered_map<std::string, uint32> ids;
+
+	std::deque<std::string> names;
+};
+
+//! \brief Returns the name table, which is constructed on first use so that names may be interned during static initialization
+NotificationNameTable& GetNameTable() {
+	static NotificationNameTable table;
+	return table;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////
+// Notification name functions
+////////////////////////////////////////////////////////////////////////////////
+
+uint32 InternNotificationName(const string& name) {
+	NotificationNameTable& table = GetNameTable();
+	unordered_map<string, uint32>::iterator entry = table.ids.find(name);
+	if (entry != table.ids.end())
+		return entry->second;
+
+	uint32 id = table.names.size();
+	table.names.push_back(name);
+	table.ids[name] = id;
+	return id;
+}
+
+
+
+const string& GetNotificationName(uint32 id) {
+	NotificationNameTable& table = GetNameTable();
+	if (id >= table.names.size()) {
+		IF_PRINT_WARNING(NOTIFICATION_DEBUG) << "invalid notification name ID: " << id << endl;
+		return table.names[NOTIFICATION_ANY];
+	}
+	return table.names[id];
+}
+
+namespace private_notification {
+
+////////////////////////////////////////////////////////////////////////////////
+// NotificationArena class methods
+////////////////////////////////////////////////////////////////////////////////
+
+void* NotificationArena::Allocate(size_t size) {
+	if (size > BLOCK_SIZE)
+		return nullptr;
+
+	// Round the offset up so that every allocation is suitably aligned for any type
+	const size_t alignment = alignof(max_align_t);
+	_block_offset = (_block_offset + alignment - 1) & ~(alignment - 1);
+
+	if (_block_index < _blocks.size() && _block_offset + size > BLOCK_SIZE) {
+		_block_index++;
+		_block_offset = 0;
+	}
+	if (_block_index == _blocks.size()) {
+		_blocks.push_back(unique_ptr<char[]>(new char[BLOCK_SIZE]));
+		_block_offset = 0;
+	}
+
+	void* memory = _blocks[_block_index].get() + _block_offset;
+	_block_offset += size;
+	return memory;
+}
+
+
+
+bool NotificationArena::Contains(const void* address) const {
+	const char* byte = static_cast<const char*>(address);
+	for (uint32 i = 0; i < _blocks.size(); ++i) {
+		if (byte >= _blocks[i].get() && byte < _blocks[i].get() + BLOCK_SIZE)
+			return true;
+	}
+	return false;
+}
+
+} // namespace private_notification
+
 ////////////////////////////////////////////////////////////////////////////////
 // NotificationEngine class methods
 ////////////////////////////////////////////////////////////////////////////////
 
-NotificationEngine::NotificationEngine() {
+NotificationEngine::NotificationEngine() :
+	_next_subscription_id(1),
+	_dispatch_depth(0),
+	_cancelled_subscriptions(false)
+{
 	IF_PRINT_DEBUG(NOTIFICATION_DEBUG) << "constructor invoked" << endl;
 }
 
@@ -47,9 +145,14 @@ NotificationEngine::~NotificationEngine() {
 
 void NotificationEngine::DeleteAllNotificationEvents() {
 	for (uint32 i = 0; i < _notification_events.size(); ++i) {
-		delete _notification_events[i];
+		// Notifications constructed in the arena are only destroyed here. Their memory is reclaimed when the arena is reset.
+		if (_arena.Contains(_notification_events[i]) == true)
+			_notification_events[i]->~NotificationEvent();
+		else
+			delete _notification_events[i];
 	}
 	_notification_events.clear();
+	_arena.Reset();
 }
 
 
@@ -61,13 +164,72 @@ void NotificationEngine::Notify(NotificationEvent* notification) {
 	}
 
 	_notification_events.push_back(notification);
+	_DispatchNotification(notification);
 }
 
 
 
 void NotificationEngine::CreateAndNotify(const string& category, const string& event) {
-	NotificationEvent* new_trigger = new NotificationEvent(category, event);
-	_notification_events.push_back(new_trigger);
+	CreateNotification<NotificationEvent>(category, event);
+}
+
+
+
+uint32 NotificationEngine::Subscribe(uint32 category_id, uint32 event_id, NotificationHandler handler, GameMode* owner) {
+	if (!handler) {
+		IF_PRINT_WARNING(NOTIFICATION_DEBUG) << "function received an empty handler" << endl;
+		return 0;
+	}
+
+	uint32 id = _next_subscription_id++;
+	_subscriptions.push_back(private_notification::NotificationSubscription(id, category_id, event_id, handler, owner));
+	return id;
+}
+
+
+
+void NotificationEngine::Unsubscribe(uint32 subscription_id) {
+	for (uint32 i = 0; i < _subscriptions.size(); ++i) {
+		if (_subscriptions[i].id != subscription_id || subscription_id == 0)
+			continue;
+
+		// Removing the subscription while it is being iterated over would skip the handler that follows it
+		if (_dispatch_depth > 0) {
+			_subscriptions[i].id = 0;
+			_cancelled_subscriptions = true;
+		}
+		else {
+			_subscriptions.erase(_subscriptions.begin() + i);
+		}
+		return;
+	}
+
+	IF_PRINT_WARNING(NOTIFICATION_DEBUG) << "no subscription existed with the ID: " << subscription_id << endl;
+}
+
+
+
+void NotificationEngine::ReleaseSubscriptions(GameMode* owner) {
+	if (owner == nullptr) {
+		IF_PRINT_WARNING(NOTIFICATION_DEBUG) << "function received nullptr argument" << endl;
+		return;
+	}
+
+	bool released = false;
+	for (uint32 i = 0; i < _subscriptions.size(); ++i) {
+		if (_subscriptions[i].owner == owner && _subscriptions[i].id != 0) {
+			_subscriptions[i].id = 0;
+			released = true;
+		}
+	}
+
+	if (released == false)
+		return;
+	// The subscriptions can not be removed if a mode is destroyed by a handler, since they are still being iterated over
+	if (_dispatch_depth > 0)
+		_cancelled_subscriptions = true;
+	else
+		_RemoveCancelledSubscriptions();
 }
 
 
@@ -81,6 +243,47 @@ NotificationEvent* NotificationEngine::GetNotificationEvent(uint32 index) const
 
 
 
+void NotificationEngine::_DispatchNotification(NotificationEvent* notification) {
+	_dispatch_depth++;
+
+	// Subscriptions made by a handler are not invoked for the notification that is currently being dispatched
+	uint32 subscription_count = _subscriptions.size();
+	for (uint32 i = 0; i < subscription_count; ++i) {
+		const private_notification::NotificationSubscription& subscription = _subscriptions[i];
+		if (subscription.id == 0)
+			continue;
+		if (subscription.category_id != NOTIFICATION_ANY && subscription.category_id != notification->category_id)
+			continue;
+		if (subscription.event_id != NOTIFICATION_ANY && subscription.event_id != notification->event_id)
+			continue;
+
+		// The handler is copied because it may add subscriptions, which could reallocate the container
+		NotificationHandler handler = subscription.handler;
+		handler(notification);
+	}
+
+	_dispatch_depth--;
+	if (_dispatch_depth == 0 && _cancelled_subscriptions == true)
+		_RemoveCancelledSubscriptions();
+}
+
+
+
+void NotificationEngine::_RemoveCancelledSubscriptions() {
+	uint32 active_count = 0;
+	for (uint32 i = 0; i < _subscriptions.size(); ++i) {
+		if (_subscriptions[i].id != 0) {
+			if (active_count != i)
+				_subscriptions[active_count] = _subscriptions[i];
+			active_count++;
+		}
+	}
+	_subscriptions.erase(_subscriptions.begin() + active_count, _subscriptions.end());
+	_cancelled_subscriptions = false;
+}
+
+
+
 void NotificationEngine::DEBUG_PrintNotificationEvents() const {
 	if (_notification_events.size()) PRINT_DEBUG << "printing list of all stored notifications" << endl;
 	for (uint32 i = 0; i < _notification_events.size(); ++i) {
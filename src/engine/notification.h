@@ -15,6 +15,11 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <new>
+#include <utility>
+
 #include "utils.h"
 #include "defs.h"
 
@@ -27,6 +32,90 @@ extern NotificationEngine* NotificationManager;
 //! \brief Determines whether the code in the hoa_notification namespace should print debug statements or not.
 extern bool NOTIFICATION_DEBUG;
 
+//! \brief The ID of the empty name, which matches any category or event when used to subscribe to notifications
+const uint32 NOTIFICATION_ANY = 0;
+
+/** \brief Retrieves the unique integer ID for a notification category or event name
+*** \param name The name to retrieve the ID for
+*** \return The ID of the name. The same name always returns the same ID for the duration of the program.
+***
+*** Comparing two IDs is much cheaper than comparing the strings they represent. Code that creates or examines
+*** the same type of notification repeatedly should retrieve the IDs for its names once and store them.
+**/
+uint32 InternNotificationName(const std::string& name);
+
+/** \brief Retrieves the name that a notification ID represents
+*** \param id The ID of the name to retrieve
+*** \return A reference to the name, or to the empty string if the ID is invalid. The reference remains valid for the
+*** duration of the program.
+**/
+const std::string& GetNotificationName(uint32 id);
+
+//! \brief The type of function that is invoked for every notification that matches a subscription
+typedef std::function<void(NotificationEvent*)> NotificationHandler;
+
+namespace private_notification {
+
+/** ***************************************************************************
+*** \brief A memory arena that holds notification events for the duration of a single frame
+***
+*** Memory is allocated from a list of fixed size blocks by advancing an offset. Individual allocations are never
+*** freed. Instead the entire arena is reset once the frame's notifications have been deleted, after which the
+*** blocks are reused. This avoids a heap allocation and deallocation for every notification that is sent.
+*** **************************************************************************/
+class NotificationArena {
+public:
+	NotificationArena() :
+		_block_index(0), _block_offset(0) {}
+
+	/** \brief Allocates memory from the arena
+	*** \param size The number of bytes to allocate
+	*** \return A pointer to the memory, or nullptr if the size is larger than an arena block
+	**/
+	void* Allocate(size_t size);
+
+	//! \brief Returns true if the address points to memory held by the arena
+	bool Contains(const void* address) const;
+
+	//! \brief Marks all memory in the arena as free. Any objects constructed in the arena must already be destroyed.
+	void Reset()
+		{ _block_index = 0; _block_offset = 0; }
+
+private:
+	//! \brief The size of each block of memory, in bytes
+	static const size_t BLOCK_SIZE = 4096;
+
+	//! \brief All blocks that the arena has allocated. Blocks are retained when the arena is reset.
+	std::vector<std::unique_ptr<char[]>> _blocks;
+
+	//! \brief The index of the block that memory is currently being allocated from
+	uint32 _block_index;
+
+	//! \brief The offset in the current block to the first byte of free memory
+	size_t _block_offset;
+}; // class NotificationArena
+
+//! \brief A handler function along with the category and event that it is subscribed to
+class NotificationSubscription {
+public:
+	NotificationSubscription(uint32 id, uint32 category_id, uint32 event_id, NotificationHandler handler, hoa_mode_manager::GameMode* owner) :
+		id(id), category_id(category_id), event_id(event_id), handler(handler), owner(owner) {}
+
+	//! \brief The unique ID of the subscription, or zero if it has been cancelled
+	uint32 id;
+
+	//! \brief The IDs of the category and event names that the subscription matches
+	uint32 category_id, event_id;
+
+	//! \brief The function to invoke for each matching notification
+	NotificationHandler handler;
+
+	//! \brief The game mode that the subscription is cancelled along with, or nullptr if it has no owner
+	hoa_mode_manager::GameMode* owner;
+}; // class NotificationSubscription
+
+} // namespace private_notification
+
 
 /** ***************************************************************************
 *** \brief A simple container class for creating notifications of important events
@@ -42,6 +131,9 @@ extern bool NOTIFICATION_DEBUG;
 *** the type of event that caused the trigger to be generated, which could be anything from "collision" to
 *** "equipped_weapon".
 ***
+*** Both strings are interned when the notification is constructed, so a notification only stores the integer ID
+*** of each name. Code that checks for a particular type of notification should compare the IDs instead of the names.
+***
 *** Many notifications will desire more data than these two strings can provide to indicate any particular state
 *** or conditions that caused the notification to be generated. This class should be sub-classed appropriately
 *** to generate such notification events.
@@ -51,8 +143,14 @@ public:
 	/** \param category String that represents the area of code creating this notification
 	*** \param event Identifier string for the type of this notification
 	**/
-	NotificationEvent(std::string category_name, std::string event_name) :
-		category(category_name), event(event_name) {}
+	NotificationEvent(const std::string& category_name, const std::string& event_name) :
+		category_id(InternNotificationName(category_name)), event_id(InternNotificationName(event_name)) {}
+
+	/** \param category The interned ID of the category name
+	*** \param event The interned ID of the event name
+	**/
+	NotificationEvent(uint32 category, uint32 event) :
+		category_id(category), event_id(event) {}
 
 	virtual ~NotificationEvent()
 		{}
@@ -64,13 +162,21 @@ public:
 	*** line and follow the format: "ClassName::category/event - extra data here" to maintain consistency.
 	**/
 	virtual const std::string DEBUG_PrintInfo()
-		{ return ("NotificationEvent::" + category + "/" + event); }
+		{ return ("NotificationEvent::" + GetCategory() + "/" + GetEvent()); }
+
+	//! \brief Returns the name of the area of code that generated the notification (ex: "map" for map mode)
+	const std::string& GetCategory() const
+		{ return GetNotificationName(category_id); }
+
+	//! \brief Returns the name of the event that caused the notification to be created (ex: "collision")
+	const std::string& GetEvent() const
+		{ return GetNotificationName(event_id); }
 
-	//! \brief An identifier that signifies the area of code that generated the notification (ex: "map" for map mode)
-	std::string category;
+	//! \brief The interned ID of the name of the area of code that generated the notification
+	uint32 category_id;
 
-	//! \brief An identifier that signifies the event that caused the notification to be created (ex: "collision")
-	std::string event;
+	//! \brief The interned ID of the name of the event that caused the notification to be created
+	uint32 event_id;
 
 private:
 	//! \brief Copy constructor is private, because making a copy of a notification object is a \b bad idea.
@@ -84,13 +190,18 @@ private:
 /** ***************************************************************************
 *** \brief Maintains a list of all notifications that have occurred since the last game loop update
 ***
-*** This is a very simple engine class that does little more than maintain a list of NotificationEvent
-*** objects that it provides access to. Once a NotificationEvent object is passed to this function, it
-*** assumes responsibility for making sure that the object gets destroyed appropriately. So you
-*** should never call delete on a NotificationEvent object that is contained in the trigger list for this class.
+*** This engine class maintains a list of NotificationEvent objects that it provides access to. Once a
+*** NotificationEvent object is passed to this function, it assumes responsibility for making sure that the object
+*** gets destroyed appropriately. So you should never call delete on a NotificationEvent object that is contained
+*** in the trigger list for this class.
+***
+*** Code may also subscribe a handler function to a category and event. Each notification is passed to the
+*** handlers of every matching subscription at the moment it is sent, so the subscriber never needs to examine
+*** notifications that it is not interested in.
 ***
 *** \note One way to iterate through all triggers in the list is to simply continue to call GetNotificationEvent()
 *** with increasing index arguments until it returns nullptr, at which case you've reached the end of the list.
+*** This polling interface remains available, but subscriptions should be preferred for new code.
 *** **************************************************************************/
 class NotificationEngine : public hoa_utils::Singleton<NotificationEngine> {
 	friend class hoa_utils::Singleton<NotificationEngine>;
@@ -117,6 +228,49 @@ public:
 	**/
 	void CreateAndNotify(const std::string& category, const std::string& event);
 
+	/** \brief Constructs a notification in the frame's memory arena and immediately sends it
+	*** \param args The arguments to pass to the constructor of the notification
+	*** \return A pointer to the notification, which is valid until the notifications are deleted at the end of the frame
+	***
+	*** This is the preferred way for C++ code to send a notification, since it avoids a heap allocation.
+	**/
+	template <class T, class... Args>
+	T* CreateNotification(Args&&... args);
+
+	/** \brief Registers a function to invoke for every notification with a matching category and event
+	*** \param category_id The ID of the category to match, or NOTIFICATION_ANY to match all categories
+	*** \param event_id The ID of the event to match, or NOTIFICATION_ANY to match all events
+	*** \param handler The function to invoke
+	*** \param owner The game mode that the handler belongs to, or nullptr if the subscription should last until it is cancelled
+	*** \return The ID of the subscription, which is needed to cancel it later
+	***
+	*** A subscription with an owner is cancelled automatically when its game mode is destroyed or parked in the mode pool.
+	*** Handlers that refer to data owned by a game mode, such as the functions of a map script, should always have an owner.
+	**/
+	uint32 Subscribe(uint32 category_id, uint32 event_id, NotificationHandler handler, hoa_mode_manager::GameMode* owner = nullptr);
+
+	//! \brief Performs the same function as above, but for the names of the category and event instead of their IDs
+	uint32 Subscribe(const std::string& category, const std::string& event, NotificationHandler handler,
+		hoa_mode_manager::GameMode* owner = nullptr)
+		{ return Subscribe(InternNotificationName(category), InternNotificationName(event), handler, owner); }
+
+	/** \brief Cancels a subscription so that its handler is no longer invoked
+	*** \param subscription_id The ID of the subscription that was returned by Subscribe()
+	*** \note It is safe to call this function from within a handler
+	**/
+	void Unsubscribe(uint32 subscription_id);
+
+	/** \brief Cancels every subscription owned by a game mode
+	*** \param owner The game mode to cancel the subscriptions of
+	*** \note This is called by the GameMode destructor and when a game mode is parked in the mode pool. There is
+	*** usually no reason to call it anywhere else.
+	**/
+	void ReleaseSubscriptions(hoa_mode_manager::GameMode* owner);
+
+	//! \brief Returns the interned ID of a name. This exists for Lua to be able to retrieve IDs.
+	uint32 GetNotificationID(const std::string& name) const
+		{ return InternNotificationName(name); }
+
 	//! \brief Returns the number of notification events currently stored by the class
 	uint32 GetNotificationCount() const
 		{ return _notification_events.size(); }
@@ -139,6 +293,42 @@ private:
 
 	//! \brief The list of game NotificationEvent objects that have been sent to this class since it was last cleared
 	std::vector<NotificationEvent*> _notification_events;
+
+	//! \brief Holds the notifications created by CreateNotification() until the end of the frame
+	private_notification::NotificationArena _arena;
+
+	//! \brief All active subscriptions, in the order that they were made
+	std::vector<private_notification::NotificationSubscription> _subscriptions;
+
+	//! \brief The ID to assign to the next subscription
+	uint32 _next_subscription_id;
+
+	//! \brief The number of notifications that are currently being passed to subscription handlers
+	uint32 _dispatch_depth;
+
+	//! \brief Set when a subscription is cancelled during a dispatch and needs to be removed once the dispatch finishes
+	bool _cancelled_subscriptions;
+
+	//! \brief Passes a notification to the handler of every matching subscription
+	void _DispatchNotification(NotificationEvent* notification);
+
+	//! \brief Removes all subscriptions that were cancelled while notifications were being dispatched
+	void _RemoveCancelledSubscriptions();
 }; // class NotificationEngine : public hoa_utils::Singleton<NotificationEngine>
 
+
+
+template <class T, class... Args>
+T* NotificationEngine::CreateNotification(Args&&... args) {
+	void* memory = _arena.Allocate(sizeof(T));
+	T* notification = nullptr;
+	if (memory != nullptr)
+		notification = new(memory) T(std::forward<Args>(args)...);
+	else
+		notification = new T(std::forward<Args>(args)...);
+
+	Notify(notification);
+	return notification;
+}
+
 } // namespace hoa_notification
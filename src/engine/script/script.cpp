@@ -16,6 +16,7 @@
 *** ***************************************************************************/
 
 #include <iostream>
+#include <iomanip>
 #include <stdarg.h>
 
 #include "script.h"
@@ -63,11 +64,13 @@ string DetermineLuaFileTablespaceName(const string& filename) {
 // ScriptEngine Class Functions
 //-----------------------------------------------------------------------------
 
-ScriptEngine::ScriptEngine() {
+ScriptEngine::ScriptEngine() :
+	_cache_enabled(false)
+{
 	IF_PRINT_DEBUG(SCRIPT_DEBUG) << "ScriptEngine constructor invoked." << endl;
 
 	// Initialize Lua and LuaBind
-	_global_state = lua_open();
+	_global_state = luaL_newstate();
 	luaL_openlibs(_global_state);
 	luabind::open(_global_state);
 }
@@ -77,6 +80,9 @@ ScriptEngine::ScriptEngine() {
 ScriptEngine::~ScriptEngine() {
 	IF_PRINT_DEBUG(SCRIPT_DEBUG) << "ScriptEngine destructor invoked." << endl;
 
+	if (SCRIPT_DEBUG == true && _cache_statistics.empty() == false)
+		DEBUG_PrintCacheStatistics();
+
 	_open_files.clear();
 	lua_close(_global_state);
 	_global_state = nullptr;
@@ -86,6 +92,20 @@ ScriptEngine::~ScriptEngine() {
 
 bool ScriptEngine::SingletonInitialize() {
 	// TODO: Open the user setting's file and apply those settings
+
+	// Failing to create the cache directory is not an error. Scripts will simply be parsed every time they are loaded.
+	_cache_directory = GetUserDataPath(true) + SCRIPT_CACHE_DIRECTORY;
+	_user_data_paths.clear();
+	_user_data_paths.push_back(GetUserDataPath(true));
+	if (GetUserDataPath(false) != _user_data_paths.front())
+		_user_data_paths.push_back(GetUserDataPath(false));
+	if (DoesFileExist(_cache_directory) == false && MakeDirectory(_cache_directory) == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to create the script cache directory: " << _cache_directory << endl;
+		_cache_enabled = false;
+	}
+	else {
+		_cache_enabled = true;
+	}
 	return true;
 }
 
@@ -148,6 +168,69 @@ void ScriptEngine::HandleCastError(luabind::cast_failed& err) {
 
 
 
+bool ScriptEngine::CompileScriptFile(const string& filename, const string& cache_directory) {
+	string source;
+	if (ReadFileContents(filename, source) == false) {
+		PRINT_ERROR << "failed to read script file: " << filename << endl;
+		return false;
+	}
+
+	ScriptCacheEntry entry;
+	if (GetSourceFileInfo(filename, entry.source_size, entry.source_time, entry.source_time_nanoseconds) == false) {
+		PRINT_ERROR << "failed to retrieve the properties of script file: " << filename << endl;
+		return false;
+	}
+
+	entry.source_name = filename;
+	entry.source_size = static_cast<uint32>(source.size());
+	entry.source_hash = HashScriptSource(source);
+
+	uint32 start_time = GetScriptTimer();
+	if (LoadScriptBuffer(_global_state, source, "@" + filename) != 0) {
+		PRINT_ERROR << "failed to compile script file: " << filename << ", error message:" << endl;
+		cerr << lua_tostring(_global_state, STACK_TOP) << endl;
+		lua_pop(_global_state, 1);
+		return false;
+	}
+	entry.parse_time = GetScriptTimer() - start_time;
+
+	bool dumped = DumpScriptFunction(_global_state, entry.bytecode);
+	lua_pop(_global_state, 1);
+	if (dumped == false) {
+		PRINT_ERROR << "failed to generate bytecode for script file: " << filename << endl;
+		return false;
+	}
+
+	if (entry.WriteFile(GetCacheEntryFilename(cache_directory, filename)) == false) {
+		PRINT_ERROR << "failed to write the cache entry for script file: " << filename << endl;
+		return false;
+	}
+	return true;
+}
+
+
+
+void ScriptEngine::DEBUG_PrintCacheStatistics() {
+	uint32 total_loads = 0;
+	uint32 total_hits = 0;
+	int32 total_saved = 0;
+
+	cout << "Script cache statistics (times in microseconds)" << endl;
+	cout << setw(8) << "loads" << setw(8) << "hits" << setw(10) << "parse" << setw(10) << "load" << setw(10) << "saved" << "  file" << endl;
+	for (map<string, ScriptCacheStatistics>::iterator i = _cache_statistics.begin(); i != _cache_statistics.end(); ++i) {
+		const ScriptCacheStatistics& statistics = i->second;
+		cout << setw(8) << statistics.loads << setw(8) << statistics.cache_hits << setw(10) << statistics.parse_time
+			<< setw(10) << statistics.load_time << setw(10) << statistics.GetTimeSaved() << "  " << i->first << endl;
+
+		total_loads += statistics.loads;
+		total_hits += statistics.cache_hits;
+		total_saved += statistics.GetTimeSaved();
+	}
+	cout << "Total: " << total_loads << " loads, " << total_hits << " cache hits, " << total_saved << " microseconds saved" << endl;
+}
+
+
+
 void ScriptEngine::_AddOpenFile(ScriptDescriptor* sd) {
 	// NOTE: This function assumes that the file is not already open
 
@@ -169,6 +252,109 @@ void ScriptEngine::_RemoveOpenFile(ScriptDescriptor* sd) {
 
 
 
+int32 ScriptEngine::_LoadScriptFile(lua_State* lstack, const string& filename) {
+	// Saved games and settings are rewritten while the game runs and are only read a few times, so they are never cached
+	if (_cache_enabled == false || _IsUserDataFile(filename) == true)
+		return luaL_loadfile(lstack, filename.c_str());
+
+	// If the file can not be found, let Lua generate the error message
+	uint32 source_size = 0;
+	uint32 source_time = 0;
+	uint32 source_time_nanoseconds = 0;
+	if (GetSourceFileInfo(filename, source_size, source_time, source_time_nanoseconds) == false)
+		return luaL_loadfile(lstack, filename.c_str());
+
+	string entry_filename = GetCacheEntryFilename(_cache_directory, filename);
+	ScriptCacheStatistics& statistics = _cache_statistics[filename];
+	statistics.loads++;
+
+	// When the size and modification time of the source match the entry, the source file does not need to be read at all
+	ScriptCacheEntry entry;
+	bool user_entry_found = entry.ReadFile(entry_filename, filename);
+	if (user_entry_found == true && entry.source_size == source_size && entry.source_time == source_time &&
+		entry.source_time_nanoseconds == source_time_nanoseconds)
+	{
+		if (_LoadCacheEntry(lstack, entry, statistics) == true)
+			return 0;
+	}
+
+	string source;
+	if (ReadFileContents(filename, source) == false)
+		return luaL_loadfile(lstack, filename.c_str());
+
+	// Files that are already compiled (.hoa) gain nothing from the cache
+	if (source.empty() == false && source[0] == LUA_SIGNATURE[0])
+		return LoadScriptBuffer(lstack, source, "@" + filename);
+
+	// The modification time changes when files are copied or installed, so the contents of the source must be compared
+	// instead. An entry in the installed cache directory is checked when the user's cache does not have a matching entry.
+	uint32 source_hash = HashScriptSource(source);
+	bool entry_matches = (user_entry_found == true && entry.source_size == source_size && entry.source_hash == source_hash);
+	if (entry_matches == false && entry.ReadFile(GetCacheEntryFilename(SCRIPT_CACHE_DIRECTORY, filename), filename) == true) {
+		entry_matches = (entry.source_size == source_size && entry.source_hash == source_hash);
+	}
+
+	if (entry_matches == true && _LoadCacheEntry(lstack, entry, statistics) == true) {
+		// Rewrite the entry with the new modification time so that the next load can skip reading the source file
+		entry.source_time = source_time;
+		entry.source_time_nanoseconds = source_time_nanoseconds;
+		entry.WriteFile(entry_filename);
+		return 0;
+	}
+
+	// There is no usable entry for this file, so the source must be parsed and a new entry generated
+	uint32 start_time = GetScriptTimer();
+	int32 result = LoadScriptBuffer(lstack, source, "@" + filename);
+	if (result != 0)
+		return result;
+
+	entry.source_name = filename;
+	entry.source_size = source_size;
+	entry.source_time = source_time;
+	entry.source_time_nanoseconds = source_time_nanoseconds;
+	entry.source_hash = source_hash;
+	entry.parse_time = GetScriptTimer() - start_time;
+	statistics.parse_time = entry.parse_time;
+	if (DumpScriptFunction(lstack, entry.bytecode) == true) {
+		entry.WriteFile(entry_filename);
+	}
+	else {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to generate bytecode for script file: " << filename << endl;
+	}
+	return 0;
+} // int32 ScriptEngine::_LoadScriptFile(lua_State* lstack, const string& filename)
+
+
+
+bool ScriptEngine::_IsUserDataFile(const string& filename) const {
+	for (uint32 i = 0; i < _user_data_paths.size(); ++i) {
+		if (filename.compare(0, _user_data_paths[i].size(), _user_data_paths[i]) == 0)
+			return true;
+	}
+	return false;
+}
+
+
+
+bool ScriptEngine::_LoadCacheEntry(lua_State* lstack, const ScriptCacheEntry& entry, ScriptCacheStatistics& statistics) {
+	uint32 start_time = GetScriptTimer();
+	// The chunk name stored in the bytecode is used for error messages, so the name given here is never seen
+	if (LoadScriptBuffer(lstack, entry.bytecode, "=" + entry.source_name) != 0) {
+		// This happens if the entry was generated by a different version of Lua. It will be replaced by a new entry.
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to load cache entry for script file: " << entry.source_name << ", error message: "
+			<< lua_tostring(lstack, STACK_TOP) << endl;
+		lua_pop(lstack, 1);
+		return false;
+	}
+
+	statistics.cache_hits++;
+	statistics.load_time += GetScriptTimer() - start_time;
+	statistics.parse_time = entry.parse_time;
+	return true;
+}
+
+
+
 lua_State *ScriptEngine::_CheckForPreviousLuaState(const std::string &filename) {
 	return nullptr; // TEMP, see todo notes in script.h
 
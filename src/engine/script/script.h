@@ -44,6 +44,8 @@ extern "C" {
 #include "utils.h"
 #include "defs.h"
 
+#include "script_cache.h"
+
 //! \brief All calls to the scripting engine are wrapped in this namespace.
 namespace hoa_script {
 
@@ -272,6 +274,29 @@ public:
 	**/
 	void HandleCastError(luabind::cast_failed& err);
 
+	/** \brief Compiles a Lua source file and writes its bytecode to a cache directory
+	*** \param filename The name of the Lua source file to compile
+	*** \param cache_directory The directory to write the cache entry to, including the trailing slash
+	*** \return True if the file was compiled and its cache entry was written successfully
+	***
+	*** This is used to precompile all of the game's scripts when the game is installed, so that
+	*** even the first time a script is loaded it does not need to be parsed. The source is only
+	*** compiled, not executed, so the rest of the engine does not need to be initialized.
+	**/
+	bool CompileScriptFile(const std::string& filename, const std::string& cache_directory);
+
+	/** \brief Prints how much parsing time the bytecode cache has saved for every file loaded so far
+	*** This is printed automatically when the engine is destroyed if script debugging is enabled.
+	**/
+	void DEBUG_PrintCacheStatistics();
+
+	//! \brief When disabled, every script file is loaded and parsed from its source
+	void SetCacheEnabled(bool enabled)
+		{ _cache_enabled = enabled; }
+
+	bool IsCacheEnabled() const
+		{ return _cache_enabled; }
+
 private:
 	ScriptEngine();
 
@@ -290,6 +315,45 @@ private:
 	//! \brief The lua state shared globally by all files
 	lua_State* _global_state;
 
+	//! \brief True when script files should be loaded through the bytecode cache
+	bool _cache_enabled;
+
+	//! \brief The directory under the user data path where cache entries are read from and written to
+	std::string _cache_directory;
+
+	/** \brief The directories that hold the user's saved games and settings
+	*** Files in these directories are rewritten by the game and are never loaded through the cache.
+	**/
+	std::vector<std::string> _user_data_paths;
+
+	//! \brief Cache statistics for every script file that has been loaded, indexed by filename
+	std::map<std::string, private_script::ScriptCacheStatistics> _cache_statistics;
+
+	/** \brief Loads a script file as a Lua chunk, using the bytecode cache whenever possible
+	*** \param lstack The Lua state to load the chunk into
+	*** \param filename The name of the script file to load
+	*** \return Zero on success, in which case the chunk is pushed on to the stack as a function.
+	*** Otherwise an error message is pushed on to the stack in its place.
+	***
+	*** This is used in place of luaL_loadfile() by the descriptors that open script files. Cache entries
+	*** are first searched for in the user's cache directory, then in the cache directory that may have
+	*** been installed with the game. A source file that has no valid entry is parsed and a new entry is
+	*** written for it in the user's cache directory. Files in the user data directories are always
+	*** loaded from their source.
+	**/
+	int32 _LoadScriptFile(lua_State* lstack, const std::string& filename);
+
+	/** \brief Loads the bytecode stored in a cache entry
+	*** \param lstack The Lua state to load the chunk into
+	*** \param entry The cache entry to load
+	*** \param statistics The statistics of the entry's source file to update
+	*** \return True if the bytecode was loaded. On failure nothing is left on the stack.
+	**/
+	bool _LoadCacheEntry(lua_State* lstack, const private_script::ScriptCacheEntry& entry, private_script::ScriptCacheStatistics& statistics);
+
+	//! \brief Returns true if the file resides in one of the user data directories
+	bool _IsUserDataFile(const std::string& filename) const;
+
 	//! \brief Adds an open file to the list of open files
 	void _AddOpenFile(ScriptDescriptor* sd);
 
@@ -0,0 +1,251 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_cache.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for the Lua bytecode cache
+*** ***************************************************************************/
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+
+#include "utils.h"
+
+#include "script.h"
+#include "script_cache.h"
+
+using namespace std;
+
+using namespace hoa_utils;
+
+namespace hoa_script {
+
+namespace private_script {
+
+namespace {
+
+//! \brief The state passed to the lua_load() reader function
+struct ScriptBufferReader {
+	const char* data;
+	size_t size;
+};
+
+//! \brief Gives Lua the entire buffer on the first call and signals the end of the chunk on the next
+const char* ReadScriptBuffer(lua_State* lstack, void* data, size_t* size) {
+	ScriptBufferReader* reader = static_cast<ScriptBufferReader*>(data);
+	if (reader->size == 0) {
+		*size = 0;
+		return nullptr;
+	}
+
+	const char* buffer = reader->data;
+	*size = reader->size;
+	reader->size = 0;
+	return buffer;
+}
+
+
+
+//! \brief Appends each block of bytecode that lua_dump() produces to a string
+int WriteScriptBuffer(lua_State* lstack, const void* data, size_t size, void* buffer) {
+	static_cast<string*>(buffer)->append(static_cast<const char*>(data), size);
+	return 0;
+}
+
+
+
+//! \brief Appends a 32-bit value to an entry buffer
+void AppendEntryValue(string& buffer, uint32 value) {
+	buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+
+
+//! \brief Reads a 32-bit value from an entry buffer, advancing the offset past it
+bool ReadEntryValue(const string& buffer, size_t& offset, uint32& value) {
+	if (buffer.size() - offset < sizeof(value))
+		return false;
+
+	memcpy(&value, buffer.data() + offset, sizeof(value));
+	offset += sizeof(value);
+	return true;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// ScriptCacheEntry Class Functions
+//-----------------------------------------------------------------------------
+
+bool ScriptCacheEntry::ReadFile(const string& entry_filename, const string& source_name) {
+	string buffer;
+	if (ReadFileContents(entry_filename, buffer) == false)
+		return false;
+
+	if (buffer.compare(0, SCRIPT_CACHE_SIGNATURE.size(), SCRIPT_CACHE_SIGNATURE) != 0) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "cache entry file had an invalid signature: " << entry_filename << endl;
+		return false;
+	}
+
+	size_t offset = SCRIPT_CACHE_SIGNATURE.size();
+	uint32 name_length = 0;
+	uint32 bytecode_length = 0;
+	if (ReadEntryValue(buffer, offset, source_size) == false || ReadEntryValue(buffer, offset, source_time) == false ||
+		ReadEntryValue(buffer, offset, source_time_nanoseconds) == false || ReadEntryValue(buffer, offset, source_hash) == false || ReadEntryValue(buffer, offset, parse_time) == false ||
+		ReadEntryValue(buffer, offset, name_length) == false || buffer.size() - offset < name_length)
+	{
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "cache entry file was truncated: " << entry_filename << endl;
+		return false;
+	}
+
+	// Different source files may map to the same entry filename, so the entry must name the exact source file
+	if (buffer.compare(offset, name_length, source_name) != 0)
+		return false;
+	offset += name_length;
+
+	if (ReadEntryValue(buffer, offset, bytecode_length) == false || buffer.size() - offset != bytecode_length) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "cache entry file was truncated: " << entry_filename << endl;
+		return false;
+	}
+
+	this->source_name = source_name;
+	bytecode.assign(buffer, offset, bytecode_length);
+	return true;
+}
+
+
+
+bool ScriptCacheEntry::WriteFile(const string& entry_filename) const {
+	string buffer = SCRIPT_CACHE_SIGNATURE;
+	buffer.reserve(SCRIPT_CACHE_SIGNATURE.size() + 7 * sizeof(uint32) + source_name.size() + bytecode.size());
+	AppendEntryValue(buffer, source_size);
+	AppendEntryValue(buffer, source_time);
+	AppendEntryValue(buffer, source_time_nanoseconds);
+	AppendEntryValue(buffer, source_hash);
+	AppendEntryValue(buffer, parse_time);
+	AppendEntryValue(buffer, static_cast<uint32>(source_name.size()));
+	buffer.append(source_name);
+	AppendEntryValue(buffer, static_cast<uint32>(bytecode.size()));
+	buffer.append(bytecode);
+
+	// The entry is written to a temporary file first so that an interrupted write never leaves a partial entry behind
+	string temporary_filename = entry_filename + ".tmp";
+	ofstream file(temporary_filename.c_str(), ios::out | ios::binary | ios::trunc);
+	if (file.is_open() == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to open cache entry file for writing: " << temporary_filename << endl;
+		return false;
+	}
+
+	file.write(buffer.data(), buffer.size());
+	file.close();
+	if (file.fail() == true) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to write cache entry file: " << temporary_filename << endl;
+		DeleteFile(temporary_filename);
+		return false;
+	}
+
+	if (MoveFile(temporary_filename, entry_filename) == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed to replace cache entry file: " << entry_filename << endl;
+		DeleteFile(temporary_filename);
+		return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Cache Utility Functions
+//-----------------------------------------------------------------------------
+
+string GetCacheEntryFilename(const string& directory, const string& source_name) {
+	string entry_name = source_name;
+	for (uint32 i = 0; i < entry_name.size(); ++i) {
+		if (entry_name[i] == '/' || entry_name[i] == '\\' || entry_name[i] == ':')
+			entry_name[i] = '_';
+	}
+	return directory + entry_name + SCRIPT_CACHE_EXTENSION;
+}
+
+
+
+bool GetSourceFileInfo(const string& filename, uint32& size, uint32& time, uint32& time_nanoseconds) {
+	struct stat source_info;
+	if (stat(filename.c_str(), &source_info) != 0)
+		return false;
+
+	size = static_cast<uint32>(source_info.st_size);
+	time = static_cast<uint32>(source_info.st_mtime);
+#if defined(__MACH__)
+	time_nanoseconds = static_cast<uint32>(source_info.st_mtimespec.tv_nsec);
+#elif defined(_WIN32)
+	time_nanoseconds = 0;
+#else
+	time_nanoseconds = static_cast<uint32>(source_info.st_mtim.tv_nsec);
+#endif
+	return true;
+}
+
+
+
+bool ReadFileContents(const string& filename, string& contents) {
+	ifstream file(filename.c_str(), ios::in | ios::binary);
+	if (file.is_open() == false)
+		return false;
+
+	file.seekg(0, ios::end);
+	streamoff size = file.tellg();
+	if (size < 0)
+		return false;
+	file.seekg(0, ios::beg);
+
+	contents.resize(static_cast<size_t>(size));
+	if (size > 0)
+		file.read(&contents[0], size);
+	return (file.fail() == false);
+}
+
+
+
+uint32 HashScriptSource(const string& source) {
+	uint32 hash = 2166136261u;
+	for (size_t i = 0; i < source.size(); ++i) {
+		hash ^= static_cast<uint8>(source[i]);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+
+
+int32 LoadScriptBuffer(lua_State* lstack, const string& buffer, const string& chunk_name) {
+	ScriptBufferReader reader;
+	reader.data = buffer.data();
+	reader.size = buffer.size();
+	return lua_load(lstack, ReadScriptBuffer, &reader, chunk_name.c_str());
+}
+
+
+
+bool DumpScriptFunction(lua_State* lstack, string& bytecode) {
+	bytecode.clear();
+	return (lua_dump(lstack, WriteScriptBuffer, &bytecode) == 0 && bytecode.empty() == false);
+}
+
+
+
+uint32 GetScriptTimer() {
+	return static_cast<uint32>(chrono::duration_cast<chrono::microseconds>(
+		chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace private_script
+
+} // namespace hoa_script
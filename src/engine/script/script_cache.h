@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    script_cache.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for the Lua bytecode cache
+***
+*** Parsing a Lua source file is a significant portion of the time it takes to
+*** open it. The script engine compiles every source file it loads to Lua bytecode
+*** and stores the bytecode in a cache entry file. The next time the same file is
+*** loaded, the bytecode is loaded instead of the source as long as the source
+*** has not changed since the entry was written.
+*** ***************************************************************************/
+
+#pragma once
+
+extern "C" {
+	#include <lua.h>
+}
+
+#include "utils.h"
+
+namespace hoa_script {
+
+namespace private_script {
+
+//! \brief The name of the cache directory, both under the user data path and in the game's data directory
+const std::string SCRIPT_CACHE_DIRECTORY = "script_cache/";
+
+//! \brief The extension appended to the name of every cache entry file
+const std::string SCRIPT_CACHE_EXTENSION = ".luac";
+
+/** \brief Identifies a cache entry file and the version of its layout. Changing the layout requires changing this value.
+*** LuaJIT bytecode is incompatible with the bytecode of the standard interpreter, so each uses a different signature.
+**/
+#ifdef USE_LUAJIT
+const std::string SCRIPT_CACHE_SIGNATURE = "HOALJC02";
+#else
+const std::string SCRIPT_CACHE_SIGNATURE = "HOALUAC2";
+#endif
+
+/** ****************************************************************************
+*** \brief Keeps track of how much time the bytecode cache has saved for a single script file
+*** ***************************************************************************/
+class ScriptCacheStatistics {
+public:
+	ScriptCacheStatistics() :
+		loads(0), cache_hits(0), parse_time(0), load_time(0) {}
+
+	//! \brief The number of times that the script file was loaded
+	uint32 loads;
+
+	//! \brief The number of times that the script file was loaded from its bytecode instead of its source
+	uint32 cache_hits;
+
+	//! \brief The number of microseconds it took to parse the source of the file when its bytecode was generated
+	uint32 parse_time;
+
+	//! \brief The total number of microseconds spent loading the bytecode of the file for all cache hits
+	uint32 load_time;
+
+	//! \brief Returns the number of microseconds saved by loading bytecode instead of parsing the source on every cache hit
+	int32 GetTimeSaved() const
+		{ return static_cast<int32>(cache_hits * parse_time) - static_cast<int32>(load_time); }
+}; // class ScriptCacheStatistics
+
+
+/** ****************************************************************************
+*** \brief The contents of a single bytecode cache entry file
+***
+*** An entry records the name, size, modification time, and a hash of the source file
+*** that its bytecode was compiled from. An entry is valid for a source file when the size
+*** and modification time both match. The modification time includes nanoseconds where the
+*** system provides them, so that a file rewritten within the same second is still noticed.
+*** When only the modification time differs, which happens when the game files are copied or
+*** installed, the entry is still valid if the hash of the source contents matches.
+***
+*** \note The bytecode and the entry layout use the native byte order and type sizes of the
+*** machine that wrote them, which is fine because Lua bytecode is not portable either. An
+*** entry that can not be loaded is simply replaced.
+*** ***************************************************************************/
+class ScriptCacheEntry {
+public:
+	ScriptCacheEntry() :
+		source_size(0), source_time(0), source_time_nanoseconds(0), source_hash(0), parse_time(0) {}
+
+	/** \brief Reads the cache entry for a source file
+	*** \param entry_filename The name of the cache entry file to read
+	*** \param source_name The name of the source file that the entry is expected to belong to
+	*** \return True if the entry was read successfully and belongs to the source file
+	**/
+	bool ReadFile(const std::string& entry_filename, const std::string& source_name);
+
+	/** \brief Writes the entry to a file, replacing any previous entry once the write is complete
+	*** \param entry_filename The name of the cache entry file to write
+	*** \return True if the entry was written successfully
+	**/
+	bool WriteFile(const std::string& entry_filename) const;
+
+	//! \brief The name of the source file that the bytecode was compiled from
+	std::string source_name;
+
+	//! \brief The size of the source file, in bytes
+	uint32 source_size;
+
+	//! \brief The last modification time of the source file, in seconds
+	uint32 source_time;
+
+	//! \brief The fraction of a second of the last modification time, or zero if the system does not provide it
+	uint32 source_time_nanoseconds;
+
+	//! \brief A hash of the contents of the source file
+	uint32 source_hash;
+
+	//! \brief The number of microseconds it took to parse the source file
+	uint32 parse_time;
+
+	//! \brief The compiled bytecode of the source file
+	std::string bytecode;
+}; // class ScriptCacheEntry
+
+
+/** \brief Returns the name of the cache entry file for a source file
+*** \param directory The cache directory that the entry resides in, including the trailing slash
+*** \param source_name The name of the source file
+**/
+std::string GetCacheEntryFilename(const std::string& directory, const std::string& source_name);
+
+/** \brief Retrieves the size and last modification time of a source file
+*** \param filename The name of the source file
+*** \param size A reference to hold the size of the file, in bytes
+*** \param time A reference to hold the modification time of the file, in seconds
+*** \param time_nanoseconds A reference to hold the fraction of a second of the modification time
+*** \return False if the properties of the file could not be retrieved, which usually means that it does not exist
+***
+*** Systems that do not record the fraction of a second, such as Windows, always report zero nanoseconds.
+**/
+bool GetSourceFileInfo(const std::string& filename, uint32& size, uint32& time, uint32& time_nanoseconds);
+
+/** \brief Reads the entire contents of a file
+*** \param filename The name of the file to read
+*** \param contents A reference to the string to hold the contents of the file
+*** \return True if the file was read successfully
+**/
+bool ReadFileContents(const std::string& filename, std::string& contents);
+
+//! \brief Computes the 32-bit FNV-1a hash of the contents of a source file
+uint32 HashScriptSource(const std::string& source);
+
+/** \brief Loads a Lua chunk, either source or bytecode, from a buffer in memory
+*** \param lstack The Lua state to load the chunk into
+*** \param buffer The source or bytecode of the chunk
+*** \param chunk_name The name of the chunk to use in error messages, typically "@" followed by the filename
+*** \return The result of lua_load(), which is zero on success
+***
+*** On success the loaded chunk is pushed on to the stack as a function. On failure an error message
+*** is pushed on to the stack instead.
+**/
+int32 LoadScriptBuffer(lua_State* lstack, const std::string& buffer, const std::string& chunk_name);
+
+/** \brief Dumps the function on the top of the stack to bytecode
+*** \param lstack The Lua state that holds the function
+*** \param bytecode A reference to the string to hold the bytecode
+*** \return True if the function was dumped successfully
+**/
+bool DumpScriptFunction(lua_State* lstack, std::string& bytecode);
+
+//! \brief Returns the number of microseconds that have elapsed since an arbitrary fixed point in time
+uint32 GetScriptTimer();
+
+} // namespace private_script
+
+} // namespace hoa_script
@@ -73,7 +73,7 @@ bool ReadScriptDescriptor::OpenFile(const string& filename, bool force_reload) {
 		_lstack = lua_newthread(ScriptManager->GetGlobalState());
 
 		// Attempt to load and execute the Lua file
-		if (luaL_loadfile(_lstack, file_name.c_str()) != 0 || lua_pcall(_lstack, 0, 0, 0)) {
+		if (ScriptManager->_LoadScriptFile(_lstack, file_name) != 0 || lua_pcall(_lstack, 0, 0, 0)) {
 			PRINT_ERROR << "could not open script file: " << file_name << ", error message:" << endl;
 			cerr << lua_tostring(_lstack, private_script::STACK_TOP) << endl;
 			_access_mode = SCRIPT_CLOSED;
@@ -423,18 +423,20 @@ uint32 ReadScriptDescriptor::GetTableSize() {
 	// lua returns 0 on table sizes in a couple situations
 	// 1. the indexes don't start from what lua expects
 	// 2. a hash table instead of an array table.
-	// So we'll just count the table size ourselves
-	object o(from_stack(_lstack, STACK_TOP));
-
-	if (type(o) != LUA_TTABLE)
-	{
+	// So we'll just count the table size ourselves. This is done with the raw Lua API because creating a luabind
+	// object for every key and value is far more expensive than the iteration itself.
+	if (lua_istable(_lstack, STACK_TOP) == false) {
 		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed because the top of the stack is not a table." << endl;
 		return 0;
 	}
 
+	int32 table_index = lua_gettop(_lstack);
 	uint32 table_size = 0;
-	for (luabind::iterator i(o); i != private_script::TABLE_END; ++i)
+	lua_pushnil(_lstack);
+	while (lua_next(_lstack, table_index) != 0) {
 		table_size++;
+		lua_pop(_lstack, 1); // Only the key remains on the stack for the next iteration
+	}
 
 	return table_size;
 }
@@ -38,6 +38,26 @@ const int32 UINTEGER_TYPE   = 0x87654321;
 const int32 FLOAT_TYPE      = 0x12344321;
 //@}
 
+/** \name Stack Number Conversion Functions
+*** \brief Converts the number at a stack index to a C++ type
+*** \param lstack The Lua stack that holds the number
+*** \param index The index of the number on the stack
+*** \param value A reference to hold the converted number
+***
+*** These perform exactly the same conversion that luabind::object_cast() does for each type, so that
+*** values read through the bulk read functions are identical to values read through luabind.
+**/
+//@{
+inline void ConvertStackNumber(lua_State* lstack, int32 index, int32& value)
+	{ value = static_cast<int32>(lua_tointeger(lstack, index)); }
+
+inline void ConvertStackNumber(lua_State* lstack, int32 index, uint32& value)
+	{ value = static_cast<uint32>(lua_tointeger(lstack, index)); }
+
+inline void ConvertStackNumber(lua_State* lstack, int32 index, float& value)
+	{ value = static_cast<float>(lua_tonumber(lstack, index)); }
+//@}
+
 } // namespace private_script
 
 /** ****************************************************************************
@@ -251,6 +271,60 @@ public:
 		{ _ReadDataVector<hoa_utils::ustring>(key, vect); }
 	//@}
 
+	/** \name Array Read Functions
+	*** \brief These functions copy the numeric elements of a table directly into a buffer provided by the caller
+	*** \param key The name or numeric id of the table to read the elements of
+	*** \param buffer A pointer to the first element of the buffer to write to
+	*** \param buffer_size The maximum number of elements that the buffer can hold
+	*** \return The number of elements that were written to the buffer
+	***
+	*** The table is assumed to be <b>closed</b>, just as it is for the vector read functions. Only the elements
+	*** with the keys 1 through n are read, which is how Lua stores the elements of a table constructor such
+	*** as "{ 1, 2, 3 }". No memory is allocated, which makes these functions the best choice for reading
+	*** large amounts of data such as the tiles of a map.
+	***
+	*** \note The integer keys are only valid for tables that are elements of a parent table.
+	**/
+	//@{
+	uint32 ReadIntArray(const std::string& key, int32* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+
+	uint32 ReadIntArray(int32 key, int32* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+
+	uint32 ReadUIntArray(const std::string& key, uint32* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+
+	uint32 ReadUIntArray(int32 key, uint32* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+
+	uint32 ReadFloatArray(const std::string& key, float* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+
+	uint32 ReadFloatArray(int32 key, float* buffer, uint32 buffer_size)
+		{ return _ReadNumberArray(key, buffer, buffer_size); }
+	//@}
+
+	/** \name Grid Read Functions
+	*** \brief These functions read a two-dimensional table of numbers into a single row-major vector
+	*** \param key The name of the (un-opened) table that contains the rows of the grid
+	*** \param grid A reference to the vector to hold the grid. It is cleared before the grid is read.
+	*** \param num_rows A reference to hold the number of rows that were read
+	*** \param num_columns A reference to hold the number of columns in each row
+	*** \return True if the grid was read successfully. The grid is left empty if it was not.
+	***
+	*** The grid format is the one written by WriteScriptDescriptor::WriteIntGrid(): each row is an array table
+	*** stored at consecutive integer keys starting from zero. Rows that start from one are accepted as well.
+	*** Every row must have the same number of columns as the first.
+	**/
+	//@{
+	bool ReadIntGrid(const std::string& key, std::vector<int32>& grid, uint32& num_rows, uint32& num_columns)
+		{ return _ReadNumberGrid(key, grid, num_rows, num_columns); }
+
+	bool ReadUIntGrid(const std::string& key, std::vector<uint32>& grid, uint32& num_rows, uint32& num_columns)
+		{ return _ReadNumberGrid(key, grid, num_rows, num_columns); }
+	//@}
+
 	/** \name Function Pointer Read Functions
 	*** \param key The name of the function if it is contained in the global space, or the key
 	*** if the function is embedded in a table.
@@ -447,6 +521,39 @@ protected:
 	template <class T> void _ReadDataVector(int32 key, std::vector<T>& vect);
 	//! \brief This template method is a helper function for the other two
 	template <class T> void _ReadDataVectorHelper(std::vector<T>& vect);
+
+	/** \brief Numeric vectors are read with these overloads, which are preferred over the template above
+	*** Tables with an array part are read directly from the Lua stack into the vector. Other tables fall back
+	*** to iterating through every element of the table.
+	**/
+	void _ReadDataVectorHelper(std::vector<int32>& vect)
+		{ _ReadNumberVectorHelper(vect); }
+
+	void _ReadDataVectorHelper(std::vector<uint32>& vect)
+		{ _ReadNumberVectorHelper(vect); }
+
+	void _ReadDataVectorHelper(std::vector<float>& vect)
+		{ _ReadNumberVectorHelper(vect); }
+
+	template <class T> void _ReadNumberVectorHelper(std::vector<T>& vect);
+	//@}
+
+	/** \name Bulk Numeric Read Templates
+	*** \brief These template functions are called by the public ReadTYPEArray and ReadTYPEGrid functions of this class.
+	**/
+	//@{
+	template <class T> uint32 _ReadNumberArray(const std::string& key, T* buffer, uint32 buffer_size);
+	template <class T> uint32 _ReadNumberArray(int32 key, T* buffer, uint32 buffer_size);
+	//! \brief This template method is a helper function for the other two
+	template <class T> uint32 _ReadNumberArrayHelper(const std::string& key, T* buffer, uint32 buffer_size);
+	template <class T> bool _ReadNumberGrid(const std::string& key, std::vector<T>& grid, uint32& num_rows, uint32& num_columns);
+
+	/** \brief Reads the elements of the array table on the top of the stack
+	*** \param buffer A pointer to the buffer to write the elements to
+	*** \param count The number of elements to read, starting from the key 1
+	*** \return The number of elements written to the buffer. Elements that are not numbers are skipped.
+	**/
+	template <class T> uint32 _ReadNumberSequence(T* buffer, uint32 count);
 	//@}
 
 	/** \name Table Key Template
@@ -578,6 +685,154 @@ template <class T> void ReadScriptDescriptor::_ReadDataVectorHelper(std::vector<
 
 
 
+template <class T> void ReadScriptDescriptor::_ReadNumberVectorHelper(std::vector<T>& vect) {
+	if (lua_istable(_lstack, private_script::STACK_TOP) == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed because the top of the stack was not a table" << std::endl;
+		return;
+	}
+
+	// A table without an array part, such as one that starts from a zero index, must have all of its elements iterated through
+	uint32 size = static_cast<uint32>(lua_objlen(_lstack, private_script::STACK_TOP));
+	if (size == 0) {
+		_ReadDataVectorHelper<T>(vect);
+		return;
+	}
+
+	size_t start = vect.size();
+	vect.resize(start + size);
+	vect.resize(start + _ReadNumberSequence(&vect[start], size));
+} // template <class T> void ReadScriptDescriptor::_ReadNumberVectorHelper(std::vector<T>& vect)
+
+
+
+template <class T> uint32 ReadScriptDescriptor::_ReadNumberArray(const std::string& key, T* buffer, uint32 buffer_size) {
+	OpenTable(key);
+	uint32 count = _ReadNumberArrayHelper(key, buffer, buffer_size);
+	CloseTable();
+	return count;
+} // template <class T> uint32 ReadScriptDescriptor::_ReadNumberArray(const std::string& key, T* buffer, uint32 buffer_size)
+
+
+
+template <class T> uint32 ReadScriptDescriptor::_ReadNumberArray(int32 key, T* buffer, uint32 buffer_size) {
+	if (_open_tables.size() == 0) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed because no tables were open when trying to access the table variable: "
+			<< key << std::endl;
+		return 0;
+	}
+
+	OpenTable(key);
+	uint32 count = _ReadNumberArrayHelper(hoa_utils::NumberToString(key), buffer, buffer_size);
+	CloseTable();
+	return count;
+} // template <class T> uint32 ReadScriptDescriptor::_ReadNumberArray(int32 key, T* buffer, uint32 buffer_size)
+
+
+
+template <class T> uint32 ReadScriptDescriptor::_ReadNumberArrayHelper(const std::string& key, T* buffer, uint32 buffer_size) {
+	if (lua_istable(_lstack, private_script::STACK_TOP) == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed because the top of the stack was not a table" << std::endl;
+		return 0;
+	}
+
+	uint32 size = static_cast<uint32>(lua_objlen(_lstack, private_script::STACK_TOP));
+	if (size > buffer_size) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "table " << key << " had " << size << " elements, more than the buffer size of "
+			<< buffer_size << std::endl;
+		size = buffer_size;
+	}
+	return _ReadNumberSequence(buffer, size);
+} // template <class T> uint32 ReadScriptDescriptor::_ReadNumberArrayHelper(const std::string& key, T* buffer, uint32 buffer_size)
+
+
+
+template <class T> bool ReadScriptDescriptor::_ReadNumberGrid(const std::string& key, std::vector<T>& grid, uint32& num_rows, uint32& num_columns) {
+	grid.clear();
+	num_rows = 0;
+	num_columns = 0;
+
+	OpenTable(key);
+	if (lua_istable(_lstack, private_script::STACK_TOP) == false) {
+		IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed because the top of the stack was not a table" << std::endl;
+		CloseTable();
+		return false;
+	}
+
+	bool success = true;
+	int32 table_index = lua_gettop(_lstack);
+	lua_rawgeti(_lstack, table_index, 0);
+	int32 first_row = lua_isnil(_lstack, private_script::STACK_TOP) ? 1 : 0;
+	lua_pop(_lstack, 1);
+
+	for (int32 r = first_row; success == true; ++r) {
+		lua_rawgeti(_lstack, table_index, r);
+		if (lua_isnil(_lstack, private_script::STACK_TOP)) {
+			lua_pop(_lstack, 1);
+			break;
+		}
+
+		if (lua_istable(_lstack, private_script::STACK_TOP) == false) {
+			IF_PRINT_WARNING(SCRIPT_DEBUG) << "row " << r << " of grid " << key << " was not a table" << std::endl;
+			success = false;
+		}
+		else {
+			uint32 row_size = static_cast<uint32>(lua_objlen(_lstack, private_script::STACK_TOP));
+			if (num_rows == 0) {
+				// The length of the table of rows does not count a row at index zero
+				num_columns = row_size;
+				grid.reserve((lua_objlen(_lstack, table_index) + 1 - first_row) * num_columns);
+			}
+
+			if (row_size != num_columns || row_size == 0) {
+				IF_PRINT_WARNING(SCRIPT_DEBUG) << "row " << r << " of grid " << key << " had " << row_size
+					<< " columns instead of " << num_columns << std::endl;
+				success = false;
+			}
+			else {
+				size_t offset = grid.size();
+				grid.resize(offset + num_columns);
+				if (_ReadNumberSequence(&grid[offset], num_columns) != num_columns) {
+					IF_PRINT_WARNING(SCRIPT_DEBUG) << "row " << r << " of grid " << key << " contained elements that were not numbers" << std::endl;
+					success = false;
+				}
+				++num_rows;
+			}
+		}
+		lua_pop(_lstack, 1);
+	}
+	CloseTable();
+
+	if (success == false) {
+		grid.clear();
+		num_rows = 0;
+		num_columns = 0;
+	}
+	return success;
+} // template <class T> bool ReadScriptDescriptor::_ReadNumberGrid(const std::string& key, std::vector<T>& grid, uint32& num_rows, uint32& num_columns)
+
+
+
+template <class T> uint32 ReadScriptDescriptor::_ReadNumberSequence(T* buffer, uint32 count) {
+	int32 table_index = lua_gettop(_lstack);
+	uint32 num_read = 0;
+
+	for (uint32 i = 1; i <= count; ++i) {
+		lua_rawgeti(_lstack, table_index, i);
+		if (lua_type(_lstack, private_script::STACK_TOP) == LUA_TNUMBER) {
+			private_script::ConvertStackNumber(_lstack, private_script::STACK_TOP, buffer[num_read]);
+			++num_read;
+		}
+		else {
+			IF_PRINT_WARNING(SCRIPT_DEBUG) << "failed due to a type cast failure when reading the table" << std::endl;
+		}
+		lua_pop(_lstack, 1);
+	}
+
+	return num_read;
+} // template <class T> uint32 ReadScriptDescriptor::_ReadNumberSequence(T* buffer, uint32 count)
+
+
+
 template <class T> void ReadScriptDescriptor::_ReadTableKeys(std::vector<T>& keys) {
 	keys.clear();
 
@@ -15,6 +15,7 @@
 *** ***************************************************************************/
 
 #include <fstream>
+#include <locale>
 
 #include "utils.h"
 
@@ -27,6 +28,98 @@ using namespace hoa_utils;
 
 namespace hoa_script {
 
+namespace private_script {
+
+//-----------------------------------------------------------------------------
+// ScriptWriteBuffer Class Functions
+//-----------------------------------------------------------------------------
+
+bool ScriptWriteBuffer::Open(const string& file_name) {
+	Close();
+
+	_file.open(file_name.c_str());
+	if (!_file) {
+		return false;
+	}
+
+	_buffer.reserve(SCRIPT_WRITE_BUFFER_SIZE + 256);
+	_float_stream.imbue(locale::classic());
+	_write_error = false;
+	return true;
+}
+
+
+
+bool ScriptWriteBuffer::Flush() {
+	if (IsOpen() == false) {
+		return false;
+	}
+
+	if (_buffer.empty() == false) {
+		_file.write(_buffer.data(), _buffer.size());
+		_buffer.clear();
+	}
+	_file.flush();
+	if (!_file) {
+		_write_error = true;
+	}
+	return (_write_error == false);
+}
+
+
+
+bool ScriptWriteBuffer::Close() {
+	if (IsOpen() == false) {
+		return false;
+	}
+
+	bool success = Flush();
+	_file.close();
+	if (_file.fail()) {
+		success = false;
+	}
+	_file.clear();
+	_buffer.clear();
+	return success;
+}
+
+
+
+ScriptWriteBuffer& ScriptWriteBuffer::operator<<(int32 value) {
+	if (value < 0) {
+		_buffer.push_back('-');
+		// Negate in unsigned arithmetic so that the smallest int32 value does not overflow
+		return *this << static_cast<uint32>(0u - static_cast<uint32>(value));
+	}
+	return *this << static_cast<uint32>(value);
+}
+
+
+
+ScriptWriteBuffer& ScriptWriteBuffer::operator<<(uint32 value) {
+	// Digits are produced from least to most significant, so fill the array from the back
+	char digits[10];
+	uint32 start = sizeof(digits);
+	do {
+		digits[--start] = '0' + (value % 10);
+		value /= 10;
+	} while (value != 0);
+
+	_buffer.append(digits + start, sizeof(digits) - start);
+	return _CheckBufferFull();
+}
+
+
+
+ScriptWriteBuffer& ScriptWriteBuffer::operator<<(float value) {
+	_float_stream.str("");
+	_float_stream << value;
+	_buffer.append(_float_stream.str());
+	return _CheckBufferFull();
+}
+
+} // namespace private_script
+
 WriteScriptDescriptor::~WriteScriptDescriptor() {
 	if (IsFileOpen()) {
 		if (SCRIPT_DEBUG)
@@ -64,15 +157,17 @@ bool WriteScriptDescriptor::OpenFile(const string& file_name) {
 		temp_file.close();
 	}
 
-	_outfile.open(file_name.c_str());
-	if (!_outfile) {
+	// The contents go to a temporary file first, which replaces the real file when it is closed
+	_temporary_filename = file_name + private_script::SCRIPT_WRITE_TEMPORARY_EXTENSION;
+	if (_outfile.Open(_temporary_filename) == false) {
 		cerr << "SCRIPT ERROR: WriteScriptDescriptor::OpenFile() failed to open the file "
-			<< file_name << " for writing." << endl;
+			<< _temporary_filename << " for writing." << endl;
 		_access_mode = SCRIPT_CLOSED;
 		return false;
 	}
 
 	_filename = file_name;
+	_table_path.clear();
 	_access_mode = SCRIPT_WRITE;
 	ScriptManager->_AddOpenFile(this);
 	return true;
@@ -107,9 +202,21 @@ void WriteScriptDescriptor::CloseFile() {
 		cerr << _error_messages.str() << endl;
 	}
 
-	_outfile.close();
+	// Only replace the original file if every part of the new contents made it to the disk. Renaming over an
+	// existing file is atomic on most platforms. Where it is not allowed, fall back to removing the original first.
+	if (_outfile.Close() == false) {
+		PRINT_ERROR << "failed to write the contents of the file " << _filename
+			<< ". The original file was left unchanged." << endl;
+		DeleteFile(_temporary_filename);
+	}
+	else if (rename(_temporary_filename.c_str(), _filename.c_str()) != 0 && MoveFile(_temporary_filename, _filename) == false) {
+		PRINT_ERROR << "failed to replace the file " << _filename << " with the newly written file "
+			<< _temporary_filename << endl;
+	}
+
 	_error_messages.clear();
 	_open_tables.clear();
+	_table_path.clear();
 	_access_mode = SCRIPT_CLOSED;
 	ScriptManager->_RemoveOpenFile(this);
 }
@@ -128,8 +235,7 @@ bool WriteScriptDescriptor::SaveFile() {
 		cerr << _error_messages.str() << endl;
 	}
 
-	_outfile.flush();
-	return _outfile.bad();
+	return _outfile.Flush();
 }
 
 //-----------------------------------------------------------------------------
@@ -137,13 +243,13 @@ bool WriteScriptDescriptor::SaveFile() {
 //-----------------------------------------------------------------------------
 
 void WriteScriptDescriptor::InsertNewLine() {
-	_outfile << endl;
+	_outfile << '\n';
 }
 
 
 
 void WriteScriptDescriptor::WriteComment(const string& comment) {
-	_outfile << "-- " << comment << endl;
+	_outfile << "-- " << comment << '\n';
 }
 
 
@@ -156,7 +262,7 @@ void WriteScriptDescriptor::BeginCommentBlock() {
 	}
 
 	_inside_comment_block = true;
-	_outfile << "--[[" << endl;
+	_outfile << "--[[" << '\n';
 }
 
 
@@ -169,7 +275,7 @@ void WriteScriptDescriptor::EndCommentBlock() {
 	}
 
 	_inside_comment_block = false;
-	_outfile << "--]]" << endl;
+	_outfile << "--]]" << '\n';
 }
 
 
@@ -177,7 +283,7 @@ void WriteScriptDescriptor::EndCommentBlock() {
 void WriteScriptDescriptor::WriteLine(const string& comment, bool new_line) {
 	_outfile << comment;
 	if (new_line)
-		_outfile << endl;
+		_outfile << '\n';
 }
 
 //-----------------------------------------------------------------------------
@@ -190,17 +296,17 @@ void WriteScriptDescriptor::WriteBool(const string& key, bool value) {
 	if (_open_tables.size() == 0) {
 		_outfile << key << " = ";
 		if (value)
-			_outfile << "true" << endl;
+			_outfile << "true" << '\n';
 		else
-			_outfile << "false" << endl;
+			_outfile << "false" << '\n';
 	}
 	else {
 		_WriteTablePath();
 		_outfile << '.' << key << " = ";
 		if (value)
-			_outfile << "true" << endl;
+			_outfile << "true" << '\n';
 		else
-			_outfile << "false" << endl;
+			_outfile << "false" << '\n';
 	}
 }
 
@@ -216,9 +322,9 @@ void WriteScriptDescriptor::WriteBool(const int32 key, bool value) {
 	_WriteTablePath();
 	_outfile << '[' << key << ']' << " = ";
 	if (value)
-		_outfile << "true" << endl;
+		_outfile << "true" << '\n';
 	else
-		_outfile << "false" << endl;
+		_outfile << "false" << '\n';
 }
 
 // WriteString can not use the _WriteData helper because it needs to do additional
@@ -226,11 +332,11 @@ void WriteScriptDescriptor::WriteBool(const int32 key, bool value) {
 // TODO: Check for bad strings (ie, if it contains puncutation charcters like , or ])
 void WriteScriptDescriptor::WriteString(const string& key, const string& value) {
 	if (_open_tables.size() == 0) {
-		_outfile << key << " = \"" << value << "\"" << endl;
+		_outfile << key << " = \"" << value << "\"" << '\n';
 	}
 	else {
 		_WriteTablePath();
-		_outfile << '.' << key << " = \"" << value << "\"" << endl;
+		_outfile << '.' << key << " = \"" << value << "\"" << '\n';
 	}
 }
 
@@ -244,7 +350,7 @@ void WriteScriptDescriptor::WriteString(const int32 key, const string& value) {
 	}
 
 	_WriteTablePath();
-	_outfile << '[' << key << ']' << " = \"" << value << "\"" << endl;
+	_outfile << '[' << key << ']' << " = \"" << value << "\"" << '\n';
 }
 
 // WriteUString can not use the _WriteData helper because it needs to do additional
@@ -291,7 +397,7 @@ void WriteScriptDescriptor::WriteBoolVector(const string& key, std::vector<bool>
 		else
 			_outfile << ", false";
 	}
-	_outfile << " }" << endl;
+	_outfile << " }" << '\n';
 }
 
 
@@ -316,7 +422,7 @@ void WriteScriptDescriptor::WriteBoolVector(const int32 key, std::vector<bool>&
 		else
 			_outfile << ", false";
 	}
-	_outfile << " }" << endl;
+	_outfile << " }" << '\n';
 }
 
 // WriteString can not use the _WriteData helper because it needs to do additional
@@ -341,7 +447,7 @@ void WriteScriptDescriptor::WriteStringVector(const string &key, std::vector<str
 	for (uint32 i = 1; i < vect.size(); i++) {
 		_outfile << ", \"" << vect[i] << "\"";
 	}
-	_outfile << " }" << endl;
+	_outfile << " }" << '\n';
 }
 
 
@@ -365,7 +471,7 @@ void WriteScriptDescriptor::WriteStringVector(const int32 key, std::vector<strin
 	for (uint32 i = 1; i < vect.size(); i++) {
 		_outfile << ", \"" << vect[i] << "\"";
 	}
-	_outfile << " }" << endl;
+	_outfile << " }" << '\n';
 }
 
 
@@ -385,10 +491,10 @@ void WriteScriptDescriptor::WriteUStringVector(const int32 key, std::vector<stri
 
 void WriteScriptDescriptor::WriteNamespace(const string &ns)
 {
-	_outfile << "local ns = {};" << endl;
-	_outfile << "setmetatable(ns, {__index = _G});" << endl;
-	_outfile << ns << " = ns;" << endl;
-	_outfile << "setfenv(1, ns);" << endl;
+	_outfile << "local ns = {};" << '\n';
+	_outfile << "setmetatable(ns, {__index = _G});" << '\n';
+	_outfile << ns << " = ns;" << '\n';
+	_outfile << "setfenv(1, ns);" << '\n';
 }
 
 //-----------------------------------------------------------------------------
@@ -397,11 +503,11 @@ void WriteScriptDescriptor::WriteNamespace(const string &ns)
 
 void WriteScriptDescriptor::DeclareTable(const string &key) {
 	if (_open_tables.empty() == true) {
-		_outfile << key << " = {}" << endl;
+		_outfile << key << " = {}" << '\n';
 	}
 	else {
 		_WriteTablePath();
-		_outfile << '.' << key << " = {}" << endl;
+		_outfile << '.' << key << " = {}" << '\n';
 	}
 }
 
@@ -409,11 +515,11 @@ void WriteScriptDescriptor::DeclareTable(const string &key) {
 
 void WriteScriptDescriptor::DeclareTable(int32 key) {
 	if (_open_tables.empty() == true) {
-		_outfile << key << " = {}" << endl;
+		_outfile << key << " = {}" << '\n';
 	}
 	else {
 		_WriteTablePath();
-		_outfile << '[' << key << "] = {}" << endl;
+		_outfile << '[' << key << "] = {}" << '\n';
 	}
 }
 
@@ -425,6 +531,7 @@ void WriteScriptDescriptor::EndTable() {
 	}
 	else {
 		_open_tables.pop_back();
+		_table_path.clear();
 	}
 }
 
@@ -433,6 +540,7 @@ void WriteScriptDescriptor::EndTable() {
 //-----------------------------------------------------------------------------
 
 // Writes the path for all the open tables. For example, "table01[table02][table03]"
+// The path is only rebuilt after the open tables change, since it is written for nearly every line of data.
 void WriteScriptDescriptor::_WriteTablePath() {
 	if (_open_tables.empty()) {
 		_error_messages << "* WriteScriptDescriptor::_WriteTablePath() failed because there were no "
@@ -440,13 +548,17 @@ void WriteScriptDescriptor::_WriteTablePath() {
 		return;
 	}
 
-	_outfile << _open_tables[0];
-	for (uint32 i = 1; i < _open_tables.size(); i++) {
-		if (IsStringNumeric(_open_tables[i]))
-			_outfile << '[' << _open_tables[i] << ']';
-		else
-			_outfile << '.' << _open_tables[i];
+	if (_table_path.empty() == true) {
+		_table_path = _open_tables[0];
+		for (uint32 i = 1; i < _open_tables.size(); i++) {
+			if (IsStringNumeric(_open_tables[i]))
+				_table_path += '[' + _open_tables[i] + ']';
+			else
+				_table_path += '.' + _open_tables[i];
+		}
 	}
+
+	_outfile << _table_path;
 }
 
 } // namespace hoa_script
@@ -25,6 +25,94 @@
 
 namespace hoa_script {
 
+namespace private_script {
+
+//! \brief The number of bytes of text that are collected in memory before they are written to the file
+const uint32 SCRIPT_WRITE_BUFFER_SIZE = 1048576;
+
+//! \brief Appended to the name of a file being written. The file only replaces the original once it is complete.
+const std::string SCRIPT_WRITE_TEMPORARY_EXTENSION = ".tmp";
+
+/** ****************************************************************************
+*** \brief A buffered output stream for writing the text of Lua files
+***
+*** Writing every line through a file stream with std::endl flushes the stream
+*** after each line, which makes writing large files such as maps very slow. This
+*** class collects all written text in a large memory buffer and only passes it to
+*** the file when the buffer is full or when it is flushed. Integers are formatted
+*** directly into the buffer.
+***
+*** \note Floating point values are formatted through a string stream using the
+*** classic locale. They are rare in the files that are written and this keeps
+*** their text identical to what a standard file stream would produce.
+*** ***************************************************************************/
+class ScriptWriteBuffer {
+public:
+	ScriptWriteBuffer() :
+		_write_error(false) {}
+
+	~ScriptWriteBuffer()
+		{ Close(); }
+
+	/** \brief Opens a file for writing, replacing any existing contents
+	*** \param file_name The name of the file to open
+	*** \return True if the file was opened successfully
+	**/
+	bool Open(const std::string& file_name);
+
+	/** \brief Writes all buffered text to the file
+	*** \return True if all text written since the file was opened made it to the file successfully
+	**/
+	bool Flush();
+
+	/** \brief Writes all buffered text and closes the file
+	*** \return True if all text written since the file was opened made it to the file successfully
+	**/
+	bool Close();
+
+	bool IsOpen() const
+		{ return _file.is_open(); }
+
+	/** \name Stream Operators
+	*** \brief Append a value to the buffer in the same text format as a standard output stream
+	**/
+	//@{
+	ScriptWriteBuffer& operator<<(char value)
+		{ _buffer.push_back(value); return _CheckBufferFull(); }
+
+	ScriptWriteBuffer& operator<<(const char* value)
+		{ _buffer.append(value); return _CheckBufferFull(); }
+
+	ScriptWriteBuffer& operator<<(const std::string& value)
+		{ _buffer.append(value); return _CheckBufferFull(); }
+
+	ScriptWriteBuffer& operator<<(int32 value);
+
+	ScriptWriteBuffer& operator<<(uint32 value);
+
+	ScriptWriteBuffer& operator<<(float value);
+	//@}
+
+private:
+	//! \brief The file that the buffered text is written to
+	std::ofstream _file;
+
+	//! \brief Holds the text that has not yet been written to the file
+	std::string _buffer;
+
+	//! \brief Used to format floating point values
+	std::ostringstream _float_stream;
+
+	//! \brief Set to true if any write to the file failed since the file was opened
+	bool _write_error;
+
+	//! \brief Writes the buffer to the file once it grows beyond SCRIPT_WRITE_BUFFER_SIZE
+	ScriptWriteBuffer& _CheckBufferFull()
+		{ if (_buffer.size() >= SCRIPT_WRITE_BUFFER_SIZE) Flush(); return *this; }
+}; // class ScriptWriteBuffer
+
+} // namespace private_script
+
 /** ****************************************************************************
 *** \brief Provides a simplistic interface for writing data to a new Lua file
 ***
@@ -44,6 +132,11 @@ namespace hoa_script {
 *** automatically insert a new line into the file after they write their
 *** requested contents.
 ***
+*** \note The contents are written to a temporary file next to the requested file,
+*** which replaces the requested file only when CloseFile() is called and all of
+*** the contents were written successfully. A crash or a failed write while saving
+*** therefore leaves any previous version of the file untouched.
+***
 *** \todo Implement the WriteUString methods that will automatically insert the
 *** gettext call to retrieve the translated value of the string.
 ***
@@ -70,9 +163,10 @@ public:
 	/** \brief Saves the file with the newly written contents
 	*** \return True if the save operation was successful
 	***
-	*** All this method actually does is flush the output file stream. This method does not need
+	*** All this method actually does is flush the output buffer to the temporary file. This method does not need
 	*** to be called normally since simply calling CloseFile() will achieve the same effect. The purpose
 	*** of this method is to provide the option to save the file contents without also closing the file.
+	*** \note The original file is not replaced until CloseFile() is called.
 	**/
 	bool SaveFile();
 	//@}
@@ -180,6 +274,23 @@ public:
 	void WriteUStringVector(const int32 key, std::vector<std::string> &vect);
 	//@}
 
+	/** \name Grid Write Functions
+	*** \brief These functions write a two-dimensional grid of numbers to a Lua file
+	*** \param key The name of the table to use in the Lua file to represent the grid.
+	*** \param grid A reference to the rows of elements to write.
+	***
+	*** The grid is written as a table containing one table per row, keyed by the row index starting
+	*** from zero. The result is identical to calling BeginTable(key), then WriteIntVector(row, grid[row])
+	*** for every row, and finally EndTable(), but the rows are emitted in bulk.
+	**/
+	//@{
+	void WriteIntGrid(const std::string &key, std::vector<std::vector<int32> > &grid)
+		{ _WriteDataGrid(key, grid); }
+
+	void WriteUIntGrid(const std::string &key, std::vector<std::vector<uint32> > &grid)
+		{ _WriteDataGrid(key, grid); }
+	//@}
+
 	/** \brief Write out the namespace header
 	*** \param the name of the namespace for this lua file.
 	**/
@@ -209,10 +320,10 @@ public:
 	void DeclareTable(int32 key);
 
 	void OpenTable(const std::string &key)
-		{ _open_tables.push_back(key); }
+		{ _open_tables.push_back(key); _table_path.clear(); }
 
 	void OpenTable(int32 key)
-		{ _open_tables.push_back(hoa_utils::NumberToString<int32>(key)); }
+		{ _open_tables.push_back(hoa_utils::NumberToString<int32>(key)); _table_path.clear(); }
 
 	void BeginTable(const std::string &key)
 		{ DeclareTable(key); OpenTable(key); }
@@ -224,8 +335,14 @@ public:
 	//@}
 
 private:
-	//! \brief The output file stream to write to for when the file is opened in write mode.
-	std::ofstream _outfile;
+	//! \brief The buffered output stream to write to for when the file is opened in write mode.
+	private_script::ScriptWriteBuffer _outfile;
+
+	//! \brief The name of the temporary file that the contents are written to until the file is closed
+	std::string _temporary_filename;
+
+	//! \brief The path of all open tables as written by _WriteTablePath(). Empty when it needs to be rebuilt.
+	std::string _table_path;
 
 	//! \brief Set to true after a comment block begins and false after the comment block ends
 	bool _inside_comment_block;
@@ -252,6 +369,9 @@ private:
 	template <class T> void _WriteDataVector(const int32 key, std::vector<T> &vect);
 	//@}
 
+	//! \brief Called by the public WriteTYPEGrid functions of this class to write each row of the grid
+	template <class T> void _WriteDataGrid(const std::string& key, std::vector<std::vector<T> > &grid);
+
 	//! \brief Writes the pathname of all open tables (i.e., table1[table2][table3])
 	void _WriteTablePath();
 }; // class WriteScriptDescriptor : public ScriptDescriptor
@@ -262,11 +382,11 @@ private:
 
 template <class T> void WriteScriptDescriptor::_WriteData(const std::string &key, T value) {
 	if (_open_tables.size() == 0) {
-		_outfile << key << " = " << value << std::endl;
+		_outfile << key << " = " << value << '\n';
 	}
 	else {
 		_WriteTablePath();
-		_outfile << '.' << key << " = " << value << std::endl;
+		_outfile << '.' << key << " = " << value << '\n';
 	}
 }
 
@@ -279,7 +399,7 @@ template <class T> void WriteScriptDescriptor::_WriteData(const int32 key, T val
 	}
 
 	_WriteTablePath();
-	_outfile << '[' << key << ']' << " = " << value << std::endl;
+	_outfile << '[' << key << ']' << " = " << value << '\n';
 }
 
 
@@ -306,7 +426,7 @@ template <class T> void WriteScriptDescriptor::_WriteDataVector(const std::strin
 	for (uint32 i = 1; i < vect.size(); i++) {
 		_outfile << ", " << vect[i];
 	}
-	_outfile << " }" << std::endl;
+	_outfile << " }" << '\n';
 }
 
 
@@ -325,7 +445,29 @@ template <class T> void WriteScriptDescriptor::_WriteDataVector(const int32 key,
 	for (uint32 i = 1; i < vect.size(); i++) {
 		_outfile << ", " << vect[i];
 	}
-	_outfile << " }" << std::endl;
+	_outfile << " }" << '\n';
+}
+
+
+
+template <class T> void WriteScriptDescriptor::_WriteDataGrid(const std::string& key, std::vector<std::vector<T> >& grid) {
+	BeginTable(key);
+	for (uint32 row = 0; row < grid.size(); ++row) {
+		std::vector<T>& vect = grid[row];
+		if (vect.empty()) {
+			_error_messages << "* WriteScriptDescriptor::_WriteDataGrid() skipped row " << row
+				<< " because it was empty for key name: " << key << std::endl;
+			continue;
+		}
+
+		_WriteTablePath();
+		_outfile << '[' << row << "] = { " << vect[0];
+		for (uint32 i = 1; i < vect.size(); i++) {
+			_outfile << ", " << vect[i];
+		}
+		_outfile << " }" << '\n';
+	}
+	EndTable();
 }
 
 } // namespace hoa_script
@@ -70,7 +70,8 @@ SystemTimer::SystemTimer() :
 	_number_loops(0),
 	_mode_owner(nullptr),
 	_time_expired(0),
-	_times_completed(0)
+	_times_completed(0),
+	_auto_update_index(0)
 {}
 
 
@@ -82,7 +83,8 @@ SystemTimer::SystemTimer(uint32 duration, int32 loops) :
 	_number_loops(loops),
 	_mode_owner(nullptr),
 	_time_expired(0),
-	_times_completed(0)
+	_times_completed(0),
+	_auto_update_index(0)
 {}
 
 
@@ -236,6 +238,222 @@ void SystemTimer::_UpdateTimer(uint32 time) {
 	}
 }
 
+// -----------------------------------------------------------------------------
+// TimerWheel Class
+// -----------------------------------------------------------------------------
+
+namespace {
+
+//! \brief The number of levels in a timer wheel and the number of slots in each level
+//@{
+const uint32 TIMER_WHEEL_LEVELS = 4;
+const uint32 TIMER_WHEEL_SLOT_BITS = 6;
+const uint32 TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_SLOT_BITS;
+const uint32 TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+//@}
+
+//! \brief The number of list heads at the beginning of the node container, one for every slot of every level
+const uint32 TIMER_WHEEL_HEADS = TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS;
+
+//! \brief A handle holds the index of its node in the lower bits and the generation of the node in the upper bits
+//@{
+const uint32 TIMER_HANDLE_INDEX_BITS = 20;
+const uint32 TIMER_HANDLE_INDEX_MASK = (1 << TIMER_HANDLE_INDEX_BITS) - 1;
+const uint32 TIMER_HANDLE_GENERATION_MASK = (1 << (32 - TIMER_HANDLE_INDEX_BITS)) - 1;
+//@}
+
+} // namespace
+
+TimerWheel::TimerWheel() :
+	_current_time(0),
+	_scheduled_count(0)
+{
+	// Every list head begins as an empty circular list that links only to itself
+	_nodes.resize(TIMER_WHEEL_HEADS);
+	for (uint32 i = 0; i < TIMER_WHEEL_HEADS; ++i) {
+		_nodes[i].prev = i;
+		_nodes[i].next = i;
+		_nodes[i].expire_time = 0;
+		_nodes[i].generation = 0;
+		_nodes[i].scheduled = false;
+	}
+}
+
+
+
+uint32 TimerWheel::Schedule(uint32 delay, const function<void()>& callback) {
+	if (!callback) {
+		IF_PRINT_WARNING(SYSTEM_DEBUG) << "function received an empty callback argument" << endl;
+		return SYSTEM_INVALID_CALLBACK;
+	}
+
+	uint32 index = 0;
+	if (_free_nodes.empty() == false) {
+		index = _free_nodes.back();
+		_free_nodes.pop_back();
+	}
+	else {
+		if (_nodes.size() > TIMER_HANDLE_INDEX_MASK) {
+			IF_PRINT_WARNING(SYSTEM_DEBUG) << "could not schedule a call because the maximum number of calls are already scheduled" << endl;
+			return SYSTEM_INVALID_CALLBACK;
+		}
+		index = _nodes.size();
+		_nodes.emplace_back();
+		_nodes[index].generation = 0;
+	}
+
+	// A zero delay would place the call in the slot that was already processed for the current time
+	Node& node = _nodes[index];
+	node.expire_time = _current_time + ((delay == 0) ? 1 : delay);
+	node.scheduled = true;
+	node.callback = callback;
+	_InsertNode(index);
+	_scheduled_count++;
+
+	return (node.generation << TIMER_HANDLE_INDEX_BITS) | index;
+}
+
+
+
+bool TimerWheel::Cancel(uint32 handle) {
+	if (_FindNode(handle) == nullptr)
+		return false;
+
+	_ReleaseNode(handle & TIMER_HANDLE_INDEX_MASK);
+	_scheduled_count--;
+	return true;
+}
+
+
+
+uint32 TimerWheel::TimeRemaining(uint32 handle) const {
+	const Node* node = _FindNode(handle);
+	if (node == nullptr)
+		return 0;
+
+	return node->expire_time - _current_time;
+}
+
+
+
+void TimerWheel::Advance(uint32 time) {
+	for (uint32 i = 0; i < time; ++i) {
+		// There is nothing to examine while the wheel is empty, so the remaining time can be skipped over entirely
+		if (_scheduled_count == 0) {
+			_current_time += time - i;
+			return;
+		}
+
+		_current_time++;
+
+		// Whenever the first slot of a level comes around, the next slot of the level above it is redistributed
+		for (uint32 level = 1; level < TIMER_WHEEL_LEVELS; ++level) {
+			uint32 shift = level * TIMER_WHEEL_SLOT_BITS;
+			if ((_current_time & ((1 << shift) - 1)) != 0)
+				break;
+			_CascadeSlot(level, (_current_time >> shift) & TIMER_WHEEL_SLOT_MASK);
+		}
+
+		// The node is released before its callback is made so that the callback is free to schedule or cancel other calls
+		uint32 head = _current_time & TIMER_WHEEL_SLOT_MASK;
+		while (_nodes[head].next != head) {
+			uint32 index = _nodes[head].next;
+			function<void()> callback;
+			callback.swap(_nodes[index].callback);
+			_ReleaseNode(index);
+			_scheduled_count--;
+			callback();
+		}
+	}
+}
+
+
+
+void TimerWheel::Clear() {
+	for (uint32 i = TIMER_WHEEL_HEADS; i < _nodes.size(); ++i) {
+		if (_nodes[i].scheduled == true)
+			_ReleaseNode(i);
+	}
+	_scheduled_count = 0;
+}
+
+
+
+const TimerWheel::Node* TimerWheel::_FindNode(uint32 handle) const {
+	uint32 index = handle & TIMER_HANDLE_INDEX_MASK;
+	if (index < TIMER_WHEEL_HEADS || index >= _nodes.size())
+		return nullptr;
+
+	const Node& node = _nodes[index];
+	if (node.scheduled == false || node.generation != (handle >> TIMER_HANDLE_INDEX_BITS))
+		return nullptr;
+
+	return &node;
+}
+
+
+
+void TimerWheel::_InsertNode(uint32 index) {
+	Node& node = _nodes[index];
+
+	// Find the lowest level that can distinguish the node's expiration time from the current time
+	uint32 head = 0;
+	uint32 level = 0;
+	for (; level < TIMER_WHEEL_LEVELS; ++level) {
+		uint32 shift = level * TIMER_WHEEL_SLOT_BITS;
+		if ((node.expire_time >> shift) - (_current_time >> shift) < TIMER_WHEEL_SLOTS) {
+			head = level * TIMER_WHEEL_SLOTS + ((node.expire_time >> shift) & TIMER_WHEEL_SLOT_MASK);
+			break;
+		}
+	}
+
+	// Calls beyond the span of the wheel wait in the furthest slot of the highest level and are placed again when it comes around
+	if (level == TIMER_WHEEL_LEVELS) {
+		uint32 shift = (TIMER_WHEEL_LEVELS - 1) * TIMER_WHEEL_SLOT_BITS;
+		head = (TIMER_WHEEL_LEVELS - 1) * TIMER_WHEEL_SLOTS + (((_current_time >> shift) + TIMER_WHEEL_SLOTS - 1) & TIMER_WHEEL_SLOT_MASK);
+	}
+
+	// Append the node to the end of the slot's list so that calls expiring together are made in the order they were scheduled
+	node.prev = _nodes[head].prev;
+	node.next = head;
+	_nodes[node.prev].next = index;
+	_nodes[head].prev = index;
+}
+
+
+
+void TimerWheel::_UnlinkNode(uint32 index) {
+	Node& node = _nodes[index];
+	_nodes[node.prev].next = node.next;
+	_nodes[node.next].prev = node.prev;
+	node.prev = index;
+	node.next = index;
+}
+
+
+
+void TimerWheel::_ReleaseNode(uint32 index) {
+	_UnlinkNode(index);
+
+	Node& node = _nodes[index];
+	node.scheduled = false;
+	node.callback = nullptr;
+	node.generation = (node.generation + 1) & TIMER_HANDLE_GENERATION_MASK;
+	_free_nodes.push_back(index);
+}
+
+
+
+void TimerWheel::_CascadeSlot(uint32 level, uint32 slot) {
+	// Each node is always placed into a lower level than the one it is taken from, so this loop terminates
+	uint32 head = level * TIMER_WHEEL_SLOTS + slot;
+	while (_nodes[head].next != head) {
+		uint32 index = _nodes[head].next;
+		_UnlinkNode(index);
+		_InsertNode(index);
+	}
+}
+
 // -----------------------------------------------------------------------------
 // SystemEngine Class
 // -----------------------------------------------------------------------------
@@ -244,6 +462,17 @@ SystemEngine::SystemEngine() {
 	IF_PRINT_DEBUG(SYSTEM_DEBUG) << "constructor invoked" << endl;
 
 	_not_done = true;
+	_active_timer_mode = nullptr;
+	_active_timer_wheel = nullptr;
+	_fixed_update_time = 0;
+	_measured_update_time = 0;
+	_frame_time = 0;
+	_step_time = SYSTEM_DEFAULT_STEP_TIME;
+	_accumulated_time = 0;
+	_pending_steps = 0;
+	_frame_count = 0;
+	_total_frame_time = 0;
+	_longest_frame_time = 0;
 	SetLanguage("en@quot"); // Default language is English
 }
 
@@ -251,6 +480,10 @@ SystemEngine::SystemEngine() {
 
 SystemEngine::~SystemEngine() {
 	IF_PRINT_DEBUG(SYSTEM_DEBUG) << "destructor invoked" << endl;
+
+	for (map<GameMode*, TimerWheel*>::iterator i = _mode_timer_wheels.begin(); i != _mode_timer_wheels.end(); i++)
+		delete i->second;
+	_mode_timer_wheels.clear();
 }
 
 
@@ -301,6 +534,9 @@ bool SystemEngine::SingletonInitialize() {
 void SystemEngine::InitializeTimers() {
 	_last_update = SDL_GetTicks();
 	_update_time = 1; // Set to non-zero, otherwise bad things may happen...
+	_frame_time = 1;
+	_accumulated_time = 0;
+	_pending_steps = 0;
 	_hours_played = 0;
 	_minutes_played = 0;
 	_seconds_played = 0;
@@ -320,10 +556,14 @@ void SystemEngine::AddAutoTimer(SystemTimer* timer) {
 		return;
 	}
 
-// 	pair<set<SystemTimer*>::iterator, bool> return_value;
-	if (_auto_system_timers.insert(timer).second == false) {
+	uint32 index = timer->_auto_update_index;
+	if (index < _auto_system_timers.size() && _auto_system_timers[index] == timer) {
 		IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer already existed in auto system timer container" << endl;
+		return;
 	}
+
+	timer->_auto_update_index = _auto_system_timers.size();
+	_auto_system_timers.push_back(timer);
 }
 
 
@@ -337,20 +577,58 @@ void SystemEngine::RemoveAutoTimer(SystemTimer* timer) {
 		IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer did not have auto update feature enabled" << endl;
 	}
 
-	if (_auto_system_timers.erase(timer) == 0) {
+	uint32 index = timer->_auto_update_index;
+	if (index >= _auto_system_timers.size() || _auto_system_timers[index] != timer) {
 		IF_PRINT_WARNING(SYSTEM_DEBUG) << "timer was not found in auto system timer container" << endl;
+		return;
 	}
+
+	// Move the last timer into the vacated position so that no other timers need to be shifted
+	_auto_system_timers[index] = _auto_system_timers.back();
+	_auto_system_timers[index]->_auto_update_index = index;
+	_auto_system_timers.pop_back();
 }
 
 
 
 void SystemEngine::UpdateTimers() {
-	// ----- (1): Update the update game timer
+	// ----- (1): Measure the time of the last frame
 	uint32 tmp = _last_update;
 	_last_update = SDL_GetTicks();
-	_update_time = _last_update - tmp;
+	_measured_update_time = _last_update - tmp;
+	_frame_time = (_fixed_update_time != 0) ? _fixed_update_time : _measured_update_time;
+
+	_frame_count++;
+	_total_frame_time += _measured_update_time;
+	if (_measured_update_time > _longest_frame_time)
+		_longest_frame_time = _measured_update_time;
+
+	// ----- (2): Determine how many simulation steps the frame time covers
+	if (_step_time == 0) {
+		_pending_steps = 1;
+		return;
+	}
+
+	_accumulated_time += _frame_time;
+	if (_accumulated_time > _step_time * SYSTEM_MAX_STEPS_PER_FRAME) {
+		IF_PRINT_DEBUG(SYSTEM_DEBUG) << "discarding " << (_accumulated_time - _step_time * SYSTEM_MAX_STEPS_PER_FRAME)
+			<< "ms of frame time that exceeded the simulation step limit" << endl;
+		_accumulated_time = _step_time * SYSTEM_MAX_STEPS_PER_FRAME;
+	}
+	_pending_steps = _accumulated_time / _step_time;
+	_accumulated_time -= _pending_steps * _step_time;
+}
+
 
-	// ----- (2): Update the game play timer
+
+bool SystemEngine::SimulationStep() {
+	if (_pending_steps == 0)
+		return false;
+
+	_pending_steps--;
+	_update_time = (_step_time == 0) ? _frame_time : _step_time;
+
+	// ----- (1): Update the game play timer
 	_milliseconds_played += _update_time;
 	if (_milliseconds_played >= 1000) {
 		_seconds_played += _milliseconds_played / 1000;
@@ -365,9 +643,29 @@ void SystemEngine::UpdateTimers() {
 		}
 	}
 
-	// ----- (3): Update all SystemTimer objects
-	for (set<SystemTimer*>::iterator i = _auto_system_timers.begin(); i != _auto_system_timers.end(); i++)
-		(*i)->_AutoUpdate();
+	// ----- (2): Update all SystemTimer objects
+	for (uint32 i = 0; i < _auto_system_timers.size(); ++i)
+		_auto_system_timers[i]->_AutoUpdate();
+
+	// ----- (3): Make all scheduled calls that expire during this step
+	_timer_wheel.Advance(_update_time);
+	if (_active_timer_wheel != nullptr)
+		_active_timer_wheel->Advance(_update_time);
+
+	return true;
+}
+
+
+
+void SystemEngine::DEBUG_PrintFrameTimes() const {
+	cout << "__Frame Times__" << endl;
+	cout << "* fixed update time:  " << _fixed_update_time << "ms" << endl;
+	cout << "* simulation step:    " << _step_time << "ms" << endl;
+	cout << "* frames processed:   " << _frame_count << endl;
+	cout << "* total time:         " << _total_frame_time << "ms" << endl;
+	cout << "* average frame time: " << (_frame_count == 0 ? 0.0f : static_cast<float>(_total_frame_time) / static_cast<float>(_frame_count)) << "ms" << endl;
+	cout << "* longest frame time: " << _longest_frame_time << "ms" << endl;
+	cout << endl;
 }
 
 
@@ -376,16 +674,59 @@ void SystemEngine::ExamineSystemTimers() {
 	GameMode* active_mode = ModeManager->GetTop();
 	GameMode* timer_mode = nullptr;
 
-	for (set<SystemTimer*>::iterator i = _auto_system_timers.begin(); i != _auto_system_timers.end(); i++) {
-		timer_mode = (*i)->GetModeOwner();
+	for (uint32 i = 0; i < _auto_system_timers.size(); ++i) {
+		timer_mode = _auto_system_timers[i]->GetModeOwner();
 		if (timer_mode == nullptr)
 			continue;
 
 		if (timer_mode == active_mode)
-			(*i)->Run();
+			_auto_system_timers[i]->Run();
 		else
-			(*i)->Pause();
+			_auto_system_timers[i]->Pause();
 	}
+
+	// Only the timer wheel of the active game mode advances, so the wheels of all other modes are effectively paused
+	_active_timer_mode = active_mode;
+	map<GameMode*, TimerWheel*>::iterator wheel = _mode_timer_wheels.find(active_mode);
+	_active_timer_wheel = (wheel != _mode_timer_wheels.end()) ? wheel->second : nullptr;
+}
+
+
+
+TimerWheel* SystemEngine::GetTimerWheel(GameMode* owner) {
+	if (owner == nullptr)
+		return &_timer_wheel;
+
+	map<GameMode*, TimerWheel*>::iterator i = _mode_timer_wheels.find(owner);
+	if (i != _mode_timer_wheels.end())
+		return i->second;
+
+	TimerWheel* wheel = new TimerWheel();
+	_mode_timer_wheels.insert(make_pair(owner, wheel));
+	if (owner == _active_timer_mode)
+		_active_timer_wheel = wheel;
+	return wheel;
+}
+
+
+
+void SystemEngine::ReleaseTimerWheel(GameMode* owner) {
+	if (owner == nullptr) {
+		IF_PRINT_WARNING(SYSTEM_DEBUG) << "function received nullptr argument" << endl;
+		return;
+	}
+
+	if (owner == _active_timer_mode) {
+		_active_timer_mode = nullptr;
+		_active_timer_wheel = nullptr;
+	}
+
+	map<GameMode*, TimerWheel*>::iterator i = _mode_timer_wheels.find(owner);
+	if (i == _mode_timer_wheels.end())
+		return;
+
+	delete i->second;
+	_mode_timer_wheels.erase(i);
 }
 
 
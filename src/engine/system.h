@@ -24,6 +24,8 @@
 
 #include <SDL2/SDL.h>
 
+#include <functional>
+
 #include "defs.h"
 #include "utils.h"
 
@@ -72,6 +74,18 @@ const int32 SYSTEM_TIMER_NO_LOOPS = 0;
 **/
 const int32 SYSTEM_TIMER_INFINITE_LOOP = -1;
 
+/** \brief The default number of milliseconds that each simulation step advances the game by
+*** A step time of zero disables fixed stepping and updates the game once per frame by the frame's time instead.
+**/
+const uint32 SYSTEM_DEFAULT_STEP_TIME = 10;
+
+/** \brief The most simulation steps that may be processed for a single frame
+*** When a frame takes longer than this many steps worth of time (for example, while a map is loading or
+*** the window is being dragged), the excess time is discarded rather than trying to catch up with it.
+*** Without this limit a slow frame would cause more steps to be processed, causing a slower frame, and so on.
+**/
+const uint32 SYSTEM_MAX_STEPS_PER_FRAME = 5;
+
 //! \brief All of the possible states which a SystemTimer classs object may be in
 enum SYSTEM_TIMER_STATE {
 	SYSTEM_TIMER_INVALID  = -1,
@@ -82,6 +96,9 @@ enum SYSTEM_TIMER_STATE {
 	SYSTEM_TIMER_TOTAL    =  4
 };
 
+//! \brief A value that is never returned as a handle by TimerWheel::Schedule()
+const uint32 SYSTEM_INVALID_CALLBACK = 0;
+
 
 /** \brief Returns a standard string translated into the game's current language
 *** \param text A const reference to the string that should be translated
@@ -292,9 +309,129 @@ protected:
 	*** by itself; It simply updates the timer without complaint.
 	**/
 	void _UpdateTimer(uint32 amount);
+
+private:
+	//! \brief The position of this timer in the SystemEngine's auto update container, which allows it to be removed in constant time
+	uint32 _auto_update_index;
 }; // class SystemTimer
 
 
+/** ****************************************************************************
+*** \brief Calls functions after a delay without polling each pending call every update
+***
+*** Code that waits for a period of time before taking an action would typically keep a
+*** countdown and decrement it every update. When many such countdowns exist, nearly all of
+*** that work is wasted. A timer wheel instead files each scheduled call into a slot according
+*** to the time at which it expires, and only examines the slot for the current millisecond as
+*** time advances. Scheduling and canceling a call both take constant time.
+***
+*** The wheel is hierarchical. The first level holds calls that expire within the next 64ms
+*** with one slot for each millisecond. Each of the following levels covers a span 64 times
+*** greater than the previous one. Whenever the first slot of a level comes around, the calls
+*** held in the corresponding slot of the next level are redistributed into the lower levels.
+*** Calls that expire further in the future than the wheel spans (about 4.6 hours) are placed
+*** in the highest level and redistributed until their time arrives.
+***
+*** The wheel only advances when its Advance() method is called. SystemEngine owns one wheel for
+*** unowned calls and one wheel for each game mode that requests one, and advances them as the
+*** game time advances. Code that needs its own notion of time, such as battles that halt while
+*** the player selects a command, may own a wheel directly and advance it themselves.
+***
+*** \note Calls that expire during the same millisecond are made in the order that they were scheduled.
+*** \note It is safe to schedule and cancel calls from within a callback function.
+*** ***************************************************************************/
+class TimerWheel {
+public:
+	TimerWheel();
+
+	~TimerWheel()
+		{}
+
+	/** \brief Schedules a function to be called after a delay
+	*** \param delay The number of milliseconds until the function should be called. A zero delay is treated as one millisecond.
+	*** \param callback The function to call when the delay expires
+	*** \return A handle that identifies the call, which will never be equal to SYSTEM_INVALID_CALLBACK
+	**/
+	uint32 Schedule(uint32 delay, const std::function<void()>& callback);
+
+	/** \brief Cancels a scheduled call so that it is never made
+	*** \param handle The handle returned when the call was scheduled
+	*** \return True if the call was pending and has been canceled
+	***
+	*** Canceling a call that has already been made or canceled is harmless and simply returns false.
+	**/
+	bool Cancel(uint32 handle);
+
+	//! \brief Returns true if the call identified by the handle has not yet been made or canceled
+	bool IsScheduled(uint32 handle) const
+		{ return (_FindNode(handle) != nullptr); }
+
+	//! \brief Returns the number of milliseconds until the call identified by the handle is made, or zero if it is not scheduled
+	uint32 TimeRemaining(uint32 handle) const;
+
+	/** \brief Advances the time of the wheel and makes every call that expires along the way
+	*** \param time The number of milliseconds to advance the wheel by
+	**/
+	void Advance(uint32 time);
+
+	//! \brief Cancels every scheduled call
+	void Clear();
+
+	//! \brief Returns the number of calls that are currently scheduled
+	uint32 GetScheduledCount() const
+		{ return _scheduled_count; }
+
+private:
+	//! \brief A scheduled call, or the head of the list of calls held by a slot
+	struct Node {
+		//! \brief The indices of the neighboring nodes in the list that this node belongs to
+		uint32 prev, next;
+
+		//! \brief The wheel time at which the call is to be made
+		uint32 expire_time;
+
+		//! \brief Incremented each time the node is released so that handles to previous calls become invalid
+		uint32 generation;
+
+		//! \brief True while the node holds a scheduled call
+		bool scheduled;
+
+		//! \brief The function to call when the node expires
+		std::function<void()> callback;
+	};
+
+	//! \brief The number of milliseconds that the wheel has been advanced by, which is allowed to wrap around
+	uint32 _current_time;
+
+	//! \brief The number of calls that are currently scheduled
+	uint32 _scheduled_count;
+
+	/** \brief All list heads and scheduled calls of the wheel
+	*** The first entries are the heads of the slot lists, which are never released. The lists are linked by
+	*** indices rather than pointers so that growing this container does not invalidate them.
+	**/
+	std::vector<Node> _nodes;
+
+	//! \brief Indeces of released nodes that can be reused by the next calls to be scheduled
+	std::vector<uint32> _free_nodes;
+
+	//! \brief Returns the node for a handle if it holds a scheduled call, or nullptr otherwise
+	const Node* _FindNode(uint32 handle) const;
+
+	//! \brief Places a scheduled node into the slot that corresponds to its expiration time
+	void _InsertNode(uint32 index);
+
+	//! \brief Removes a node from the slot list that it belongs to
+	void _UnlinkNode(uint32 index);
+
+	//! \brief Unlinks a node and makes it available to be reused
+	void _ReleaseNode(uint32 index);
+
+	//! \brief Redistributes every node held by a slot into the slots that correspond to their remaining time
+	void _CascadeSlot(uint32 level, uint32 slot);
+}; // class TimerWheel
+
+
 /** ****************************************************************************
 *** \brief Engine class that manages system information and functions
 ***
@@ -322,7 +459,7 @@ public:
 	*** the active game mode's execution begins with only 1 millisecond of time expired instead of several.
 	**/
 	void InitializeUpdateTimer()
-		{ _last_update = SDL_GetTicks(); _update_time = 1; }
+		{ _last_update = SDL_GetTicks(); _update_time = 1; _accumulated_time = 0; _pending_steps = 0; }
 
 	/** \brief Adds a timer to the set system timers for auto updating
 	*** \param timer A pointer to the timer to add
@@ -340,20 +477,73 @@ public:
 	**/
 	void RemoveAutoTimer(SystemTimer* timer);
 
-	/** \brief Updates the game timer variables.
+	/** \brief Measures the time of the last frame and determines how many simulation steps it requires
 	*** This function should only be called <b>once</b> for each cycle through the main game loop. Since
 	*** it is called inside the loop in main.cpp, you should have no reason to call this function anywhere
-	*** else.
+	*** else. The game timers are not advanced here, but by each following call to SimulationStep().
+	***
+	*** When a step time is set, the frame time is added to an accumulator and one step is made pending for
+	*** every whole step of time that it holds. The remainder is carried over to the next frame. At most
+	*** SYSTEM_MAX_STEPS_PER_FRAME steps are made pending for a single frame.
 	**/
 	void UpdateTimers();
 
+	/** \brief Advances the game timers by one simulation step if any steps are pending for this frame
+	*** \return True if a step was taken and the game should be updated, or false if there are no more steps
+	***
+	*** The main game loop calls this function repeatedly after UpdateTimers(), updating the active game mode
+	*** once for every step taken. When no step time is set, exactly one step is taken per frame.
+	**/
+	bool SimulationStep();
+
+	//! \brief Returns the number of simulation steps that remain to be taken for the current frame
+	uint32 GetPendingSteps() const
+		{ return _pending_steps; }
+
+	/** \brief Sets the amount of time that each simulation step advances the game by
+	*** \param step_time The number of milliseconds in each step, or zero to update once per frame by the frame time
+	**/
+	void SetStepTime(uint32 step_time)
+		{ _step_time = step_time; _accumulated_time = 0; }
+
+	//! \brief Returns the number of milliseconds in each simulation step, or zero if fixed stepping is disabled
+	uint32 GetStepTime() const
+		{ return _step_time; }
+
+	/** \brief Returns how far the current frame lies between the last simulation step and the next one
+	*** \return A value between 0.0f and 1.0f, or 1.0f when fixed stepping is disabled
+	***
+	*** Drawing code uses this value to interpolate between the state of the previous step and the state of the
+	*** latest step, so that motion appears smooth when the frame rate and the step rate differ.
+	**/
+	float GetInterpolationAlpha() const
+		{ return (_step_time == 0) ? 1.0f : (static_cast<float>(_accumulated_time) / static_cast<float>(_step_time)); }
+
 	/** \brief Checks all system timers for whether they should be paused or resumed
 	*** This function is typically called whenever the ModeEngine class has changed the active game mode.
 	*** When this is done, all system timers that are owned by the active game mode are resumed, all timers with
-	*** a different owner are paused, and all timers with no owner are ignored.
+	*** a different owner are paused, and all timers with no owner are ignored. Likewise, only the timer wheel of
+	*** the active game mode is advanced from then on.
 	**/
 	void ExamineSystemTimers();
 
+	/** \brief Returns a timer wheel that is advanced along with the game's time
+	*** \param owner The game mode that owns the wheel, or nullptr for the wheel of calls that have no owner
+	*** \return A pointer to the wheel, which is created the first time that it is requested for a game mode
+	***
+	*** The wheel with no owner is advanced on every simulation step. A wheel owned by a game mode is only advanced
+	*** while that game mode is the active game mode, following the same rules as auto update timers with an owner.
+	*** The wheel of a game mode is destroyed along with that game mode, and all of its calls are discarded.
+	**/
+	TimerWheel* GetTimerWheel(hoa_mode_manager::GameMode* owner = nullptr);
+
+	/** \brief Destroys the timer wheel owned by a game mode without making any of its scheduled calls
+	*** \param owner The game mode to destroy the wheel of
+	*** \note This is called by the GameMode destructor and when a game mode is parked in the mode pool. There is
+	*** usually no reason to call it anywhere else.
+	**/
+	void ReleaseTimerWheel(hoa_mode_manager::GameMode* owner);
+
 	/** \brief Retrieves the amount of time that the game should be updated by for time-based movement.
 	*** \return The number of milliseconds that have transpired since the last update.
 	***
@@ -365,6 +555,37 @@ public:
 	uint32 GetUpdateTime() const
 		{ return _update_time; }
 
+	/** \brief Makes every timer update advance the game by a constant amount of time instead of the measured time
+	*** \param update_time The number of milliseconds that each update should represent, or zero to measure real time
+	***
+	*** A fixed update time makes the game's progression independent of how quickly each frame is processed. This
+	*** is necessary for replaying recorded input deterministically and for comparing performance between builds.
+	**/
+	void SetFixedUpdateTime(uint32 update_time)
+		{ _fixed_update_time = update_time; }
+
+	//! \brief Returns the fixed update time in milliseconds, or zero if real time is being measured
+	uint32 GetFixedUpdateTime() const
+		{ return _fixed_update_time; }
+
+	/** \brief Retrieves the real amount of time that the last frame took to process
+	*** \return The number of milliseconds that have transpired since the last update, regardless of any fixed update time
+	**/
+	uint32 GetMeasuredUpdateTime() const
+		{ return _measured_update_time; }
+
+	/** \brief Retrieves the amount of time that the last frame represents
+	*** \return The measured or fixed frame time in milliseconds, regardless of how many simulation steps it was split into
+	***
+	*** Code that runs once per frame instead of once per simulation step, such as screen effects, should use this
+	*** value rather than GetUpdateTime().
+	**/
+	uint32 GetFrameTime() const
+		{ return _frame_time; }
+
+	//! \brief Prints the number of frames processed along with their average and longest measured times
+	void DEBUG_PrintFrameTimes() const;
+
 	/** \brief Sets the play time of a game instance
 	*** \param h The amount of hours to set.
 	*** \param m The amount of minutes to set.
@@ -431,6 +652,33 @@ private:
 	//! \brief The number of milliseconds that have transpired on the last timer update.
 	uint32 _update_time;
 
+	//! \brief When non-zero, the number of milliseconds that every update is set to instead of the measured time
+	uint32 _fixed_update_time;
+
+	//! \brief The number of milliseconds that really transpired on the last timer update
+	uint32 _measured_update_time;
+
+	//! \brief The number of milliseconds that the last frame represents (either the fixed or the measured time)
+	uint32 _frame_time;
+
+	//! \brief The number of milliseconds in each simulation step, or zero to update once per frame
+	uint32 _step_time;
+
+	//! \brief The frame time that has not yet been consumed by a simulation step
+	uint32 _accumulated_time;
+
+	//! \brief The number of simulation steps that remain to be taken for the current frame
+	uint32 _pending_steps;
+
+	/** \name Frame time statistics
+	*** \brief The number of updates performed along with the sum and maximum of their measured times
+	**/
+	//@{
+	uint32 _frame_count;
+	uint32 _total_frame_time;
+	uint32 _longest_frame_time;
+	//@}
+
 	/** \name Play time members
 	*** \brief Timers that retain the total amount of time that the user has been playing
 	*** When the player starts a new game or loads an existing game, these timers are reset.
@@ -448,10 +696,23 @@ private:
 	//! \brief The identification string that determines what language the game is running in
 	std::string _language;
 
-	/** \brief A set container for all SystemTimer objects that have automatic updating enabled
-	*** The timers in this container are updated on each call to UpdateTimers().
+	/** \brief A container for all SystemTimer objects that have automatic updating enabled
+	*** The timers in this container are updated on each call to SimulationStep(). Each timer records its own position
+	*** in the container so that it can be removed without searching for it.
 	**/
-	std::set<SystemTimer*> _auto_system_timers;
+	std::vector<SystemTimer*> _auto_system_timers;
+
+	//! \brief The timer wheel for scheduled calls that are not owned by any game mode
+	TimerWheel _timer_wheel;
+
+	//! \brief The timer wheels that are owned by game modes
+	std::map<hoa_mode_manager::GameMode*, TimerWheel*> _mode_timer_wheels;
+
+	//! \brief The game mode that was active on the last call to ExamineSystemTimers()
+	hoa_mode_manager::GameMode* _active_timer_mode;
+
+	//! \brief The timer wheel owned by the active game mode, or nullptr if it does not own one
+	TimerWheel* _active_timer_wheel;
 }; // class SystemEngine : public hoa_utils::Singleton<SystemEngine>
 
 
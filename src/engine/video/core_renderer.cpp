@@ -0,0 +1,415 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    core_renderer.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for drawing with an OpenGL 3.3 core profile context
+*** ***************************************************************************/
+
+#include <SDL2/SDL.h>
+
+#include "core_renderer.h"
+#include "video.h"
+
+using namespace std;
+using namespace hoa_utils;
+
+namespace hoa_video {
+
+namespace private_video {
+
+namespace {
+
+// The OpenGL 2.0 and later constants are declared here because the system OpenGL headers may predate them
+const GLenum CORE_FRAGMENT_SHADER = 0x8B30;
+const GLenum CORE_VERTEX_SHADER = 0x8B31;
+const GLenum CORE_COMPILE_STATUS = 0x8B81;
+const GLenum CORE_LINK_STATUS = 0x8B82;
+const GLenum CORE_INFO_LOG_LENGTH = 0x8B84;
+const GLenum CORE_ARRAY_BUFFER = 0x8892;
+const GLenum CORE_ELEMENT_ARRAY_BUFFER = 0x8893;
+const GLenum CORE_STREAM_DRAW = 0x88E0;
+const GLenum CORE_STATIC_DRAW = 0x88E4;
+
+//! \brief The attribute indices of the vertex shader inputs
+enum {
+	POSITION_ATTRIBUTE = 0,
+	TEX_COORD_ATTRIBUTE = 1,
+	COLOR_ATTRIBUTE = 2
+};
+
+const char* VERTEX_SHADER_SOURCE =
+	"#version 330 core\n"
+	"uniform mat4 projection;\n"
+	"in vec2 position;\n"
+	"in vec2 tex_coord;\n"
+	"in vec4 color;\n"
+	"out vec2 fragment_tex_coord;\n"
+	"out vec4 fragment_color;\n"
+	"void main() {\n"
+	"	fragment_tex_coord = tex_coord;\n"
+	"	fragment_color = color;\n"
+	"	gl_Position = projection * vec4(position, 0.0, 1.0);\n"
+	"}\n";
+
+const char* COLOR_FRAGMENT_SHADER_SOURCE =
+	"#version 330 core\n"
+	"in vec2 fragment_tex_coord;\n"
+	"in vec4 fragment_color;\n"
+	"out vec4 output_color;\n"
+	"void main() {\n"
+	"	output_color = fragment_color;\n"
+	"}\n";
+
+// Modulating the texture by the vertex color matches the default GL_MODULATE texture environment
+const char* TEXTURE_FRAGMENT_SHADER_SOURCE =
+	"#version 330 core\n"
+	"uniform sampler2D image;\n"
+	"uniform float alpha_threshold;\n"
+	"in vec2 fragment_tex_coord;\n"
+	"in vec4 fragment_color;\n"
+	"out vec4 output_color;\n"
+	"void main() {\n"
+	"	vec4 color = texture(image, fragment_tex_coord) * fragment_color;\n"
+	"	if (color.a <= alpha_threshold)\n"
+	"		discard;\n"
+	"	output_color = color;\n"
+	"}\n";
+
+//! \brief Loads an OpenGL entry point into a function pointer of any type
+template <typename T> bool LoadFunction(T& function, const char* name) {
+	function = reinterpret_cast<T>(SDL_GL_GetProcAddress(name));
+	if (function == nullptr) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL function was not available: " << name << endl;
+		return false;
+	}
+	return true;
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// CoreRenderer class methods
+// -----------------------------------------------------------------------------
+
+CoreRenderer::CoreRenderer() :
+	_active(false),
+	_current_program(nullptr),
+	_vertex_array(0),
+	_vertex_buffer(0),
+	_index_buffer(0),
+	_index_buffer_quads(0),
+	_projection_serial(1),
+	_alpha_threshold(CORE_ALPHA_TEST_DISABLED)
+{
+	SetProjection(0.0f, 1024.0f, 0.0f, 768.0f);
+}
+
+
+
+bool CoreRenderer::Initialize() {
+	Destroy();
+
+	if (_LoadFunctions() == false) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "the OpenGL context does not provide the functions required by the core profile renderer" << endl;
+		return false;
+	}
+
+	if (_CreateProgram(_color_program, COLOR_FRAGMENT_SHADER_SOURCE) == false ||
+		_CreateProgram(_texture_program, TEXTURE_FRAGMENT_SHADER_SOURCE) == false)
+	{
+		Destroy();
+		return false;
+	}
+
+	// Core profile contexts are unable to draw anything without a vertex array object bound
+	_glGenVertexArrays(1, &_vertex_array);
+	_glBindVertexArray(_vertex_array);
+	_glGenBuffers(1, &_vertex_buffer);
+	_glGenBuffers(1, &_index_buffer);
+
+	// The element array buffer binding is part of the vertex array state, so it only needs to be bound once
+	_glBindBuffer(CORE_ARRAY_BUFFER, _vertex_buffer);
+	_glBindBuffer(CORE_ELEMENT_ARRAY_BUFFER, _index_buffer);
+	_glEnableVertexAttribArray(POSITION_ATTRIBUTE);
+	_glEnableVertexAttribArray(TEX_COORD_ATTRIBUTE);
+	_glEnableVertexAttribArray(COLOR_ATTRIBUTE);
+	_glVertexAttribPointer(POSITION_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(CoreVertex),
+		reinterpret_cast<const void*>(offsetof(CoreVertex, x)));
+	_glVertexAttribPointer(TEX_COORD_ATTRIBUTE, 2, GL_FLOAT, GL_FALSE, sizeof(CoreVertex),
+		reinterpret_cast<const void*>(offsetof(CoreVertex, u)));
+	_glVertexAttribPointer(COLOR_ATTRIBUTE, 4, GL_FLOAT, GL_FALSE, sizeof(CoreVertex),
+		reinterpret_cast<const void*>(offsetof(CoreVertex, red)));
+
+	_index_buffer_quads = 0;
+	_ReserveIndices(CORE_INITIAL_QUADS);
+
+	// The texture program always samples from the first texture unit
+	_glUseProgram(_texture_program.program);
+	_glUniform1i(_glGetUniformLocation(_texture_program.program, "image"), 0);
+	_glUseProgram(0);
+	_current_program = nullptr;
+
+	_active = true;
+	return true;
+} // bool CoreRenderer::Initialize()
+
+
+
+void CoreRenderer::Destroy() {
+	// The entry points are only guaranteed to be loaded if one of the objects was created
+	if (_color_program.program == 0 && _texture_program.program == 0 && _vertex_array == 0)
+		return;
+
+	_glUseProgram(0);
+	if (_color_program.program != 0)
+		_glDeleteProgram(_color_program.program);
+	if (_texture_program.program != 0)
+		_glDeleteProgram(_texture_program.program);
+	if (_vertex_buffer != 0)
+		_glDeleteBuffers(1, &_vertex_buffer);
+	if (_index_buffer != 0)
+		_glDeleteBuffers(1, &_index_buffer);
+	if (_vertex_array != 0)
+		_glDeleteVertexArrays(1, &_vertex_array);
+
+	_color_program = CoreShaderProgram();
+	_texture_program = CoreShaderProgram();
+	_current_program = nullptr;
+	_vertex_array = 0;
+	_vertex_buffer = 0;
+	_index_buffer = 0;
+	_index_buffer_quads = 0;
+	_active = false;
+}
+
+
+
+void CoreRenderer::SetProjection(float left, float right, float bottom, float top) {
+	// This is the matrix that glOrtho() produces with a near plane of -1 and a far plane of 1
+	for (uint32 i = 0; i < 16; ++i)
+		_projection[i] = 0.0f;
+
+	_projection[0] = 2.0f / (right - left);
+	_projection[5] = 2.0f / (top - bottom);
+	_projection[10] = -1.0f;
+	_projection[12] = -(right + left) / (right - left);
+	_projection[13] = -(top + bottom) / (top - bottom);
+	_projection[15] = 1.0f;
+	++_projection_serial;
+}
+
+
+
+void CoreRenderer::DrawQuads(const Transform2D& transform, const float* vertices, const float* tex_coords, const Color* colors,
+	bool single_color, uint32 quad_count)
+{
+	if (_active == false || quad_count == 0)
+		return;
+
+	uint32 vertex_count = quad_count * 4;
+	_vertices.resize(vertex_count);
+	for (uint32 i = 0; i < vertex_count; ++i) {
+		CoreVertex& vertex = _vertices[i];
+		transform.Apply(vertices[i * 2], vertices[i * 2 + 1], vertex.x, vertex.y);
+
+		if (tex_coords != nullptr) {
+			vertex.u = tex_coords[i * 2];
+			vertex.v = tex_coords[i * 2 + 1];
+		}
+		else {
+			vertex.u = 0.0f;
+			vertex.v = 0.0f;
+		}
+
+		const Color& color = single_color ? colors[0] : colors[i];
+		vertex.red = color[0];
+		vertex.green = color[1];
+		vertex.blue = color[2];
+		vertex.alpha = color[3];
+	}
+
+	_UseProgram(tex_coords != nullptr ? _texture_program : _color_program);
+	_ReserveIndices(quad_count);
+	_UploadVertices();
+	glDrawElements(GL_TRIANGLES, quad_count * 6, GL_UNSIGNED_INT, nullptr);
+}
+
+
+
+void CoreRenderer::DrawLines(const Transform2D& transform, const float* vertices, uint32 vertex_count, const Color& color) {
+	if (_active == false || vertex_count == 0)
+		return;
+
+	_vertices.resize(vertex_count);
+	for (uint32 i = 0; i < vertex_count; ++i) {
+		CoreVertex& vertex = _vertices[i];
+		transform.Apply(vertices[i * 2], vertices[i * 2 + 1], vertex.x, vertex.y);
+		vertex.u = 0.0f;
+		vertex.v = 0.0f;
+		vertex.red = color[0];
+		vertex.green = color[1];
+		vertex.blue = color[2];
+		vertex.alpha = color[3];
+	}
+
+	_UseProgram(_color_program);
+	_UploadVertices();
+	glDrawArrays(GL_LINES, 0, vertex_count);
+}
+
+
+
+bool CoreRenderer::_LoadFunctions() {
+	return LoadFunction(_glCreateShader, "glCreateShader") && LoadFunction(_glShaderSource, "glShaderSource") &&
+		LoadFunction(_glCompileShader, "glCompileShader") && LoadFunction(_glGetShaderiv, "glGetShaderiv") &&
+		LoadFunction(_glGetShaderInfoLog, "glGetShaderInfoLog") && LoadFunction(_glDeleteShader, "glDeleteShader") &&
+		LoadFunction(_glCreateProgram, "glCreateProgram") && LoadFunction(_glAttachShader, "glAttachShader") &&
+		LoadFunction(_glBindAttribLocation, "glBindAttribLocation") && LoadFunction(_glLinkProgram, "glLinkProgram") &&
+		LoadFunction(_glGetProgramiv, "glGetProgramiv") && LoadFunction(_glGetProgramInfoLog, "glGetProgramInfoLog") &&
+		LoadFunction(_glDeleteProgram, "glDeleteProgram") && LoadFunction(_glUseProgram, "glUseProgram") &&
+		LoadFunction(_glGetUniformLocation, "glGetUniformLocation") && LoadFunction(_glUniform1i, "glUniform1i") &&
+		LoadFunction(_glUniform1f, "glUniform1f") && LoadFunction(_glUniformMatrix4fv, "glUniformMatrix4fv") &&
+		LoadFunction(_glGenVertexArrays, "glGenVertexArrays") && LoadFunction(_glBindVertexArray, "glBindVertexArray") &&
+		LoadFunction(_glDeleteVertexArrays, "glDeleteVertexArrays") && LoadFunction(_glGenBuffers, "glGenBuffers") &&
+		LoadFunction(_glBindBuffer, "glBindBuffer") && LoadFunction(_glBufferData, "glBufferData") &&
+		LoadFunction(_glDeleteBuffers, "glDeleteBuffers") && LoadFunction(_glEnableVertexAttribArray, "glEnableVertexAttribArray") &&
+		LoadFunction(_glVertexAttribPointer, "glVertexAttribPointer");
+}
+
+
+
+bool CoreRenderer::_CreateProgram(CoreShaderProgram& program, const char* fragment_source) {
+	GLuint vertex_shader = _CompileShader(CORE_VERTEX_SHADER, VERTEX_SHADER_SOURCE);
+	GLuint fragment_shader = _CompileShader(CORE_FRAGMENT_SHADER, fragment_source);
+	if (vertex_shader == 0 || fragment_shader == 0) {
+		if (vertex_shader != 0)
+			_glDeleteShader(vertex_shader);
+		if (fragment_shader != 0)
+			_glDeleteShader(fragment_shader);
+		return false;
+	}
+
+	program.program = _glCreateProgram();
+	_glAttachShader(program.program, vertex_shader);
+	_glAttachShader(program.program, fragment_shader);
+	_glBindAttribLocation(program.program, POSITION_ATTRIBUTE, "position");
+	_glBindAttribLocation(program.program, TEX_COORD_ATTRIBUTE, "tex_coord");
+	_glBindAttribLocation(program.program, COLOR_ATTRIBUTE, "color");
+	_glLinkProgram(program.program);
+
+	// The shaders are only flagged for deletion here, and are deleted along with the program
+	_glDeleteShader(vertex_shader);
+	_glDeleteShader(fragment_shader);
+
+	GLint status = GL_FALSE;
+	_glGetProgramiv(program.program, CORE_LINK_STATUS, &status);
+	if (status == GL_FALSE) {
+		GLint log_length = 0;
+		_glGetProgramiv(program.program, CORE_INFO_LOG_LENGTH, &log_length);
+		string log(log_length > 0 ? log_length : 1, '\0');
+		_glGetProgramInfoLog(program.program, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+		PRINT_ERROR << "failed to link shader program: " << log << endl;
+		_glDeleteProgram(program.program);
+		program.program = 0;
+		return false;
+	}
+
+	program.projection_location = _glGetUniformLocation(program.program, "projection");
+	program.alpha_threshold_location = _glGetUniformLocation(program.program, "alpha_threshold");
+	program.projection_serial = 0;
+	program.alpha_threshold = CORE_ALPHA_TEST_DISABLED;
+	if (program.alpha_threshold_location != -1) {
+		_glUseProgram(program.program);
+		_glUniform1f(program.alpha_threshold_location, program.alpha_threshold);
+	}
+	return true;
+} // bool CoreRenderer::_CreateProgram(CoreShaderProgram& program, const char* fragment_source)
+
+
+
+GLuint CoreRenderer::_CompileShader(GLenum type, const char* source) {
+	GLuint shader = _glCreateShader(type);
+	_glShaderSource(shader, 1, &source, nullptr);
+	_glCompileShader(shader);
+
+	GLint status = GL_FALSE;
+	_glGetShaderiv(shader, CORE_COMPILE_STATUS, &status);
+	if (status == GL_FALSE) {
+		GLint log_length = 0;
+		_glGetShaderiv(shader, CORE_INFO_LOG_LENGTH, &log_length);
+		string log(log_length > 0 ? log_length : 1, '\0');
+		_glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, &log[0]);
+		PRINT_ERROR << "failed to compile " << (type == CORE_VERTEX_SHADER ? "vertex" : "fragment") << " shader: " << log << endl;
+		_glDeleteShader(shader);
+		return 0;
+	}
+
+	return shader;
+}
+
+
+
+void CoreRenderer::_UseProgram(CoreShaderProgram& program) {
+	if (_current_program != &program) {
+		_glUseProgram(program.program);
+		_current_program = &program;
+	}
+
+	if (program.projection_serial != _projection_serial) {
+		_glUniformMatrix4fv(program.projection_location, 1, GL_FALSE, _projection);
+		program.projection_serial = _projection_serial;
+	}
+
+	if (program.alpha_threshold_location != -1 && program.alpha_threshold != _alpha_threshold) {
+		_glUniform1f(program.alpha_threshold_location, _alpha_threshold);
+		program.alpha_threshold = _alpha_threshold;
+	}
+}
+
+
+
+void CoreRenderer::_ReserveIndices(uint32 quad_count) {
+	if (quad_count <= _index_buffer_quads)
+		return;
+
+	// Grow geometrically so that a slowly growing particle system does not rebuild the buffer every frame
+	uint32 new_quads = (_index_buffer_quads == 0) ? quad_count : _index_buffer_quads;
+	while (new_quads < quad_count)
+		new_quads *= 2;
+
+	vector<GLuint> indices(new_quads * 6);
+	for (uint32 i = 0; i < new_quads; ++i) {
+		GLuint first = i * 4;
+		indices[i * 6] = first;
+		indices[i * 6 + 1] = first + 1;
+		indices[i * 6 + 2] = first + 2;
+		indices[i * 6 + 3] = first;
+		indices[i * 6 + 4] = first + 2;
+		indices[i * 6 + 5] = first + 3;
+	}
+
+	_glBindVertexArray(_vertex_array);
+	_glBufferData(CORE_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], CORE_STATIC_DRAW);
+	_index_buffer_quads = new_quads;
+}
+
+
+
+void CoreRenderer::_UploadVertices() {
+	_glBindVertexArray(_vertex_array);
+	_glBindBuffer(CORE_ARRAY_BUFFER, _vertex_buffer);
+	// Respecifying the whole buffer lets the driver hand out new storage instead of waiting on the previous draw
+	_glBufferData(CORE_ARRAY_BUFFER, _vertices.size() * sizeof(CoreVertex), &_vertices[0], CORE_STREAM_DRAW);
+}
+
+} // namespace private_video
+
+} // namespace hoa_video
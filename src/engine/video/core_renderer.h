@@ -0,0 +1,284 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    core_renderer.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for drawing with an OpenGL 3.3 core profile context
+***
+*** By default the video engine draws with the fixed-function pipeline, which
+*** requires a compatibility context. When the core profile is requested, the
+*** video engine creates an OpenGL 3.3 core context and submits all geometry
+*** through the CoreRenderer instead. The model-view transformation is kept on
+*** the CPU (see Transform2D), vertices are transformed before they are
+*** uploaded, and every quad is drawn as two triangles with per-vertex colors.
+*** Only the projection matrix and the alpha test threshold are ever uploaded
+*** as shader uniforms, and only when they change.
+***
+*** The renderer only uses functionality that Mesa's llvmpipe driver supports,
+*** so it may be exercised on machines without a GPU by setting the environment
+*** variable LIBGL_ALWAYS_SOFTWARE=1.
+*** ***************************************************************************/
+
+#pragma once
+
+// OpenGL includes
+#ifdef __APPLE__
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+
+#include <cstddef>
+
+#include "defs.h"
+#include "utils.h"
+
+#include "color.h"
+#include "transform.h"
+
+namespace hoa_video {
+
+namespace private_video {
+
+//! \brief The texture wrap mode to use for texture sheets in a core profile context, where GL_CLAMP is not available
+const GLenum CORE_TEXTURE_WRAP_MODE = 0x812F; // GL_CLAMP_TO_EDGE
+
+//! \brief The alpha test threshold that disables alpha testing, since no fragment has an alpha value below zero
+const float CORE_ALPHA_TEST_DISABLED = -1.0f;
+
+//! \brief The number of quads that the index buffer initially holds indices for
+const uint32 CORE_INITIAL_QUADS = 256;
+
+/** ****************************************************************************
+*** \brief A single vertex in the format that is uploaded to the vertex buffer
+*** ***************************************************************************/
+class CoreVertex {
+public:
+	//! \brief The position of the vertex after the model-view transformation has been applied
+	float x, y;
+
+	//! \brief The texture coordinates of the vertex
+	float u, v;
+
+	//! \brief The color of the vertex
+	float red, green, blue, alpha;
+}; // class CoreVertex
+
+
+/** ****************************************************************************
+*** \brief A linked shader program and the uniform values last uploaded to it
+*** ***************************************************************************/
+class CoreShaderProgram {
+public:
+	CoreShaderProgram() :
+		program(0), projection_location(-1), alpha_threshold_location(-1), projection_serial(0),
+		alpha_threshold(CORE_ALPHA_TEST_DISABLED) {}
+
+	//! \brief The OpenGL name of the program
+	GLuint program;
+
+	//! \brief The locations of the uniforms, or -1 if the program does not use them
+	GLint projection_location, alpha_threshold_location;
+
+	//! \brief The serial number of the projection matrix that was last uploaded to the program
+	uint32 projection_serial;
+
+	//! \brief The alpha test threshold that was last uploaded to the program
+	float alpha_threshold;
+}; // class CoreShaderProgram
+
+
+/** ****************************************************************************
+*** \brief Draws geometry with shaders on an OpenGL 3.3 core profile context
+***
+*** The caller remains responsible for binding textures and for the blending,
+*** stencil, and scissor state, which work identically in both pipelines.
+***
+*** \note Initialize() loads the entry points for the current context, so it must
+*** be called again whenever the context is replaced.
+*** ***************************************************************************/
+class CoreRenderer {
+public:
+	CoreRenderer();
+
+	~CoreRenderer()
+		{}
+
+	/** \brief Loads the OpenGL 3.3 entry points and creates the shaders and buffers
+	*** \return True if the renderer is ready to draw, false if the current context does not support it
+	**/
+	bool Initialize();
+
+	//! \brief Deletes all OpenGL objects, which must be done while the context that created them is still current
+	void Destroy();
+
+	//! \brief Returns true if the renderer was initialized and is used for all drawing
+	bool IsActive() const
+		{ return _active; }
+
+	//! \brief Sets the orthographic projection for the visible area, like glOrtho() with a depth range of -1 to 1
+	void SetProjection(float left, float right, float bottom, float top);
+
+	/** \brief Sets the alpha test, like glAlphaFunc(GL_GREATER, threshold)
+	*** \param threshold Fragments with an alpha value at or below this are discarded. Use CORE_ALPHA_TEST_DISABLED to disable the test.
+	**/
+	void SetAlphaTest(float threshold)
+		{ _alpha_threshold = threshold; }
+
+	/** \brief Draws a series of quads, each specified by four vertices in the order used by GL_QUADS
+	*** \param transform The model-view transformation to apply to the vertices
+	*** \param vertices An array of two coordinates for each vertex
+	*** \param tex_coords An array of two texture coordinates for each vertex, or nullptr to draw without a texture
+	*** \param colors An array with a color for each vertex, or a single color if single_color is true
+	*** \param single_color True if every vertex is drawn with the first color in the colors array
+	*** \param quad_count The number of quads to draw
+	*** \note The texture to draw with must already be bound
+	**/
+	void DrawQuads(const Transform2D& transform, const float* vertices, const float* tex_coords, const Color* colors,
+		bool single_color, uint32 quad_count);
+
+	/** \brief Draws a series of independent line segments, like GL_LINES
+	*** \param transform The model-view transformation to apply to the vertices
+	*** \param vertices An array of two coordinates for each vertex, with two vertices for each line
+	*** \param vertex_count The number of vertices in the array
+	*** \param color The color of every line
+	**/
+	void DrawLines(const Transform2D& transform, const float* vertices, uint32 vertex_count, const Color& color);
+
+private:
+	//! \name OpenGL 3.3 entry point signatures
+	//@{
+	typedef GLuint (APIENTRY *CreateShaderFunction)(GLenum type);
+	typedef void (APIENTRY *ShaderSourceFunction)(GLuint shader, GLsizei count, const char* const* source, const GLint* length);
+	typedef void (APIENTRY *CompileShaderFunction)(GLuint shader);
+	typedef void (APIENTRY *GetShaderivFunction)(GLuint shader, GLenum name, GLint* value);
+	typedef void (APIENTRY *GetShaderInfoLogFunction)(GLuint shader, GLsizei size, GLsizei* length, char* log);
+	typedef void (APIENTRY *DeleteShaderFunction)(GLuint shader);
+	typedef GLuint (APIENTRY *CreateProgramFunction)();
+	typedef void (APIENTRY *AttachShaderFunction)(GLuint program, GLuint shader);
+	typedef void (APIENTRY *BindAttribLocationFunction)(GLuint program, GLuint index, const char* name);
+	typedef void (APIENTRY *LinkProgramFunction)(GLuint program);
+	typedef void (APIENTRY *GetProgramivFunction)(GLuint program, GLenum name, GLint* value);
+	typedef void (APIENTRY *GetProgramInfoLogFunction)(GLuint program, GLsizei size, GLsizei* length, char* log);
+	typedef void (APIENTRY *DeleteProgramFunction)(GLuint program);
+	typedef void (APIENTRY *UseProgramFunction)(GLuint program);
+	typedef GLint (APIENTRY *GetUniformLocationFunction)(GLuint program, const char* name);
+	typedef void (APIENTRY *Uniform1iFunction)(GLint location, GLint value);
+	typedef void (APIENTRY *Uniform1fFunction)(GLint location, GLfloat value);
+	typedef void (APIENTRY *UniformMatrix4fvFunction)(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value);
+	typedef void (APIENTRY *GenVertexArraysFunction)(GLsizei count, GLuint* arrays);
+	typedef void (APIENTRY *BindVertexArrayFunction)(GLuint array);
+	typedef void (APIENTRY *DeleteVertexArraysFunction)(GLsizei count, const GLuint* arrays);
+	typedef void (APIENTRY *GenBuffersFunction)(GLsizei count, GLuint* buffers);
+	typedef void (APIENTRY *BindBufferFunction)(GLenum target, GLuint buffer);
+	typedef void (APIENTRY *BufferDataFunction)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+	typedef void (APIENTRY *DeleteBuffersFunction)(GLsizei count, const GLuint* buffers);
+	typedef void (APIENTRY *EnableVertexAttribArrayFunction)(GLuint index);
+	typedef void (APIENTRY *VertexAttribPointerFunction)(GLuint index, GLint size, GLenum type, GLboolean normalized,
+		GLsizei stride, const void* pointer);
+	//@}
+
+	//! \name OpenGL 3.3 entry points for the current context
+	//@{
+	CreateShaderFunction _glCreateShader;
+	ShaderSourceFunction _glShaderSource;
+	CompileShaderFunction _glCompileShader;
+	GetShaderivFunction _glGetShaderiv;
+	GetShaderInfoLogFunction _glGetShaderInfoLog;
+	DeleteShaderFunction _glDeleteShader;
+	CreateProgramFunction _glCreateProgram;
+	AttachShaderFunction _glAttachShader;
+	BindAttribLocationFunction _glBindAttribLocation;
+	LinkProgramFunction _glLinkProgram;
+	GetProgramivFunction _glGetProgramiv;
+	GetProgramInfoLogFunction _glGetProgramInfoLog;
+	DeleteProgramFunction _glDeleteProgram;
+	UseProgramFunction _glUseProgram;
+	GetUniformLocationFunction _glGetUniformLocation;
+	Uniform1iFunction _glUniform1i;
+	Uniform1fFunction _glUniform1f;
+	UniformMatrix4fvFunction _glUniformMatrix4fv;
+	GenVertexArraysFunction _glGenVertexArrays;
+	BindVertexArrayFunction _glBindVertexArray;
+	DeleteVertexArraysFunction _glDeleteVertexArrays;
+	GenBuffersFunction _glGenBuffers;
+	BindBufferFunction _glBindBuffer;
+	BufferDataFunction _glBufferData;
+	DeleteBuffersFunction _glDeleteBuffers;
+	EnableVertexAttribArrayFunction _glEnableVertexAttribArray;
+	VertexAttribPointerFunction _glVertexAttribPointer;
+	//@}
+
+	//! \brief True if the renderer was initialized successfully
+	bool _active;
+
+	//! \brief The program for untextured geometry, which only uses the vertex colors
+	CoreShaderProgram _color_program;
+
+	//! \brief The program for textured geometry, which modulates the texture by the vertex colors and applies the alpha test
+	CoreShaderProgram _texture_program;
+
+	//! \brief The program that is currently in use, or nullptr if none is
+	CoreShaderProgram* _current_program;
+
+	//! \brief The vertex array object that holds the vertex format
+	GLuint _vertex_array;
+
+	//! \brief The buffer that vertices are streamed into before every draw
+	GLuint _vertex_buffer;
+
+	//! \brief The buffer that holds the indices that split each quad into two triangles
+	GLuint _index_buffer;
+
+	//! \brief The number of quads that the index buffer holds indices for
+	uint32 _index_buffer_quads;
+
+	//! \brief The current projection matrix, in column-major order
+	float _projection[16];
+
+	//! \brief Incremented every time that the projection changes so that programs know when to upload it again
+	uint32 _projection_serial;
+
+	//! \brief The current alpha test threshold
+	float _alpha_threshold;
+
+	//! \brief Reused to build the vertices of each draw so that drawing does not allocate memory
+	std::vector<CoreVertex> _vertices;
+
+	//! \brief Loads all of the entry points, returning false if any of them are missing
+	bool _LoadFunctions();
+
+	/** \brief Compiles and links a shader program
+	*** \param program The program to initialize
+	*** \param fragment_source The source of the fragment shader to use with the common vertex shader
+	*** \return True if the program was created successfully
+	**/
+	bool _CreateProgram(CoreShaderProgram& program, const char* fragment_source);
+
+	//! \brief Compiles a single shader, returning zero if compilation failed
+	GLuint _CompileShader(GLenum type, const char* source);
+
+	//! \brief Makes a program current and uploads any uniform values that have changed since it was last used
+	void _UseProgram(CoreShaderProgram& program);
+
+	//! \brief Makes sure that the index buffer holds indices for at least the given number of quads
+	void _ReserveIndices(uint32 quad_count);
+
+	//! \brief Uploads the vertices that were built in _vertices and binds the vertex array for drawing
+	void _UploadVertices();
+}; // class CoreRenderer
+
+} // namespace private_video
+
+} // namespace hoa_video
@@ -15,21 +15,12 @@ using namespace hoa_video::private_video;
 namespace hoa_video {
 
 ParticleEffectID VideoEngine::AddParticleEffect(const string &filename, float x, float y, bool reload) {
-	ParticleEffectDef *def = nullptr;
+	const ParticleEffectDef *def = nullptr;
 
-	bool effect_loaded = _particle_effect_defs.find(filename) != _particle_effect_defs.end();
-
-	if(effect_loaded && !reload)
-	{
-		def = _particle_effect_defs[filename];
-	}
+	if(reload)
+		def = _particle_manager.ReloadEffect(filename);
 	else
-	{
 		def = _particle_manager.LoadEffect(filename);
-		if(effect_loaded)
-			delete _particle_effect_defs[filename];
-		_particle_effect_defs[filename] = def;
-	}
 
 	if(!def)
 	{
@@ -50,6 +41,35 @@ ParticleEffectID VideoEngine::AddParticleEffect(const string &filename, float x,
 }
 
 
+//-----------------------------------------------------------------------------
+// PreloadParticleEffect: loads an effect definition and its images without
+//                        adding the effect, so that adding it later does not
+//                        need to read any files.
+//-----------------------------------------------------------------------------
+
+bool VideoEngine::PreloadParticleEffect(const string &filename)
+{
+	if(_particle_manager.LoadEffect(filename) == nullptr)
+	{
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to load particle definition file: " << filename << endl;
+		return false;
+	}
+
+	return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// ClearParticleEffectCache: releases all loaded effect definitions. Effects
+//                           which are still active keep their definitions.
+//-----------------------------------------------------------------------------
+
+void VideoEngine::ClearParticleEffectCache()
+{
+	_particle_manager.ClearEffectCache();
+}
+
+
 //-----------------------------------------------------------------------------
 // DrawParticleEffects: call this once per frame. You should call this after
 //                      rendering things like tiles, characters, and monsters,
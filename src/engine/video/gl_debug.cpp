@@ -0,0 +1,254 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_debug.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for OpenGL error reporting
+*** ***************************************************************************/
+
+#include <SDL2/SDL.h>
+
+#include "gl_debug.h"
+#include "video.h"
+
+using namespace std;
+using namespace hoa_utils;
+
+namespace hoa_video {
+
+namespace private_video {
+
+namespace {
+
+// The extension constants are declared here because the system OpenGL headers may predate the extensions.
+// GL_ARB_debug_output uses the same values as GL_KHR_debug for every constant that both extensions define.
+const GLenum DEBUG_OUTPUT = 0x92E0;
+const GLenum DEBUG_OUTPUT_SYNCHRONOUS = 0x8242;
+
+const GLenum DEBUG_SOURCE_API = 0x8246;
+const GLenum DEBUG_SOURCE_WINDOW_SYSTEM = 0x8247;
+const GLenum DEBUG_SOURCE_SHADER_COMPILER = 0x8248;
+const GLenum DEBUG_SOURCE_THIRD_PARTY = 0x8249;
+const GLenum DEBUG_SOURCE_APPLICATION = 0x824A;
+
+const GLenum DEBUG_TYPE_ERROR = 0x824C;
+const GLenum DEBUG_TYPE_DEPRECATED_BEHAVIOR = 0x824D;
+const GLenum DEBUG_TYPE_UNDEFINED_BEHAVIOR = 0x824E;
+const GLenum DEBUG_TYPE_PORTABILITY = 0x824F;
+const GLenum DEBUG_TYPE_PERFORMANCE = 0x8250;
+const GLenum DEBUG_TYPE_MARKER = 0x8268;
+const GLenum DEBUG_TYPE_PUSH_GROUP = 0x8269;
+const GLenum DEBUG_TYPE_POP_GROUP = 0x826A;
+
+const GLenum DEBUG_SEVERITY_HIGH = 0x9146;
+const GLenum DEBUG_SEVERITY_MEDIUM = 0x9147;
+const GLenum DEBUG_SEVERITY_LOW = 0x9148;
+const GLenum DEBUG_SEVERITY_NOTIFICATION = 0x826B;
+
+// The range of the OpenGL error codes, which drivers commonly use as the ID of API error messages
+const GLuint FIRST_GL_ERROR_CODE = 0x0500;
+const GLuint LAST_GL_ERROR_CODE = 0x0507;
+
+const char* DebugSourceName(GLenum source) {
+	switch (source) {
+		case DEBUG_SOURCE_API: return "API";
+		case DEBUG_SOURCE_WINDOW_SYSTEM: return "window system";
+		case DEBUG_SOURCE_SHADER_COMPILER: return "shader compiler";
+		case DEBUG_SOURCE_THIRD_PARTY: return "third party";
+		case DEBUG_SOURCE_APPLICATION: return "application";
+		default: return "other";
+	}
+}
+
+
+
+const char* DebugTypeName(GLenum type) {
+	switch (type) {
+		case DEBUG_TYPE_ERROR: return "error";
+		case DEBUG_TYPE_DEPRECATED_BEHAVIOR: return "deprecated behavior";
+		case DEBUG_TYPE_UNDEFINED_BEHAVIOR: return "undefined behavior";
+		case DEBUG_TYPE_PORTABILITY: return "portability";
+		case DEBUG_TYPE_PERFORMANCE: return "performance";
+		default: return "other";
+	}
+}
+
+
+
+const char* DebugSeverityName(GLenum severity) {
+	switch (severity) {
+		case DEBUG_SEVERITY_HIGH: return "high";
+		case DEBUG_SEVERITY_MEDIUM: return "medium";
+		case DEBUG_SEVERITY_LOW: return "low";
+		default: return "notification";
+	}
+}
+
+} // namespace
+
+GLDebugOutput* GLDebugOutput::_active_output = nullptr;
+
+// -----------------------------------------------------------------------------
+// GLDebugOutput class methods
+// -----------------------------------------------------------------------------
+
+GLDebugOutput::GLDebugOutput() :
+	_active(false),
+	_error_reported(false),
+	_last_error_code(GL_NO_ERROR),
+	_debug_message_callback(nullptr),
+	_debug_message_control(nullptr),
+	_push_debug_group(nullptr),
+	_pop_debug_group(nullptr)
+{}
+
+
+
+GLDebugOutput::~GLDebugOutput() {
+	if (_active_output == this)
+		_active_output = nullptr;
+}
+
+
+
+bool GLDebugOutput::Initialize() {
+	Disable();
+
+	bool khr_debug = (SDL_GL_ExtensionSupported("GL_KHR_debug") == SDL_TRUE);
+	if (khr_debug == true) {
+		_debug_message_callback = reinterpret_cast<DebugMessageCallbackFunction>(SDL_GL_GetProcAddress("glDebugMessageCallback"));
+		_debug_message_control = reinterpret_cast<DebugMessageControlFunction>(SDL_GL_GetProcAddress("glDebugMessageControl"));
+		_push_debug_group = reinterpret_cast<PushDebugGroupFunction>(SDL_GL_GetProcAddress("glPushDebugGroup"));
+		_pop_debug_group = reinterpret_cast<PopDebugGroupFunction>(SDL_GL_GetProcAddress("glPopDebugGroup"));
+	}
+	else if (SDL_GL_ExtensionSupported("GL_ARB_debug_output") == SDL_TRUE) {
+		_debug_message_callback = reinterpret_cast<DebugMessageCallbackFunction>(SDL_GL_GetProcAddress("glDebugMessageCallbackARB"));
+		_debug_message_control = reinterpret_cast<DebugMessageControlFunction>(SDL_GL_GetProcAddress("glDebugMessageControlARB"));
+	}
+
+	if (_debug_message_callback == nullptr || _debug_message_control == nullptr) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL debug output is not supported, errors will be checked for once per frame" << endl;
+		Disable();
+		return false;
+	}
+
+	// Only GL_KHR_debug has the notification severity and the switch that enables output in a non-debug context
+	if (khr_debug == true) {
+		glEnable(DEBUG_OUTPUT);
+		_debug_message_control(GL_DONT_CARE, GL_DONT_CARE, DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+	}
+	// The call site is only known while the call that produced the message is still executing
+	glEnable(DEBUG_OUTPUT_SYNCHRONOUS);
+	_debug_message_callback(_MessageCallback, this);
+
+	// Drain any error that occurred before the callback was registered so it is not attributed to a later call
+	while (glGetError() != GL_NO_ERROR);
+
+	_active = true;
+	_active_output = this;
+	return true;
+} // bool GLDebugOutput::Initialize()
+
+
+
+void GLDebugOutput::Disable() {
+	if (_active == true && _debug_message_callback != nullptr) {
+		_debug_message_callback(nullptr, nullptr);
+	}
+
+	if (_active_output == this)
+		_active_output = nullptr;
+
+	_active = false;
+	_error_reported = false;
+	_group_names.clear();
+	_message_counts.clear();
+	_debug_message_callback = nullptr;
+	_debug_message_control = nullptr;
+	_push_debug_group = nullptr;
+	_pop_debug_group = nullptr;
+}
+
+
+
+bool GLDebugOutput::TakeError(GLenum& error_code) {
+	if (_error_reported == false)
+		return false;
+
+	error_code = _last_error_code;
+	_error_reported = false;
+	return true;
+}
+
+
+
+void APIENTRY GLDebugOutput::_MessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+	const char* message, const void* user_data)
+{
+	GLDebugOutput* output = const_cast<GLDebugOutput*>(static_cast<const GLDebugOutput*>(user_data));
+	if (output != nullptr)
+		output->_ReportMessage(source, type, id, severity, message);
+}
+
+
+
+void GLDebugOutput::_ReportMessage(GLenum source, GLenum type, GLuint id, GLenum severity, const char* message) {
+	// The messages produced by our own debug groups are of no interest
+	if (source == DEBUG_SOURCE_APPLICATION || type == DEBUG_TYPE_PUSH_GROUP || type == DEBUG_TYPE_POP_GROUP || type == DEBUG_TYPE_MARKER)
+		return;
+	if (severity == DEBUG_SEVERITY_NOTIFICATION)
+		return;
+
+	if (type == DEBUG_TYPE_ERROR) {
+		_error_reported = true;
+		_last_error_code = (id >= FIRST_GL_ERROR_CODE && id <= LAST_GL_ERROR_CODE) ? static_cast<GLenum>(id) : GL_INVALID_OPERATION;
+		_last_error_message = message;
+	}
+
+	// Some drivers repeat the same performance warning for every draw call, so only the first few reports are printed
+	uint32& count = _message_counts[id];
+	if (count >= GL_DEBUG_MESSAGE_REPEAT_LIMIT)
+		return;
+	++count;
+
+	const char* call_site = GetCallSite();
+	IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL " << DebugSourceName(source) << " " << DebugTypeName(type)
+		<< " (severity: " << DebugSeverityName(severity) << ", ID: " << id << ") in "
+		<< (call_site[0] == '\0' ? "an unknown call site" : call_site) << ": " << message << endl;
+	if (count == GL_DEBUG_MESSAGE_REPEAT_LIMIT) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "further reports of OpenGL message ID " << id << " will be suppressed" << endl;
+	}
+}
+
+
+
+void GLDebugOutput::_PushGroup(const char* name) {
+	_group_names.push_back(name);
+	// An error that was not checked for by the previous group should not be seen by checks within this group
+	_error_reported = false;
+
+	if (_push_debug_group != nullptr)
+		_push_debug_group(DEBUG_SOURCE_APPLICATION, 0, -1, name);
+}
+
+
+
+void GLDebugOutput::_PopGroup() {
+	if (_group_names.empty() == true)
+		return;
+
+	_group_names.pop_back();
+	if (_pop_debug_group != nullptr)
+		_pop_debug_group();
+}
+
+} // namespace private_video
+
+} // namespace hoa_video
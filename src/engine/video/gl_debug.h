@@ -0,0 +1,183 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    gl_debug.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for OpenGL error reporting
+***
+*** Calling glGetError() after a draw or bind forces a round trip to the driver
+*** and serializes the rendering pipeline. When the game runs with video
+*** debugging enabled, the video engine instead requests a debug context and
+*** registers a message callback through the GL_KHR_debug or
+*** GL_ARB_debug_output extensions. The driver then reports errors as they
+*** happen, and each report is attributed to the engine function that issued
+*** the failing call through debug groups. When neither extension is available,
+*** the error flag is only polled once per frame, in VideoEngine::Display().
+***
+*** None of this code does any work when video debugging is disabled.
+*** ***************************************************************************/
+
+#pragma once
+
+// OpenGL includes
+#ifdef __APPLE__
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+
+#include "defs.h"
+#include "utils.h"
+
+namespace hoa_video {
+
+namespace private_video {
+
+//! \brief The number of times that the same debug message is printed before further reports of it are suppressed
+const uint32 GL_DEBUG_MESSAGE_REPEAT_LIMIT = 5;
+
+/** ****************************************************************************
+*** \brief Receives OpenGL error reports from the driver through the debug output extensions
+***
+*** The video engine owns the only instance of this class. Initialize() must be
+*** called each time that a new OpenGL context is created, because the entry
+*** points of the extension functions belong to the context.
+***
+*** Debug output is always synchronous, so the callback runs inside the OpenGL
+*** call that produced the message. This allows the callback to name the debug
+*** group, and therefore the engine function, that was active at the time.
+*** ***************************************************************************/
+class GLDebugOutput {
+	friend class GLDebugGroup;
+
+public:
+	GLDebugOutput();
+
+	~GLDebugOutput();
+
+	/** \brief Enables debug output for the current OpenGL context
+	*** \return True if debug output was enabled, false if the context does not support it
+	*** \note The context should have been created with the debug flag set, or the driver may not report any messages
+	**/
+	bool Initialize();
+
+	//! \brief Stops using debug output, which should be done before the OpenGL context is destroyed
+	void Disable();
+
+	//! \brief Returns true if the driver is reporting errors through the debug output callback
+	bool IsActive() const
+		{ return _active; }
+
+	/** \brief Retrieves and clears the most recent error that the driver reported
+	*** \param error_code Set to the OpenGL error code of the error, if one was reported
+	*** \return True if the driver reported an error since the last call to this function
+	**/
+	bool TakeError(GLenum& error_code);
+
+	//! \brief Returns the text of the most recent error message that the driver reported
+	const std::string& GetLastErrorMessage() const
+		{ return _last_error_message; }
+
+	//! \brief Returns the name of the innermost debug group, or an empty string if no group is active
+	const char* GetCallSite() const
+		{ return _group_names.empty() ? "" : _group_names.back(); }
+
+private:
+	//! \brief Signature of the debug message callback, as defined by the extensions
+	typedef void (APIENTRY *DebugCallback)(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+		const char* message, const void* user_data);
+
+	//! \name Extension function signatures
+	//@{
+	typedef void (APIENTRY *DebugMessageCallbackFunction)(DebugCallback callback, const void* user_data);
+	typedef void (APIENTRY *DebugMessageControlFunction)(GLenum source, GLenum type, GLenum severity, GLsizei count,
+		const GLuint* ids, GLboolean enabled);
+	typedef void (APIENTRY *PushDebugGroupFunction)(GLenum source, GLuint id, GLsizei length, const char* message);
+	typedef void (APIENTRY *PopDebugGroupFunction)();
+	//@}
+
+	//! \brief The instance that is receiving debug output, or nullptr if debug output is not active
+	static GLDebugOutput* _active_output;
+
+	//! \brief True if debug output is enabled on the current context
+	bool _active;
+
+	//! \brief True if an error has been reported since the last call to TakeError()
+	bool _error_reported;
+
+	//! \brief The OpenGL error code of the most recently reported error
+	GLenum _last_error_code;
+
+	//! \brief The text of the most recently reported error
+	std::string _last_error_message;
+
+	//! \brief The names of the active debug groups, from outermost to innermost
+	std::vector<const char*> _group_names;
+
+	//! \brief The number of times that each message ID has been reported, used to suppress repetitive messages
+	std::map<GLuint, uint32> _message_counts;
+
+	//! \name Extension entry points for the current context
+	//! \note The debug group functions are only available through GL_KHR_debug and may be nullptr
+	//@{
+	DebugMessageCallbackFunction _debug_message_callback;
+	DebugMessageControlFunction _debug_message_control;
+	PushDebugGroupFunction _push_debug_group;
+	PopDebugGroupFunction _pop_debug_group;
+	//@}
+
+	//! \brief Receives messages from the driver and forwards them to the instance passed as the user data
+	static void APIENTRY _MessageCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length,
+		const char* message, const void* user_data);
+
+	//! \brief Reports a single debug message
+	void _ReportMessage(GLenum source, GLenum type, GLuint id, GLenum severity, const char* message);
+
+	//! \brief Pushes a debug group onto the driver's group stack and the local stack of names
+	void _PushGroup(const char* name);
+
+	//! \brief Pops the innermost debug group
+	void _PopGroup();
+}; // class GLDebugOutput
+
+
+/** ****************************************************************************
+*** \brief Attributes all OpenGL messages produced within a scope to an engine function
+***
+*** Create an instance of this class as a local variable at the top of a function
+*** that makes OpenGL calls. The constructor only tests a pointer when debug
+*** output is not active, so it is inexpensive enough to use in drawing code.
+***
+*** \note The name must be a string literal or otherwise outlive the group.
+*** ***************************************************************************/
+class GLDebugGroup {
+public:
+	GLDebugGroup(const char* name) :
+		_output(GLDebugOutput::_active_output)
+		{ if (_output != nullptr) _output->_PushGroup(name); }
+
+	~GLDebugGroup()
+		{ if (_output != nullptr) _output->_PopGroup(); }
+
+private:
+	//! \brief The debug output that the group was pushed to, or nullptr if no group was pushed
+	GLDebugOutput* _output;
+
+	GLDebugGroup(const GLDebugGroup& copy);
+	GLDebugGroup& operator=(const GLDebugGroup& copy);
+}; // class GLDebugGroup
+
+} // namespace private_video
+
+} // namespace hoa_video
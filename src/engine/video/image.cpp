@@ -375,8 +375,13 @@ bool ImageDescriptor::SaveMultiImage(const vector<StillImage*>& images, const st
 		return false;
 	}
 
-	TextureManager->_BindTexture(tex_id);
-	glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels);
+	if (VideoManager->IsHeadless() == true) {
+		memset(texture.pixels, 0, texture.width * texture.height * 4);
+	}
+	else {
+		TextureManager->_BindTexture(tex_id);
+		glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels);
+	}
 
 	uint32 i = 0; // i is used to count through the images vector to get the image to save
 	for (uint32 x = 0; x < grid_rows; x++) {
@@ -403,7 +408,10 @@ bool ImageDescriptor::SaveMultiImage(const vector<StillImage*>& images, const st
 						return false;
 					}
 				}
-				glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels);
+				if (VideoManager->IsHeadless() == true)
+					memset(texture.pixels, 0, texture.width * texture.height * 4);
+				else
+					glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, texture.pixels);
 			}
 
 			// Determine the part of the texture that we are interested in (the part that contains the current image we're saving)
@@ -515,7 +523,7 @@ void ImageDescriptor::_DrawOrientation() const {
 		x_scale = -x_scale;
 	if (current_context.coordinate_system.GetVerticalDirection() < 0.0f)
 		y_scale = -y_scale;
-	glScalef(x_scale, y_scale, 1.0f);
+	VideoManager->Scale(x_scale, y_scale);
 }
 
 
@@ -535,6 +543,12 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const {
 	if (draw_color == nullptr)
 		draw_color = _color;
 
+	VideoManager->_render_statistics.RecordDrawCall();
+	if (VideoManager->IsHeadless() == true)
+		return;
+
+	GLDebugGroup debug_group("ImageDescriptor::_DrawTexture");
+
 	// Set blending parameters
 	if (VideoManager->_current_context.blend) {
 		glEnable(GL_BLEND);
@@ -551,8 +565,12 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const {
 		glDisable(GL_BLEND);
 	}
 
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glVertexPointer(2, GL_FLOAT, 0, vert_coords);
+	// With a core profile context, the vertices are drawn by the core renderer instead of through client arrays
+	bool core_profile = VideoManager->_core_renderer.IsActive();
+	if (core_profile == false) {
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glVertexPointer(2, GL_FLOAT, 0, vert_coords);
+	}
 
 	// If we have a valid image texture poiner, setup texture coordinates and the texture coordinate array for glDrawArrays()
 	if (_texture != nullptr) {
@@ -587,25 +605,34 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const {
 		};
 
 		// Enable texturing and bind texture
-		glEnable(GL_TEXTURE_2D);
+		if (core_profile == false)
+			glEnable(GL_TEXTURE_2D);
 		TextureManager->_BindTexture(_texture->texture_sheet->tex_id);
 		_texture->texture_sheet->Smooth(_texture->smooth);
 
-		// Enable and setup the texture coordinate array
-		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-		glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
-
-		if (_unichrome_vertices == true) {
-			glColor4fv((GLfloat*)draw_color[0].GetColors());
-			glDisableClientState(GL_COLOR_ARRAY);
+		if (core_profile == true) {
+			VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, vert_coords, tex_coords, draw_color, _unichrome_vertices, 1);
 		}
 		else {
-			glEnableClientState(GL_COLOR_ARRAY);
-			glColorPointer(4, GL_FLOAT, 0, (GLfloat*)draw_color);
+			// Enable and setup the texture coordinate array
+			glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+			glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
+
+			if (_unichrome_vertices == true) {
+				glColor4fv((GLfloat*)draw_color[0].GetColors());
+				glDisableClientState(GL_COLOR_ARRAY);
+			}
+			else {
+				glEnableClientState(GL_COLOR_ARRAY);
+				glColorPointer(4, GL_FLOAT, 0, (GLfloat*)draw_color);
+			}
 		}
 	} // if (_texture != nullptr)
 
 	// Otherwise there is no image texture, so we're drawing pure color on the vertices
+	else if (core_profile == true) {
+		VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, vert_coords, nullptr, draw_color, _unichrome_vertices, 1);
+	}
 	else {
 		// Use a single call to glColor for unichrome images, or a setup a gl color array for multiple colors
 		if (_unichrome_vertices == true) {
@@ -621,22 +648,20 @@ void ImageDescriptor::_DrawTexture(const Color* draw_color) const {
 		glDisable(GL_TEXTURE_2D);
 	}
 
-	// Use a vertex array to draw all of the vertices
-	glDrawArrays(GL_QUADS, 0, 4);
-	glDisableClientState(GL_VERTEX_ARRAY);
+	if (core_profile == false) {
+		// Use a vertex array to draw all of the vertices
+		glDrawArrays(GL_QUADS, 0, 4);
+		glDisableClientState(GL_VERTEX_ARRAY);
 
-	if (_texture != nullptr)
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		if (_texture != nullptr)
+			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 
-	if (glIsEnabled(GL_COLOR_ARRAY))
-		glDisableClientState(GL_COLOR_ARRAY);
+		if (glIsEnabled(GL_COLOR_ARRAY))
+			glDisableClientState(GL_COLOR_ARRAY);
+	}
 
 	if (VideoManager->_current_context.blend || _blend == true)
 		glDisable(GL_BLEND);
-
-	if (VideoManager->CheckGLError() == true) {
-		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occurred: " << VideoManager->CreateGLErrorString() << endl;
-	}
 } // void ImageDescriptor::_DrawTexture(const Color* color_array) const
 
 
@@ -1019,7 +1044,7 @@ void StillImage::Draw(const Color& draw_color) const {
 		return;
 	}
 
-	glPushMatrix();
+	VideoManager->PushMatrix();
 	_DrawOrientation();
 
 	float modulation = VideoManager->_screen_fader.GetFadeModulation();
@@ -1040,7 +1065,7 @@ void StillImage::Draw(const Color& draw_color) const {
 		_DrawTexture(modulated_colors);
 	}
 
-	glPopMatrix();
+	VideoManager->PopMatrix();
 } // void StillImage::Draw(const Color& draw_color) const
 
 
@@ -1578,7 +1603,7 @@ void CompositeImage::Draw(const Color& draw_color) const {
 		coord_sys.GetVerticalDirection();
 
 	// Save the draw cursor position as we move to draw each element
-	glPushMatrix();
+	VideoManager->PushMatrix();
 
 	VideoManager->MoveRelative(x_align_offset, y_align_offset);
 
@@ -1608,7 +1633,7 @@ void CompositeImage::Draw(const Color& draw_color) const {
 		x_off += x_shake;
 		y_off += y_shake;
 
-		glPushMatrix();
+		VideoManager->PushMatrix();
 		VideoManager->MoveRelative(x_off * coord_sys.GetHorizontalDirection(),
 			y_off * coord_sys.GetVerticalDirection());
 
@@ -1620,7 +1645,7 @@ void CompositeImage::Draw(const Color& draw_color) const {
 		if (coord_sys.GetVerticalDirection() < 0.0f)
 			y_scale = -y_scale;
 
-		glScalef(x_scale, y_scale, 1.0f);
+		VideoManager->Scale(x_scale, y_scale);
 
 		if (skip_modulation)
 			_elements[i].image._DrawTexture(_color);
@@ -1632,9 +1657,9 @@ void CompositeImage::Draw(const Color& draw_color) const {
 			modulated_colors[3] = _color[3] * fade_color;
 			_elements[i].image._DrawTexture(modulated_colors);
 		}
-		glPopMatrix();
+		VideoManager->PopMatrix();
 	}
-	glPopMatrix();
+	VideoManager->PopMatrix();
 } // void CompositeImage::Draw(const Color& draw_color) const
 
 
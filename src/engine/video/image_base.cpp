@@ -14,9 +14,11 @@
 *** ***************************************************************************/
 
 #include <cstdarg>
+#include <cstring>
 #include <math.h>
 
 #include "image_base.h"
+#include "pixel_conversion.h"
 #include "video.h"
 
 using namespace std;
@@ -111,17 +113,11 @@ void ImageMemory::ConvertToGrayscale() {
 		return;
 	}
 
-	uint8 format_bytes = (rgb_format ? 3 : 4);
-	uint8* end_position = static_cast<uint8*>(pixels) + (width * height * format_bytes);
-
-	for (uint8* i = static_cast<uint8*>(pixels); i < end_position; i += format_bytes) {
-		// Compute the grayscale value for this pixel based on RGB values: 0.30R + 0.59G + 0.11B
-		uint8 value = static_cast<uint8>((30 * *(i) + 59 * *(i + 1) + 11 * *(i + 2)) * 0.01f);
-		*i = value;
-		*(i + 1) = value;
-		*(i + 2) = value;
-		// *(i + 3) for RGBA is the alpha value and is left unmodified
-	}
+	// Each pixel is set to 0.30R + 0.59G + 0.11B, and the alpha value of RGBA pixels is left unmodified
+	if (rgb_format == true)
+		ConvertRGBToGrayscale(static_cast<uint8*>(pixels), width * height);
+	else
+		ConvertRGBAToGrayscale(static_cast<uint8*>(pixels), width * height);
 }
 
 
@@ -141,15 +137,7 @@ void ImageMemory::RGBAToRGB() {
 		return;
 	}
 
-	uint8* pixel_index = static_cast<uint8*>(pixels);
-	uint8* pixel_source = pixel_index;
-
-	for (int32 i = 0; i < height * width; i++, pixel_index += 4) {
-		int32 index = 3 * i;
-		pixel_source[index] = *pixel_index;
-		pixel_source[index + 1] = *(pixel_index + 1);
-		pixel_source[index + 2] = *(pixel_index + 2);
-	}
+	ConvertRGBAToRGB(static_cast<uint8*>(pixels), static_cast<uint8*>(pixels), width * height);
 
 	// Reduce the memory consumed by 1/4 since we no longer need to contain alpha data
 	void* new_pixels = realloc(pixels, width * height * 3);
@@ -171,6 +159,13 @@ void ImageMemory::CopyFromTexture(TexSheet* texture) {
 	pixels = malloc(height * width * (rgb_format ? 3 : 4));
 	if (pixels == nullptr) {
 		PRINT_ERROR << "failed to malloc enough memory to copy the texture" << endl;
+		return;
+	}
+
+	// Without a window there is no texture memory to read back from, so the copy is left blank
+	if (VideoManager->IsHeadless() == true) {
+		memset(pixels, 0, height * width * (rgb_format ? 3 : 4));
+		return;
 	}
 
 	TextureManager->_BindTexture(texture->tex_id);
@@ -301,51 +296,22 @@ bool ImageMemory::_LoadPngImage(const string& filename) {
 	}
 	else if (bpp == 1) {
 		for (uint32 y = 0; y < static_cast<uint32>(height); y++) {
-			for (uint32 x = 0; x < static_cast<uint32>(width); x++) {
-				img_pixel = row_pointers[y] + (x * bpp);
-				dst_pixel = ((uint8*)pixels) + ((y * width) + x) * 4;
-				dst_pixel[0] = img_pixel[0];
-				dst_pixel[1] = img_pixel[0];
-				dst_pixel[2] = img_pixel[0];
-				dst_pixel[3] = 0xFF;
-			}
+			ConvertGrayToRGBA(row_pointers[y], static_cast<uint8*>(pixels) + y * width * 4, width);
 		}
 	}
 	else if (bpp == 3) {
 		for (uint32 y = 0; y < static_cast<uint32>(height); y++) {
-			for (uint32 x = 0; x < static_cast<uint32>(width); x++) {
-				img_pixel = row_pointers[y] + (x * bpp);
-				dst_pixel = ((uint8*)pixels) + ((y * width) + x) * 4;
-				dst_pixel[0] = img_pixel[0];
-				dst_pixel[1] = img_pixel[1];
-				dst_pixel[2] = img_pixel[2];
-				dst_pixel[3] = 0xFF;
-			}
+			ConvertRGBToRGBA(row_pointers[y], static_cast<uint8*>(pixels) + y * width * 4, width);
 		}
 	}
 	else if (bpp == 4) {
+		// When a pixel is fully transparent and the texture smoothing option is enabled in the video engine,
+		// this causes OpenGL to use GL_LINEAR, which performs a linear average between pixels. Unfortunately,
+		// this results in a white outline to be seen when moving between transparent and non-transparent pixels
+		// in an image. To eliminate this unwanted artifact, we set the RGB values for all transparent pixels to
+		// 0 (black).
 		for (uint32 y = 0; y < static_cast<uint32>(height); y++) {
-			for (uint32 x = 0; x < static_cast<uint32>(width); x++) {
-				img_pixel = row_pointers[y] + (x * bpp);
-				dst_pixel = ((uint8*)pixels) + ((y * width) + x) * 4;
-				// When a pixel is fully transparent and the texture smoothing option is enabled in the video engine,
-				// this causes OpenGL to use GL_LINEAR, which performs a linear average between pixels. Unfortunately,
-				// this results in a white outline to be seen when moving between transparent and non-transparent pixels
-				// in an image. To eliminate this unwanted artifact, we set the RGB values for all transparent pixels to
-				// 0 (black).
-				if (img_pixel[3] == 0) {
-					dst_pixel[0] = 0;
-					dst_pixel[1] = 0;
-					dst_pixel[2] = 0;
-					dst_pixel[3] = img_pixel[3];
-				}
-				else {
-					dst_pixel[0] = img_pixel[0];
-					dst_pixel[1] = img_pixel[1];
-					dst_pixel[2] = img_pixel[2];
-					dst_pixel[3] = img_pixel[3];
-				}
-			}
+			CopyRGBAClearingTransparent(row_pointers[y], static_cast<uint8*>(pixels) + y * width * 4, width);
 		}
 	}
 	else {
@@ -400,35 +366,17 @@ bool ImageMemory::_LoadJpgImage(const string& filename) {
 
 	// swizzle everything so it's in the format we want
 	uint32 bpp = cinfo.output_components;
-	uint8* img_pixel = nullptr;
-	uint8* dst_pixel = nullptr;
 
 	if (bpp == 3) {
 		for (uint32 y = 0; y < cinfo.output_height; y++) {
 			jpeg_read_scanlines(&cinfo, buffer, 1);
-
-			for(uint32 x = 0; x < cinfo.output_width; x++) {
-				img_pixel = buffer[0] + (x * bpp);
-				dst_pixel = ((uint8 *)pixels) + ((y * cinfo.output_width) + x) * 3;
-
-				dst_pixel[0] = img_pixel[0];
-				dst_pixel[1] = img_pixel[1];
-				dst_pixel[2] = img_pixel[2];
-			}
+			memcpy(static_cast<uint8*>(pixels) + y * row_stride, buffer[0], row_stride);
 		}
 	}
 	else if (bpp == 4) {
 		for (uint32 y = 0; y < cinfo.output_height; y++) {
 			jpeg_read_scanlines(&cinfo, buffer, 1);
-
-			for (uint32 x = 0; x < cinfo.output_width; x++) {
-				img_pixel = buffer[0] + (x * bpp);
-				dst_pixel = ((uint8 *)pixels) + ((y * cinfo.output_width) + x) * 3;
-
-				dst_pixel[0] = img_pixel[0];
-				dst_pixel[1] = img_pixel[1];
-				dst_pixel[2] = img_pixel[2];
-			}
+			ConvertRGBAToRGB(buffer[0], static_cast<uint8*>(pixels) + y * cinfo.output_width * 3, cinfo.output_width);
 		}
 	}
 	else {
@@ -20,6 +20,17 @@ using namespace hoa_video::private_video;
 namespace hoa_video
 {
 
+ParticleEffectDef::~ParticleEffectDef() {
+	list<ParticleSystemDef *>::iterator iSystem = _systems.begin();
+
+	while (iSystem != _systems.end()) {
+		delete (*iSystem);
+		++iSystem;
+	}
+
+	_systems.clear();
+}
+
 
 //-----------------------------------------------------------------------------
 // ParticleEffect
@@ -60,9 +71,14 @@ bool ParticleEffect::_Draw() {
 		++iSystem;
 	}
 
-	glDisable(GL_STENCIL_TEST);
-	glDisable(GL_ALPHA_TEST);
-	glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	if (VideoManager->IsHeadless() == false) {
+		glDisable(GL_STENCIL_TEST);
+		if (VideoManager->_core_renderer.IsActive() == true)
+			VideoManager->_core_renderer.SetAlphaTest(CORE_ALPHA_TEST_DISABLED);
+		else
+			glDisable(GL_ALPHA_TEST);
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	}
 
 
 	return success;
@@ -95,6 +111,7 @@ bool ParticleEffect::_Update(float frame_time) {
 	while (iSystem != _systems.end()) {
 		if (!(*iSystem)->IsAlive()) {
 			(*iSystem)->Destroy();
+			delete (*iSystem);
 			iSystem = _systems.erase(iSystem);
 
 			if(_systems.empty())
@@ -126,8 +143,16 @@ void ParticleEffect::_Destroy() {
 
 	while (iSystem != _systems.end()) {
 		(*iSystem)->Destroy();
+		delete (*iSystem);
 		++iSystem;
 	}
+
+	_systems.clear();
+
+	if (_effect_def != nullptr) {
+		_effect_def->RemoveReference();
+		_effect_def = nullptr;
+	}
 }
 
 
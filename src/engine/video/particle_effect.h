@@ -46,14 +46,42 @@ using private_video::ParticleSystemDef;
  *  \brief particle effect definition, just consists of each of its subsystems'
  *         definitions. This is basically just a struct, except it has a
  *         function to load the structure from a particle file (.lua/.hoa)
+ *
+ *  Definitions are cached by the ParticleManager and shared by every effect
+ *  created from them. They are reference counted: the cache holds one reference
+ *  and each live effect holds another, so a definition that is removed from the
+ *  cache remains valid until the last effect using it has finished.
  *****************************************************************************/
 
 class ParticleEffectDef
 {
 public:
 
+	ParticleEffectDef() :
+		_reference_count(0) {}
+
+	/*!
+	 *  \brief Destructor, which deletes all of the system definitions
+	 */
+	~ParticleEffectDef();
+
+	//! \brief Increments the number of references to this definition
+	void AddReference() const
+		{ ++_reference_count; }
+
+	//! \brief Decrements the number of references to this definition and deletes it when none remain
+	void RemoveReference() const
+		{ if (--_reference_count == 0) delete this; }
+
 	//! list of system definitions
 	std::list<ParticleSystemDef *> _systems;
+
+private:
+	//! The number of effects and caches that retain a pointer to this definition
+	mutable uint32 _reference_count;
+
+	ParticleEffectDef(const ParticleEffectDef&);
+	ParticleEffectDef& operator=(const ParticleEffectDef&);
 };
 
 
@@ -180,7 +208,8 @@ private:
 
 
 	/*!
-	 *  \brief destroys the effect. This is private so that only the ParticleManager class
+	 *  \brief destroys the effect, deleting all of its systems and releasing its reference to
+	 *         the effect definition. This is private so that only the ParticleManager class
 	 *         can destroy effects.
 	 */
 	void _Destroy();
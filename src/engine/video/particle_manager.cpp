@@ -27,9 +27,51 @@ namespace private_video {
 // ParticleManager class methods
 // -----------------------------------------------------------------------------
 
-ParticleEffectDef* ParticleManager::LoadEffect(const string& filename) {
-	ReadScriptDescriptor script;
+const ParticleEffectDef* ParticleManager::LoadEffect(const string& filename) {
+	map<string, const ParticleEffectDef*>::iterator it = _effect_definitions.find(filename);
+	if (it != _effect_definitions.end()) {
+		return it->second;
+	}
+
+	ParticleEffectDef* definition = _ReadEffect(filename);
+	if (definition != nullptr) {
+		definition->AddReference();
+	}
+	_effect_definitions.insert(make_pair(filename, definition));
+	return definition;
+}
+
+
+
+const ParticleEffectDef* ParticleManager::ReloadEffect(const string& filename) {
+	// Effects that are active keep their own reference to the previous definition
+	map<string, const ParticleEffectDef*>::iterator it = _effect_definitions.find(filename);
+	if (it != _effect_definitions.end()) {
+		if (it->second != nullptr) {
+			it->second->RemoveReference();
+		}
+		_effect_definitions.erase(it);
+	}
+
+	return LoadEffect(filename);
+}
+
+
+
+void ParticleManager::ClearEffectCache() {
+	for (map<string, const ParticleEffectDef*>::iterator i = _effect_definitions.begin(); i != _effect_definitions.end(); ++i) {
+		if (i->second != nullptr) {
+			i->second->RemoveReference();
+		}
+	}
 
+	_effect_definitions.clear();
+}
+
+
+
+ParticleEffectDef* ParticleManager::_ReadEffect(const string& filename) {
+	ReadScriptDescriptor script;
 	if (script.OpenFile(filename) == false) {
 		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to open the particle definition file: "
 			<< filename << ", the particle effect was not loaded" << endl;
@@ -220,6 +262,19 @@ ParticleEffectDef* ParticleManager::LoadEffect(const string& filename) {
 			}
 		}
 
+		// Load the frame images once here so that every system created from this definition shares them
+		system_definition->animation_frames.resize(system_definition->animation_frame_filenames.size());
+		for (uint32 i = 0; i < system_definition->animation_frame_filenames.size(); i++) {
+			if (system_definition->animation_frames[i].Load(system_definition->animation_frame_filenames[i]) == false) {
+				IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to load animation frame image: " << system_definition->animation_frame_filenames[i]
+					<< ", in system table #" << system_number << " in particle defintion file: " << filename << endl;
+				delete effect_definition;
+				script.CloseAllTables();
+				script.CloseFile();
+				return nullptr;
+			}
+		}
+
 		// Read the remaining particle system data
 		system_definition->enabled = script.ReadBool("enabled");
 		system_definition->blend_mode = script.ReadInt("blend_mode");
@@ -291,7 +346,7 @@ ParticleEffectDef* ParticleManager::LoadEffect(const string& filename) {
 	script.CloseFile(); // close the systems table
 
 	return effect_definition;
-} // ParticleEffectDef* ParticleManager::LoadEffect(const string& filename)
+} // ParticleEffectDef* ParticleManager::_ReadEffect(const string& filename)
 
 
 
@@ -332,6 +387,8 @@ bool ParticleManager::Update(int32 frame_time) {
 		if ((i->second)->IsAlive() == false) {
 			map<ParticleEffectID, ParticleEffect*>::iterator finished_effect = i;
 			++i;
+			finished_effect->second->_Destroy();
+			delete finished_effect->second;
 			_effects.erase(finished_effect);
 		}
 		else {
@@ -356,8 +413,10 @@ bool ParticleManager::Draw() {
 	VideoManager->SetCoordSys(CoordSys(0.0f, 1024.0f, 768.0f, 0.0f));
 	VideoManager->DisableScissoring();
 
-	glClearStencil(0);
-	glClear(GL_STENCIL_BUFFER_BIT);
+	if (VideoManager->IsHeadless() == false) {
+		glClearStencil(0);
+		glClear(GL_STENCIL_BUFFER_BIT);
+	}
 
 	bool success = true;
 
@@ -399,6 +458,7 @@ void ParticleManager::Destroy() {
 	}
 
 	_effects.clear();
+	ClearEffectCache();
 }
 
 
@@ -414,6 +474,7 @@ ParticleEffect *ParticleManager::_CreateEffect(const ParticleEffectDef *definiti
 
 	ParticleEffect* effect = new ParticleEffect;
 	effect->_effect_def = definition;
+	definition->AddReference();
 
 	for (list<ParticleSystemDef*>::const_iterator i = definition->_systems.begin(); i != definition->_systems.end(); ++i) {
 		if ((*i)->enabled == false) {
@@ -427,12 +488,8 @@ ParticleEffect *ParticleManager::_CreateEffect(const ParticleEffectDef *definiti
 			system->Destroy();
 			delete system;
 
-			// Delete all previously loaded systems
-			for (list<ParticleSystem*>::const_iterator j = effect->_systems.begin(); j != effect->_systems.end(); ++j) {
-				(*j)->Destroy();
-				delete (*j);
-			}
-
+			// Delete all previously loaded systems and release the effect's reference to the definition
+			effect->_Destroy();
 			delete effect;
 			return nullptr;
 		}
@@ -15,6 +15,11 @@
 *** The particle manager is very simple. Every time you want to draw an effect,
 *** you call AddEffect() with a pointer to the effect definition structure.
 *** Then every frame, call Update() and Draw() to draw all the effects.
+***
+*** Effect definitions are cached by filename, so each definition file is read
+*** and its images loaded only the first time that the effect is requested. The
+*** definition data, including the images, is shared by every instance of the
+*** effect. Creating an instance of a known effect only allocates its particles.
 *** ***************************************************************************/
 
 #pragma once
@@ -38,13 +43,26 @@ namespace private_video {
 class ParticleManager {
 public:
 	ParticleManager()
-		{ _current_id = 0; }
+		{ _current_id = 0; _num_particles = 0; }
+
+	/** \brief Retrieves the cached effect definition for a particle file, loading it if necessary
+	*** \param filename The file to load the effect definition from
+	*** \return A pointer to the effect definition, or nullptr if the definition could not be loaded
+	***
+	*** The returned definition is owned by the cache. It remains valid until the cache is cleared or the
+	*** effect is reloaded, and effects that were created from it remain valid after that.
+	**/
+	const ParticleEffectDef* LoadEffect(const std::string &filename);
 
-	/** \brief Loads an effect definition from a particle file
+	/** \brief Reads an effect definition from a particle file again, replacing any cached definition
 	*** \param filename The file to load the effect definition from
-	*** \return A pointer to the newly loaded effect definition
+	*** \return A pointer to the effect definition, or nullptr if the definition could not be loaded
+	*** \note This is intended for use while developing an effect and should not be used by release-quality code
 	**/
-	ParticleEffectDef* LoadEffect(const std::string &filename);
+	const ParticleEffectDef* ReloadEffect(const std::string &filename);
+
+	//! \brief Releases all cached effect definitions, which are deleted once no active effect is using them
+	void ClearEffectCache();
 
 	/** \brief Creates a new instance of an effect at (x,y)
 	*** \param definition A pointer to the new effect to add
@@ -104,12 +122,24 @@ private:
 	//! we can convert easily between an id and a pointer
 	std::map<ParticleEffectID, ParticleEffect*> _effects;
 
+	/** \brief All the effect definitions that have been loaded, keyed by their filename
+	*** The cache holds a reference to each definition. Files that failed to load are cached as nullptr
+	*** so that they are not read again every time the effect is requested.
+	**/
+	std::map<std::string, const ParticleEffectDef*> _effect_definitions;
+
 	/** \brief Creates a new particle effect from a provided effect definition
 	*** \param definition A pointer to the definition data of the effect
 	*** \return A pointer to the created ParticleEffect object
 	**/
 	ParticleEffect* _CreateEffect(const ParticleEffectDef *definition);
 
+	/** \brief Reads an effect definition and loads its images
+	*** \param filename The file to read the effect definition from
+	*** \return A pointer to the newly read effect definition, or nullptr if the definition was invalid
+	**/
+	ParticleEffectDef* _ReadEffect(const std::string &filename);
+
 	/** \brief A helper function that is used to read a table of color data (four floats)
 	*** \param script A reference to the script to read the data from
 	*** \param parameter_name The name of the parameter containing the float data to read
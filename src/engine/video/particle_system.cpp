@@ -22,6 +22,18 @@ namespace private_video
 {
 
 
+//-----------------------------------------------------------------------------
+// ParticleSystemDef
+//-----------------------------------------------------------------------------
+
+ParticleSystemDef::~ParticleSystemDef()
+{
+	for(size_t j = 0; j < keyframes.size(); ++j)
+		delete keyframes[j];
+	keyframes.clear();
+}
+
+
 //-----------------------------------------------------------------------------
 // ParticleSystem
 //-----------------------------------------------------------------------------
@@ -58,7 +70,8 @@ bool ParticleSystem::Create(const ParticleSystemDef *sys_def)
 	_stopped = false;
 	_age = 0.0f;
 
-	size_t num_frames = sys_def->animation_frame_filenames.size();
+	// The frame images are shared with the definition, so adding them does not load anything
+	size_t num_frames = sys_def->animation_frames.size();
 
 	for(size_t j = 0; j < num_frames; ++j)
 	{
@@ -70,7 +83,7 @@ bool ParticleSystem::Create(const ParticleSystemDef *sys_def)
 		else
 			frame_time = sys_def->animation_frame_times.back();
 
-		_animation.AddFrame(sys_def->animation_frame_filenames[j], frame_time);
+		_animation.AddFrame(sys_def->animation_frames[j], frame_time);
 	}
 
 // 	VideoManager->LoadImage(_animation);
@@ -88,6 +101,13 @@ bool ParticleSystem::Draw()
 	if(!_system_def->enabled || _age < _system_def->emitter._start_time)
 		return true;
 
+	VideoManager->_render_statistics.RecordDrawCall();
+	if (VideoManager->IsHeadless() == true)
+		return true;
+
+	GLDebugGroup debug_group("ParticleSystem::Draw");
+	bool core_profile = VideoManager->_core_renderer.IsActive();
+
 	// set blending parameters
 	if(_system_def->blend_mode == VIDEO_NO_BLEND)
 	{
@@ -125,19 +145,28 @@ bool ParticleSystem::Draw()
 			glStencilOp(GL_REPLACE, GL_KEEP, GL_KEEP);
 
 		glStencilFunc(GL_NEVER, 1, 0xFFFFFFFF);
-		glEnable(GL_ALPHA_TEST);
-		glAlphaFunc(GL_GREATER, 0.00f);
+		if (core_profile == true) {
+			VideoManager->_core_renderer.SetAlphaTest(0.0f);
+		}
+		else {
+			glEnable(GL_ALPHA_TEST);
+			glAlphaFunc(GL_GREATER, 0.00f);
+		}
 		glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
 
 	}
 	else
 	{
 		glDisable(GL_STENCIL_TEST);
-		glDisable(GL_ALPHA_TEST);
+		if (core_profile == true)
+			VideoManager->_core_renderer.SetAlphaTest(CORE_ALPHA_TEST_DISABLED);
+		else
+			glDisable(GL_ALPHA_TEST);
 		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
 	}
 
-	glEnable(GL_TEXTURE_2D);
+	if (core_profile == false)
+		glEnable(GL_TEXTURE_2D);
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -294,19 +323,26 @@ bool ParticleSystem::Draw()
 		++t;
 	}
 
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_COLOR_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-	glVertexPointer   (2, GL_FLOAT, 0, &_particle_vertices[0]);
-	glColorPointer    (4, GL_FLOAT, 0, &_particle_colors[0]);
-	glTexCoordPointer (2, GL_FLOAT, 0, &_particle_texcoords[0]);
+	if (core_profile == true) {
+		VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, &_particle_vertices[0]._x, &_particle_texcoords[0]._t0,
+			&_particle_colors[0], false, _num_particles);
+	}
+	else {
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_COLOR_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glVertexPointer   (2, GL_FLOAT, 0, &_particle_vertices[0]);
+		glColorPointer    (4, GL_FLOAT, 0, &_particle_colors[0]);
+		glTexCoordPointer (2, GL_FLOAT, 0, &_particle_texcoords[0]);
 
-	glDrawArrays(GL_QUADS, 0, _num_particles * 4);
+		glDrawArrays(GL_QUADS, 0, _num_particles * 4);
 
-	glDisableClientState(GL_VERTEX_ARRAY);
+		glDisableClientState(GL_VERTEX_ARRAY);
+	}
 
 	if(_system_def->smooth_animation) {
-		glEnableClientState(GL_VERTEX_ARRAY);
+		if (core_profile == false)
+			glEnableClientState(GL_VERTEX_ARRAY);
 
 		int findex = _animation.GetCurrentFrameIndex();
 		findex = (findex + 1) % _animation.GetNumberOfFrames();
@@ -362,6 +398,12 @@ bool ParticleSystem::Draw()
 			++c;
 		}
 
+		if (core_profile == true) {
+			VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, &_particle_vertices[0]._x, &_particle_texcoords[0]._t0,
+				&_particle_colors[0], false, _num_particles);
+			return true;
+		}
+
 		glVertexPointer   (2, GL_FLOAT, 0, &_particle_vertices[0]);
 		glColorPointer    (4, GL_FLOAT, 0, &_particle_colors[0]);
 		glTexCoordPointer (2, GL_FLOAT, 0, &_particle_texcoords[0]);
@@ -369,6 +411,9 @@ bool ParticleSystem::Draw()
 		glDrawArrays(GL_QUADS, 0, _num_particles * 4);
 
 		glDisableClientState(GL_VERTEX_ARRAY);
+	}
+
+	if (core_profile == false) {
 		glDisableClientState(GL_COLOR_ARRAY);
 		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 	}
@@ -62,6 +62,11 @@ class ParticleSystemDef
 {
 public:
 
+	/*!
+	 *  \brief Destructor, which deletes the keyframes
+	 */
+	~ParticleSystemDef();
+
 
 	//! Is this system supposed to be displayed
 	bool enabled;
@@ -228,6 +233,11 @@ public:
 	//! Array of filenames for each frame of animation
 	std::vector <std::string> animation_frame_filenames;
 
+
+	//! Array of the images for each frame of animation. These are loaded along with the definition
+	//! and are shared by every system created from it, so that creating a system loads no images.
+	std::vector <StillImage>  animation_frames;
+
 }; // class ParticleSystemDef
 
 
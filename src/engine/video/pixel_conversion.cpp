@@ -0,0 +1,325 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    pixel_conversion.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for converting between pixel formats
+***
+*** Each function converts as many pixels as possible with vector instructions
+*** and then converts the remaining pixels with the same scalar code that is
+*** used when no vector instruction set is available.
+*** ***************************************************************************/
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define VIDEO_PIXEL_SSE2
+	#include <emmintrin.h>
+#elif defined(USE_NEON) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+	// The NEON implementations have not yet been tested on ARM hardware, so they must be enabled with the USE_NEON option
+	#define VIDEO_PIXEL_NEON
+	#include <arm_neon.h>
+#endif
+
+#include "pixel_conversion.h"
+
+using namespace std;
+using namespace hoa_utils;
+
+namespace hoa_video {
+
+namespace private_video {
+
+namespace {
+
+//! \name Grayscale weights, in hundredths
+//@{
+const uint32 GRAY_RED_WEIGHT = 30;
+const uint32 GRAY_GREEN_WEIGHT = 59;
+const uint32 GRAY_BLUE_WEIGHT = 11;
+//@}
+
+/** \brief Multiplying by this and then shifting right by GRAY_DIVISION_SHIFT divides by 100
+*** This gives the exact quotient for every weighted sum of three channels (0 to 25500). The quotient is also identical
+*** to the result of multiplying the sum by 0.01f and truncating, which is how the gray value was originally computed.
+**/
+const uint32 GRAY_DIVISION_MULTIPLIER = 5243;
+const uint32 GRAY_DIVISION_SHIFT = 19;
+
+//! \brief Computes the gray value of a single pixel
+inline uint8 GrayValue(const uint8* pixel) {
+	uint32 sum = GRAY_RED_WEIGHT * pixel[0] + GRAY_GREEN_WEIGHT * pixel[1] + GRAY_BLUE_WEIGHT * pixel[2];
+	return static_cast<uint8>((sum * GRAY_DIVISION_MULTIPLIER) >> GRAY_DIVISION_SHIFT);
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Grayscale conversion
+// -----------------------------------------------------------------------------
+
+void ConvertRGBAToGrayscale(uint8* pixels, uint32 pixel_count) {
+	uint32 i = 0;
+
+#if defined(VIDEO_PIXEL_SSE2)
+	// Each 32-bit lane holds one pixel. Every intermediate value fits in the low 16 bits of its lane.
+	const __m128i channel_mask = _mm_set1_epi32(0xFF);
+	const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+	const __m128i red_weight = _mm_set1_epi32(GRAY_RED_WEIGHT);
+	const __m128i green_weight = _mm_set1_epi32(GRAY_GREEN_WEIGHT);
+	const __m128i blue_weight = _mm_set1_epi32(GRAY_BLUE_WEIGHT);
+	const __m128i division_multiplier = _mm_set1_epi32(GRAY_DIVISION_MULTIPLIER);
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i* block = reinterpret_cast<__m128i*>(pixels + i * 4);
+		__m128i source = _mm_loadu_si128(block);
+
+		__m128i red = _mm_and_si128(source, channel_mask);
+		__m128i green = _mm_and_si128(_mm_srli_epi32(source, 8), channel_mask);
+		__m128i blue = _mm_and_si128(_mm_srli_epi32(source, 16), channel_mask);
+		__m128i sum = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(red, red_weight), _mm_mullo_epi16(green, green_weight)),
+			_mm_mullo_epi16(blue, blue_weight));
+		// The high half of the product is the product shifted right by 16 bits
+		__m128i gray = _mm_srli_epi32(_mm_mulhi_epu16(sum, division_multiplier), GRAY_DIVISION_SHIFT - 16);
+
+		__m128i result = _mm_or_si128(_mm_or_si128(gray, _mm_slli_epi32(gray, 8)), _mm_slli_epi32(gray, 16));
+		result = _mm_or_si128(result, _mm_and_si128(source, alpha_mask));
+		_mm_storeu_si128(block, result);
+	}
+#elif defined(VIDEO_PIXEL_NEON)
+	const uint8x8_t red_weight = vdup_n_u8(GRAY_RED_WEIGHT);
+	const uint8x8_t green_weight = vdup_n_u8(GRAY_GREEN_WEIGHT);
+	const uint8x8_t blue_weight = vdup_n_u8(GRAY_BLUE_WEIGHT);
+	const uint16x4_t division_multiplier = vdup_n_u16(GRAY_DIVISION_MULTIPLIER);
+	for (; i + 8 <= pixel_count; i += 8) {
+		uint8x8x4_t source = vld4_u8(pixels + i * 4);
+
+		uint16x8_t sum = vmull_u8(source.val[0], red_weight);
+		sum = vmlal_u8(sum, source.val[1], green_weight);
+		sum = vmlal_u8(sum, source.val[2], blue_weight);
+		uint32x4_t low = vshrq_n_u32(vmull_u16(vget_low_u16(sum), division_multiplier), GRAY_DIVISION_SHIFT);
+		uint32x4_t high = vshrq_n_u32(vmull_u16(vget_high_u16(sum), division_multiplier), GRAY_DIVISION_SHIFT);
+		uint8x8_t gray = vmovn_u16(vcombine_u16(vmovn_u32(low), vmovn_u32(high)));
+
+		source.val[0] = gray;
+		source.val[1] = gray;
+		source.val[2] = gray;
+		vst4_u8(pixels + i * 4, source);
+	}
+#endif
+
+	for (uint8* pixel = pixels + i * 4; i < pixel_count; ++i, pixel += 4) {
+		uint8 value = GrayValue(pixel);
+		pixel[0] = value;
+		pixel[1] = value;
+		pixel[2] = value;
+	}
+}
+
+
+
+void ConvertRGBToGrayscale(uint8* pixels, uint32 pixel_count) {
+	uint32 i = 0;
+
+	// SSE2 has no instruction for rearranging individual bytes, so three byte pixels are only vectorized with NEON
+#if defined(VIDEO_PIXEL_NEON)
+	const uint8x8_t red_weight = vdup_n_u8(GRAY_RED_WEIGHT);
+	const uint8x8_t green_weight = vdup_n_u8(GRAY_GREEN_WEIGHT);
+	const uint8x8_t blue_weight = vdup_n_u8(GRAY_BLUE_WEIGHT);
+	const uint16x4_t division_multiplier = vdup_n_u16(GRAY_DIVISION_MULTIPLIER);
+	for (; i + 8 <= pixel_count; i += 8) {
+		uint8x8x3_t source = vld3_u8(pixels + i * 3);
+
+		uint16x8_t sum = vmull_u8(source.val[0], red_weight);
+		sum = vmlal_u8(sum, source.val[1], green_weight);
+		sum = vmlal_u8(sum, source.val[2], blue_weight);
+		uint32x4_t low = vshrq_n_u32(vmull_u16(vget_low_u16(sum), division_multiplier), GRAY_DIVISION_SHIFT);
+		uint32x4_t high = vshrq_n_u32(vmull_u16(vget_high_u16(sum), division_multiplier), GRAY_DIVISION_SHIFT);
+		uint8x8_t gray = vmovn_u16(vcombine_u16(vmovn_u32(low), vmovn_u32(high)));
+
+		source.val[0] = gray;
+		source.val[1] = gray;
+		source.val[2] = gray;
+		vst3_u8(pixels + i * 3, source);
+	}
+#endif
+
+	for (uint8* pixel = pixels + i * 3; i < pixel_count; ++i, pixel += 3) {
+		uint8 value = GrayValue(pixel);
+		pixel[0] = value;
+		pixel[1] = value;
+		pixel[2] = value;
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Channel conversion
+// -----------------------------------------------------------------------------
+
+void ConvertRGBAToRGB(const uint8* source, uint8* destination, uint32 pixel_count) {
+	uint32 i = 0;
+
+	// When converting in place, each block of pixels is read completely before it is written, and is never written
+	// past the start of the next block to be read
+#if defined(VIDEO_PIXEL_SSE2)
+	// Each 64-bit lane holds two pixels, which are packed into the low six bytes of the lane
+	const __m128i first_pixel_mask = _mm_set1_epi64x(0x0000000000FFFFFFLL);
+	const __m128i second_pixel_mask = _mm_set1_epi64x(0x0000FFFFFF000000LL);
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+		__m128i packed = _mm_or_si128(_mm_and_si128(block, first_pixel_mask), _mm_and_si128(_mm_srli_epi64(block, 8), second_pixel_mask));
+
+		// Join the six bytes of the two lanes into twelve consecutive bytes
+		__m128i high_lane = _mm_srli_si128(packed, 8);
+		__m128i first_eight = _mm_or_si128(packed, _mm_slli_epi64(high_lane, 48));
+		int32 last_four = _mm_cvtsi128_si32(_mm_srli_epi64(high_lane, 16));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(destination + i * 3), first_eight);
+		memcpy(destination + i * 3 + 8, &last_four, 4);
+	}
+#elif defined(VIDEO_PIXEL_NEON)
+	for (; i + 16 <= pixel_count; i += 16) {
+		uint8x16x4_t block = vld4q_u8(source + i * 4);
+		uint8x16x3_t packed;
+		packed.val[0] = block.val[0];
+		packed.val[1] = block.val[1];
+		packed.val[2] = block.val[2];
+		vst3q_u8(destination + i * 3, packed);
+	}
+#endif
+
+	for (; i < pixel_count; ++i) {
+		destination[i * 3] = source[i * 4];
+		destination[i * 3 + 1] = source[i * 4 + 1];
+		destination[i * 3 + 2] = source[i * 4 + 2];
+	}
+}
+
+
+
+void ConvertRGBToRGBA(const uint8* source, uint8* destination, uint32 pixel_count) {
+	uint32 i = 0;
+
+#if defined(VIDEO_PIXEL_SSE2)
+	// Each 64-bit lane is loaded with two pixels from overlapping reads, so every block reads two bytes past its
+	// twelve bytes of pixels. The loop stops early enough that those bytes still belong to the source.
+	const __m128i first_pixel_mask = _mm_set1_epi64x(0x0000000000FFFFFFLL);
+	const __m128i second_pixel_mask = _mm_set1_epi64x(0x00FFFFFF00000000LL);
+	const __m128i alpha = _mm_set1_epi32(0xFF000000);
+	for (; i + 5 <= pixel_count; i += 4) {
+		__m128i first_two = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i * 3));
+		__m128i second_two = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i * 3 + 6));
+		__m128i block = _mm_unpacklo_epi64(first_two, second_two);
+
+		__m128i result = _mm_or_si128(_mm_and_si128(block, first_pixel_mask), _mm_and_si128(_mm_slli_epi64(block, 8), second_pixel_mask));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_or_si128(result, alpha));
+	}
+#elif defined(VIDEO_PIXEL_NEON)
+	for (; i + 16 <= pixel_count; i += 16) {
+		uint8x16x3_t block = vld3q_u8(source + i * 3);
+		uint8x16x4_t expanded;
+		expanded.val[0] = block.val[0];
+		expanded.val[1] = block.val[1];
+		expanded.val[2] = block.val[2];
+		expanded.val[3] = vdupq_n_u8(0xFF);
+		vst4q_u8(destination + i * 4, expanded);
+	}
+#endif
+
+	for (; i < pixel_count; ++i) {
+		destination[i * 4] = source[i * 3];
+		destination[i * 4 + 1] = source[i * 3 + 1];
+		destination[i * 4 + 2] = source[i * 3 + 2];
+		destination[i * 4 + 3] = 0xFF;
+	}
+}
+
+
+
+void ConvertGrayToRGBA(const uint8* source, uint8* destination, uint32 pixel_count) {
+	uint32 i = 0;
+
+#if defined(VIDEO_PIXEL_SSE2)
+	const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+	for (; i + 16 <= pixel_count; i += 16) {
+		__m128i gray = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+		// Interleaving the gray values with themselves and with the alpha value produces the pairs (g, g) and (g, 0xFF),
+		// and interleaving those pairs produces the pixels (g, g, g, 0xFF)
+		__m128i gray_gray_low = _mm_unpacklo_epi8(gray, gray);
+		__m128i gray_gray_high = _mm_unpackhi_epi8(gray, gray);
+		__m128i gray_alpha_low = _mm_unpacklo_epi8(gray, alpha);
+		__m128i gray_alpha_high = _mm_unpackhi_epi8(gray, alpha);
+
+		__m128i* block = reinterpret_cast<__m128i*>(destination + i * 4);
+		_mm_storeu_si128(block, _mm_unpacklo_epi16(gray_gray_low, gray_alpha_low));
+		_mm_storeu_si128(block + 1, _mm_unpackhi_epi16(gray_gray_low, gray_alpha_low));
+		_mm_storeu_si128(block + 2, _mm_unpacklo_epi16(gray_gray_high, gray_alpha_high));
+		_mm_storeu_si128(block + 3, _mm_unpackhi_epi16(gray_gray_high, gray_alpha_high));
+	}
+#elif defined(VIDEO_PIXEL_NEON)
+	for (; i + 16 <= pixel_count; i += 16) {
+		uint8x16_t gray = vld1q_u8(source + i);
+		uint8x16x4_t expanded;
+		expanded.val[0] = gray;
+		expanded.val[1] = gray;
+		expanded.val[2] = gray;
+		expanded.val[3] = vdupq_n_u8(0xFF);
+		vst4q_u8(destination + i * 4, expanded);
+	}
+#endif
+
+	for (; i < pixel_count; ++i) {
+		destination[i * 4] = source[i];
+		destination[i * 4 + 1] = source[i];
+		destination[i * 4 + 2] = source[i];
+		destination[i * 4 + 3] = 0xFF;
+	}
+}
+
+
+
+void CopyRGBAClearingTransparent(const uint8* source, uint8* destination, uint32 pixel_count) {
+	uint32 i = 0;
+
+#if defined(VIDEO_PIXEL_SSE2)
+	// A pixel with an alpha value of zero is entirely zero once its color is cleared, so whole lanes are cleared
+	const __m128i alpha_mask = _mm_set1_epi32(0xFF000000);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= pixel_count; i += 4) {
+		__m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+		__m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(block, alpha_mask), zero);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_andnot_si128(transparent, block));
+	}
+#elif defined(VIDEO_PIXEL_NEON)
+	for (; i + 4 <= pixel_count; i += 4) {
+		uint32x4_t block = vreinterpretq_u32_u8(vld1q_u8(source + i * 4));
+		uint32x4_t opaque = vtstq_u32(block, vdupq_n_u32(0xFF000000));
+		vst1q_u8(destination + i * 4, vreinterpretq_u8_u32(vandq_u32(block, opaque)));
+	}
+#endif
+
+	for (; i < pixel_count; ++i) {
+		const uint8* source_pixel = source + i * 4;
+		uint8* destination_pixel = destination + i * 4;
+		if (source_pixel[3] == 0) {
+			destination_pixel[0] = 0;
+			destination_pixel[1] = 0;
+			destination_pixel[2] = 0;
+		}
+		else {
+			destination_pixel[0] = source_pixel[0];
+			destination_pixel[1] = source_pixel[1];
+			destination_pixel[2] = source_pixel[2];
+		}
+		destination_pixel[3] = source_pixel[3];
+	}
+}
+
+} // namespace private_video
+
+} // namespace hoa_video
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    pixel_conversion.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for converting between pixel formats
+***
+*** These functions perform the per-pixel work of the ImageMemory class when
+*** images are loaded, converted to grayscale, or have their alpha channel
+*** removed. Each function is implemented with SSE2 instructions on x86
+*** processors and with NEON instructions on ARM processors, processing several
+*** pixels at a time, and with plain C++ everywhere else. The instruction set
+*** is chosen when the game is compiled, and the NEON implementations are only
+*** used when the USE_NEON build option is enabled. Every implementation
+*** produces exactly the same bytes, which pixel_conversion_test verifies.
+***
+*** All pixel data is 8 bits per channel. RGBA pixels are in the byte order
+*** R, G, B, A and RGB pixels in the byte order R, G, B.
+*** ***************************************************************************/
+
+#pragma once
+
+#include "defs.h"
+#include "utils.h"
+
+namespace hoa_video {
+
+namespace private_video {
+
+/** \brief Converts RGBA pixels to grayscale in place, leaving the alpha channel unmodified
+*** \param pixels The pixels to convert
+*** \param pixel_count The number of pixels
+***
+*** The gray value of each pixel is 0.30R + 0.59G + 0.11B, rounded down.
+**/
+void ConvertRGBAToGrayscale(uint8* pixels, uint32 pixel_count);
+
+/** \brief Converts RGB pixels to grayscale in place
+*** \param pixels The pixels to convert
+*** \param pixel_count The number of pixels
+**/
+void ConvertRGBToGrayscale(uint8* pixels, uint32 pixel_count);
+
+/** \brief Removes the alpha channel from RGBA pixels
+*** \param source The RGBA pixels to convert
+*** \param destination Where to write the RGB pixels, which may be the same as source to convert in place
+*** \param pixel_count The number of pixels
+**/
+void ConvertRGBAToRGB(const uint8* source, uint8* destination, uint32 pixel_count);
+
+/** \brief Adds a fully opaque alpha channel to RGB pixels
+*** \param source The RGB pixels to convert
+*** \param destination Where to write the RGBA pixels, which must not overlap the source
+*** \param pixel_count The number of pixels
+**/
+void ConvertRGBToRGBA(const uint8* source, uint8* destination, uint32 pixel_count);
+
+/** \brief Converts single channel gray pixels to fully opaque RGBA pixels
+*** \param source The gray pixels to convert
+*** \param destination Where to write the RGBA pixels, which must not overlap the source
+*** \param pixel_count The number of pixels
+**/
+void ConvertGrayToRGBA(const uint8* source, uint8* destination, uint32 pixel_count);
+
+/** \brief Copies RGBA pixels and sets the color of every fully transparent pixel to black
+*** \param source The RGBA pixels to copy
+*** \param destination Where to write the copy, which must not overlap the source
+*** \param pixel_count The number of pixels
+***
+*** When texture smoothing is enabled, OpenGL averages the colors of neighboring pixels. Transparent pixels that
+*** keep their original color would then produce a visible outline around the opaque parts of an image.
+**/
+void CopyRGBAClearingTransparent(const uint8* source, uint8* destination, uint32 pixel_count);
+
+} // namespace private_video
+
+} // namespace hoa_video
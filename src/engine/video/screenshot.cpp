@@ -0,0 +1,329 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    screenshot.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for saving screenshots without stalling the frame
+*** ***************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include <SDL2/SDL.h>
+
+#include "screenshot.h"
+#include "video.h"
+
+using namespace std;
+using namespace hoa_utils;
+
+namespace hoa_video {
+
+namespace private_video {
+
+namespace {
+
+// The pixel buffer constants are declared here because the system OpenGL headers may predate them
+const GLenum SCREENSHOT_PIXEL_PACK_BUFFER = 0x88EB;
+const GLenum SCREENSHOT_STREAM_READ = 0x88E1;
+const GLenum SCREENSHOT_READ_ONLY = 0x88B8;
+
+//! \brief Loads an OpenGL entry point into a function pointer of any type
+template <typename T> bool LoadFunction(T& function, const char* name) {
+	function = reinterpret_cast<T>(SDL_GL_GetProcAddress(name));
+	return (function != nullptr);
+}
+
+//! \brief Returns true if the version of the current context is at least the given version
+bool IsContextVersion(int32 major, int32 minor) {
+	const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+	int32 context_major = 0, context_minor = 0;
+	if (version == nullptr || sscanf(version, "%d.%d", &context_major, &context_minor) != 2)
+		return false;
+
+	return (context_major > major || (context_major == major && context_minor >= minor));
+}
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// ScreenshotWriter class methods
+// -----------------------------------------------------------------------------
+
+ScreenshotWriter::ScreenshotWriter() :
+	_glGenBuffers(nullptr),
+	_glDeleteBuffers(nullptr),
+	_glBindBuffer(nullptr),
+	_glBufferData(nullptr),
+	_glMapBuffer(nullptr),
+	_glUnmapBuffer(nullptr),
+	_pixel_buffers_supported(false),
+	_next_readback(0),
+	_worker_thread(nullptr),
+	_job_mutex(nullptr),
+	_job_condition(nullptr),
+	_stop_worker(false)
+{}
+
+
+
+ScreenshotWriter::~ScreenshotWriter() {
+	if (_worker_thread != nullptr) {
+		SDL_LockMutex(_job_mutex);
+		_stop_worker = true;
+		SDL_CondSignal(_job_condition);
+		SDL_UnlockMutex(_job_mutex);
+		SDL_WaitThread(_worker_thread, nullptr);
+		_worker_thread = nullptr;
+	}
+
+	if (_job_condition != nullptr)
+		SDL_DestroyCond(_job_condition);
+	if (_job_mutex != nullptr)
+		SDL_DestroyMutex(_job_mutex);
+}
+
+
+
+bool ScreenshotWriter::Initialize() {
+	Flush();
+
+	// Pixel buffer objects are part of OpenGL 2.1, and are otherwise available through GL_ARB_pixel_buffer_object
+	_pixel_buffers_supported = (IsContextVersion(2, 1) == true || SDL_GL_ExtensionSupported("GL_ARB_pixel_buffer_object") == SDL_TRUE);
+	if (_pixel_buffers_supported == true) {
+		_pixel_buffers_supported = LoadFunction(_glGenBuffers, "glGenBuffers") && LoadFunction(_glDeleteBuffers, "glDeleteBuffers") &&
+			LoadFunction(_glBindBuffer, "glBindBuffer") && LoadFunction(_glBufferData, "glBufferData") &&
+			LoadFunction(_glMapBuffer, "glMapBuffer") && LoadFunction(_glUnmapBuffer, "glUnmapBuffer");
+	}
+
+	if (_pixel_buffers_supported == false) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "pixel buffer objects are not supported, screenshots will be read synchronously" << endl;
+		return false;
+	}
+
+	for (uint32 i = 0; i < VIDEO_SCREENSHOT_BUFFERS; ++i) {
+		_glGenBuffers(1, &_readbacks[i].buffer);
+	}
+	_next_readback = 0;
+	return true;
+}
+
+
+
+void ScreenshotWriter::Flush() {
+	for (uint32 i = 0; i < VIDEO_SCREENSHOT_BUFFERS; ++i) {
+		ScreenshotReadback& readback = _readbacks[i];
+		if (readback.filenames.empty() == false)
+			_FinishReadback(readback);
+
+		if (readback.buffer != 0 && _glDeleteBuffers != nullptr)
+			_glDeleteBuffers(1, &readback.buffer);
+		readback.buffer = 0;
+		readback.buffer_size = 0;
+	}
+
+	_pixel_buffers_supported = false;
+}
+
+
+
+void ScreenshotWriter::ProcessFrame() {
+	// Any read that is in progress now was started during the previous frame and has had a whole frame to complete
+	bool previous_reads[VIDEO_SCREENSHOT_BUFFERS];
+	for (uint32 i = 0; i < VIDEO_SCREENSHOT_BUFFERS; ++i)
+		previous_reads[i] = (_readbacks[i].filenames.empty() == false);
+
+	// The new read is started before the previous one is mapped so that the driver can begin copying it right away
+	if (_requests.empty() == false) {
+		ScreenshotReadback& readback = _readbacks[_next_readback];
+		if (previous_reads[_next_readback] == true) {
+			_FinishReadback(readback);
+			previous_reads[_next_readback] = false;
+		}
+
+		readback.filenames.swap(_requests);
+		_requests.clear();
+		_StartReadback(readback);
+		_next_readback = (_next_readback + 1) % VIDEO_SCREENSHOT_BUFFERS;
+	}
+
+	for (uint32 i = 0; i < VIDEO_SCREENSHOT_BUFFERS; ++i) {
+		if (previous_reads[i] == true)
+			_FinishReadback(_readbacks[i]);
+	}
+}
+
+
+
+void ScreenshotWriter::_StartReadback(ScreenshotReadback& readback) {
+	GLDebugGroup debug_group("ScreenshotWriter::_StartReadback");
+
+	// The area of the window that the game is drawn to. viewport_dimensions[2] is the width, [3] is the height
+	GLint viewport_dimensions[4];
+	glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
+	readback.width = viewport_dimensions[2];
+	readback.height = viewport_dimensions[3];
+	size_t size = readback.width * readback.height * 4;
+
+	if (_pixel_buffers_supported == false) {
+		void* pixels = malloc(size);
+		glReadPixels(0, 0, readback.width, readback.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		_QueueJobs(pixels, readback.width, readback.height, readback.filenames);
+		free(pixels);
+		readback.filenames.clear();
+		return;
+	}
+
+	_glBindBuffer(SCREENSHOT_PIXEL_PACK_BUFFER, readback.buffer);
+	if (readback.buffer_size != size) {
+		_glBufferData(SCREENSHOT_PIXEL_PACK_BUFFER, size, nullptr, SCREENSHOT_STREAM_READ);
+		readback.buffer_size = size;
+	}
+	// With a pixel pack buffer bound, the pointer is an offset into the buffer and the call returns without waiting
+	glReadPixels(0, 0, readback.width, readback.height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	_glBindBuffer(SCREENSHOT_PIXEL_PACK_BUFFER, 0);
+
+	if (VideoManager->CheckGLError() == true) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << VideoManager->CreateGLErrorString() << endl;
+		readback.filenames.clear();
+	}
+}
+
+
+
+void ScreenshotWriter::_FinishReadback(ScreenshotReadback& readback) {
+	GLDebugGroup debug_group("ScreenshotWriter::_FinishReadback");
+
+	_glBindBuffer(SCREENSHOT_PIXEL_PACK_BUFFER, readback.buffer);
+	const void* pixels = _glMapBuffer(SCREENSHOT_PIXEL_PACK_BUFFER, SCREENSHOT_READ_ONLY);
+	if (pixels != nullptr) {
+		_QueueJobs(pixels, readback.width, readback.height, readback.filenames);
+		_glUnmapBuffer(SCREENSHOT_PIXEL_PACK_BUFFER);
+	}
+	else {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to map the pixel buffer of a screenshot" << endl;
+	}
+	_glBindBuffer(SCREENSHOT_PIXEL_PACK_BUFFER, 0);
+
+	readback.filenames.clear();
+}
+
+
+
+void ScreenshotWriter::_QueueJobs(const void* pixels, int32 width, int32 height, const vector<string>& filenames) {
+	size_t size = width * height * 4;
+	bool worker_running = _StartWorker();
+
+	for (uint32 i = 0; i < filenames.size(); ++i) {
+		ScreenshotJob* job = new ScreenshotJob();
+		job->filename = filenames[i];
+		job->image.width = width;
+		job->image.height = height;
+		job->image.rgb_format = false;
+		job->image.pixels = malloc(size);
+		memcpy(job->image.pixels, pixels, size);
+
+		if (worker_running == false) {
+			_SaveJob(job);
+			continue;
+		}
+
+		SDL_LockMutex(_job_mutex);
+		_jobs.push_back(job);
+		SDL_CondSignal(_job_condition);
+		SDL_UnlockMutex(_job_mutex);
+	}
+}
+
+
+
+bool ScreenshotWriter::_StartWorker() {
+	if (_worker_thread != nullptr)
+		return true;
+
+	if (_job_mutex == nullptr)
+		_job_mutex = SDL_CreateMutex();
+	if (_job_condition == nullptr)
+		_job_condition = SDL_CreateCond();
+	if (_job_mutex == nullptr || _job_condition == nullptr) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to create the screenshot job queue, screenshots will be saved synchronously: "
+			<< SDL_GetError() << endl;
+		return false;
+	}
+
+	_stop_worker = false;
+	_worker_thread = SDL_CreateThread(_WorkerThread, "screenshot", this);
+	if (_worker_thread == nullptr) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to start the screenshot thread, screenshots will be saved synchronously: "
+			<< SDL_GetError() << endl;
+		return false;
+	}
+	return true;
+}
+
+
+
+int ScreenshotWriter::_WorkerThread(void* data) {
+	static_cast<ScreenshotWriter*>(data)->_ProcessJobs();
+	return 0;
+}
+
+
+
+void ScreenshotWriter::_ProcessJobs() {
+	SDL_LockMutex(_job_mutex);
+	while (true) {
+		while (_jobs.empty() == true && _stop_worker == false)
+			SDL_CondWait(_job_condition, _job_mutex);
+
+		// Every queued screenshot is saved before the thread exits
+		if (_jobs.empty() == true)
+			break;
+
+		ScreenshotJob* job = _jobs.front();
+		_jobs.pop_front();
+
+		SDL_UnlockMutex(_job_mutex);
+		_SaveJob(job);
+		SDL_LockMutex(_job_mutex);
+	}
+	SDL_UnlockMutex(_job_mutex);
+}
+
+
+
+void ScreenshotWriter::_SaveJob(ScreenshotJob* job) {
+	ImageMemory& image = job->image;
+	size_t row_size = image.width * 4;
+	uint8* pixels = static_cast<uint8*>(image.pixels);
+
+	// OpenGL returns the bottom row first, so the image is flipped vertically
+	vector<uint8> row(row_size);
+	for (int32 i = 0; i < image.height / 2; ++i) {
+		uint8* top = pixels + i * row_size;
+		uint8* bottom = pixels + (image.height - i - 1) * row_size;
+		memcpy(&row[0], top, row_size);
+		memcpy(top, bottom, row_size);
+		memcpy(bottom, &row[0], row_size);
+	}
+
+	// Screenshots are always saved as JPG images, whatever the extension of the filename
+	if (image.SaveImage(job->filename, false) == false) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to save screenshot: " << job->filename << endl;
+	}
+
+	free(image.pixels);
+	image.pixels = nullptr;
+	delete job;
+}
+
+} // namespace private_video
+
+} // namespace hoa_video
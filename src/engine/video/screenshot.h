@@ -0,0 +1,207 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    screenshot.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for saving screenshots without stalling the frame
+***
+*** Reading the screen with glReadPixels() into client memory forces the CPU to
+*** wait until the GPU has finished drawing the frame, and encoding the pixels
+*** as a JPG image takes far longer than drawing a frame. Screenshots
+*** are instead read into one of two pixel buffer objects at the end of the
+*** frame in which they were requested. The driver copies the pixels in the
+*** background, and the buffer is mapped one frame later, when the copy has
+*** completed. The pixels are then handed to a worker thread which flips and
+*** encodes them through ImageMemory::SaveImage().
+***
+*** When pixel buffer objects are not supported, the pixels are read directly
+*** but are still encoded by the worker thread.
+*** ***************************************************************************/
+
+#pragma once
+
+// OpenGL includes
+#ifdef __APPLE__
+	#include <OpenGL/gl.h>
+#else
+	#include <GL/gl.h>
+#endif
+
+#ifndef APIENTRY
+	#define APIENTRY
+#endif
+
+#include <cstddef>
+#include <deque>
+
+#include <SDL2/SDL_thread.h>
+#include <SDL2/SDL_mutex.h>
+
+#include "defs.h"
+#include "utils.h"
+
+#include "image_base.h"
+
+namespace hoa_video {
+
+namespace private_video {
+
+//! \brief The number of pixel buffers that screen reads alternate between
+const uint32 VIDEO_SCREENSHOT_BUFFERS = 2;
+
+/** ****************************************************************************
+*** \brief A screenshot that has been read from the screen and is waiting to be saved
+*** ***************************************************************************/
+class ScreenshotJob {
+public:
+	//! \brief The name of the file to save the screenshot to
+	std::string filename;
+
+	//! \brief The RGBA pixels of the screenshot, with the bottom row first as OpenGL returns them
+	ImageMemory image;
+}; // class ScreenshotJob
+
+
+/** ****************************************************************************
+*** \brief A read of the screen that may still be in progress
+*** ***************************************************************************/
+class ScreenshotReadback {
+public:
+	ScreenshotReadback() :
+		buffer(0), buffer_size(0), width(0), height(0) {}
+
+	//! \brief The OpenGL name of the pixel buffer that the screen is read into
+	GLuint buffer;
+
+	//! \brief The size of the storage allocated for the buffer, in bytes
+	size_t buffer_size;
+
+	//! \brief The dimensions of the area that was read
+	int32 width, height;
+
+	//! \brief The files to save the pixels to, which is empty if no read is in progress
+	std::vector<std::string> filenames;
+}; // class ScreenshotReadback
+
+
+/** ****************************************************************************
+*** \brief Reads screenshots with pixel buffer objects and saves them on a worker thread
+***
+*** The video engine owns the only instance of this class. Initialize() must be
+*** called each time that a new OpenGL context is created, and Flush() must be
+*** called before the context is destroyed.
+***
+*** \note Only the worker thread and the functions that queue jobs for it touch
+*** the job queue, and they always do so while holding the job mutex.
+*** ***************************************************************************/
+class ScreenshotWriter {
+public:
+	ScreenshotWriter();
+
+	//! \brief Waits for every queued screenshot to be saved
+	~ScreenshotWriter();
+
+	/** \brief Loads the pixel buffer entry points for the current context
+	*** \return True if screenshots are read with pixel buffer objects, false if they are read directly
+	**/
+	bool Initialize();
+
+	//! \brief Finishes any read that is in progress and deletes the pixel buffers, which requires the context to still be current
+	void Flush();
+
+	/** \brief Requests that the contents of the screen be saved at the end of the current frame
+	*** \param filename The name of the file to save to. The image is saved in the JPG format regardless of the file extension.
+	**/
+	void RequestScreenshot(const std::string& filename)
+		{ _requests.push_back(filename); }
+
+	/** \brief Starts reading the screen for any requested screenshots and retrieves the read from the previous frame
+	*** This must be called once per frame after everything has been drawn and before the buffers are swapped.
+	**/
+	void ProcessFrame();
+
+private:
+	//! \name Pixel buffer entry point signatures
+	//@{
+	typedef void (APIENTRY *GenBuffersFunction)(GLsizei count, GLuint* buffers);
+	typedef void (APIENTRY *DeleteBuffersFunction)(GLsizei count, const GLuint* buffers);
+	typedef void (APIENTRY *BindBufferFunction)(GLenum target, GLuint buffer);
+	typedef void (APIENTRY *BufferDataFunction)(GLenum target, ptrdiff_t size, const void* data, GLenum usage);
+	typedef void* (APIENTRY *MapBufferFunction)(GLenum target, GLenum access);
+	typedef GLboolean (APIENTRY *UnmapBufferFunction)(GLenum target);
+	//@}
+
+	//! \name Pixel buffer entry points for the current context
+	//@{
+	GenBuffersFunction _glGenBuffers;
+	DeleteBuffersFunction _glDeleteBuffers;
+	BindBufferFunction _glBindBuffer;
+	BufferDataFunction _glBufferData;
+	MapBufferFunction _glMapBuffer;
+	UnmapBufferFunction _glUnmapBuffer;
+	//@}
+
+	//! \brief True if the current context supports pixel buffer objects
+	bool _pixel_buffers_supported;
+
+	//! \brief The files that have been requested to be saved since the last call to ProcessFrame()
+	std::vector<std::string> _requests;
+
+	//! \brief The pixel buffers that screen reads alternate between
+	ScreenshotReadback _readbacks[VIDEO_SCREENSHOT_BUFFERS];
+
+	//! \brief The index of the readback that the next read of the screen will use
+	uint32 _next_readback;
+
+	//! \brief The thread that saves the screenshots, or nullptr if it has not been started
+	SDL_Thread* _worker_thread;
+
+	//! \brief Protects the job queue and the stop flag
+	SDL_mutex* _job_mutex;
+
+	//! \brief Signaled when a job is queued or when the worker thread should stop
+	SDL_cond* _job_condition;
+
+	//! \brief The screenshots waiting to be saved
+	std::deque<ScreenshotJob*> _jobs;
+
+	//! \brief Set to true to make the worker thread exit after it has saved every queued screenshot
+	bool _stop_worker;
+
+	//! \brief Reads the screen into a readback, directly into new jobs if pixel buffers are not supported
+	void _StartReadback(ScreenshotReadback& readback);
+
+	//! \brief Maps the pixel buffer of a readback that is in progress and queues its pixels to be saved
+	void _FinishReadback(ScreenshotReadback& readback);
+
+	/** \brief Creates a job for each of the files that the pixels should be saved to and queues them
+	*** \param pixels The RGBA pixels, which are copied
+	*** \param width The width of the image
+	*** \param height The height of the image
+	*** \param filenames The files to save the image to
+	**/
+	void _QueueJobs(const void* pixels, int32 width, int32 height, const std::vector<std::string>& filenames);
+
+	//! \brief Starts the worker thread if it is not already running, returning false if it could not be started
+	bool _StartWorker();
+
+	//! \brief The entry point of the worker thread
+	static int _WorkerThread(void* data);
+
+	//! \brief Saves queued jobs until the worker is told to stop and the queue is empty
+	void _ProcessJobs();
+
+	//! \brief Flips, encodes, and saves a single screenshot, then deletes the job
+	static void _SaveJob(ScreenshotJob* job);
+}; // class ScreenshotWriter
+
+} // namespace private_video
+
+} // namespace hoa_video
@@ -263,7 +263,7 @@ void TextElement::Draw(const Color& draw_color) const {
 		return;
 	}
 
-	glPushMatrix();
+	VideoManager->PushMatrix();
 	_DrawOrientation();
 
 	float modulation = VideoManager->_screen_fader.GetFadeModulation();
@@ -284,7 +284,7 @@ void TextElement::Draw(const Color& draw_color) const {
 		_DrawTexture(modulated_colors);
 	}
 
-	glPopMatrix();
+	VideoManager->PopMatrix();
 } // void TextElement::Draw(const Color& draw_color) const
 
 
@@ -401,12 +401,12 @@ void TextImage::Clear() {
 
 
 void TextImage::Draw() const {
-	glPushMatrix();
+	VideoManager->PushMatrix();
 	for (uint32 i = 0; i < _text_sections.size(); ++i) {
 		_text_sections[i]->Draw();
 		VideoManager->MoveRelative(0.0f, TextManager->GetFontProperties(_style.font)->line_skip * -VideoManager->_current_context.coordinate_system.GetVerticalDirection());
 	}
-	glPopMatrix();
+	VideoManager->PopMatrix();
 }
 
 
@@ -417,12 +417,12 @@ void TextImage::Draw(const Color& draw_color) const {
 		return;
 	}
 
-	glPushMatrix();
+	VideoManager->PushMatrix();
 	for (uint32 i = 0; i < _text_sections.size(); ++i) {
 		_text_sections[i]->Draw(draw_color);
 		VideoManager->MoveRelative(0.0f, TextManager->GetFontProperties(_style.font)->line_skip * -VideoManager->_current_context.coordinate_system.GetVerticalDirection());
 	}
-	glPopMatrix();
+	VideoManager->PopMatrix();
 }
 
 
@@ -648,20 +648,20 @@ void TextSupervisor::Draw(const ustring& text, const TextStyle& style) {
 		}
 
 		// Save the draw cursor position before drawing this text
-		glPushMatrix();
+		VideoManager->PushMatrix();
 
 		// If text shadows are enabled, draw the shadow first
 		if (style.shadow_style != VIDEO_TEXT_SHADOW_NONE) {
-			glPushMatrix();
+			VideoManager->PushMatrix();
 			VideoManager->MoveRelative(VideoManager->_current_context.coordinate_system.GetHorizontalDirection() * style.shadow_offset_x, 0.0f);
 			VideoManager->MoveRelative(0.0f, VideoManager->_current_context.coordinate_system.GetVerticalDirection() * style.shadow_offset_y);
 			_DrawTextHelper(buffer, fp, _GetTextShadowColor(style));
-			glPopMatrix();
+			VideoManager->PopMatrix();
 		}
 
 		// Now draw the text itself, restore the position of the draw cursor, and move the draw cursor one line down
 		_DrawTextHelper(buffer, fp, style.color);
-		glPopMatrix();
+		VideoManager->PopMatrix();
 		VideoManager->MoveRelative(0, -fp->line_skip * VideoManager->_current_context.coordinate_system.GetVerticalDirection());
 
 	} while (last_line < text.length());
@@ -812,24 +812,30 @@ void TextSupervisor::_CacheGlyphs(const uint16* text, FontProperties* fp) {
 			return;
 		}
 
-		glGenTextures(1, &texture);
-		TextureManager->_BindTexture(texture);
-
-
-		SDL_LockSurface(intermediary);
-
-		uint32 num_bytes = w * h * 4;
-		for (uint32 j = 0; j < num_bytes; j += 4) {
-			(static_cast<uint8*>(intermediary->pixels))[j+3] = (static_cast<uint8*>(intermediary->pixels))[j+2];
-			(static_cast<uint8*>(intermediary->pixels))[j+0] = 0xff;
-			(static_cast<uint8*>(intermediary->pixels))[j+1] = 0xff;
-			(static_cast<uint8*>(intermediary->pixels))[j+2] = 0xff;
+		// The glyph metrics are still needed to lay out text when running headless, but the glyph texture is not
+		if (VideoManager->IsHeadless() == true) {
+			texture = TextureManager->_CreateBlankGLTexture(w, h);
 		}
+		else {
+			glGenTextures(1, &texture);
+			TextureManager->_BindTexture(texture);
+			VideoManager->_render_statistics.RecordTextureCreation(w, h);
+
+			SDL_LockSurface(intermediary);
+
+			uint32 num_bytes = w * h * 4;
+			for (uint32 j = 0; j < num_bytes; j += 4) {
+				(static_cast<uint8*>(intermediary->pixels))[j+3] = (static_cast<uint8*>(intermediary->pixels))[j+2];
+				(static_cast<uint8*>(intermediary->pixels))[j+0] = 0xff;
+				(static_cast<uint8*>(intermediary->pixels))[j+1] = 0xff;
+				(static_cast<uint8*>(intermediary->pixels))[j+2] = 0xff;
+			}
 
-		glTexImage2D(GL_TEXTURE_2D, 0, 4, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, intermediary->pixels );
-		SDL_UnlockSurface(intermediary);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, intermediary->pixels );
+			SDL_UnlockSurface(intermediary);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		}
 
 		if (VideoManager->CheckGLError()) {
 			SDL_FreeSurface(initial);
@@ -878,6 +884,16 @@ void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* f
 		return;
 	}
 
+	// Each glyph is drawn as its own quad
+	if (VideoManager->IsHeadless() == true) {
+		for (const uint16* glyph = text; *glyph != 0; ++glyph) {
+			VideoManager->_render_statistics.RecordDrawCall();
+		}
+		return;
+	}
+
+	GLDebugGroup debug_group("TextSupervisor::_DrawTextHelper");
+
 	glBlendFunc(GL_ONE, GL_ONE);
 	glEnable(GL_BLEND);
 
@@ -885,19 +901,25 @@ void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* f
 
 	_CacheGlyphs(text, fp);
 
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-	glEnable(GL_TEXTURE_2D);
-	glEnable(GL_ALPHA_TEST);
-	glAlphaFunc(GL_GREATER, 0.1f);
-
-	glPushMatrix();
-
 	int font_width, font_height;
 	if (TTF_SizeUNICODE(fp->ttf_font, text, &font_width, &font_height) != 0) {
 		IF_PRINT_WARNING(VIDEO_DEBUG) << "call to TTF_SizeUNICODE() failed" << endl;
 		return;
 	}
 
+	bool core_profile = VideoManager->_core_renderer.IsActive();
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	if (core_profile == true) {
+		VideoManager->_core_renderer.SetAlphaTest(0.1f);
+	}
+	else {
+		glEnable(GL_TEXTURE_2D);
+		glEnable(GL_ALPHA_TEST);
+		glAlphaFunc(GL_GREATER, 0.1f);
+	}
+
+	VideoManager->PushMatrix();
+
 	float xoff = ((VideoManager->_current_context.x_align + 1) * font_width) * 0.5f * -cs.GetHorizontalDirection();
 	float yoff = ((VideoManager->_current_context.y_align + 1) * font_height) * 0.5f * -cs.GetVerticalDirection();
 
@@ -906,13 +928,14 @@ void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* f
 	float modulation = VideoManager->_screen_fader.GetFadeModulation();
 	Color final_color = text_color * modulation;
 
-	glEnableClientState(GL_VERTEX_ARRAY);
-	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
-
 	GLint vertices[8];
 	GLfloat tex_coords[8];
-	glVertexPointer(2, GL_INT, 0, vertices);
-	glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
+	if (core_profile == false) {
+		glEnableClientState(GL_VERTEX_ARRAY);
+		glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+		glVertexPointer(2, GL_INT, 0, vertices);
+		glTexCoordPointer(2, GL_FLOAT, 0, tex_coords);
+	}
 
 	// Iterate through each character in the string and render the character glyphs one at a time
 	int xpos = 0;
@@ -933,10 +956,6 @@ void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* f
 		ty = glyph_info->max_y;
 
 		TextureManager->_BindTexture(glyph_info->texture);
-		if (VideoManager->CheckGLError()) {
-			IF_PRINT_WARNING(VIDEO_DEBUG) << "OpenGL error detected: " << VideoManager->CreateGLErrorString() << endl;
-			return;
-		}
 
 		vertices[0] = min_x;
 		vertices[1] = min_y;
@@ -955,17 +974,31 @@ void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* f
 		tex_coords[6] = 0.0f;
 		tex_coords[7] = 0.0f;
 
-		glColor4fv((GLfloat*)&final_color);
-		glDrawArrays(GL_QUADS, 0, 4);
+		if (core_profile == true) {
+			float core_vertices[8];
+			for (uint32 i = 0; i < 8; ++i)
+				core_vertices[i] = static_cast<float>(vertices[i]);
+			VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, core_vertices, tex_coords, &final_color, true, 1);
+		}
+		else {
+			glColor4fv((GLfloat*)&final_color);
+			glDrawArrays(GL_QUADS, 0, 4);
+		}
+		VideoManager->_render_statistics.RecordDrawCall();
 
 		xpos += glyph_info->advance;
 	} // for (const uint16* glyph = text; *glyph != 0; glyph++)
 
-	glDisableClientState(GL_VERTEX_ARRAY);
-	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
-	glPopMatrix();
+	VideoManager->PopMatrix();
 
-	glDisable(GL_ALPHA_TEST);
+	if (core_profile == true) {
+		VideoManager->_core_renderer.SetAlphaTest(CORE_ALPHA_TEST_DISABLED);
+	}
+	else {
+		glDisableClientState(GL_VERTEX_ARRAY);
+		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		glDisable(GL_ALPHA_TEST);
+	}
 } // void TextSupervisor::_DrawTextHelper(const uint16* const text, FontProperties* fp, Color color)
 
 
@@ -44,7 +44,7 @@ TexSheet::TexSheet(int32 sheet_width, int32 sheet_height, GLuint sheet_id, TexSh
 
 TexSheet::~TexSheet() {
 	// Unload OpenGL texture from memory
-	TextureManager->_DeleteTexture(tex_id);
+	TextureManager->_DeleteTexture(tex_id, width, height);
 }
 
 
@@ -55,7 +55,7 @@ bool TexSheet::Unload() {
 		return false;
 	}
 
-	TextureManager->_DeleteTexture(tex_id);
+	TextureManager->_DeleteTexture(tex_id, width, height);
 	tex_id = INVALID_TEXTURE_ID;
 	loaded = false;
 	return true;
@@ -98,6 +98,10 @@ bool TexSheet::Reload() {
 
 
 bool TexSheet::CopyRect(int32 x, int32 y, ImageMemory& data) {
+	VideoManager->_render_statistics.texture_uploads++;
+	if (VideoManager->IsHeadless() == true)
+		return true;
+
 	TextureManager->_BindTexture(tex_id);
 
 	glTexSubImage2D(
@@ -123,6 +127,10 @@ bool TexSheet::CopyRect(int32 x, int32 y, ImageMemory& data) {
 
 
 bool TexSheet::CopyScreenRect(int32 x, int32 y, const ScreenRect& screen_rect) {
+	VideoManager->_render_statistics.texture_uploads++;
+	if (VideoManager->IsHeadless() == true)
+		return true;
+
 	TextureManager->_BindTexture(tex_id);
 
 	glCopyTexSubImage2D(
@@ -154,6 +162,9 @@ void TexSheet::Smooth(bool flag) {
 	// If setting has changed, set the appropriate filtering
 	if (smoothed != flag) {
 		smoothed = flag;
+		if (VideoManager->IsHeadless() == true)
+			return;
+
 		GLenum filtering_type = smoothed ? GL_LINEAR : GL_NEAREST;
 
 		TextureManager->_BindTexture(tex_id);
@@ -181,8 +192,20 @@ void TexSheet::DEBUG_Draw() const {
 		0.0f, 0.0f, // Upper left
 	};
 
+	VideoManager->_render_statistics.RecordDrawCall();
+	if (VideoManager->IsHeadless() == true)
+		return;
+
+	GLDebugGroup debug_group("TexSheet::DEBUG_Draw");
+
 	// Enable texturing and bind the texture
 	glDisable(GL_BLEND);
+	if (VideoManager->_core_renderer.IsActive() == true) {
+		TextureManager->_BindTexture(tex_id);
+		VideoManager->_core_renderer.DrawQuads(VideoManager->_transform, vertex_coords, texture_coords, &Color::white, true, 1);
+		return;
+	}
+
 	glEnable(GL_TEXTURE_2D);
 	TextureManager->_BindTexture(tex_id);
 
@@ -194,10 +217,6 @@ void TexSheet::DEBUG_Draw() const {
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glVertexPointer(2, GL_FLOAT, 0, vertex_coords);
 	glDrawArrays(GL_QUADS, 0, 4);
-
-	if (VideoManager->CheckGLError() == true) {
-		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occurred: " << VideoManager->CreateGLErrorString() << endl;
-	}
 } // void TexSheet::DEBUG_Draw() const
 
 // -----------------------------------------------------------------------------
@@ -32,7 +32,8 @@ TextureController* TextureManager = nullptr;
 TextureController::TextureController() :
 	debug_current_sheet(-1),
 	_last_tex_id(INVALID_TEXTURE_ID),
-	_debug_num_tex_switches(0)
+	_debug_num_tex_switches(0),
+	_last_headless_tex_id(0)
 {}
 
 
@@ -120,8 +121,9 @@ bool TextureController::UnloadTextures() {
 		if (fp->glyph_cache != nullptr) {
 			for (uint32 k = 0; k < fp->glyph_cache->size(); ++k) {
 				if (fp->glyph_cache->at(k) != nullptr) {
-					_DeleteTexture(fp->glyph_cache->at(k)->texture);
-					delete fp->glyph_cache->at(k);
+					FontGlyph* glyph = fp->glyph_cache->at(k);
+					_DeleteTexture(glyph->texture, RoundUpPow2(glyph->width), RoundUpPow2(glyph->height));
+					delete glyph;
 				}
 			}
 
@@ -210,13 +212,13 @@ void TextureController::DEBUG_ShowTexSheet() {
 	VideoManager->SetDrawFlags(VIDEO_NO_BLEND, VIDEO_X_LEFT, VIDEO_Y_BOTTOM, 0);
 	VideoManager->SetCoordSys(0.0f, 1024.0f, 0.0f, 768.0f);
 
-	glPushMatrix();
+	VideoManager->PushMatrix();
 	VideoManager->Move(0.0f,0.0f);
-	glScalef(sheet->width / 2.0f, sheet->height / 2.0f, 1.0f);
+	VideoManager->Scale(sheet->width / 2.0f, sheet->height / 2.0f);
 
 	sheet->DEBUG_Draw();
 
-	glPopMatrix();
+	VideoManager->PopMatrix();
 
 	char buf[200];
 
@@ -259,25 +261,30 @@ void TextureController::DEBUG_ShowTexSheet() {
 
 
 GLuint TextureController::_CreateBlankGLTexture(int32 width, int32 height) {
+	VideoManager->_render_statistics.RecordTextureCreation(width, height);
+
+	// Without a window no OpenGL context exists, so hand out unique IDs that are never used by OpenGL
+	if (VideoManager->IsHeadless() == true) {
+		return ++_last_headless_tex_id;
+	}
+
+	GLDebugGroup debug_group("TextureController::_CreateBlankGLTexture");
+
 	GLuint tex_id;
 	glGenTextures(1, &tex_id);
 
 	if (VideoManager->CheckGLError()) {
 		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error was detected: " << VideoManager->CreateGLErrorString() << endl;
-		_DeleteTexture(tex_id);
+		_DeleteTexture(tex_id, width, height);
 		return INVALID_TEXTURE_ID;
 	}
 
-	_BindTexture(tex_id); // NOTE: this call makes another call to VideoManager->CheckGLError()
-
-	// If the binding was successful, initialize the texture with glTexImage2D()
-	if (VideoManager->GetGLError() == GL_NO_ERROR) {
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
-	}
+	_BindTexture(tex_id);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 
 	if (VideoManager->CheckGLError()) {
 		PRINT_ERROR << "failed to create new texture. OpenGL reported the following error: " << VideoManager->CreateGLErrorString() << endl;
-		_DeleteTexture(tex_id);
+		_DeleteTexture(tex_id, width, height);
 		return INVALID_TEXTURE_ID;
 	}
 
@@ -286,8 +293,10 @@ GLuint TextureController::_CreateBlankGLTexture(int32 width, int32 height) {
 
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering_type);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering_type);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+	// GL_CLAMP does not exist in a core profile context
+	GLenum wrap_mode = VideoManager->IsCoreProfile() ? CORE_TEXTURE_WRAP_MODE : GL_CLAMP;
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_mode);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_mode);
 
 	return tex_id;
 }
@@ -300,22 +309,26 @@ void TextureController::_BindTexture(GLuint tex_id) {
 		return;
 
 	_last_tex_id = tex_id;
-	glBindTexture(GL_TEXTURE_2D, tex_id);
 	_debug_num_tex_switches++;
+	if (VideoManager->IsHeadless() == true)
+		return;
 
-	if (VideoManager->CheckGLError()) {
-		PRINT_WARNING << "an OpenGL error was detected: " << VideoManager->CreateGLErrorString() << endl;
-	}
+	glBindTexture(GL_TEXTURE_2D, tex_id);
 }
 
 
 
-void TextureController::_DeleteTexture(GLuint tex_id) {
-	glDeleteTextures(1, &tex_id);
-
+void TextureController::_DeleteTexture(GLuint tex_id, int32 width, int32 height) {
 	if (_last_tex_id == tex_id)
 		_last_tex_id = INVALID_TEXTURE_ID;
 
+	if (tex_id != INVALID_TEXTURE_ID)
+		VideoManager->_render_statistics.RecordTextureDeletion(width, height);
+	if (VideoManager->IsHeadless() == true)
+		return;
+
+	glDeleteTextures(1, &tex_id);
+
 	if (VideoManager->CheckGLError()) {
 		PRINT_WARNING << "an OpenGL error was detected: " << VideoManager->CreateGLErrorString() << endl;
 	}
@@ -109,6 +109,9 @@ private:
 	//! \brief Keeps track of the number of texture switches per frame
 	uint32 _debug_num_tex_switches;
 
+	//! \brief The most recent texture ID handed out when the video engine is headless and no OpenGL context exists
+	GLuint _last_headless_tex_id;
+
 	// ---------- Private methods
 
 	//! \name Texture Operations
@@ -128,8 +131,10 @@ private:
 
 	/** \brief A wrapper to glDeleteTextures() that also adds checking to eliminate redundant texture binding
 	*** \param tex_id The integer handle to the OpenGL texture to delete
+	*** \param width The width of the texture in pixels, used to track the texture memory that is in use
+	*** \param height The height of the texture in pixels, used to track the texture memory that is in use
 	 */
-	void _DeleteTexture(GLuint tex_id);
+	void _DeleteTexture(GLuint tex_id, int32 width, int32 height);
 
 	/** \brief Saves all temporary textures (textures not loaded from a file) to disk
 	*** \return True only if all temporary textures were successfully saved to a file
@@ -0,0 +1,83 @@
+////////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+////////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    transform.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for the Transform2D class.
+*** ***************************************************************************/
+
+#pragma once
+
+#include "defs.h"
+#include "utils.h"
+
+namespace hoa_video {
+
+namespace private_video {
+
+/** ****************************************************************************
+*** \brief A two dimensional affine transformation
+***
+*** This holds the model-view transformation that the video engine applies to
+*** everything it draws. Each operation multiplies the transformation on the
+*** right, exactly like the corresponding OpenGL matrix function, so the two
+*** can be used interchangeably. The matrix is stored as:
+***
+*** | a  c  x |
+*** | b  d  y |
+*** | 0  0  1 |
+*** ***************************************************************************/
+class Transform2D {
+public:
+	Transform2D()
+		{ Reset(); }
+
+	//! \brief Sets the transformation to the identity, like glLoadIdentity()
+	void Reset()
+		{ a = 1.0f; b = 0.0f; c = 0.0f; d = 1.0f; x = 0.0f; y = 0.0f; }
+
+	//! \brief Applies a translation, like glTranslatef()
+	void Translate(float tx, float ty)
+		{ x += a * tx + c * ty; y += b * tx + d * ty; }
+
+	//! \brief Applies a scale, like glScalef()
+	void Scale(float sx, float sy)
+		{ a *= sx; b *= sx; c *= sy; d *= sy; }
+
+	//! \brief Applies a counter-clockwise rotation about the z axis in degrees, like glRotatef()
+	void Rotate(float degrees) {
+		float radians = degrees * hoa_utils::UTILS_PI / 180.0f;
+		float cosine = cosf(radians);
+		float sine = sinf(radians);
+		float new_a = a * cosine + c * sine;
+		float new_b = b * cosine + d * sine;
+		c = c * cosine - a * sine;
+		d = d * cosine - b * sine;
+		a = new_a;
+		b = new_b;
+	}
+
+	/** \brief Replaces the transformation with the two dimensional part of an OpenGL matrix, like glLoadMatrixf()
+	*** \param matrix A 4x4 matrix in column-major order
+	**/
+	void Load(const float matrix[16])
+		{ a = matrix[0]; b = matrix[1]; c = matrix[4]; d = matrix[5]; x = matrix[12]; y = matrix[13]; }
+
+	//! \brief Transforms a point
+	void Apply(float px, float py, float& out_x, float& out_y) const
+		{ out_x = a * px + c * py + x; out_y = b * px + d * py + y; }
+
+	//! \brief The components of the transformation matrix
+	float a, b, c, d, x, y;
+}; // class Transform2D
+
+} // namespace private_video
+
+} // namespace hoa_video
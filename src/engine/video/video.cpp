@@ -67,6 +67,64 @@ void RotatePoint(float& x, float& y, float angle) {
 	y = y * cos_angle + original_x * sin_angle;
 }
 
+//-----------------------------------------------------------------------------
+// RenderStatistics class
+//-----------------------------------------------------------------------------
+
+void RenderStatistics::Reset() {
+	frames = 0;
+	draw_calls = 0;
+	frame_draw_calls = 0;
+	peak_frame_draw_calls = 0;
+	textures_created = 0;
+	textures_deleted = 0;
+	texture_bytes_resident = 0;
+	peak_texture_bytes_resident = 0;
+	texture_uploads = 0;
+}
+
+
+
+void RenderStatistics::RecordTextureCreation(int32 width, int32 height) {
+	++textures_created;
+	texture_bytes_resident += width * height * 4;
+	if (texture_bytes_resident > peak_texture_bytes_resident)
+		peak_texture_bytes_resident = texture_bytes_resident;
+}
+
+
+
+void RenderStatistics::RecordTextureDeletion(int32 width, int32 height) {
+	++textures_deleted;
+	uint32 bytes = width * height * 4;
+	texture_bytes_resident = (bytes < texture_bytes_resident) ? texture_bytes_resident - bytes : 0;
+}
+
+
+
+void RenderStatistics::RecordFrame() {
+	++frames;
+	if (frame_draw_calls > peak_frame_draw_calls)
+		peak_frame_draw_calls = frame_draw_calls;
+	frame_draw_calls = 0;
+}
+
+
+
+void RenderStatistics::DEBUG_PrintStatistics() const {
+	cout << "__Render Statistics__" << endl;
+	cout << "* frames displayed:        " << frames << endl;
+	cout << "* draw calls:              " << draw_calls << endl;
+	cout << "* draw calls per frame:    " << (frames == 0 ? 0.0f : static_cast<float>(draw_calls) / static_cast<float>(frames)) << endl;
+	cout << "* peak draw calls (frame): " << peak_frame_draw_calls << endl;
+	cout << "* textures created:        " << textures_created << endl;
+	cout << "* textures deleted:        " << textures_deleted << endl;
+	cout << "* texture bytes resident:  " << texture_bytes_resident << endl;
+	cout << "* peak texture bytes:      " << peak_texture_bytes_resident << endl;
+	cout << "* texture uploads:         " << texture_uploads << endl;
+	cout << endl;
+}
+
 //-----------------------------------------------------------------------------
 // VideoEngine class
 //-----------------------------------------------------------------------------
@@ -99,6 +157,14 @@ VideoEngine::VideoEngine() :
 	_current_sample = 0;
 	_number_samples = 0;
 
+	_vsync = VIDEO_DEFAULT_VSYNC;
+	_target_fps = VIDEO_DEFAULT_TARGET_FPS;
+	_low_power_mode = false;
+	_core_profile = false;
+	_last_frame_counter = 0;
+	_current_frame_duration = 0;
+	_number_frame_durations = 0;
+
 	_current_context.blend = 0;
 	_current_context.x_align = -1;
 	_current_context.y_align = -1;
@@ -113,6 +179,8 @@ VideoEngine::VideoEngine() :
 
 	for (uint32 sample = 0; sample < FPS_SAMPLES; sample++)
 		 _fps_samples[sample] = 0;
+	for (uint32 sample = 0; sample < FRAME_TIME_SAMPLES; sample++)
+		 _frame_durations[sample] = 0.0f;
 
 	_light_overlay_enabled = false;
 	_ambient_overlay_enabled = false;
@@ -141,6 +209,8 @@ VideoEngine::~VideoEngine() {
 	_ambient_overlay_image.Clear();
 
 	TextureManager->SingletonDestroy();
+	_core_renderer.Destroy();
+	_screenshot_writer.Flush();
 }
 
 
@@ -194,12 +264,29 @@ void VideoEngine::DrawFPS(uint32 frame_time) {
 
 	uint32 avg_fps = _fps_sum / FPS_SAMPLES;
 
+	// Determine the standard deviation of the recent frame durations, which shows how evenly paced the frames are
+	float mean_duration = 0.0f;
+	float duration_variance = 0.0f;
+	if (_number_frame_durations != 0) {
+		for (uint32 i = 0; i < _number_frame_durations; i++)
+			mean_duration += _frame_durations[i];
+		mean_duration /= static_cast<float>(_number_frame_durations);
+
+		for (uint32 i = 0; i < _number_frame_durations; i++)
+			duration_variance += (_frame_durations[i] - mean_duration) * (_frame_durations[i] - mean_duration);
+		duration_variance /= static_cast<float>(_number_frame_durations);
+	}
+
 	// The text to display to the screen
 	char fps_text[16];
 	sprintf(fps_text, "FPS: %d", avg_fps);
+	char deviation_text[32];
+	sprintf(deviation_text, "+/- %.1fms", sqrtf(duration_variance));
 
 	Move(930.0f, 720.0f); // Upper right hand corner of the screen
 	Text()->Draw(fps_text, TextStyle("text20", Color::white));
+	Move(930.0f, 700.0f);
+	Text()->Draw(deviation_text, TextStyle("text20", Color::white));
 	PopState();
 } // void GUISystem::_DrawFPS(uint32 frame_time)
 
@@ -213,6 +300,15 @@ bool VideoEngine::SingletonInitialize() {
     // initialize window pointer
 	window = nullptr;
 
+	// Without a window only the event queue is needed, which the input engine still polls every frame
+	if (_target == VIDEO_TARGET_NULL) {
+		if (SDL_InitSubSystem(SDL_INIT_EVENTS) < 0) {
+			PRINT_ERROR << "SDL event initialization failed" << endl;
+			return false;
+		}
+		return true;
+	}
+
 	if (SDL_InitSubSystem(SDL_INIT_VIDEO) < 0) {
 		PRINT_ERROR << "SDL video initialization failed" << endl;
 		return false;
@@ -267,6 +363,12 @@ void VideoEngine::SetInitialResolution(int32 width, int32 height) {
     // TODO loop over SDL_GetNumVideoDisplays() and SDL_GetDisplayMode() somewhere
     // until the above is done, defaulting to display 0 mode 0
 
+	// There is no display to query when running without a window, so any resolution is acceptable
+	if (_target == VIDEO_TARGET_NULL) {
+		SetResolution(width, height);
+		return;
+	}
+
     SDL_DisplayMode display;
 
     // Attempt to get the default display's info
@@ -357,14 +459,13 @@ void VideoEngine::Clear() {
 
 void VideoEngine::Clear(const Color &c) {
 	SetViewport(0.0f, 100.0f, 0.0f, 100.0f);
-	glClearColor(c[0], c[1], c[2], c[3]);
-	glClear(GL_COLOR_BUFFER_BIT);
-
 	TextureManager->_debug_num_tex_switches = 0;
 
-	if (CheckGLError() == true) {
-		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << CreateGLErrorString() << endl;
-	}
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
+	glClearColor(c[0], c[1], c[2], c[3]);
+	glClear(GL_COLOR_BUFFER_BIT);
 }
 
 
@@ -397,13 +498,124 @@ void VideoEngine::Display(uint32 frame_time) {
 
 	PopState();
 
-	SDL_GL_SwapWindow(window);
+	_render_statistics.RecordFrame();
+	if (_target != VIDEO_TARGET_NULL) {
+		// Screenshots are read once the frame is complete, but before the back buffer becomes undefined
+		_screenshot_writer.ProcessFrame();
+		SDL_GL_SwapWindow(window);
+	}
+
+	_CheckFrameGLErrors();
 
+	_PaceFrame();
 } // void VideoEngine::Display(uint32 frame_time)
 
 
 
+void VideoEngine::SetVSync(bool vsync) {
+	_vsync = vsync;
+	_ApplySwapInterval();
+}
+
+
+
+void VideoEngine::_SetContextProfileAttributes() {
+	if (_core_profile == true) {
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 3);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+	}
+	else {
+		// These are the SDL defaults, which allow any context that supports the fixed-function pipeline
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MAJOR_VERSION, 2);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_MINOR_VERSION, 1);
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_PROFILE_MASK, 0);
+	}
+}
+
+
+
+void VideoEngine::_ApplySwapInterval() {
+	// The swap interval belongs to the OpenGL context, so it can only be set once the window exists
+	if (_target != VIDEO_TARGET_SDL_WINDOW || window == nullptr)
+		return;
+
+	if (_vsync == false) {
+		SDL_GL_SetSwapInterval(0);
+		return;
+	}
+
+	// Adaptive vsync (a swap interval of -1) is not supported by every driver
+	if (SDL_GL_SetSwapInterval(-1) == 0)
+		return;
+
+	IF_PRINT_DEBUG(VIDEO_DEBUG) << "adaptive vsync is not supported, using regular vsync instead: " << SDL_GetError() << endl;
+	if (SDL_GL_SetSwapInterval(1) != 0) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to enable vsync: " << SDL_GetError() << endl;
+	}
+}
+
+
+
+void VideoEngine::_PaceFrame() {
+	// Milliseconds are too coarse for pacing frames, so the high resolution performance counter is used instead
+	const float counts_per_ms = static_cast<float>(SDL_GetPerformanceFrequency()) / 1000.0f;
+
+	uint32 fps = _target_fps;
+	if (_low_power_mode == true && (fps == 0 || fps > VIDEO_LOW_POWER_FPS))
+		fps = VIDEO_LOW_POWER_FPS;
+
+	// There is no reason to limit the frame rate when nothing is being shown
+	if (_target == VIDEO_TARGET_NULL)
+		fps = 0;
+
+	if (fps != 0 && _last_frame_counter != 0) {
+		float frame_length = 1000.0f / static_cast<float>(fps);
+		float time_remaining = frame_length - static_cast<float>(SDL_GetPerformanceCounter() - _last_frame_counter) / counts_per_ms;
+
+		if (time_remaining > FRAME_SPIN_TIME) {
+			SDL_Delay(static_cast<uint32>(time_remaining - FRAME_SPIN_TIME));
+		}
+		while (static_cast<float>(SDL_GetPerformanceCounter() - _last_frame_counter) / counts_per_ms < frame_length) {
+			// Spin until the end of the frame
+		}
+	}
+
+	Uint64 current_counter = SDL_GetPerformanceCounter();
+	if (_last_frame_counter != 0) {
+		_frame_durations[_current_frame_duration] = static_cast<float>(current_counter - _last_frame_counter) / counts_per_ms;
+		_current_frame_duration = (_current_frame_duration + 1) % FRAME_TIME_SAMPLES;
+		if (_number_frame_durations < FRAME_TIME_SAMPLES)
+			_number_frame_durations++;
+	}
+	_last_frame_counter = current_counter;
+}
+
+
+
+void VideoEngine::_CheckFrameGLErrors() {
+	if (VIDEO_DEBUG == false || _target == VIDEO_TARGET_NULL)
+		return;
+
+	// The debug output callback has already reported every error that occurred during the frame
+	if (_gl_debug_output.IsActive() == true) {
+		_gl_debug_output.TakeError(_gl_error_code);
+		return;
+	}
+
+	// OpenGL may hold more than one error flag, so keep checking until all of them have been cleared
+	while (CheckGLError() == true) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occurred during the last frame: " << CreateGLErrorString() << endl;
+	}
+}
+
+
+
 const std::string VideoEngine::CreateGLErrorString() {
+	// The message from the driver describes the error far better than the error code does
+	if (_gl_debug_output.IsActive() == true && _gl_debug_output.GetLastErrorMessage().empty() == false)
+		return _gl_debug_output.GetLastErrorMessage();
+
 	const GLubyte* error_string = gluErrorString(_gl_error_code);
 
 	if (error_string == nullptr)
@@ -429,6 +641,9 @@ bool VideoEngine::ApplySettings() {
 		if (TextureManager && TextureManager->UnloadTextures() == false) {
 			IF_PRINT_WARNING(VIDEO_DEBUG) << "failed to delete OpenGL textures during a context change" << endl;
 		}
+		_gl_debug_output.Disable();
+		_core_renderer.Destroy();
+		_screenshot_writer.Flush();
 
 		Uint32 flags = SDL_WINDOW_OPENGL;
 
@@ -444,7 +659,9 @@ bool VideoEngine::ApplySettings() {
 		SDL_GL_SetAttribute(SDL_GL_DOUBLEBUFFER, 1);
 		SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 2);
 		SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, 4);
-        SDL_GL_SetSwapInterval(1);
+		// A debug context is required for the driver to report errors through the debug output extensions
+		SDL_GL_SetAttribute(SDL_GL_CONTEXT_FLAGS, VIDEO_DEBUG ? SDL_GL_CONTEXT_DEBUG_FLAG : 0);
+		_SetContextProfileAttributes();
 
         // This check is relevant to knowing if a window already exists.
         // If a window exists, we destroy it, since we don't want multiple windows.
@@ -466,7 +683,6 @@ bool VideoEngine::ApplySettings() {
 			SDL_GL_SetAttribute(SDL_GL_ALPHA_SIZE, 0);
 			SDL_GL_SetAttribute(SDL_GL_MULTISAMPLEBUFFERS, 0);
 			SDL_GL_SetAttribute(SDL_GL_MULTISAMPLESAMPLES, 0);
-			SDL_GL_SetSwapInterval(1);
 
 			window = SDL_CreateWindow("Hero of Allacrost", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED,
                        _temp_width, _temp_height, flags);
@@ -487,15 +703,31 @@ bool VideoEngine::ApplySettings() {
 
 		// Only now that SDL_SetVideoMode(...) has been called can we make OpenGL calls
 		glcontext = SDL_GL_CreateContext(window);
+		if (_core_profile == true && (glcontext == nullptr || _core_renderer.Initialize() == false)) {
+			IF_PRINT_WARNING(VIDEO_DEBUG) << "could not draw with an OpenGL 3.3 core profile context, "
+				<< "using the fixed-function pipeline instead" << endl;
+			_core_renderer.Destroy();
+			if (glcontext != nullptr)
+				SDL_GL_DeleteContext(glcontext);
+			_core_profile = false;
+			_SetContextProfileAttributes();
+			glcontext = SDL_GL_CreateContext(window);
+		}
+		_ApplySwapInterval();
+		if (VIDEO_DEBUG == true)
+			_gl_debug_output.Initialize();
+		_screenshot_writer.Initialize();
 		glDisable(GL_BLEND);
-		glDisable(GL_TEXTURE_2D);
-		glDisable(GL_ALPHA_TEST);
 		glDisable(GL_STENCIL_TEST);
 		_current_context.scissoring_enabled = false;
 		glDisable(GL_SCISSOR_TEST);
-		glDisableClientState(GL_VERTEX_ARRAY);
-		glDisableClientState(GL_COLOR_ARRAY);
-		glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		if (_core_renderer.IsActive() == false) {
+			glDisable(GL_TEXTURE_2D);
+			glDisable(GL_ALPHA_TEST);
+			glDisableClientState(GL_VERTEX_ARRAY);
+			glDisableClientState(GL_COLOR_ARRAY);
+			glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+		}
 
 		// Turn off writing to the depth buffer
 		glDepthMask(GL_FALSE);
@@ -510,8 +742,8 @@ bool VideoEngine::ApplySettings() {
 		return true;
 	} // if (_target == VIDEO_TARGET_SDL_WINDOW)
 
-	// Used by the Allacrost editor, which uses QT4
-	else if (_target == VIDEO_TARGET_QT_WIDGET) {
+	// Used by the Allacrost editor, which uses QT4, and when running without any window at all
+	else if (_target == VIDEO_TARGET_QT_WIDGET || _target == VIDEO_TARGET_NULL) {
 		_screen_width = _temp_width;
 		_screen_height = _temp_height;
 		_fullscreen = _temp_fullscreen;
@@ -551,7 +783,8 @@ void VideoEngine::SetViewport(float left, float right, float bottom, float top)
 		t = _screen_height;
 
 	_current_context.viewport = ScreenRect(l, b, r - l, t - b);
-	glViewport(l, b, r - l, t - b);
+	if (_target != VIDEO_TARGET_NULL)
+		glViewport(l, b, r - l, t - b);
 }
 
 
@@ -559,6 +792,19 @@ void VideoEngine::SetViewport(float left, float right, float bottom, float top)
 void VideoEngine::SetCoordSys(const CoordSys& coordinate_system) {
 	_current_context.coordinate_system = coordinate_system;
 
+	// This small translation is supposed to help with pixel-perfect 2D rendering in OpenGL.
+	// Reference: http://www.opengl.org/resources/faq/technical/transformations.htm#tran0030
+	_transform.Reset();
+	_transform.Translate(0.375f, 0.375f);
+
+	if (_core_renderer.IsActive() == true) {
+		_core_renderer.SetProjection(_current_context.coordinate_system.GetLeft(), _current_context.coordinate_system.GetRight(),
+			_current_context.coordinate_system.GetBottom(), _current_context.coordinate_system.GetTop());
+		return;
+	}
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
 	glMatrixMode(GL_PROJECTION);
 	glLoadIdentity();
 	glOrtho(_current_context.coordinate_system.GetLeft(), _current_context.coordinate_system.GetRight(),
@@ -566,8 +812,6 @@ void VideoEngine::SetCoordSys(const CoordSys& coordinate_system) {
 
  	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
-	// This small translation is supposed to help with pixel-perfect 2D rendering in OpenGL.
-	// Reference: http://www.opengl.org/resources/faq/technical/transformations.htm#tran0030
 	glTranslatef(0.375, 0.375, 0);
 }
 
@@ -575,20 +819,24 @@ void VideoEngine::SetCoordSys(const CoordSys& coordinate_system) {
 
 void VideoEngine::EnableScissoring() {
 	_current_context.scissoring_enabled = true;
-	glEnable(GL_SCISSOR_TEST);
+	if (_target != VIDEO_TARGET_NULL)
+		glEnable(GL_SCISSOR_TEST);
 }
 
 
 
 void VideoEngine::DisableScissoring() {
 	_current_context.scissoring_enabled = false;
-	glDisable(GL_SCISSOR_TEST);
+	if (_target != VIDEO_TARGET_NULL)
+		glDisable(GL_SCISSOR_TEST);
 }
 
 
 
 void VideoEngine::SetScissorRect(float left, float right, float bottom, float top) {
 	_current_context.scissor_rectangle = CalculateScreenRect(left, right, bottom, top);
+	if (_target == VIDEO_TARGET_NULL)
+		return;
 
 	glScissor(static_cast<GLint>((_current_context.scissor_rectangle.left / static_cast<float>(VIDEO_STANDARD_RESOLUTION_WIDTH)) * _current_context.viewport.width),
 		static_cast<GLint>((_current_context.scissor_rectangle.top / static_cast<float>(VIDEO_STANDARD_RESOLUTION_HEIGHT)) * _current_context.viewport.height),
@@ -601,6 +849,8 @@ void VideoEngine::SetScissorRect(float left, float right, float bottom, float to
 
 void VideoEngine::SetScissorRect(const ScreenRect& rect) {
 	_current_context.scissor_rectangle = rect;
+	if (_target == VIDEO_TARGET_NULL)
+		return;
 
 	glScissor(static_cast<GLint>((_current_context.scissor_rectangle.left / static_cast<float>(VIDEO_STANDARD_RESOLUTION_WIDTH)) * _current_context.viewport.width),
 		static_cast<GLint>((_current_context.scissor_rectangle.top / static_cast<float>(VIDEO_STANDARD_RESOLUTION_HEIGHT)) * _current_context.viewport.height),
@@ -645,8 +895,12 @@ ScreenRect VideoEngine::CalculateScreenRect(float left, float right, float botto
 //-----------------------------------------------------------------------------
 
 void VideoEngine::Move(float x, float y) {
-	glLoadIdentity();
-	glTranslatef(x, y, 0);
+	_transform.Reset();
+	_transform.Translate(x, y);
+	if (_IsFixedFunction() == true) {
+		glLoadIdentity();
+		glTranslatef(x, y, 0);
+	}
 	_x_cursor = x;
 	_y_cursor = y;
 }
@@ -654,7 +908,9 @@ void VideoEngine::Move(float x, float y) {
 
 
 void VideoEngine::MoveRelative(float x, float y) {
-	glTranslatef(x, y, 0);
+	_transform.Translate(x, y);
+	if (_IsFixedFunction() == true)
+		glTranslatef(x, y, 0);
 	_x_cursor += x;
 	_y_cursor += y;
 }
@@ -664,8 +920,9 @@ void VideoEngine::MoveRelative(float x, float y) {
 
 void VideoEngine::PushState() {
 	// Push current modelview transformation
-	glMatrixMode(GL_MODELVIEW);
-	glPushMatrix();
+	if (_IsFixedFunction() == true)
+		glMatrixMode(GL_MODELVIEW);
+	PushMatrix();
 
 	_context_stack.push(_current_context);
 }
@@ -689,8 +946,12 @@ void VideoEngine::PopState() {
 	SetCoordSys(_current_context.coordinate_system);
 
 	// Restore the modelview transformation
-	glMatrixMode(GL_MODELVIEW);
-	glPopMatrix();
+	if (_IsFixedFunction() == true)
+		glMatrixMode(GL_MODELVIEW);
+	PopMatrix();
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
 	glViewport(_current_context.viewport.left, _current_context.viewport.top, _current_context.viewport.width, _current_context.viewport.height);
 
 	if (_current_context.scissoring_enabled) {
@@ -709,6 +970,10 @@ void VideoEngine::PopState() {
 
 
 void VideoEngine::SetTransform(float matrix[16]) {
+	_transform.Load(matrix);
+	if (_IsFixedFunction() == false)
+		return;
+
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 	glLoadMatrixf(matrix);
@@ -923,7 +1188,15 @@ StillImage VideoEngine::CaptureScreen() throw(Exception) {
 
 	// Retrieve width/height of the viewport. viewport_dimensions[2] is the width, [3] is the height
 	GLint viewport_dimensions[4];
-	glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
+	if (_target == VIDEO_TARGET_NULL) {
+		viewport_dimensions[0] = _current_context.viewport.left;
+		viewport_dimensions[1] = _current_context.viewport.top;
+		viewport_dimensions[2] = _current_context.viewport.width;
+		viewport_dimensions[3] = _current_context.viewport.height;
+	}
+	else {
+		glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
+	}
 	screen_image.SetDimensions((float)viewport_dimensions[2], (float)viewport_dimensions[3]);
 
 	// Set up the screen rectangle to copy
@@ -990,6 +1263,10 @@ void VideoEngine::SetGamma(float value) {
 		IF_PRINT_WARNING(VIDEO_DEBUG) << "tried to set gamma below 0.0f" << endl;
 		_gamma_value = 0.0f;
 	}
+
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
     Uint16 ramp[256];
     SDL_CalculateGammaRamp(_gamma_value,ramp);
 	SDL_SetWindowGammaRamp(window, ramp, ramp, ramp);
@@ -998,43 +1275,12 @@ void VideoEngine::SetGamma(float value) {
 
 
 void VideoEngine::MakeScreenshot(const std::string& filename) {
-	private_video::ImageMemory buffer;
-
-	// Retrieve the width and height of the viewport.
-	GLint viewport_dimensions[4]; // viewport_dimensions[2] is the width, [3] is the height
-	glGetIntegerv(GL_VIEWPORT, viewport_dimensions);
-
-	// Buffer to store the image before it is flipped
-	buffer.width = viewport_dimensions[2];
-	buffer.height = viewport_dimensions[3];
-	buffer.pixels = malloc(buffer.width * buffer.height * 3);
-	buffer.rgb_format = true;
-
-	// Read pixel data
-	glReadPixels(0, 0, buffer.width, buffer.height, GL_RGB, GL_UNSIGNED_BYTE, buffer.pixels);
-
-	if (CheckGLError() == true) {
-		IF_PRINT_WARNING(VIDEO_DEBUG) << "an OpenGL error occured: " << CreateGLErrorString() << endl;
-
-		free(buffer.pixels);
-		buffer.pixels = nullptr;
+	if (_target == VIDEO_TARGET_NULL) {
+		IF_PRINT_WARNING(VIDEO_DEBUG) << "no screen exists to take a screenshot of when running without a window" << endl;
 		return;
 	}
 
-	// Vertically flip the image, then swap the flipped and original images
-	void* buffer_temp = malloc(buffer.width * buffer.height * 3);
-	for (int32 i=0; i < buffer.height; ++i) {
-		memcpy((uint8*)buffer_temp + i * buffer.width * 3, (uint8*)buffer.pixels + (buffer.height - i - 1) * buffer.width * 3, buffer.width * 3);
-	}
-	void* temp = buffer.pixels;
-	buffer.pixels = buffer_temp;
-	buffer_temp = temp;
-
-	buffer.SaveImage(filename, false);
-
-	free(buffer_temp);
-	free(buffer.pixels);
-	buffer.pixels = nullptr;
+	_screenshot_writer.RequestScreenshot(filename);
 }
 
 //-----------------------------------------------------------------------------
@@ -1229,8 +1475,8 @@ void VideoEngine::_UpdateLightning(uint32 frame_time) {
 
 
 void VideoEngine::_DEBUG_ShowAdvancedStats() {
-	char text[50];
-	sprintf(text, "Switches: %d\nParticles: %d", TextureManager->_debug_num_tex_switches, _particle_manager.GetNumParticles());
+	char text[80];
+	sprintf(text, "Switches: %d\nDraws: %d\nParticles: %d", TextureManager->_debug_num_tex_switches, _render_statistics.frame_draw_calls, _particle_manager.GetNumParticles());
 
 	Move(896.0f, 690.0f);
 	TextManager->Draw(text);
@@ -1239,18 +1485,29 @@ void VideoEngine::_DEBUG_ShowAdvancedStats() {
 
 
 void VideoEngine::DrawLine(float x1, float y1, float x2, float y2, float width, const Color& color) {
+	_render_statistics.RecordDrawCall();
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
 	GLfloat vert_coords[] =
 	{
 		x1, y1,
 		x2, y2
 	};
 	glEnable(GL_BLEND);
-	glDisable(GL_TEXTURE_2D);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA); // Normal blending
-	glPushAttrib(GL_LINE_WIDTH);
 
 	float pixel_width, pixel_height;
 	GetPixelSize(pixel_width, pixel_height);
+	if (_core_renderer.IsActive() == true) {
+		glLineWidth(width * pixel_height);
+		_core_renderer.DrawLines(_transform, vert_coords, 2, color);
+		glLineWidth(1.0f);
+		return;
+	}
+
+	glDisable(GL_TEXTURE_2D);
+	glPushAttrib(GL_LINE_WIDTH);
 	glLineWidth(width * pixel_height);
 	glEnableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_COLOR_ARRAY);
@@ -1265,6 +1522,10 @@ void VideoEngine::DrawLine(float x1, float y1, float x2, float y2, float width,
 
 
 void VideoEngine::DrawGrid(float x, float y, float x_step, float y_step, const Color& c) {
+	_render_statistics.RecordDrawCall();
+	if (_target == VIDEO_TARGET_NULL)
+		return;
+
 	PushState();
 
 	Move(0, 0);
@@ -1288,6 +1549,12 @@ void VideoEngine::DrawGrid(float x, float y, float x_step, float y_step, const C
 		vertices.push_back(y);
 		num_vertices += 2;
 	}
+	if (_core_renderer.IsActive() == true) {
+		_core_renderer.DrawLines(_transform, &(vertices[0]), num_vertices, c);
+		PopState();
+		return;
+	}
+
 	glColor4fv(&c[0]);
 	glDisable(GL_TEXTURE_2D);
 	glEnableClientState(GL_VERTEX_ARRAY);
@@ -1342,12 +1609,14 @@ void VideoEngine::DrawLight(float radius, float x, float y, const Color &color)
 
 
 void VideoEngine::SetWindowTitle(const char* title) {
-	SDL_SetWindowTitle(window, title);
+	if (window != nullptr)
+		SDL_SetWindowTitle(window, title);
 }
 
 
 void VideoEngine::SetWindowIcon(SDL_Surface* icon) {
-	SDL_SetWindowIcon(window, icon);
+	if (window != nullptr)
+		SDL_SetWindowIcon(window, icon);
 }
 
 }  // namespace hoa_video
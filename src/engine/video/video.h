@@ -63,13 +63,17 @@ extern "C" {
 #include "context.h"
 #include "color.h"
 #include "coord_sys.h"
+#include "core_renderer.h"
 #include "fade.h"
+#include "gl_debug.h"
 #include "image.h"
 #include "interpolator.h"
 #include "shake.h"
 #include "screen_rect.h"
+#include "screenshot.h"
 #include "texture_controller.h"
 #include "text.h"
+#include "transform.h"
 #include "particle_manager.h"
 #include "particle_effect.h"
 
@@ -93,8 +97,26 @@ const uint32 MAX_FTIME_DIFF = 5;
 //! \brief The number of samples to take if we need to play catchup with the current FPS
 const uint32 FPS_CATCHUP = 20;
 
+//! \brief The number of frame durations to retain for calculating how much the frame time varies
+const uint32 FRAME_TIME_SAMPLES = 60;
+
+/** \brief The number of milliseconds at the end of a limited frame to spin-wait for instead of sleeping
+*** SDL_Delay() commonly oversleeps by a millisecond or more, so sleeping for the entire remaining time of a frame
+*** would make frames late. The final part of the wait is instead spent checking the time until the frame is over.
+**/
+const float FRAME_SPIN_TIME = 2.0f;
+
 }
 
+//! \brief The frame rate that the engine is limited to while low power mode is active
+const uint32 VIDEO_LOW_POWER_FPS = 30;
+
+//! \brief The default frame pacing settings, which match video_defaults in the settings file
+//@{
+const bool VIDEO_DEFAULT_VSYNC = true;
+const uint32 VIDEO_DEFAULT_TARGET_FPS = 0;
+//@}
+
 //! \brief Draw flags to control x and y alignment, flipping, and texture blending.
 enum VIDEO_DRAW_FLAGS {
 	VIDEO_DRAW_FLAGS_INVALID = -1,
@@ -146,7 +168,10 @@ enum VIDEO_TARGET {
 	//! Represents a QT widget
 	VIDEO_TARGET_QT_WIDGET  = 1,
 
-	VIDEO_TARGET_TOTAL = 2
+	//! Represents no window at all. Rendering operations are recorded but never sent to OpenGL
+	VIDEO_TARGET_NULL = 2,
+
+	VIDEO_TARGET_TOTAL = 3
 };
 
 
@@ -194,6 +219,74 @@ float Lerp(float alpha, float initial, float final);
 void RotatePoint(float &x, float &y, float angle);
 
 
+/** ****************************************************************************
+*** \brief Counters describing the rendering work requested of the video engine
+***
+*** These counters are maintained for every video target, but they are most useful
+*** when the engine runs with VIDEO_TARGET_NULL. In that case no OpenGL calls are
+*** made at all and these counters are the only record of the work that each frame
+*** would have submitted to the GPU. This makes it possible to compare the rendering
+*** workload of two builds on a machine that does not have a display.
+*** ***************************************************************************/
+class RenderStatistics {
+public:
+	RenderStatistics()
+		{ Reset(); }
+
+	//! \brief Sets all of the counters back to zero
+	void Reset();
+
+	//! \brief Records the submission of a single draw operation
+	void RecordDrawCall()
+		{ ++draw_calls; ++frame_draw_calls; }
+
+	/** \brief Records the creation of a texture
+	*** \param width The width of the texture, in pixels
+	*** \param height The height of the texture, in pixels
+	**/
+	void RecordTextureCreation(int32 width, int32 height);
+
+	/** \brief Records the deletion of a texture
+	*** \param width The width of the texture, in pixels
+	*** \param height The height of the texture, in pixels
+	**/
+	void RecordTextureDeletion(int32 width, int32 height);
+
+	//! \brief Closes out the counters for the frame that was just displayed
+	void RecordFrame();
+
+	//! \brief Prints the value of every counter to standard output
+	void DEBUG_PrintStatistics() const;
+
+	//! \brief The number of frames that have been displayed
+	uint32 frames;
+
+	//! \brief The total number of draw operations that have been submitted
+	uint32 draw_calls;
+
+	//! \brief The number of draw operations submitted since the last frame was displayed
+	uint32 frame_draw_calls;
+
+	//! \brief The largest number of draw operations that were submitted in a single frame
+	uint32 peak_frame_draw_calls;
+
+	//! \brief The number of textures that have been created and deleted
+	//@{
+	uint32 textures_created;
+	uint32 textures_deleted;
+	//@}
+
+	//! \brief The number of bytes of texture memory held by the textures that currently exist
+	uint32 texture_bytes_resident;
+
+	//! \brief The largest number of bytes of texture memory that were held by textures at the same time
+	uint32 peak_texture_bytes_resident;
+
+	//! \brief The number of times that pixel data was uploaded to an existing texture
+	uint32 texture_uploads;
+}; // class RenderStatistics
+
+
 /** ****************************************************************************
 *** \brief Manages all the video operations and serves as the API to the video engine.
 ***
@@ -218,6 +311,7 @@ class VideoEngine : public hoa_utils::Singleton<VideoEngine> {
 	friend class private_video::VariableTexSheet;
 	friend class private_video::ParticleSystem;
 
+	friend class ParticleEffect;
 	friend class ImageDescriptor;
 	friend class StillImage;
 	friend class CompositeImage;
@@ -241,7 +335,7 @@ public:
 	// ---------- General methods
 
 	/** \brief Sets the target window environment where the video engine will be used
-	*** \param target The window target, which can be VIDEO_TARGET_SDL_WINDOW or VIDEO_TARGET_QT_WIDGET
+	*** \param target The window target, which can be VIDEO_TARGET_SDL_WINDOW, VIDEO_TARGET_QT_WIDGET, or VIDEO_TARGET_NULL
 	*** \note The video engien's default target is a SDL window, so if that's what you desire then this
 	*** function does not need to be called.
 	*** \note You must set the target before calling the SingletonInitialize() function. Any invocations
@@ -280,12 +374,18 @@ public:
 
 	/** \brief Retrieves the OpenGL error code and retains it in the _gl_error_code member
 	*** \return True if an OpenGL error has been detected, false if no errors were detected
-	*** \note This function only produces a meaningful result if the VIDEO_DEBUG variable is set to true. This is done
-	*** because the call to glGetError() requires a round trip to the GPU and a flush of the rendering pipeline; a fairly
-	*** expensive operation. If VIDEO_DEBUG is false, the function will always return false immediately.
+	*** \note This function only produces a meaningful result if the VIDEO_DEBUG variable is set to true. If VIDEO_DEBUG
+	*** is false, the function will always return false immediately.
+	***
+	*** When the driver supports debug output, this returns the most recent error that the driver reported within the
+	*** current GLDebugGroup and costs nothing. Otherwise it calls glGetError(), which requires a round trip to the GPU
+	*** and a flush of the rendering pipeline. Drawing and binding code should therefore not call this function: errors
+	*** from those calls are reported by the debug output callback, or by the check that Display() makes once per frame.
 	**/
 	bool CheckGLError()
-		{ if (VIDEO_DEBUG == false) return false; _gl_error_code = glGetError(); return (_gl_error_code != GL_NO_ERROR); }
+		{ if (VIDEO_DEBUG == false || _target == VIDEO_TARGET_NULL) return false;
+		  if (_gl_debug_output.IsActive() == true) return _gl_debug_output.TakeError(_gl_error_code);
+		  _gl_error_code = glGetError(); return (_gl_error_code != GL_NO_ERROR); }
 
 	//! \brief Returns the value of the most recently fetched OpenGL error code
 	GLenum GetGLError()
@@ -307,6 +407,14 @@ public:
 	bool IsInitialized() const
 		{ return _initialized; }
 
+	//! \brief Returns true if the engine has no window and is not making any OpenGL calls
+	bool IsHeadless() const
+		{ return (_target == VIDEO_TARGET_NULL); }
+
+	//! \brief Returns the counters of all rendering work requested since the engine started
+	RenderStatistics& GetRenderStatistics()
+		{ return _render_statistics; }
+
 	//! \brief Returns true if game is in fullscreen mode, false if it is in windowed mode
 	bool IsFullscreen() const
 		{ return _fullscreen; }
@@ -463,11 +571,12 @@ public:
 	*** calls (Move/MoveRelative/Scale/Rotate)
 	**/
 	void PushMatrix()
-		{ glPushMatrix(); }
+		{ _transform_stack.push(_transform); if (_IsFixedFunction() == true) glPushMatrix(); }
 
 	//! \brief Pops the modelview transformation from the stack
 	void PopMatrix()
-		{ glPopMatrix(); }
+		{ if (_transform_stack.empty() == false) { _transform = _transform_stack.top(); _transform_stack.pop(); }
+		  if (_IsFixedFunction() == true) glPopMatrix(); }
 
 	/** \brief Saves relevant state of the video engine on to an internal stack
 	*** The contents saved include the modelview transformation and the current
@@ -491,7 +600,7 @@ public:
 	*** prior to using this function.
 	**/
 	void Rotate(float angle)
-		{ glRotatef(angle, 0, 0, 1); }
+		{ _transform.Rotate(angle); if (_IsFixedFunction() == true) glRotatef(angle, 0, 0, 1); }
 
 	/** \brief Scales all subsequent image drawing calls in the horizontal and vertical direction
 	*** \param x The amount of horizontal scaling to perform (0.5 for half, 1.0 for normal, 2.0 for double, etc)
@@ -500,7 +609,7 @@ public:
 	*** prior to using this function.
 	**/
 	void Scale(float x, float y)
-		{ glScalef(x, y, 1.0f); }
+		{ _transform.Scale(x, y); if (_IsFixedFunction() == true) glScalef(x, y, 1.0f); }
 
 	/** \brief Sets the OpenGL transform to the contents of 4x4 matrix
 	*** \param matrix A pointer to an array of 16 float values that form a 4x4 transformation matrix
@@ -692,6 +801,18 @@ public:
 	**/
 	ParticleEffectID AddParticleEffect(const std::string &filename, float x, float y, bool reload = false);
 
+	/** \brief Loads a particle effect definition and its images without adding the effect
+	*** \param filename The name of the file containing the particle effect definition
+	*** \return True if the definition was loaded successfully or had already been loaded
+	***
+	*** Definitions are kept until ClearParticleEffectCache() is called, so modes can call this while they are
+	*** loading to avoid reading the definition files the first time that each effect is added.
+	**/
+	bool PreloadParticleEffect(const std::string &filename);
+
+	//! \brief Releases all loaded particle effect definitions that are not in use by an active effect
+	void ClearParticleEffectCache();
+
 	/** \brief draws all active particle effects
 	 * \return success/failure
 	 */
@@ -778,6 +899,10 @@ public:
 
 	/** \brief Takes a screenshot and saves the image to a file
 	*** \param filename The name of the file, if any, to save the screenshot as. Default is "screenshot.jpg"
+	***
+	*** The screen is captured at the end of the current frame. Reading the pixels and encoding the image both happen
+	*** in the background, so the file is written a few frames after this call returns. The image is always saved in
+	*** the JPG format.
 	**/
 	void MakeScreenshot(const std::string& filename = "screenshot.jpg");
 
@@ -811,6 +936,51 @@ public:
 	void ToggleFPS()
 		{ _fps_display = !_fps_display; }
 
+	/** \brief Enables or disables synchronizing the display of frames with the monitor's refresh
+	*** \param vsync True to enable vertical synchronization
+	***
+	*** Adaptive vsync is used when the driver supports it, which does not wait for the next refresh when a frame
+	*** is already late. Otherwise regular vsync is used. The setting may be changed before the window is created.
+	**/
+	void SetVSync(bool vsync);
+
+	bool IsVSync() const
+		{ return _vsync; }
+
+	/** \brief Limits how many frames are displayed every second
+	*** \param fps The maximum frame rate, or zero to display frames as fast as possible (or as vsync allows)
+	**/
+	void SetTargetFPS(uint32 fps)
+		{ _target_fps = fps; }
+
+	uint32 GetTargetFPS() const
+		{ return _target_fps; }
+
+	/** \brief Limits the frame rate to VIDEO_LOW_POWER_FPS, or to the target FPS if that is lower
+	*** \param low_power True to enable low power mode
+	***
+	*** This is intended for screens that are mostly still, such as menus, where there is no need to use a full
+	*** CPU core drawing the same image again and again. The mode manager enables it for such game modes.
+	**/
+	void SetLowPowerMode(bool low_power)
+		{ _low_power_mode = low_power; }
+
+	bool IsLowPowerMode() const
+		{ return _low_power_mode; }
+
+	/** \brief Selects whether the next window is drawn with an OpenGL 3.3 core profile context
+	*** \param core_profile True to draw with shaders on a core profile context, false to use the fixed-function pipeline
+	***
+	*** This takes effect the next time that ApplySettings() creates the window. If a core profile context can not be
+	*** created or lacks required functionality, the video engine falls back to the fixed-function pipeline.
+	**/
+	void SetCoreProfile(bool core_profile)
+		{ _core_profile = core_profile; }
+
+	//! \brief Returns true if drawing is currently done through the core profile renderer
+	bool IsCoreProfile() const
+		{ return _core_renderer.IsActive(); }
+
 	/** \brief Used to set the state indicating that other code drawing graphics should display any relevant debugging visuals
 	*** \param debug Whether to enable or disable graphical debugging
 	**/
@@ -852,10 +1022,43 @@ private:
 	**/
 	uint32 _number_samples;
 
+	//! \brief True if the display of frames should be synchronized with the monitor's refresh
+	bool _vsync;
+
+	//! \brief The maximum number of frames to display each second, or zero for no limit
+	uint32 _target_fps;
+
+	//! \brief When true the frame rate is limited to VIDEO_LOW_POWER_FPS
+	bool _low_power_mode;
+
+	//! \brief True if the window should be created with a core profile context, see SetCoreProfile()
+	bool _core_profile;
+
+	//! \brief Draws all geometry when the window has a core profile context
+	private_video::CoreRenderer _core_renderer;
+
+	//! \brief Reads and saves the screenshots requested by MakeScreenshot()
+	private_video::ScreenshotWriter _screenshot_writer;
+
+	//! \brief The value of the performance counter when the last frame was completed, or zero if no frame has been
+	Uint64 _last_frame_counter;
+
+	//! \brief A circular array of the most recent frame durations, in milliseconds
+	float _frame_durations[private_video::FRAME_TIME_SAMPLES];
+
+	//! \brief The index in the _frame_durations array to record the next frame duration to
+	uint32 _current_frame_duration;
+
+	//! \brief The number of frame durations that have been recorded, up to FRAME_TIME_SAMPLES
+	uint32 _number_frame_durations;
+
 	//! \brief Holds the most recently fetched OpenGL error code
 	GLenum _gl_error_code;
 
-	//! \brief The type of window target that the video manager will operate on (SDL window or QT widget)
+	//! \brief Receives error reports from the driver when video debugging is enabled and the driver supports it
+	private_video::GLDebugOutput _gl_debug_output;
+
+	//! \brief The type of window target that the video manager will operate on (SDL window, QT widget, or none)
 	VIDEO_TARGET _target;
 
 	//! \brief The width and height of the current screen, in pixels
@@ -882,8 +1085,8 @@ private:
 	//! advanced display flag. If true, info about the video engine is shown on screen
 	bool _advanced_display;
 
-	//! keep track of number of draw calls per frame
-	int32 _num_draw_calls;
+	//! \brief Keeps count of the draw calls, frames, and texture operations that have been requested
+	RenderStatistics _render_statistics;
 
 	//! \brief Set to true when the lighting overlay is enabled
 	bool _light_overlay_enabled;
@@ -969,12 +1172,18 @@ private:
 	//! current scene lighting color (essentially just modulates vertex colors of all the images)
 	Color _light_color;
 
-	//! STL map containing all loaded particle effect definitions
-	std::map<std::string, ParticleEffectDef*> _particle_effect_defs;
-
 	//! stack containing context, i.e. draw flags plus coord sys. Context is pushed and popped by any VideoEngine functions that clobber these settings
 	std::stack<private_video::Context> _context_stack;
 
+	/** \brief The current modelview transformation
+	*** This is always kept up to date. When the fixed-function pipeline is used, the same transformation is also
+	*** applied to the OpenGL modelview matrix, so that the two always match.
+	**/
+	private_video::Transform2D _transform;
+
+	//! \brief Transformations saved by PushMatrix() and PushState()
+	std::stack<private_video::Transform2D> _transform_stack;
+
 	//! check to see if the VideoManager has already been setup.
 	bool _initialized;
 
@@ -1035,6 +1244,28 @@ private:
 	**/
 	void _UpdateShake(uint32 frame_time);
 
+	//! \brief Sets the swap interval of the OpenGL context to match the vsync setting
+	void _ApplySwapInterval();
+
+	//! \brief Returns true if OpenGL calls are made for the fixed-function pipeline
+	bool _IsFixedFunction() const
+		{ return (_target != VIDEO_TARGET_NULL && _core_renderer.IsActive() == false); }
+
+	//! \brief Sets the SDL attributes which select the version and profile of the next OpenGL context that is created
+	void _SetContextProfileAttributes();
+
+	/** \brief Reports any OpenGL errors that occurred during the frame
+	*** This is the only place where glGetError() is polled for errors produced by drawing code, and it is only done
+	*** when video debugging is enabled and the driver does not support debug output.
+	**/
+	void _CheckFrameGLErrors();
+
+	/** \brief Waits until it is time to begin the next frame and records how long the frame took
+	*** If there is no target frame rate and low power mode is disabled, this returns immediately. Otherwise the
+	*** thread sleeps for most of the remaining frame time and spin-waits for the rest, see FRAME_SPIN_TIME.
+	**/
+	void _PaceFrame();
+
 	/** \brief Updates the position of the ambient overlay image
 	*** \param frame_time The number of milliseconds that have elapsed since the last draw frame
 	**/
@@ -91,6 +91,9 @@ void QuitAllacrost() {
 	// Delete the global manager second to remove all object references corresponding to other engine subsystems
 	GameGlobal::SingletonDestroy();
 
+	// Notification subscriptions made from Lua hold references to Lua functions, which must be released before the lua state is closed
+	NotificationEngine::SingletonDestroy();
+
 	// Destroy the script engine first to free all Luabind objects must be freed before closing the lua state.
 	ScriptEngine::SingletonDestroy();
 
@@ -98,7 +101,6 @@ void QuitAllacrost() {
 	GUISystem::SingletonDestroy();
 	AudioEngine::SingletonDestroy();
 	InputEngine::SingletonDestroy();
-	NotificationEngine::SingletonDestroy();
 	SystemEngine::SingletonDestroy();
 	VideoEngine::SingletonDestroy();
 } // void QuitAllacrost()
@@ -184,6 +186,13 @@ bool LoadSettings() {
 	int32 resy = settings.ReadInt("screen_resy");
 	VideoManager->SetInitialResolution(resx, resy);
 	VideoManager->SetFullscreen(fullscreen);
+	// Frame pacing settings are absent from settings files created by older versions of the game
+	if (settings.DoesBoolExist("vsync") == true)
+		VideoManager->SetVSync(settings.ReadBool("vsync"));
+	if (settings.DoesIntExist("target_fps") == true)
+		VideoManager->SetTargetFPS(static_cast<uint32>(settings.ReadInt("target_fps")));
+	if (settings.DoesBoolExist("core_profile") == true)
+		VideoManager->SetCoreProfile(settings.ReadBool("core_profile"));
 	settings.CloseTable();
 
 	if (settings.IsErrorDetected()) {
@@ -235,6 +244,10 @@ void InitializeEngine() throw (Exception) {
 	GUIManager = GUISystem::SingletonCreate();
 	GlobalManager = GameGlobal::SingletonCreate();
 
+	if (hoa_main::start_headless == true) {
+		VideoManager->SetTarget(VIDEO_TARGET_NULL);
+	}
+
 	if (VideoManager->SingletonInitialize() == false) {
 		throw Exception("ERROR: unable to initialize VideoManager", __FILE__, __LINE__, __FUNCTION__);
 	}
@@ -271,6 +284,8 @@ void InitializeEngine() throw (Exception) {
 	// Load all the settings from lua. This includes some engine configuration settings.
 	if (LoadSettings() == false)
 		throw Exception("ERROR: Unable to load settings file", __FILE__, __LINE__, __FUNCTION__);
+	if (hoa_main::use_core_profile == true)
+		VideoManager->SetCoreProfile(true);
 
 	// Apply engine configuration settings with delayed initialization calls to the managers
 	InputManager->InitializeJoysticks();
@@ -320,7 +335,9 @@ void InitializeEngine() throw (Exception) {
 	VideoManager -> SetWindowTitle("Hero of Allacrost");
 
 	// Hide the mouse cursor since we don't use or acknowledge mouse input from the user
-	SDL_ShowCursor(SDL_DISABLE);
+	if (VideoManager->IsHeadless() == false) {
+		SDL_ShowCursor(SDL_DISABLE);
+	}
 
 	// Enabled for multilingual keyboard support
 	//SDL_EnableUNICODE(1); //NOT NECESSARY FOR SDL2
@@ -379,9 +396,26 @@ int main(int argc, char *argv[]) {
 			return static_cast<int>(return_code);
 		}
 
+		// Recorded input only reproduces the same play session if random numbers are generated identically each run.
+		// Simulated battles are seeded the same way so that runs of the same battles may be compared to one another.
+		if (hoa_main::fixed_update_time != 0 || hoa_main::record_filename.empty() == false || hoa_main::replay_filename.empty() == false ||
+			hoa_main::simulate_battle_count != 0)
+		{
+			srand(0);
+		}
+
 		// Function call below throws exceptions if any errors occur
 		InitializeEngine();
 
+		SystemManager->SetFixedUpdateTime(hoa_main::fixed_update_time);
+		SystemManager->SetStepTime(hoa_main::step_time);
+		if (hoa_main::record_filename.empty() == false && InputManager->StartRecording(hoa_main::record_filename) == false) {
+			throw Exception("ERROR: unable to record input to file: " + hoa_main::record_filename, __FILE__, __LINE__, __FUNCTION__);
+		}
+		if (hoa_main::replay_filename.empty() == false && InputManager->StartReplay(hoa_main::replay_filename) == false) {
+			throw Exception("ERROR: unable to replay input from file: " + hoa_main::replay_filename, __FILE__, __LINE__, __FUNCTION__);
+		}
+
 	} catch (Exception& e) {
 		#ifdef WIN32
 		MessageBox(nullptr, e.ToString().c_str(), "Unhandled exception", MB_OK | MB_ICONERROR);
@@ -391,6 +425,11 @@ int main(int argc, char *argv[]) {
 		return EXIT_FAILURE;
 	}
 
+	// Simulated battles replace the game entirely
+	if (hoa_main::simulate_battle_count != 0) {
+		return (hoa_main::SimulateBattles() == true) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
 	// Create the first mode object to add to the game stack
 	if (hoa_main::start_in_test_mode == true) {
 		if (hoa_main::test_number == 0)
@@ -408,22 +447,28 @@ int main(int argc, char *argv[]) {
 			// 1) Render the scene
 			VideoManager->Clear();
 			ModeManager->Draw();
-			VideoManager->Display(SystemManager->GetUpdateTime());
+			VideoManager->Display(SystemManager->GetFrameTime());
 
-			// 2) Process all new input events
-			InputManager->EventHandler();
+			// 2) Measure the frame time and determine how many simulation steps it covers
+			SystemManager->UpdateTimers();
 
-			// 3) Update any streaming audio sources
-			AudioManager->Update();
+			// 3) Process all new input events. When the frame is too short for a simulation step, the events are
+			// left in the queue for the next frame so that no presses are lost before any step could see them.
+			if (SystemManager->GetPendingSteps() != 0) {
+				InputManager->EventHandler();
+			}
 
-			// 4) Update timers for correct time-based movement operation
-			SystemManager->UpdateTimers();
+			// 4) Update any streaming audio sources
+			AudioManager->Update();
 
-			// 5) Update the game status
-			ModeManager->Update();
+			// 5) Update the game status once for every simulation step
+			while (SystemManager->SimulationStep() == true) {
+				ModeManager->Update();
 
-			// 6) Clear any notification events that were generated
-			NotificationManager->DeleteAllNotificationEvents();
+				// Clear any notification events that were generated and any input presses that have now been seen
+				NotificationManager->DeleteAllNotificationEvents();
+				InputManager->ResetPressReleaseFlags();
+			}
 		} // while (SystemManager->NotDone())
 	}
 	catch (Exception& e) {
@@ -435,5 +480,14 @@ int main(int argc, char *argv[]) {
 		return EXIT_FAILURE;
 	}
 
+	// Report the rendering work that was recorded in place of drawing to a window
+	if (VideoManager->IsHeadless() == true) {
+		VideoManager->GetRenderStatistics().DEBUG_PrintStatistics();
+	}
+	// Report how long frames really took to process so that runs with identical input can be compared
+	if (SystemManager->GetFixedUpdateTime() != 0) {
+		SystemManager->DEBUG_PrintFrameTimes();
+	}
+
 	return EXIT_SUCCESS;
 } // int main(int argc, char *argv[])
@@ -26,6 +26,8 @@
 
 #include "global.h"
 
+#include "battle.h"
+
 #include "main_options.h"
 
 using namespace std;
@@ -35,6 +37,49 @@ namespace hoa_main {
 
 bool start_in_test_mode = false;
 uint32 test_number = 0;
+bool start_headless = false;
+bool use_core_profile = false;
+uint32 fixed_update_time = 0;
+uint32 step_time = hoa_system::SYSTEM_DEFAULT_STEP_TIME;
+string record_filename;
+string replay_filename;
+uint32 simulate_battle_count = 0;
+vector<uint32> simulate_battle_characters;
+vector<uint32> simulate_battle_enemies;
+
+namespace {
+
+//! \brief The length of each update of a simulated battle, in milliseconds
+const uint32 SIMULATION_UPDATE_TIME = 10;
+
+//! \brief The longest amount of simulated time that a battle may take before it is abandoned
+const uint32 SIMULATION_TIMEOUT = 30 * 60 * 1000;
+
+/** \brief Parses a list of IDs given to a program option
+*** \param vars The list of IDs in single string format
+*** \param ids A reference to a container to hold each ID
+*** \return False if the list was empty or contained anything other than positive integers
+**/
+bool ParseIDList(const string& vars, vector<uint32>& ids) {
+	vector<string> options;
+	if (ParseSecondaryOptions(vars, options) == false)
+		return false;
+
+	for (uint32 i = 0; i < options.size(); i++) {
+		int32 number = 0;
+		if (IsStringNumeric(options[i]) == true) {
+			istringstream(options[i]) >> number;
+		}
+		if (number <= 0) {
+			cerr << "ERROR: invalid ID \"" << options[i] << "\" must be a positive integer" << endl;
+			return false;
+		}
+		ids.push_back(static_cast<uint32>(number));
+	}
+	return true;
+}
+
+} // namespace
 
 
 
@@ -53,6 +98,22 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv) {
 			}
 			return false;
 		}
+		else if (options[i] == "--compile-scripts") {
+			if ((i + 1) >= options.size()) {
+				cerr << "Option " << options[i] << " requires an argument." << endl;
+				PrintUsage();
+				return_code = 1;
+				return false;
+			}
+			vector<string> filenames(options.begin() + i + 2, options.end());
+			if (CompileScripts(options[i + 1], filenames) == true) {
+				return_code = 0;
+			}
+			else {
+				return_code = 1;
+			}
+			return false;
+		}
 		else if (options[i] == "-d" || options[i] == "--debug") {
 			if ((i + 1) >= options.size()) {
 				cerr << "Option " << options[i] << " requires an argument." << endl;
@@ -69,6 +130,32 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv) {
 		else if (options[i] == "--disable-audio") {
 			hoa_audio::AUDIO_ENABLE = false;
 		}
+		else if (options[i] == "--fixed-timestep") {
+			if ((i + 1) >= options.size()) {
+				cerr << "Option " << options[i] << " requires an argument." << endl;
+				PrintUsage();
+				return_code = 1;
+				return false;
+			}
+			int32 number = 0;
+			if (IsStringNumeric(options[i + 1]) == true) {
+				istringstream(options[i + 1]) >> number;
+			}
+			if (number <= 0) {
+				cerr << "Parameter \"" << options[i + 1] << "\" for argument \"" << options[i] <<
+					"\" must be a positive integer" << endl;
+				return_code = 1;
+				return false;
+			}
+			fixed_update_time = static_cast<uint32>(number);
+			i++;
+		}
+		else if (options[i] == "--gl-core") {
+			use_core_profile = true;
+		}
+		else if (options[i] == "--headless") {
+			start_headless = true;
+		}
 		else if (options[i] == "-h" || options[i] == "--help") {
 			PrintUsage();
 			return_code = 0;
@@ -93,6 +180,71 @@ bool ParseProgramOptions(int32 &return_code, int32 argc, char **argv) {
 			return_code = 0;
 			return false;
 		}
+		else if (options[i] == "--simulate-battles") {
+			if ((i + 3) >= options.size()) {
+				cerr << "Option " << options[i] << " requires three arguments." << endl;
+				PrintUsage();
+				return_code = 1;
+				return false;
+			}
+			int32 number = 0;
+			if (IsStringNumeric(options[i + 1]) == true) {
+				istringstream(options[i + 1]) >> number;
+			}
+			if (number <= 0) {
+				cerr << "Parameter \"" << options[i + 1] << "\" for argument \"" << options[i] <<
+					"\" must be a positive integer" << endl;
+				return_code = 1;
+				return false;
+			}
+			if (ParseIDList(options[i + 2], simulate_battle_characters) == false || ParseIDList(options[i + 3], simulate_battle_enemies) == false) {
+				return_code = 1;
+				return false;
+			}
+			if (simulate_battle_characters.size() > hoa_global::GLOBAL_MAX_PARTY_SIZE) {
+				cerr << "Option " << options[i] << " accepts at most " << hoa_global::GLOBAL_MAX_PARTY_SIZE << " characters" << endl;
+				return_code = 1;
+				return false;
+			}
+			simulate_battle_count = static_cast<uint32>(number);
+			// Simulated battles are never drawn or heard
+			start_headless = true;
+			hoa_audio::AUDIO_ENABLE = false;
+			i += 3;
+		}
+		else if (options[i] == "--step-time") {
+			if ((i + 1) >= options.size()) {
+				cerr << "Option " << options[i] << " requires an argument." << endl;
+				PrintUsage();
+				return_code = 1;
+				return false;
+			}
+			int32 number = -1;
+			if (IsStringNumeric(options[i + 1]) == true) {
+				istringstream(options[i + 1]) >> number;
+			}
+			if (number < 0) {
+				cerr << "Parameter \"" << options[i + 1] << "\" for argument \"" << options[i] <<
+					"\" must be zero or a positive integer" << endl;
+				return_code = 1;
+				return false;
+			}
+			step_time = static_cast<uint32>(number);
+			i++;
+		}
+		else if (options[i] == "--record" || options[i] == "--replay") {
+			if ((i + 1) >= options.size()) {
+				cerr << "Option " << options[i] << " requires an argument." << endl;
+				PrintUsage();
+				return_code = 1;
+				return false;
+			}
+			if (options[i] == "--record")
+				record_filename = options[i + 1];
+			else
+				replay_filename = options[i + 1];
+			i++;
+		}
 		else if (options[i] == "-t" || options[i] == "--test") {
 			start_in_test_mode = true;
 			// Check for the optional argument that may follow the test option
@@ -163,6 +315,7 @@ bool ParseSecondaryOptions(string vars, vector<string>& options) {
 void PrintUsage() {
 	cout << "usage: allacrost [options]" << endl;
 	cout << "  --check/-c        :: checks all files for integrity" << endl;
+	cout << "  --compile-scripts <dir> <files> :: compiles Lua script files to bytecode cache entries in a directory" << endl;
 	cout << "  --debug/-d <args> :: enables debug statements in specifed sections of the" << endl;
 	cout << "                       program, where <args> can be:" << endl;
 	cout << "                       all, engine, modes," << endl;
@@ -170,9 +323,18 @@ void PrintUsage() {
 	cout << "                       map, mode_manager, pause, quit, scene, system" << endl;
 	cout << "                       test, utils, video" << endl;
 	cout << "  --disable-audio   :: disables loading and playing audio" << endl;
+	cout << "  --fixed-timestep <ms> :: advances the game by a constant number of milliseconds every frame" << endl;
+	cout << "  --gl-core         :: draws with shaders on an OpenGL 3.3 core profile context instead of the fixed-function pipeline" << endl;
+	cout << "  --headless        :: runs without a window, recording rendering work instead of drawing it" << endl;
 	cout << "  --help/-h         :: prints this help menu" << endl;
 	cout << "  --info/-i         :: prints information about the user's system" << endl;
+	cout << "  --record <file>   :: records the player's input for every frame to a file" << endl;
+	cout << "  --replay <file>   :: replays input from a recording instead of reading the keyboard and joystick" << endl;
 	cout << "  --reset/-r        :: resets game configuration to use default settings" << endl;
+	cout << "  --simulate-battles <count> <characters> <enemies> :: runs battles between lists of character and enemy IDs" << endl;
+	cout << "                       without a player or window and prints statistics about them, for example:" << endl;
+	cout << "                       --simulate-battles 500 \"1 2\" \"1 1 3\"" << endl;
+	cout << "  --step-time <ms>  :: sets the length of each simulation step, or 0 to update once per frame" << endl;
 	cout << "  --test/-t <test>  :: start the application in test mode, optionally specifying a specific test to immediately execute" << endl;
 }
 
@@ -317,6 +479,121 @@ bool CheckFiles() {
 
 
 
+bool CompileScripts(const string& cache_directory, const vector<string>& filenames) {
+	if (DoesFileExist(cache_directory) == false && MakeDirectory(cache_directory) == false) {
+		cerr << "ERROR: failed to create script cache directory: " << cache_directory << endl;
+		return false;
+	}
+
+	// Compiling a script does not execute it, so only the script engine needs to exist
+	hoa_script::ScriptManager = hoa_script::ScriptEngine::SingletonCreate();
+
+	uint32 num_failures = 0;
+	for (uint32 i = 0; i < filenames.size(); ++i) {
+		if (hoa_script::ScriptManager->CompileScriptFile(filenames[i], cache_directory) == false) {
+			++num_failures;
+		}
+	}
+
+	hoa_script::ScriptEngine::SingletonDestroy();
+	hoa_script::ScriptManager = nullptr;
+
+	cout << "Compiled " << (filenames.size() - num_failures) << " of " << filenames.size() << " script files" << endl;
+	return (num_failures == 0);
+} // bool CompileScripts(const string& cache_directory, const vector<string>& filenames)
+
+
+
+bool SimulateBattles() {
+	using namespace hoa_battle;
+	using namespace hoa_global;
+	using namespace hoa_notification;
+	using namespace hoa_system;
+
+	GlobalManager->ClearAllData();
+	for (uint32 i = 0; i < simulate_battle_characters.size(); i++) {
+		GlobalManager->AddCharacter(simulate_battle_characters[i]);
+	}
+	if (GlobalManager->GetActiveParty()->GetPartySize() != simulate_battle_characters.size()) {
+		cerr << "ERROR: failed to add every simulated character to the party" << endl;
+		return false;
+	}
+
+	// Every update advances the battle by the same amount of time, no matter how long it really took to process
+	SystemManager->SetFixedUpdateTime(SIMULATION_UPDATE_TIME);
+	SystemManager->SetStepTime(SIMULATION_UPDATE_TIME);
+	SystemManager->InitializeUpdateTimer();
+
+	uint32 victories = 0;
+	uint32 defeats = 0;
+	uint32 timeouts = 0;
+	uint32 total_actions = 0;
+	float total_battle_time = 0.0f;
+	float total_hit_points_remaining = 0.0f;
+
+	uint32 start_time = SDL_GetTicks();
+	for (uint32 i = 0; i < simulate_battle_count; i++) {
+		BattleMode* battle = new BattleMode();
+		battle->EnableSimulation();
+		for (uint32 j = 0; j < simulate_battle_enemies.size(); j++) {
+			battle->AddEnemy(simulate_battle_enemies[j]);
+		}
+		battle->Reset();
+
+		uint32 battle_time = 0;
+		while (battle->IsBattleFinished() == false && battle_time < SIMULATION_TIMEOUT) {
+			SystemManager->UpdateTimers();
+			while (SystemManager->SimulationStep() == true) {
+				battle->Update();
+				NotificationManager->DeleteAllNotificationEvents();
+				battle_time += SystemManager->GetUpdateTime();
+			}
+		}
+
+		total_actions += battle->GetActionCount();
+		total_battle_time += static_cast<float>(battle_time);
+		if (battle->GetState() == private_battle::BATTLE_STATE_VICTORY) {
+			++victories;
+			// Record how much of the party's health remained, which shows how close each victory was
+			uint32 hit_points = 0;
+			uint32 max_hit_points = 0;
+			deque<private_battle::BattleCharacter*>& characters = battle->GetCharacterActors();
+			for (uint32 j = 0; j < characters.size(); j++) {
+				hit_points += characters[j]->GetHitPoints();
+				max_hit_points += characters[j]->GetMaxHitPoints();
+			}
+			if (max_hit_points != 0)
+				total_hit_points_remaining += static_cast<float>(hit_points) / static_cast<float>(max_hit_points);
+		}
+		else if (battle->GetState() == private_battle::BATTLE_STATE_DEFEAT) {
+			++defeats;
+		}
+		else {
+			++timeouts;
+		}
+		delete battle;
+	}
+	uint32 elapsed_time = SDL_GetTicks() - start_time;
+	float elapsed_seconds = static_cast<float>((elapsed_time != 0) ? elapsed_time : 1) / 1000.0f;
+	float battle_count = static_cast<float>(simulate_battle_count);
+
+	cout << "__Battle Simulation__" << endl;
+	cout << "* battles:                " << simulate_battle_count << endl;
+	cout << "* victories:              " << victories << " (" << (100.0f * victories / battle_count) << "%)" << endl;
+	cout << "* defeats:                " << defeats << " (" << (100.0f * defeats / battle_count) << "%)" << endl;
+	cout << "* timeouts:               " << timeouts << " (" << (100.0f * timeouts / battle_count) << "%)" << endl;
+	cout << "* average battle time:    " << (total_battle_time / battle_count / 1000.0f) << "s (simulated)" << endl;
+	cout << "* average actions:        " << (static_cast<float>(total_actions) / battle_count) << endl;
+	if (victories != 0)
+		cout << "* average HP on victory:  " << (100.0f * total_hit_points_remaining / victories) << "%" << endl;
+	cout << "* elapsed time:           " << elapsed_time << "ms" << endl;
+	cout << "* battles per second:     " << (battle_count / elapsed_seconds) << endl;
+	cout << "* actions per second:     " << (static_cast<float>(total_actions) / elapsed_seconds) << endl;
+	return true;
+} // bool SimulateBattles()
+
+
+
 bool EnableDebugging(string vars) {
 	// A vector of all the debug arguments
 	vector<string> args;
@@ -27,6 +27,33 @@ extern bool start_in_test_mode;
 //! \brief The specific test number to begin immediate execution of. If zero, this value is ignored
 extern uint32 test_number;
 
+//! \brief Set to true when it is requested that the application run without a window or any rendering
+extern bool start_headless;
+
+//! \brief Set to true when it is requested that the game draws with an OpenGL 3.3 core profile context
+extern bool use_core_profile;
+
+//! \brief When non-zero, the number of milliseconds that every game update should advance by
+extern uint32 fixed_update_time;
+
+//! \brief The number of milliseconds in each simulation step, or zero to update the game once per frame instead
+extern uint32 step_time;
+
+//! \brief The name of the file to record player input to. If empty, input is not recorded
+extern std::string record_filename;
+
+//! \brief The name of the file to replay player input from. If empty, input is read from the keyboard and joystick
+extern std::string replay_filename;
+
+//! \brief The number of battles to simulate instead of starting the game. If zero, no battles are simulated
+extern uint32 simulate_battle_count;
+
+//! \brief The IDs of the characters in the party and of the enemies that fight each simulated battle
+//@{
+extern std::vector<uint32> simulate_battle_characters;
+extern std::vector<uint32> simulate_battle_enemies;
+//@}
+
 /** \brief Parses command-line options and takes appropriate action on those options
 *** \param return_code A reference to the return code to exit the program with.
 *** \param argc The number of arguments given to the program
@@ -55,6 +82,22 @@ bool PrintSystemInformation();
 **/
 bool CheckFiles();
 
+/** \brief Compiles Lua script files to bytecode and writes them to a script cache directory
+*** \param cache_directory The directory to write the cache entries to, including the trailing slash
+*** \param filenames The names of the Lua files to compile, relative to the game's data directory
+*** \return False if any of the files failed to compile
+**/
+bool CompileScripts(const std::string& cache_directory, const std::vector<std::string>& filenames);
+
+/** \brief Runs the requested number of battles between the simulated party and enemies without a player
+*** \return False if the battles could not be run
+***
+*** This must be called after the game engine is initialized. The battles are updated directly with a fixed
+*** update time and are never drawn, so they run as fast as the battle code and skill scripts allow. When all
+*** battles are finished, statistics about their outcomes and the rate at which they were run are printed.
+**/
+bool SimulateBattles();
+
 /** \brief Resets the game settings (audio volume, key mappings, etc.) to their default values.
 *** \return False if the settings could not be restored, or if another problem occured.
 **/
@@ -54,6 +54,127 @@ bool BATTLE_DEBUG = false;
 // Initialize static class variable
 BattleMode* BattleMode::_current_instance = nullptr;
 
+////////////////////////////////////////////////////////////////////////////////
+// BattlePreload class
+////////////////////////////////////////////////////////////////////////////////
+
+BattlePreload::BattlePreload() :
+	_reference_count(1)
+{}
+
+
+
+BattlePreload::~BattlePreload() {
+	for (map<uint32, GlobalEnemy*>::iterator i = _enemies.begin(); i != _enemies.end(); ++i) {
+		delete i->second;
+	}
+	_enemies.clear();
+
+	for (map<string, MusicDescriptor*>::iterator i = _music.begin(); i != _music.end(); ++i) {
+		delete i->second;
+	}
+	_music.clear();
+}
+
+
+
+void BattlePreload::AddEnemy(uint32 enemy_id) {
+	if (enemy_id == 0 || _added_enemies.insert(enemy_id).second == false)
+		return;
+
+	PendingAsset asset;
+	asset.type = PRELOAD_ENEMY;
+	asset.enemy_id = enemy_id;
+	_pending.push_back(asset);
+}
+
+
+
+void BattlePreload::AddBackground(const string& filename) {
+	if (filename.empty() == true || _added_files.insert(filename).second == false)
+		return;
+
+	PendingAsset asset;
+	asset.type = PRELOAD_BACKGROUND;
+	asset.enemy_id = 0;
+	asset.filename = filename;
+	_pending.push_back(asset);
+}
+
+
+
+void BattlePreload::AddMusic(const string& filename) {
+	if (filename.empty() == true || _added_files.insert(filename).second == false)
+		return;
+
+	PendingAsset asset;
+	asset.type = PRELOAD_MUSIC;
+	asset.enemy_id = 0;
+	asset.filename = filename;
+	_pending.push_back(asset);
+}
+
+
+
+bool BattlePreload::LoadNext() {
+	if (_pending.empty() == true)
+		return false;
+
+	PendingAsset asset = _pending.front();
+	_pending.pop_front();
+
+	if (asset.type == PRELOAD_ENEMY) {
+		GlobalEnemy* enemy = new GlobalEnemy(asset.enemy_id);
+		_enemies.insert(make_pair(asset.enemy_id, enemy));
+
+		// Retain the images that BattleEnemy loads or generates when it is constructed from this enemy
+		vector<StillImage>& frames = *(enemy->GetBattleSpriteFrames());
+		if (frames.empty() == false) {
+			_images.push_back(frames.back());
+			_images.back().EnableGrayScale();
+		}
+
+		string icon_filename = "img/icons/actors/enemies/" + enemy->GetFilename() + ".png";
+		if (DoesFileExist(icon_filename) == true) {
+			_images.push_back(StillImage());
+			_images.back().Load(icon_filename, 45.0f, 45.0f);
+		}
+	}
+	else if (asset.type == PRELOAD_BACKGROUND) {
+		_images.push_back(StillImage());
+		if (_images.back().Load(asset.filename) == false) {
+			IF_PRINT_WARNING(BATTLE_DEBUG) << "failed to preload background image: " << asset.filename << endl;
+			_images.pop_back();
+		}
+	}
+	else if (asset.type == PRELOAD_MUSIC) {
+		MusicDescriptor* music = new MusicDescriptor();
+		if (music->LoadAudio(asset.filename) == false) {
+			IF_PRINT_WARNING(BATTLE_DEBUG) << "failed to preload music file: " << asset.filename << endl;
+			delete music;
+		}
+		else {
+			_music.insert(make_pair(asset.filename, music));
+		}
+	}
+
+	return (_pending.empty() == false);
+} // bool BattlePreload::LoadNext()
+
+
+
+GlobalEnemy* BattlePreload::GetEnemy(uint32 enemy_id) const {
+	map<uint32, GlobalEnemy*>::const_iterator i = _enemies.find(enemy_id);
+	return (i != _enemies.end()) ? i->second : nullptr;
+}
+
+
+
+MusicDescriptor* BattlePreload::GetMusic(const string& filename) const {
+	map<string, MusicDescriptor*>::const_iterator i = _music.find(filename);
+	return (i != _music.end()) ? i->second : nullptr;
+}
+
 namespace private_battle {
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -66,7 +187,10 @@ const char* DEFAULT_VICTORY_MUSIC  = "mus/Allacrost_Fanfare.ogg";
 const char* DEFAULT_DEFEAT_MUSIC   = "mus/Allacrost_Intermission.ogg";
 //@}
 
-BattleMedia::BattleMedia() {
+BattleMedia::BattleMedia() :
+	battle_music(&_battle_music),
+	_preload(nullptr)
+{
 	if (background_image.Load("img/backdrops/battle/desert_cave.png") == false)
 		PRINT_ERROR << "failed to load default background image" << endl;
 
@@ -167,7 +291,9 @@ BattleMedia::BattleMedia() {
 
 
 BattleMedia::~BattleMedia() {
-	battle_music.FreeAudio();
+	_battle_music.FreeAudio();
+	if (_preload != nullptr)
+		_preload->RemoveReference();
 	victory_music.FreeAudio();
 	defeat_music.FreeAudio();
 }
@@ -183,13 +309,35 @@ void BattleMedia::SetBackgroundImage(const string& filename) {
 
 
 void BattleMedia::SetBattleMusic(const string& filename) {
-	if (battle_music.LoadAudio(filename) == false) {
+	MusicDescriptor* preloaded_music = (_preload != nullptr) ? _preload->GetMusic(filename) : nullptr;
+	if (preloaded_music != nullptr) {
+		_battle_music.FreeAudio();
+		battle_music = preloaded_music;
+		battle_music->Rewind();
+		return;
+	}
+
+	battle_music = &_battle_music;
+	if (_battle_music.LoadAudio(filename) == false) {
 		IF_PRINT_WARNING(BATTLE_DEBUG) << "failed to load music file: " << filename << endl;
 	}
 }
 
 
 
+void BattleMedia::SetPreload(BattlePreload* preload) {
+	if (preload == _preload)
+		return;
+
+	if (preload != nullptr)
+		preload->AddReference();
+	if (_preload != nullptr)
+		_preload->RemoveReference();
+	_preload = preload;
+}
+
+
+
 StillImage* BattleMedia:: GetCharacterActionButton(uint32 index) {
 	if (index >= character_action_buttons.size()) {
 		IF_PRINT_WARNING(BATTLE_DEBUG) << "function received invalid index argument: " << index << endl;
@@ -274,7 +422,9 @@ BattleMode::BattleMode() :
 	_finish_supervisor(nullptr),
 	_current_number_swaps(0),
 	_play_finish_music(true),
-	_disable_battle_gui(false)
+	_disable_battle_gui(false),
+	_simulated(false),
+	_action_count(0)
 {
 	IF_PRINT_DEBUG(BATTLE_DEBUG) << "constructor invoked" << endl;
 
@@ -343,8 +493,8 @@ void BattleMode::Reset() {
 	VideoManager->SetCoordSys(0.0f, 1024.0f, 0.0f, 768.0f);
 
         // Only play the battle music if it was loaded
-        if (_battle_media.battle_music.GetState() != AUDIO_STATE_UNLOADED) {
-                _battle_media.battle_music.Play();
+        if (_battle_media.battle_music->GetState() != AUDIO_STATE_UNLOADED) {
+                _battle_media.battle_music->Play();
         }
 
 	if (_state == BATTLE_STATE_INVALID) {
@@ -359,15 +509,15 @@ void BattleMode::Reset() {
 void BattleMode::Update() {
 	// Pause/quit requests take priority
 	if (InputManager->QuitPress()) {
-		ModeManager->Push(new PauseMode(hoa_pause::QUIT));
+		ModeManager->Push(PauseMode::Create(hoa_pause::QUIT));
 		return;
 	}
 	else if (InputManager->PausePress()) {
-		ModeManager->Push(new PauseMode(hoa_pause::PAUSE));
+		ModeManager->Push(PauseMode::Create(hoa_pause::PAUSE));
 		return;
 	}
 	else if (InputManager->HelpPress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::HELP));
+		ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 		return;
 	}
 
@@ -453,7 +603,15 @@ void BattleMode::Update() {
 	// command state to allow the player to enter a command for that character before resuming. We also want to make sure
 	// that the command menu is open whenever we find a character in the command state. If the command menu is not open, we
 	// forcibly open it and make the player choose a command for the character so that the battle may continue.
-	if(_disable_battle_gui == false) {
+	// Simulated battles have no player, so their characters select a command as soon as they enter the command state.
+	if (_simulated == true) {
+		for (uint32 i = 0; i < _character_actors.size(); i++) {
+			if (_character_actors[i]->GetState() == ACTOR_STATE_COMMAND) {
+				_character_actors[i]->SelectAutomaticAction();
+			}
+		}
+	}
+	else if(_disable_battle_gui == false) {
 
 		if (GlobalManager->GetBattleSetting() == GLOBAL_BATTLE_WAIT) {
 
@@ -481,6 +639,7 @@ void BattleMode::Update() {
 		switch (acting_actor->GetState()) {
 			case ACTOR_STATE_READY:
 				acting_actor->ChangeState(ACTOR_STATE_ACTING);
+				++_action_count;
 				break;
 			case ACTOR_STATE_ACTING:
 				break;
@@ -490,7 +649,8 @@ void BattleMode::Update() {
 		}
 	}
 
-	// Update all actors
+	// Update all actors. Status effects expire on the same clock as the actors that they are applied to.
+	_effect_timers.Advance(SystemManager->GetUpdateTime());
 	for (uint32 i = 0; i < _character_actors.size(); i++) {
 		_character_actors[i]->Update();
 	}
@@ -553,6 +713,17 @@ void BattleMode::AddEnemy(GlobalEnemy* new_enemy) {
 
 
 
+void BattleMode::AddEnemy(uint32 new_enemy_id) {
+	BattlePreload* preload = _battle_media.GetPreload();
+	GlobalEnemy* prototype = (preload != nullptr) ? preload->GetEnemy(new_enemy_id) : nullptr;
+	if (prototype != nullptr)
+		AddEnemy(new GlobalEnemy(*prototype));
+	else
+		AddEnemy(new GlobalEnemy(new_enemy_id));
+}
+
+
+
 void BattleMode::LoadBattleScript(const std::string& filename) {
 	if (_state != BATTLE_STATE_INVALID) {
 		IF_PRINT_WARNING(BATTLE_DEBUG) << "function was called when battle mode was already initialized" << endl;
@@ -575,9 +746,9 @@ void BattleMode::RestartBattle() {
 	}
 
         // Only restart battle music if it has been set
-        if (_battle_media.battle_music.GetState() != AUDIO_STATE_UNLOADED) {
-                _battle_media.battle_music.Rewind();
-                _battle_media.battle_music.Play();
+        if (_battle_media.battle_music->GetState() != AUDIO_STATE_UNLOADED) {
+                _battle_media.battle_music->Rewind();
+                _battle_media.battle_music->Play();
         }
 
 	ChangeState(BATTLE_STATE_INITIAL);
@@ -646,6 +817,8 @@ void BattleMode::ChangeState(BATTLE_STATE new_state) {
                         _DisableBattleGUI();
                         break;
 		case BATTLE_STATE_VICTORY:
+			if (_simulated == true)
+				break;
 		        // Play victory music if required
 		        if (_play_finish_music) {
                                 _battle_media.victory_music.Play();
@@ -653,6 +826,8 @@ void BattleMode::ChangeState(BATTLE_STATE new_state) {
 			_finish_supervisor->Initialize(true);
 			break;
 		case BATTLE_STATE_DEFEAT:
+			if (_simulated == true)
+				break;
 		        // Play defeat music if required
 		        if (_play_finish_music) {
                                 _battle_media.defeat_music.Play();
@@ -778,9 +953,12 @@ void BattleMode::NotifyActorDeath(BattleActor* actor) {
 
 	uint32 num_alive_characters = _NumberCharactersAlive();
 	uint32 num_alive_enemies = _NumberEnemiesAlive();
-	// If either party is completely dead
+	// If either party is completely dead. Simulated battles have no ending sequence to play.
 	if ((num_alive_characters == 0) || (num_alive_enemies == 0)) {
-		ChangeState(BATTLE_STATE_END);
+		if (_simulated == true)
+			ChangeState((num_alive_characters == 0) ? BATTLE_STATE_DEFEAT : BATTLE_STATE_VICTORY);
+		else
+			ChangeState(BATTLE_STATE_END);
 	}
 }
 
@@ -904,7 +1082,8 @@ void BattleMode::_Initialize() {
 		}
 	}
 
-	ChangeState(BATTLE_STATE_INITIAL);
+	// Simulated battles have no opening sequence to play
+	ChangeState((_simulated == true) ? BATTLE_STATE_NORMAL : BATTLE_STATE_INITIAL);
 } // void BattleMode::_Initialize()
 
 
@@ -21,6 +21,8 @@
 
 #pragma once
 
+#include <deque>
+
 #include "defs.h"
 #include "utils.h"
 
@@ -39,6 +41,118 @@ namespace hoa_battle {
 //! \brief Determines whether the code in the hoa_battle namespace should print debug statements or not.
 extern bool BATTLE_DEBUG;
 
+/** ****************************************************************************
+*** \brief Keeps the data of one or more potential battles resident before the battles begin
+***
+*** Constructing a battle reads the definition of every enemy, loads their battle
+*** sprites and icons, the battle background, and opens the battle music. When this
+*** is done at the moment a battle begins it causes a noticeable stall. Map mode
+*** creates a preload set for each enemy zone that the player approaches and adds
+*** every enemy, background, and piece of music that a battle in the zone may use.
+*** The assets are then loaded one at a time by calls to LoadNext(), which the owner
+*** makes once per frame so that the cost is spread across many frames.
+***
+*** While a preload set exists, the textures it retains stay resident in the texture
+*** manager. A battle that is given the set constructs its enemies by copying the
+*** preloaded prototypes and uses the preloaded music, so it does not touch the disk.
+***
+*** The set is reference counted. Its creator holds one reference and each battle
+*** that uses the set holds another, so the set is not destroyed during a battle even
+*** if its creator releases it.
+***
+*** \note All loading is done on the main thread, as image loads must have access to
+*** the rendering context.
+*** ***************************************************************************/
+class BattlePreload {
+public:
+	BattlePreload();
+
+	~BattlePreload();
+
+	//! \brief Increments the number of references to this preload set
+	void AddReference()
+		{ ++_reference_count; }
+
+	//! \brief Decrements the number of references to this preload set and deletes it when none remain
+	void RemoveReference()
+		{ if (--_reference_count == 0) delete this; }
+
+	/** \name Asset addition methods
+	*** These methods queue an asset to be loaded by LoadNext(). Assets that have already been
+	*** added are ignored, as are empty filenames and enemy IDs of zero.
+	**/
+	//@{
+	void AddEnemy(uint32 enemy_id);
+	void AddBackground(const std::string& filename);
+	void AddMusic(const std::string& filename);
+	//@}
+
+	/** \brief Loads the next asset that is waiting to be loaded
+	*** \return True if there are more assets waiting to be loaded after this call
+	**/
+	bool LoadNext();
+
+	//! \brief Loads every asset that is waiting to be loaded
+	void LoadAll()
+		{ while (LoadNext() == true); }
+
+	//! \brief Returns true if every asset added to the set has been loaded
+	bool IsLoaded() const
+		{ return _pending.empty(); }
+
+	/** \brief Returns the preloaded prototype of an enemy
+	*** \param enemy_id The ID of the enemy to retrieve
+	*** \return A pointer to the uninitialized prototype, or nullptr if the enemy has not been loaded
+	*** \note The prototype is owned by this class. Battles should add a copy of it, never the prototype itself.
+	**/
+	hoa_global::GlobalEnemy* GetEnemy(uint32 enemy_id) const;
+
+	/** \brief Returns the preloaded music for a music file
+	*** \param filename The filename of the music to retrieve
+	*** \return A pointer to the loaded music, or nullptr if the music has not been loaded
+	**/
+	hoa_audio::MusicDescriptor* GetMusic(const std::string& filename) const;
+
+private:
+	//! \brief The types of assets that may wait in the pending queue
+	enum PRELOAD_TYPE {
+		PRELOAD_ENEMY = 0,
+		PRELOAD_BACKGROUND = 1,
+		PRELOAD_MUSIC = 2
+	};
+
+	//! \brief An asset that has been added to the set but not yet loaded
+	struct PendingAsset {
+		PRELOAD_TYPE type;
+		uint32 enemy_id;
+		std::string filename;
+	};
+
+	//! \brief The number of map zones and battles that retain a pointer to this set
+	uint32 _reference_count;
+
+	//! \brief The assets waiting to be loaded, in the order that they were added
+	std::deque<PendingAsset> _pending;
+
+	//! \brief The enemy IDs and filenames of every asset added to the set, used to ignore duplicate additions
+	//@{
+	std::set<uint32> _added_enemies;
+	std::set<std::string> _added_files;
+	//@}
+
+	//! \brief Uninitialized enemy prototypes, indexed by their enemy IDs
+	std::map<uint32, hoa_global::GlobalEnemy*> _enemies;
+
+	//! \brief Holds the background images and enemy icons, keeping their textures resident
+	std::vector<hoa_video::StillImage> _images;
+
+	//! \brief Loaded battle music, indexed by filename
+	std::map<std::string, hoa_audio::MusicDescriptor*> _music;
+
+	BattlePreload(const BattlePreload&);
+	BattlePreload& operator=(const BattlePreload&);
+}; // class BattlePreload
+
 //! \brief An internal namespace to be used only within the battle code. Don't use this namespace anywhere else!
 namespace private_battle {
 
@@ -68,9 +182,19 @@ public:
 
 	/** \brief Sets the battle music to use
 	*** \param filename The full filename of the music to play
+	*** If the preload set holds this music, the preloaded music is used instead of loading it again.
 	**/
 	void SetBattleMusic(const std::string& filename);
 
+	/** \brief Sets the preload set that holds the assets for this battle
+	*** \param preload A pointer to the preload set, or nullptr to use none
+	*** This must be called before any enemies or music are added to the battle for the set to take effect.
+	**/
+	void SetPreload(BattlePreload* preload);
+
+	BattlePreload* GetPreload() const
+		{ return _preload; }
+
 	/** \brief Retrieves a specific button icon for character action
 	*** \param index The index of the button to retrieve
 	*** \return A pointer to the appropriate button image, or nullptr if the index argument was out of bounds
@@ -149,8 +273,10 @@ public:
 	**/
 	std::vector<hoa_video::StillImage> character_action_buttons;
 
-	//! \brief The music played during the battle
-	hoa_audio::MusicDescriptor battle_music;
+	/** \brief The music played during the battle
+	*** This points either to music held by the preload set or to the media's own battle music.
+	**/
+	hoa_audio::MusicDescriptor* battle_music;
 
 	//! \brief The music played after the player has won the battle
 	hoa_audio::MusicDescriptor victory_music;
@@ -168,6 +294,12 @@ public:
 	//@}
 
 private:
+	//! \brief The preload set used by the battle, or nullptr if there is none
+	BattlePreload* _preload;
+
+	//! \brief The battle music loaded by the media when the music is not found in the preload set
+	hoa_audio::MusicDescriptor _battle_music;
+
 	/** \brief Container used to find the appropriate row index for each status type
 	*** Status icons for all types of status are all contained within a single image. This container is used to
 	*** quickly determine which row of icons in that image corresponds to each status type.
@@ -220,6 +352,13 @@ public:
 	private_battle::BattleMedia& GetMedia()
 		{ return _battle_media; }
 
+	/** \brief Provides access to the timer wheel that status effects schedule their expirations on
+	*** This wheel is advanced only when the battle actors are updated, so that status effects do not expire
+	*** while the battle is halted for a dialogue or for the player to select a command.
+	**/
+	hoa_system::TimerWheel& GetEffectTimers()
+		{ return _effect_timers; }
+
 	//! \name Inherited methods for the GameMode class
 	//@{
 	//! \brief Sets the descriptions of the possible battle command inputs
@@ -258,10 +397,10 @@ public:
 	*** only this version will construct the global enemy just using its id (meaning that it has
 	*** to open up the Lua file which defines the enemy). If the GlobalEnemy has already been
 	*** defined somewhere else, it is better to pass it in to the alternative definition of this
-	*** function.
+	*** function. If the battle's preload set holds the enemy, the enemy is copied from the preloaded
+	*** prototype instead.
 	**/
-	void AddEnemy(uint32 new_enemy_id)
-		{ AddEnemy(new hoa_global::GlobalEnemy(new_enemy_id)); }
+	void AddEnemy(uint32 new_enemy_id);
 
 	/** \brief Restores the battle to its initial state, allowing the player another attempt to achieve victory
 	***
@@ -303,6 +442,22 @@ public:
 	bool IsBattleGUIDisabled() const
 		{ return _disable_battle_gui; }
 
+	/** \brief Makes the battle run without a player
+	*** A simulated battle skips the opening sequence, has its characters select their own commands, and stops in
+	*** the victory or defeat state without running the finish supervisor, so that no experience or items are awarded
+	*** to the global party. This must be called before the battle is initialized. It is used by the batch battle
+	*** simulator, which updates the battle directly instead of through the mode manager.
+	**/
+	void EnableSimulation()
+		{ _simulated = true; }
+
+	bool IsSimulated() const
+		{ return _simulated; }
+
+	//! \brief Returns the number of actions that actors have begun to execute since the battle was initialized
+	uint32 GetActionCount() const
+		{ return _action_count; }
+
 	//! \brief Sets whether or not to play the victory/defeat music when a battle is concluded.
 	//! \param to_play the victory/defeat music or not
 	void SetPlayFinishMusic(bool to_play);
@@ -374,6 +529,9 @@ private:
 	//! \brief A pointer to the BattleMedia object created to coincide with this instance of BattleMode
 	private_battle::BattleMedia _battle_media;
 
+	//! \brief Schedules the expiration of all status effects on the battle actors
+	hoa_system::TimerWheel _effect_timers;
+
 	//! \name Battle script data
 	//@{
 	//! \brief The name of the Lua file used for scripting this battle
@@ -465,6 +623,12 @@ private:
 	//! \brief Whether or not to disable the input gui.
 	//! \return True if input gui is to be disabled.
 	bool _disable_battle_gui;
+
+	//! \brief True if the battle is run by the batch simulator without a player
+	bool _simulated;
+
+	//! \brief The number of actions that actors have begun to execute
+	uint32 _action_count;
 	////////////////////////////// PRIVATE METHODS ///////////////////////////////
 
 	//! \brief Initializes all data necessary for the battle to begin
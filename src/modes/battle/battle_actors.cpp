@@ -434,6 +434,52 @@ void BattleCharacter::Update(bool animation_only) {
 
 
 
+void BattleCharacter::SelectAutomaticAction() {
+	vector<GlobalSkill*> usable_skills;
+	vector<GlobalSkill*>* skills = _global_character->GetSkills();
+	for (uint32 i = 0; i < skills->size(); ++i) {
+		if (skills->at(i)->IsExecutableInBattle() == true && skills->at(i)->GetSPRequired() <= GetSkillPoints())
+			usable_skills.push_back(skills->at(i));
+	}
+
+	if (usable_skills.empty() == true) {
+		IF_PRINT_WARNING(BATTLE_DEBUG) << "character had no usable skills" << endl;
+		ChangeState(ACTOR_STATE_IDLE);
+		return;
+	}
+
+	GlobalSkill* skill = usable_skills[0];
+	if (usable_skills.size() > 1) {
+		skill = usable_skills[RandomBoundedInteger(0, usable_skills.size() - 1)];
+	}
+
+	BattleTarget target;
+	if (skill->GetTargetType() == GLOBAL_TARGET_FOE) {
+		deque<BattleActor*> alive_enemies = BattleMode::CurrentInstance()->GetEnemyParty();
+		deque<BattleActor*>::iterator enemy_iterator = alive_enemies.begin();
+		while (enemy_iterator != alive_enemies.end()) {
+			if ((*enemy_iterator)->IsAlive() == false)
+				enemy_iterator = alive_enemies.erase(enemy_iterator);
+			else
+				enemy_iterator++;
+		}
+
+		if (alive_enemies.empty() == true) {
+			ChangeState(ACTOR_STATE_IDLE);
+			return;
+		}
+		target.SetActorTarget(GLOBAL_TARGET_FOE, alive_enemies[RandomBoundedInteger(0, alive_enemies.size() - 1)]);
+	}
+	else {
+		target.SetInitialTarget(this, skill->GetTargetType());
+	}
+
+	SetAction(new SkillAction(this, target, skill));
+	ChangeState(ACTOR_STATE_WARM_UP);
+}
+
+
+
 void BattleCharacter::DrawSprite() {
 	// Draw the character sprite
 	VideoManager->Move(_x_location, _y_location);
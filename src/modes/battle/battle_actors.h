@@ -387,6 +387,13 @@ public:
 	bool CanSelectCommand() const
 		{ return (_state == ACTOR_STATE_IDLE) || (_state == ACTOR_STATE_COMMAND); }
 
+	/** \brief Selects an action for the character without the player and moves it to the warm up state
+	*** This is used by simulated battles. Like the decisions that enemies make, a random battle skill that the
+	*** character has enough skill points for is selected. Skills that target a single foe target a random living
+	*** foe, and all other skills use their initial target. If no skill can be used, the character returns to idle.
+	**/
+	void SelectAutomaticAction();
+
 	//! \brief Updates the state of the character. Must be called every frame loop.
 	void Update(bool animation_only = false);
 
@@ -61,7 +61,10 @@ StatusEffect::StatusEffect(GLOBAL_STATUS type, GLOBAL_INTENSITY intensity, Battl
 	_status_effect(type, intensity),
 	_opposite_status_type(GLOBAL_STATUS_INVALID),
 	_intensity_changed(false),
-	_duration_timer(0),
+	_duration(0),
+	_duration_timers(&BattleMode::CurrentInstance()->GetEffectTimers()),
+	_duration_callback(SYSTEM_INVALID_CALLBACK),
+	_duration_expired(false),
 	_icon_image(nullptr),
 	_apply_function(nullptr),
 	_update_function(nullptr),
@@ -80,6 +83,8 @@ StatusEffect::StatusEffect(GLOBAL_STATUS type, GLOBAL_INTENSITY intensity, Battl
 
 
 StatusEffect::~StatusEffect() {
+	_duration_timers->Cancel(_duration_callback);
+
 	if (_apply_function != nullptr)
 		delete _apply_function;
 	if (_update_function != nullptr)
@@ -96,7 +101,7 @@ StatusEffect::~StatusEffect() {
 
 bool StatusEffect::Load(ReadScriptDescriptor& script_file) {
 	_effect_name = script_file.ReadUString("name");
-	_duration_timer.SetDuration(script_file.ReadUInt("duration"));
+	_duration = script_file.ReadUInt("duration");
 	_opposite_status_type = static_cast<GLOBAL_STATUS>(script_file.ReadInt("opposite_effect"));
 
 	if (script_file.DoesFunctionExist("Apply")) {
@@ -123,8 +128,7 @@ bool StatusEffect::Load(ReadScriptDescriptor& script_file) {
 	}
 
 	// --- (4): Finish initialization of members
-	_duration_timer.Reset();
-	_duration_timer.Run();
+	_RestartDuration();
 	_icon_image = BattleMode::CurrentInstance()->GetMedia().GetStatusIcon(_status_effect.GetType(), _status_effect.GetIntensity());
 	return true;
 }
@@ -171,8 +175,7 @@ void StatusEffect::SetIntensity(hoa_global::GLOBAL_INTENSITY intensity) {
 		_intensity_changed = true;
 		_icon_image = BattleMode::CurrentInstance()->GetMedia().GetStatusIcon(_status_effect.GetType(), _status_effect.GetIntensity());
 	}
-	_duration_timer.Reset();
-	_duration_timer.Run();
+	_RestartDuration();
 }
 
 
@@ -187,8 +190,7 @@ bool StatusEffect::IncrementIntensity(uint8 amount) {
 		_icon_image = BattleMode::CurrentInstance()->GetMedia().GetStatusIcon(_status_effect.GetType(), _status_effect.GetIntensity());
 	}
 
-	_duration_timer.Reset();
-	_duration_timer.Run();
+	_RestartDuration();
 	return changed;
 }
 
@@ -204,16 +206,24 @@ bool StatusEffect::DecrementIntensity(uint8 amount) {
 		_icon_image = BattleMode::CurrentInstance()->GetMedia().GetStatusIcon(_status_effect.GetType(), _status_effect.GetIntensity());
 	}
 
-	_duration_timer.Reset();
-	_duration_timer.Run();
+	_RestartDuration();
 	return changed;
 }
 
 
 
-void StatusEffect::_UpdateDurationTimer() {
-	_duration_timer.Update();
-	if (_duration_timer.IsFinished() == true) {
+void StatusEffect::_RestartDuration() {
+	_duration_timers->Cancel(_duration_callback);
+	_duration_expired = false;
+	_duration_callback = _duration_timers->Schedule(_duration, [this]() { _duration_expired = true; });
+}
+
+
+
+void StatusEffect::_UpdateDuration() {
+	// The expiration is processed here rather than in the scheduled call so that any intensity change is seen by the caller of Update()
+	if (_duration_expired == true) {
+		_duration_expired = false;
 		DecrementIntensity(1);
 	}
 }
@@ -224,7 +234,7 @@ void StatusEffect::_UpdateDurationTimer() {
 
 void StaticStatusEffect::Update() {
 	_intensity_changed = false;
-	_UpdateDurationTimer();
+	_UpdateDuration();
 
 	if (IsIntensityChanged() == true) {
 		if (GetIntensity() != GLOBAL_INTENSITY_NEUTRAL) {
@@ -263,7 +273,7 @@ bool PeriodicStatusEffect::Load(ReadScriptDescriptor& script_file) {
 
 void PeriodicStatusEffect::Update() {
 	_intensity_changed = false;
-	_UpdateDurationTimer();
+	_UpdateDuration();
 	uint32 last_times_completed = _period_timer.GetTimesCompleted();
 	_period_timer.Update();
 
@@ -125,7 +125,7 @@ public:
 	**/
 	bool DecrementIntensity(uint8 amount);
 
-	//! \note This will cause the duration timer to reset
+	//! \note This will cause the duration of the current intensity level to restart
 	void SetIntensity(hoa_global::GLOBAL_INTENSITY intensity);
 
 	void ResetIntensityChanged()
@@ -160,9 +160,13 @@ public:
 	bool IsIntensityChanged() const
 		{ return _intensity_changed; }
 
-	//! \note Returns a pointer instead of a reference so that Lua functions can access the timer
-	hoa_system::SystemTimer* GetDurationTimer()
-		{ return &_duration_timer; }
+	//! \brief Returns the number of milliseconds that each intensity level of the effect lasts for
+	uint32 GetDuration() const
+		{ return _duration; }
+
+	//! \brief Returns the number of milliseconds that remain until the intensity of the effect decreases
+	uint32 GetTimeRemaining() const
+		{ return _duration_timers->TimeRemaining(_duration_callback); }
 
 	hoa_video::StillImage* GetIconImage() const
 		{ return _icon_image; }
@@ -178,8 +182,17 @@ protected:
 	//! \brief A flag set to true when the intensity value was changed and cleared when the Update method is called
 	bool _intensity_changed;
 
-	//! \brief A timer used to determine how long the status effect lasts
-	hoa_system::SystemTimer _duration_timer;
+	//! \brief The number of milliseconds that each intensity level of the status effect lasts for
+	uint32 _duration;
+
+	//! \brief The battle's status effect timer wheel, which is used to schedule the expiration of each intensity level
+	hoa_system::TimerWheel* _duration_timers;
+
+	//! \brief The handle of the scheduled call that expires the current intensity level
+	uint32 _duration_callback;
+
+	//! \brief Set by the scheduled call when the current intensity level has expired and cleared when the expiration is processed
+	bool _duration_expired;
 
 	//! \brief A pointer to the icon image that represents the status. Set to nullptr if the status is invalid
 	hoa_video::StillImage* _icon_image;
@@ -193,8 +206,11 @@ protected:
 	//! \brief Called when the status effect is removed
 	ScriptObject* _remove_function;
 
-	//! \brief If the timer finishes, decrements the intensity and processes changes accordingly
-	void _UpdateDurationTimer();
+	//! \brief Cancels any pending expiration of the current intensity level and schedules a new one for the full duration
+	void _RestartDuration();
+
+	//! \brief If the current intensity level has expired, decrements the intensity and processes changes accordingly
+	void _UpdateDuration();
 }; // class StatusEffect : public BattleEffect
 
 
@@ -234,7 +250,7 @@ public:
 *** seconds.
 ***
 *** In the Lua script, a period time is defined that is used to determine how often the
-*** _update_function is invoked. This time should always be less than the _duration_timer,
+*** _update_function is invoked. This time should always be less than the _duration,
 *** otherwise the effect may never make any change while it is active.
 *** ***************************************************************************/
 class PeriodicStatusEffect : public StatusEffect {
@@ -281,12 +281,12 @@ void BootMode::Update() {
 	_credits_window->Update();
 
 	if (InputManager->HelpPress()) {
-		ModeManager->Push(new PauseMode(hoa_pause::HELP));
+		ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 	}
 	// If an unmapped key is pressed, show the help menu so long as none of the keyboard/joystick setting menus are not active
 	if (InputManager->UnmappedKeyPress() == true) {
         if (_active_menu != &_key_settings_menu && _active_menu != &_joy_settings_menu) {
-			ModeManager->Push(new PauseMode(hoa_pause::HELP));
+			ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 		}
 	}
 
@@ -1442,7 +1442,7 @@ void BootMode::_EndLogoAnimation() {
 
 	settings_lua.OpenTable("settings");
 	if (settings_lua.ReadInt("welcome") == 1) {
-		ModeManager->Push(new PauseMode(hoa_pause::HELP));
+		ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 		// Save the settings as this will automatically change the welcome setting to 0
 		_has_modified_settings = true;
 		_SaveSettingsFile("");
@@ -1600,6 +1600,16 @@ bool BootMode::_LoadSettingsFile(const std::string& filename) {
 	else if(VideoManager->IsFullscreen() == false && fullscreen)
 		_OnToggleFullscreen();
 
+	// Profiles saved by older versions of the game do not have the frame pacing settings, so their defaults are restored
+	if (settings.DoesBoolExist("vsync") == true)
+		VideoManager->SetVSync(settings.ReadBool("vsync"));
+	else
+		VideoManager->SetVSync(VIDEO_DEFAULT_VSYNC);
+	if (settings.DoesIntExist("target_fps") == true)
+		VideoManager->SetTargetFPS(static_cast<uint32>(settings.ReadInt("target_fps")));
+	else
+		VideoManager->SetTargetFPS(VIDEO_DEFAULT_TARGET_FPS);
+
 	settings.CloseTable();
 
 	if (settings.IsErrorDetected()) {
@@ -1682,6 +1692,14 @@ bool BootMode::_SaveSettingsFile(const std::string& filename) {
 	settings_lua.ModifyInt("video_settings.screen_resx", VideoManager->GetScreenWidth());
 	settings_lua.ModifyInt("video_settings.screen_resy", VideoManager->GetScreenHeight());
 	settings_lua.ModifyBool("video_settings.full_screen", VideoManager->IsFullscreen());
+	// Profiles saved by older versions of the game do not have the frame pacing settings to modify
+	settings_lua.OpenTable("video_settings");
+	bool has_frame_pacing = (settings_lua.DoesBoolExist("vsync") == true && settings_lua.DoesIntExist("target_fps") == true);
+	settings_lua.CloseTable();
+	if (has_frame_pacing == true) {
+		settings_lua.ModifyBool("video_settings.vsync", VideoManager->IsVSync());
+		settings_lua.ModifyInt("video_settings.target_fps", static_cast<int32>(VideoManager->GetTargetFPS()));
+	}
 	//settings_lua.ModifyFloat("video_settings.brightness", VideoManager->GetGamma());
 
 	// audio
@@ -74,7 +74,7 @@ MapMode::MapMode(string script_filename, int32 load_point) :
 	_global_record_group(nullptr),
 	_local_record_group("local_map"), // The group name doesn't really matter since this record group is volatile
 	_dialogue_supervisor(new DialogueSupervisor()),
-	_event_supervisor(new EventSupervisor()),
+	_event_supervisor(new EventSupervisor(this)),
 	_object_supervisor(new ObjectSupervisor()),
 	_tile_supervisor(new TileSupervisor()),
 	_transition_supervisor(new TransitionSupervisor()),
@@ -213,15 +213,15 @@ void MapMode::Update() {
 	// Process quit/pause/help events so long as we are not in the middle of a transition
 	if (CurrentState() != STATE_TRANSITION) {
 		if (InputManager->QuitPress() == true) {
-			ModeManager->Push(new PauseMode(hoa_pause::QUIT));
+			ModeManager->Push(PauseMode::Create(hoa_pause::QUIT));
 			return;
 		}
 		else if (InputManager->PausePress() == true) {
-			ModeManager->Push(new PauseMode(hoa_pause::PAUSE));
+			ModeManager->Push(PauseMode::Create(hoa_pause::PAUSE));
 			return;
 		}
 		else if (InputManager->HelpPress() == true) {
-			ModeManager->Push(new PauseMode(hoa_pause::HELP));
+			ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 			return;
 		}
 	}
@@ -337,8 +337,10 @@ MAP_STATE MapMode::CurrentState() {
 
 
 
-void MapMode::AddZone(MapZone *zone) {
+uint32 MapMode::AddZone(MapZone *zone) {
 	_object_supervisor->_zones.push_back(zone);
+	_object_supervisor->_zone_index_invalid = true;
+	return _object_supervisor->_zones.size() - 1;
 }
 
 
@@ -539,7 +541,7 @@ void MapMode::_LoadMapFiles() {
 void MapMode::_UpdateExplore() {
 	// First go to menu mode if the user requested it
 	if (InputManager->MenuPress()) {
-		MenuMode *MM = new MenuMode();
+		MenuMode *MM = MenuMode::Create();
 		ModeManager->Push(MM);
 		return;
 	}
@@ -672,14 +674,21 @@ void MapMode::_CalculateMapFrame() {
 	// However, we've discussed the possiblity of adding a zoom feature to maps, in which case we need to continually re-calculate the pixel size
 	VideoManager->GetPixelSize(x_pixel_length, y_pixel_length);
 
+	// The camera is drawn between its locations from the last two simulation steps, the same as every other map object
 	if (_camera_timer.IsRunning() == false) {
-	    _camera->GetXPosition(current_x, current_offset_x);
-	    _camera->GetYPosition(current_y, current_offset_y);
+	    float camera_location_x = _camera->ComputeDrawXLocation();
+	    float camera_location_y = _camera->ComputeDrawYLocation();
+
+	    current_x = GetFloatInteger(camera_location_x);
+	    current_y = GetFloatInteger(camera_location_y);
+
+	    current_offset_x = GetFloatFraction(camera_location_x);
+	    current_offset_y = GetFloatFraction(camera_location_y);
 	}
 	else {
 	    // Calculate path
-	    float path_x = _camera->ComputeXLocation() + (1 - _camera_timer.PercentComplete()) * _delta_x;
-	    float path_y = _camera->ComputeYLocation() + (1 - _camera_timer.PercentComplete()) * _delta_y;
+	    float path_x = _camera->ComputeDrawXLocation() + (1 - _camera_timer.PercentComplete()) * _delta_x;
+	    float path_y = _camera->ComputeDrawYLocation() + (1 - _camera_timer.PercentComplete()) * _delta_y;
 
 	    current_x = GetFloatInteger(path_x);
 	    current_y = GetFloatInteger(path_y);
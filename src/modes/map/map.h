@@ -148,10 +148,12 @@ public:
 
 	/** \brief Adds a new zone to the map
 	***
+	*** \return The index of the zone in the object supervisor, which the FFI zone accessors use to identify the zone
+	***
 	*** \todo This function should be moved to the object supervisor. The supervisor should also monitor zone IDs and warn
 	*** if two zones are added with the same ID.
 	**/
-	void AddZone(private_map::MapZone *zone);
+	uint32 AddZone(private_map::MapZone *zone);
 
 	/** \brief Checks if a GlobalEnemy with the specified id is already loaded in the MapMode#_enemies container
 	*** \param id The id of the enemy to find
@@ -222,7 +222,7 @@ void ShopEvent::AddWare(uint32 object_id, uint32 stock) {
 
 
 void ShopEvent::_Start() {
-	ShopMode* shop = new ShopMode();
+	ShopMode* shop = ShopMode::Create();
 	for (set<pair<uint32, uint32> >::iterator i = _wares.begin(); i != _wares.end(); i++) {
 		shop->AddObject((*i).first, (*i).second);
 	}
@@ -529,7 +529,16 @@ bool CustomEvent::_Update() {
 // ---------- EventSupervisor Class Methods
 // -----------------------------------------------------------------------------
 
+EventSupervisor::EventSupervisor(GameMode* owner) :
+	_launch_timers(SystemManager->GetTimerWheel(owner)),
+	_next_launch_id(0)
+{}
+
+
+
 EventSupervisor::~EventSupervisor() {
+	for (map<uint32, uint32>::iterator i = _launch_events.begin(); i != _launch_events.end(); i++)
+		_launch_timers->Cancel(i->second);
 	_active_events.clear();
 	_launch_events.clear();
 	_event_history.clear();
@@ -601,7 +610,7 @@ void EventSupervisor::StartEvent(uint32 event_id, uint32 wait_time) {
 		return;
 	}
 
-	_launch_events.push_back(make_pair(static_cast<int32>(wait_time), event));
+	_ScheduleLaunch(event, wait_time);
 }
 
 
@@ -618,7 +627,7 @@ void EventSupervisor::StartEvent(MapEvent* event, uint32 wait_time) {
 		return;
 	}
 
-	_launch_events.push_back(make_pair(static_cast<int32>(wait_time), event));
+	_ScheduleLaunch(event, wait_time);
 }
 
 
@@ -669,20 +678,7 @@ void EventSupervisor::TerminateEvent(uint32 event_id) {
 
 
 void EventSupervisor::Update() {
-	// Update all launch event timers and start all events whose timers have finished
-	for (list<pair<int32, MapEvent*> >::iterator i = _launch_events.begin(); i != _launch_events.end();) {
-		i->first -= SystemManager->GetUpdateTime();
-
-		if (i->first <= 0) { // Timer has expired
-			MapEvent* start_event = i->second;
-			i = _launch_events.erase(i);
-			// We begin the event only after it has been removed from the launch list
-			StartEvent(start_event);
-		}
-		else
-			++i;
-	}
-
+	// Events waiting to be launched are started by the map's timer wheel, so only the active events need to be checked here
 	// Check for active events which have finished
 	for (list<MapEvent*>::iterator i = _active_events.begin(); i != _active_events.end();) {
 		if ((*i)->_Update() == true) {
@@ -752,12 +748,26 @@ void EventSupervisor::_ExamineEventLinks(MapEvent* parent_event, bool event_star
 				continue;
 			}
 			else {
-				_launch_events.push_back(make_pair(static_cast<int32>(link.launch_timer), child));
+				_ScheduleLaunch(child, link.launch_timer);
 			}
 		}
 	}
 }
 
+
+
+void EventSupervisor::_ScheduleLaunch(MapEvent* event, uint32 wait_time) {
+	uint32 launch_id = _next_launch_id++;
+	uint32 handle = _launch_timers->Schedule(wait_time, [this, event, launch_id]() {
+		// We begin the event only after it has been removed from the launch container
+		_launch_events.erase(launch_id);
+		StartEvent(event);
+	});
+
+	if (handle != SYSTEM_INVALID_CALLBACK)
+		_launch_events.insert(make_pair(launch_id, handle));
+}
+
 } // namespace private_map
 
 } // namespace hoa_map
@@ -657,9 +657,9 @@ protected:
 *** Immediately after starting the first event, the supervisor will examine its event
 *** links to determine which, if any, children events begin relative to the start of
 *** the base event. If they are to start a certain time after the start of the parent
-*** event, they are placed in a container and their countdown timers are initialized.
-*** These timers will count down on every update call to the event manager and after
-*** the timers expire, these events will be launched. When an active event ends, again
+*** event, their launch is scheduled on the timer wheel owned by the map, which starts
+*** them once their wait time has expired. The wheel only advances while the map is the
+*** active game mode, so launches wait while the map is paused. When an active event ends, again
 *** its event links are examined to determine if any children events exist that start
 *** relative to the end of the parent event.
 ***
@@ -676,8 +676,8 @@ protected:
 *** ***************************************************************************/
 class EventSupervisor {
 public:
-	EventSupervisor()
-		{}
+	//! \param owner The map mode that owns this supervisor, whose timer wheel is used to launch events after a wait time
+	EventSupervisor(hoa_mode_manager::GameMode* owner);
 
 	~EventSupervisor();
 
@@ -761,7 +761,7 @@ public:
 
 	//! \brief Returns true if any events are being prepared to be launched after their timers expire
 	bool HasLaunchEvent() const
-		{ return !_launch_events.empty(); }
+		{ return (_launch_events.empty() == false); }
 
 	/** \brief Returns a pointer to a specified event stored by this class
 	*** \param event_id The ID of the event to retrieve
@@ -776,10 +776,17 @@ private:
 	//! \brief A list of all events which have started but are not yet finished
 	std::list<MapEvent*> _active_events;
 
-	/** \brief A list of all events that are waiting on their launch timers to expire before being started
-	*** The interger part of this std::pair is the countdown timer for this event to be launched
+	//! \brief The timer wheel of the owning map mode, on which all delayed event launches are scheduled
+	hoa_system::TimerWheel* _launch_timers;
+
+	/** \brief The scheduled calls that will start an event once its wait time expires
+	*** The key is an ID assigned to each launch by this class and the value is the handle returned by the timer wheel.
+	*** Entries are removed when their call is made, and any that remain are canceled when the supervisor is destroyed.
 	**/
-	std::list<std::pair<int32, MapEvent*> > _launch_events;
+	std::map<uint32, uint32> _launch_events;
+
+	//! \brief The ID to assign to the next event launch that is scheduled
+	uint32 _next_launch_id;
 
 	//! \brief A list of all events which have been paused
 	std::list<MapEvent*> _paused_events;
@@ -795,6 +802,12 @@ private:
 	*** \param event_start The event has just started if this member is true, or if it just finished it will be false
 	**/
 	void _ExamineEventLinks(MapEvent* parent_event, bool event_start);
+
+	/** \brief Schedules an event to be started after a wait time
+	*** \param event A pointer to the event to start
+	*** \param wait_time The number of milliseconds to wait before starting the event
+	**/
+	void _ScheduleLaunch(MapEvent* event, uint32 wait_time);
 }; // class EventSupervisor
 
 } // namespace private_map
@@ -0,0 +1,202 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_ffi.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Source file for the map mode C interface used by the LuaJIT FFI
+*** ***************************************************************************/
+
+extern "C" {
+	#include <lauxlib.h>
+}
+
+// Allacrost engines
+#include "notification.h"
+
+// Allacrost common
+#include "common.h"
+
+// Local map mode headers
+#include "map.h"
+#include "map_events.h"
+#include "map_ffi.h"
+#include "map_objects.h"
+#include "map_zones.h"
+
+using namespace std;
+using namespace hoa_utils;
+using namespace hoa_common;
+using namespace hoa_notification;
+using namespace hoa_map;
+using namespace hoa_map::private_map;
+
+namespace {
+
+//! \brief Returns the camera zone at an index in the active map, or nullptr if it does not exist
+CameraZone* GetCameraZone(uint32 zone_index) {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr)
+		return nullptr;
+
+	return dynamic_cast<CameraZone*>(map->GetObjectSupervisor()->GetZoneByIndex(zone_index));
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------
+// Map State Accessors
+//-----------------------------------------------------------------------------
+
+int32 hoa_map_current_state() {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr)
+		return STATE_INVALID;
+
+	return map->CurrentState();
+}
+
+
+
+int32 hoa_map_player_sprite_id() {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr || map->GetPlayerSprite() == nullptr)
+		return -1;
+
+	return map->GetPlayerSprite()->GetObjectID();
+}
+
+
+
+bool hoa_map_object_location(uint32 object_id, float* x, float* y) {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr)
+		return false;
+
+	MapObject* object = map->GetObjectSupervisor()->GetObject(object_id);
+	if (object == nullptr)
+		return false;
+
+	*x = object->ComputeXLocation();
+	*y = object->ComputeYLocation();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+// Zone Accessors
+//-----------------------------------------------------------------------------
+
+bool hoa_map_zone_player_inside(uint32 zone_index) {
+	CameraZone* zone = GetCameraZone(zone_index);
+	return (zone != nullptr && zone->IsPlayerSpriteInside());
+}
+
+
+
+bool hoa_map_zone_player_entering(uint32 zone_index) {
+	CameraZone* zone = GetCameraZone(zone_index);
+	return (zone != nullptr && zone->IsPlayerSpriteEntering());
+}
+
+
+
+bool hoa_map_zone_player_exiting(uint32 zone_index) {
+	CameraZone* zone = GetCameraZone(zone_index);
+	return (zone != nullptr && zone->IsPlayerSpriteExiting());
+}
+
+//-----------------------------------------------------------------------------
+// Record and Event Accessors
+//-----------------------------------------------------------------------------
+
+int32 hoa_map_global_record(const char* record_name) {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr || map->GetGlobalRecordGroup() == nullptr)
+		return CommonRecordGroup::BAD_RECORD;
+
+	return map->GetGlobalRecordGroup()->GetRecord(record_name);
+}
+
+
+
+int32 hoa_map_local_record(const char* record_name) {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr)
+		return CommonRecordGroup::BAD_RECORD;
+
+	return map->GetLocalRecordGroup()->GetRecord(record_name);
+}
+
+
+
+uint32 hoa_map_times_event_started(uint32 event_id) {
+	MapMode* map = MapMode::CurrentInstance();
+	if (map == nullptr)
+		return 0;
+
+	return map->GetEventSupervisor()->TimesEventStarted(event_id);
+}
+
+//-----------------------------------------------------------------------------
+// Notification Accessors
+//-----------------------------------------------------------------------------
+
+uint32 hoa_notification_count() {
+	return NotificationManager->GetNotificationCount();
+}
+
+
+
+const char* hoa_notification_category(uint32 index) {
+	NotificationEvent* notification = NotificationManager->GetNotificationEvent(index);
+	return (notification != nullptr) ? notification->GetCategory().c_str() : nullptr;
+}
+
+
+
+const char* hoa_notification_event(uint32 index) {
+	NotificationEvent* notification = NotificationManager->GetNotificationEvent(index);
+	return (notification != nullptr) ? notification->GetEvent().c_str() : nullptr;
+}
+
+namespace hoa_map {
+
+bool RegisterMapFFI(lua_State* lstack) {
+#ifdef USE_LUAJIT
+	// The declarations use the C99 fixed width types, which are identical to the integer types declared in utils.h
+	static const char* ffi_registration =
+		"local ffi = require('ffi')\n"
+		"ffi.cdef[[\n"
+		"int32_t hoa_map_current_state();\n"
+		"int32_t hoa_map_player_sprite_id();\n"
+		"bool hoa_map_object_location(uint32_t object_id, float* x, float* y);\n"
+		"bool hoa_map_zone_player_inside(uint32_t zone_index);\n"
+		"bool hoa_map_zone_player_entering(uint32_t zone_index);\n"
+		"bool hoa_map_zone_player_exiting(uint32_t zone_index);\n"
+		"int32_t hoa_map_global_record(const char* record_name);\n"
+		"int32_t hoa_map_local_record(const char* record_name);\n"
+		"uint32_t hoa_map_times_event_started(uint32_t event_id);\n"
+		"uint32_t hoa_notification_count();\n"
+		"const char* hoa_notification_category(uint32_t index);\n"
+		"const char* hoa_notification_event(uint32_t index);\n"
+		"]]\n"
+		"MapFFI = ffi.C\n";
+
+	if (luaL_dostring(lstack, ffi_registration) != 0) {
+		PRINT_ERROR << "failed to register the map mode FFI interface: " << lua_tostring(lstack, -1) << endl;
+		lua_pop(lstack, 1);
+		return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+} // bool RegisterMapFFI(lua_State* lstack)
+
+} // namespace hoa_map
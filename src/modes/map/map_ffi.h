@@ -0,0 +1,107 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    map_ffi.h
+*** \author  Tyler Olsen (Roots)
+*** \brief   Header file for the map mode C interface used by the LuaJIT FFI
+***
+*** Map scripts call a handful of accessors every frame: the player sprite's
+*** position, zone entry checks, record lookups, and iteration over the current
+*** notification events. Each of those calls through luabind allocates argument
+*** wrappers and performs a class lookup. When the game is built against LuaJIT,
+*** the functions in this file are declared to the FFI and made available to all
+*** scripts through the global table "MapFFI", which lets the JIT compiler call
+*** them directly. When the game is built against the standard Lua interpreter,
+*** "MapFFI" is nil and scripts should continue to use the luabind bindings.
+***
+*** All functions operate on the map mode instance that is currently active and
+*** return a neutral value (zero, false, or nullptr) when no map is active or the
+*** requested object does not exist.
+***
+*** \note Any change to the signatures in this file must also be made to the
+*** declarations passed to ffi.cdef in map_ffi.cpp.
+*** ***************************************************************************/
+
+#pragma once
+
+extern "C" {
+	#include <lua.h>
+}
+
+#include "utils.h"
+
+// Functions called through the FFI must be visible in the executable's dynamic symbol table
+#ifdef _WIN32
+	#define HOA_FFI_EXPORT __declspec(dllexport)
+#else
+	#define HOA_FFI_EXPORT __attribute__((visibility("default")))
+#endif
+
+extern "C" {
+
+//! \name Map State Accessors
+//@{
+//! \brief Returns the value of the MAP_STATE that the map is currently in
+HOA_FFI_EXPORT int32 hoa_map_current_state();
+
+//! \brief Returns the object ID of the player sprite, or -1 if there is no player sprite
+HOA_FFI_EXPORT int32 hoa_map_player_sprite_id();
+
+/** \brief Retrieves the location of an object on the map
+*** \param object_id The ID of the object to retrieve the location of
+*** \param x A pointer to hold the x location of the object, including its offset
+*** \param y A pointer to hold the y location of the object, including its offset
+*** \return False if the object did not exist, in which case the location arguments are not modified
+**/
+HOA_FFI_EXPORT bool hoa_map_object_location(uint32 object_id, float* x, float* y);
+//@}
+
+//! \name Zone Accessors
+//! \param zone_index The index of the zone, as returned by MapMode::AddZone()
+//! \note These functions always return false for zones that are not camera zones
+//@{
+HOA_FFI_EXPORT bool hoa_map_zone_player_inside(uint32 zone_index);
+HOA_FFI_EXPORT bool hoa_map_zone_player_entering(uint32 zone_index);
+HOA_FFI_EXPORT bool hoa_map_zone_player_exiting(uint32 zone_index);
+//@}
+
+//! \name Record and Event Accessors
+//@{
+//! \brief Returns the value of a record in the global record group, or BAD_RECORD if the record does not exist
+HOA_FFI_EXPORT int32 hoa_map_global_record(const char* record_name);
+
+//! \brief Returns the value of a record in the map's local record group, or BAD_RECORD if the record does not exist
+HOA_FFI_EXPORT int32 hoa_map_local_record(const char* record_name);
+
+//! \brief Returns the number of times that a map event has been started
+HOA_FFI_EXPORT uint32 hoa_map_times_event_started(uint32 event_id);
+//@}
+
+//! \name Notification Accessors
+//! \note The returned strings are owned by the notification and are only valid until the end of the current frame
+//@{
+HOA_FFI_EXPORT uint32 hoa_notification_count();
+HOA_FFI_EXPORT const char* hoa_notification_category(uint32 index);
+HOA_FFI_EXPORT const char* hoa_notification_event(uint32 index);
+//@}
+
+} // extern "C"
+
+namespace hoa_map {
+
+/** \brief Declares the map mode C interface to the LuaJIT FFI and stores it in the global "MapFFI"
+*** \param lstack The Lua state to register the interface with
+*** \return True if the interface was registered successfully
+***
+*** This does nothing and returns false unless the game was built against LuaJIT.
+**/
+bool RegisterMapFFI(lua_State* lstack);
+
+} // namespace hoa_map
@@ -13,6 +13,8 @@
 *** \brief   Source file for map mode objects.
 *** ***************************************************************************/
 
+#include <algorithm>
+
 // Allacrost utilities
 #include "utils.h"
 
@@ -60,7 +62,9 @@ MapObject::MapObject() :
 	updatable(true),
 	visible(true),
 	collidable(true),
-	_object_layer_id(DEFAULT_LAYER_ID)
+	_object_layer_id(DEFAULT_LAYER_ID),
+	_previous_x_location(0.0f),
+	_previous_y_location(0.0f)
 {}
 
 
@@ -82,15 +86,17 @@ bool MapObject::ShouldDraw() {
 	float x_pos, y_pos; // Holds the final X, Y coordinates of the camera
 	float x_pixel_length, y_pixel_length; // The X and Y length values that coorespond to a single pixel in the current coodinate system
 	float rounded_x_offset, rounded_y_offset; // The X and Y position offsets of the object, rounded to perfectly align on a pixel boundary
+	float x_location = ComputeDrawXLocation();
+	float y_location = ComputeDrawYLocation();
 
 	// TODO: the call to GetPixelSize() will return the same result every time so long as the coordinate system did not change. If we never
 	// change the coordinate system in map mode, then this should be done only once and the calculated values should be saved for re-use.
 	// However, we've discussed the possiblity of adding a zoom feature to maps, in which case we need to continually re-calculate the pixel size
 	VideoManager->GetPixelSize(x_pixel_length, y_pixel_length);
-	rounded_x_offset = FloorToFloatMultiple(x_offset, x_pixel_length);
-	rounded_y_offset = FloorToFloatMultiple(y_offset, y_pixel_length);
-	x_pos = static_cast<float>(x_position) + rounded_x_offset;
-	y_pos = static_cast<float>(y_position) + rounded_y_offset;
+	rounded_x_offset = FloorToFloatMultiple(GetFloatFraction(x_location), x_pixel_length);
+	rounded_y_offset = FloorToFloatMultiple(GetFloatFraction(y_location), y_pixel_length);
+	x_pos = GetFloatInteger(x_location) + rounded_x_offset;
+	y_pos = GetFloatInteger(y_location) + rounded_y_offset;
 
 	// ---------- Move the drawing cursor to the appropriate coordinates for this sprite
 	VideoManager->Move(x_pos - MapMode::CurrentInstance()->GetMapFrame().screen_edges.left, y_pos - MapMode::CurrentInstance()->GetMapFrame().screen_edges.top);
@@ -99,6 +105,28 @@ bool MapObject::ShouldDraw() {
 
 
 
+float MapObject::ComputeDrawXLocation() const {
+	float current_location = ComputeXLocation();
+	float distance = current_location - _previous_x_location;
+
+	if (distance > MAX_INTERPOLATION_DISTANCE || distance < -MAX_INTERPOLATION_DISTANCE)
+		return current_location;
+	return _previous_x_location + distance * SystemManager->GetInterpolationAlpha();
+}
+
+
+
+float MapObject::ComputeDrawYLocation() const {
+	float current_location = ComputeYLocation();
+	float distance = current_location - _previous_y_location;
+
+	if (distance > MAX_INTERPOLATION_DISTANCE || distance < -MAX_INTERPOLATION_DISTANCE)
+		return current_location;
+	return _previous_y_location + distance * SystemManager->GetInterpolationAlpha();
+}
+
+
+
 void MapObject::CheckPositionOffsets() {
 	while (x_offset < 0.0f) {
 		if (x_position != 0) {
@@ -351,7 +379,11 @@ void ObjectLayer::RemoveObject(MapObject* object) {
 ObjectSupervisor::ObjectSupervisor() :
 	_num_grid_rows(0),
 	_num_grid_cols(0),
-	_last_id(1000)
+	_last_id(1000),
+	_zone_index_invalid(true),
+	_zone_layout_version(0),
+	_zone_camera(nullptr),
+	_zone_player_sprite(nullptr)
 {
 	_object_layers.push_back(ObjectLayer(DEFAULT_LAYER_ID));
 }
@@ -359,6 +391,11 @@ ObjectSupervisor::ObjectSupervisor() :
 
 
 ObjectSupervisor::~ObjectSupervisor() {
+	// Zones must not retain pointers to any of the sprites that are about to be deleted
+	while (_zone_occupants.empty() == false) {
+		_RemoveZoneOccupant(_zone_occupants.begin()->first);
+	}
+
 	// Delete all of the map objects
 	for (map<uint16, MapObject*>::iterator i = _all_objects.begin(); i != _all_objects.end(); ++i) {
 		delete i->second;
@@ -417,28 +454,37 @@ VirtualSprite* ObjectSupervisor::GetSprite(uint32 object_id) {
 
 void ObjectSupervisor::Load(ReadScriptDescriptor& map_file) {
 	// ---------- Construct the collision grid
-	map_file.OpenTable("collision_grid");
-	_num_grid_rows = map_file.GetTableSize();
-	for (uint16 r = 0; r < _num_grid_rows; ++r) {
-		_collision_grid.push_back(vector<uint32>());
-		map_file.ReadUIntVector(r, _collision_grid.back());
-	}
-	map_file.CloseTable();
-	_num_grid_cols = _collision_grid[0].size();
+	vector<uint32> grid_data;
+	uint32 num_rows = 0;
+	uint32 num_cols = 0;
+	if (map_file.ReadUIntGrid("collision_grid", grid_data, num_rows, num_cols) == false) {
+		IF_PRINT_WARNING(MAP_DEBUG) << "failed to read the collision grid from the map file" << endl;
+	}
+
+	_collision_grid.Initialize(grid_data, num_rows, num_cols);
+	_num_grid_rows = _collision_grid.GetNumberRows();
+	_num_grid_cols = _collision_grid.GetNumberColumns();
 }
 
 
 
 void ObjectSupervisor::Update() {
 	for (uint32 i = 0; i < _object_layers.size(); ++i) {
-		_object_layers[i].Update();
+		vector<MapObject*>* objects = _object_layers[i].GetObjects();
+		for (uint32 j = 0; j < objects->size(); ++j) {
+			objects->at(j)->SavePreviousLocation();
+		}
 	}
 
-	for (uint32 i = 0; i < _zones.size(); i++) {
-		_zones[i]->Update();
+	for (uint32 i = 0; i < _object_layers.size(); ++i) {
+		_object_layers[i].Update();
 	}
 
-	// TODO: examine all sprites for movement and context change, then check all resident zones to see if the sprite has entered
+	// Zones that are informed through the zone index are not updated here
+	_UpdateZoneIndex();
+	for (uint32 i = 0; i < _updated_zones.size(); i++) {
+		_updated_zones[i]->Update();
+	}
 }
 
 
@@ -505,6 +551,30 @@ void ObjectSupervisor::MoveObjectToLayer(MapObject* object, uint32 layer_id) {
 
 
 
+void ObjectSupervisor::DeleteObject(MapObject* object) {
+	if (object == nullptr) {
+		IF_PRINT_WARNING(MAP_DEBUG) << "function received nullptr MapObject pointer" << endl;
+		return;
+	}
+
+	map<uint16, MapObject*>::iterator location = _all_objects.find(object->GetObjectID());
+	if (location == _all_objects.end() || location->second != object) {
+		IF_PRINT_WARNING(MAP_DEBUG) << "object was not added to the map, object id: " << object->GetObjectID() << endl;
+		return;
+	}
+
+	MAP_OBJECT_TYPE type = object->GetObjectType();
+	if (type == VIRTUAL_TYPE || type == SPRITE_TYPE || type == ENEMY_TYPE) {
+		_RemoveZoneOccupant(static_cast<VirtualSprite*>(object));
+	}
+
+	_all_objects.erase(location);
+	_object_layers[object->GetObjectLayerID()].RemoveObject(object);
+	delete object;
+}
+
+
+
 void ObjectSupervisor::SortObjectLayers() {
 	for (vector<ObjectLayer>::iterator i = _object_layers.begin(); i != _object_layers.end(); ++i) {
 		i->SortObjects();
@@ -610,17 +680,9 @@ bool ObjectSupervisor::CheckMapCollision(const private_map::MapObject* const obj
 
 	// Determine if the object's collision rectangle overlaps any unwalkable tiles
 	// Note that because the sprite's collision rectangle was previously determined to be within the map bounds,
-	// the map grid tile indeces referenced in this loop are all valid entries and do not need to be checked.
-	for (uint32 r = static_cast<uint32>(coll_rect.top); r <= static_cast<uint32>(coll_rect.bottom); r++) {
-		for (uint32 c = static_cast<uint32>(coll_rect.left); c <= static_cast<uint32>(coll_rect.right); c++) {
-			// Checks the collision grid at the row-column at the object's current context
-			if ((_collision_grid[r][c] & obj->context) != 0) {
-				return true;
-			}
-		}
-	}
-
-	return false;
+	// the map grid tile indeces referenced here are all valid entries and do not need to be checked.
+	return _collision_grid.IsAreaBlocked(obj->context, static_cast<uint16>(coll_rect.top), static_cast<uint16>(coll_rect.bottom),
+		static_cast<uint16>(coll_rect.left), static_cast<uint16>(coll_rect.right));
 }
 
 
@@ -676,39 +738,31 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(VirtualSprite* sprite, MapObjec
 	// ---------- (2) Check if the object's collision rectangle overlaps with any unwalkable elements on the collision grid
 	// Determine if the object's collision rectangle overlaps any unwalkable tiles
 	// Note that because the sprite's collision rectangle was previously determined to be within the map bounds,
-	// the map grid tile indeces referenced in this loop are all valid entries and do not need to be checked for out-of-bounds conditions
-	uint32 left, right, top, bottom;
-	float integer;
-
-	// We need to figure out what range of collision grid coordinates need to be examined. Extract the integer component from each side of the
-	// collision rectangle. These will directly translate into the row and column indeces of the collision grid that we need to check against.
-	modf(coll_rect.left, &integer);
-	left = static_cast<uint32>(integer);
-	modf(coll_rect.right, &integer);
-	right = static_cast<uint32>(integer);
-	modf(coll_rect.top, &integer);
-	top = static_cast<uint32>(integer);
-	modf(coll_rect.bottom, &integer);
-	bottom = static_cast<uint32>(integer);
-
-	for (uint32 r = top; r <= bottom; r++) {
-		for (uint32 c = left; c <= right; c++) {
-			// Checks the collision grid at the row-column at the object's current context
-			if ((_collision_grid[r][c] & sprite->context) != 0) {
-				return GRID_COLLISION;
-			}
+	// the map grid tile indeces referenced here are all valid entries and do not need to be checked for out-of-bounds conditions.
+	// Since all sides of the rectangle are non-negative, truncating each side yields the row and column indeces of the grid to check.
+	if (_collision_grid.IsAreaBlocked(sprite->context, static_cast<uint16>(coll_rect.top), static_cast<uint16>(coll_rect.bottom),
+		static_cast<uint16>(coll_rect.left), static_cast<uint16>(coll_rect.right)) == true)
+	{
+		return GRID_COLLISION;
+	}
+
+	// ---------- (3) Check collision areas for all objects matching the layer and context of the sprite
+	MapObject* obstruction_object = _FindObjectCollision(sprite, coll_rect, ignore_sprites);
+	if (obstruction_object != nullptr) {
+		if (collision_object != nullptr) {
+			*collision_object = obstruction_object;
 		}
+		return OBJECT_COLLISION;
 	}
 
-	// ---------- (3) Determine which set of objects to do collision detection with
-	MapObject* obstruction_object = nullptr;
-	vector<MapObject*>* objects = nullptr; // A pointer to the layer of objects to do the collision detection with
-	// TODO: use the object layer that the sprite belongs to instead of the default layer_id
-	objects = _object_layers[DEFAULT_LAYER_ID].GetObjects();
+	return NO_COLLISION;
+} // bool ObjectSupervisor::DetectCollision(VirtualSprite* sprite, MapObject** collision_object, bool ignore_sprites)
+
 
-	// ---------- (4) Check collision areas for all objects matching the layer and context of the sprite
-	MapRectangle sprite_rect;
-	sprite->GetCollisionRectangle(sprite_rect);
+
+MapObject* ObjectSupervisor::_FindObjectCollision(const VirtualSprite* sprite, const MapRectangle& sprite_rect, bool ignore_sprites) {
+	// TODO: use the object layer that the sprite belongs to instead of the default layer_id
+	vector<MapObject*>* objects = _object_layers[DEFAULT_LAYER_ID].GetObjects();
 
 	for (uint32 i = 0; i < objects->size(); i++) {
 		// Check for conditions where we would not want to do collision detection between the two objects
@@ -722,20 +776,12 @@ COLLISION_TYPE ObjectSupervisor::DetectCollision(VirtualSprite* sprite, MapObjec
 			continue; // Object is a sprite and caller instructed to avoid sprite collisions
 
 		if (CheckObjectCollision(sprite_rect, (*objects)[i]) == true) {
-			obstruction_object = (*objects)[i];
-			break;
+			return (*objects)[i];
 		}
 	}
 
-	if (obstruction_object != nullptr) {
-		if (collision_object != nullptr) {
-			*collision_object = obstruction_object;
-		}
-		return OBJECT_COLLISION;
-	}
-
-	return NO_COLLISION;
-} // bool ObjectSupervisor::DetectCollision(VirtualSprite* sprite, MapObject** collision_object, bool ignore_sprites)
+	return nullptr;
+} // MapObject* ObjectSupervisor::_FindObjectCollision(const VirtualSprite* sprite, const MapRectangle& sprite_rect, bool ignore_sprites)
 
 
 
@@ -874,6 +920,18 @@ bool ObjectSupervisor::FindPath(VirtualSprite* sprite, vector<PathNode>& path, c
 		return false;
 	}
 
+	// Because the sprite's offsets remain constant throughout the search, its collision rectangle always spans the same range of
+	// grid elements relative to the node being examined. Determine that range once here so that the grid can be tested for each
+	// node in constant time by the collision grid's footprint query.
+	const int32 left_delta = static_cast<int32>(floor(x_offset - sprite->coll_half_width));
+	const int32 right_delta = static_cast<int32>(floor(x_offset + sprite->coll_half_width));
+	const int32 top_delta = static_cast<int32>(floor(y_offset - sprite->coll_height));
+	const int32 bottom_delta = static_cast<int32>(floor(y_offset));
+	const uint16 footprint_width = static_cast<uint16>(right_delta - left_delta + 1);
+	const uint16 footprint_height = static_cast<uint16>(bottom_delta - top_delta + 1);
+	// Holds the collision rectangle of the sprite at the node being examined
+	MapRectangle node_rect;
+
 	open_list.push_back(source_node);
 
 	while (open_list.empty() == false) {
@@ -899,12 +957,23 @@ bool ObjectSupervisor::FindPath(VirtualSprite* sprite, vector<PathNode>& path, c
 
 		// Check the eight adjacent nodes
 		for (uint8 i = 0; i < 8; ++i) {
-			// ---------- (A): Check if all tiles are walkable
-			sprite->x_position = nodes[i].col;
-			sprite->y_position = nodes[i].row;
+			// ---------- (A): Check if all tiles are walkable and that no objects other than sprites are in the way
+			if (sprite->collidable == true) {
+				int32 left = nodes[i].col + left_delta;
+				int32 top = nodes[i].row + top_delta;
+				if (left < 0 || top < 0 || nodes[i].col + right_delta >= _num_grid_cols || nodes[i].row + bottom_delta >= _num_grid_rows) {
+					continue;
+				}
+				if (_collision_grid.CanFootprintFit(sprite->context, top, left, footprint_width, footprint_height) == false) {
+					continue;
+				}
 
-			if (DetectCollision(sprite, nullptr, true) != NO_COLLISION) {
-				continue;
+				sprite->x_position = nodes[i].col;
+				sprite->y_position = nodes[i].row;
+				sprite->GetCollisionRectangle(node_rect);
+				if (_FindObjectCollision(sprite, node_rect, true) != nullptr) {
+					continue;
+				}
 			}
 
 			// ---------- (B): Check if the node is already in the closed list
@@ -1004,7 +1073,7 @@ void ObjectSupervisor::DEBUG_DrawCollisionGrid(MAP_CONTEXT context) {
 	for (uint32 r = grid_row_start; r < (grid_row_start + grid_row_count); ++r)	{
 		for (uint32 c = grid_col_start; c < (grid_col_start + grid_col_count); ++c)	{
 			// Draw the colored overlay if the collision grid is invalid at this location
-			if (_collision_grid[r][c] & context) {
+			if (_collision_grid.IsElementBlocked(context, r, c) == true) {
 				VideoManager->DrawRectangle(1.0f, 1.0f, COLLISION_GRID_COLOR);
 			}
 			VideoManager->MoveRelative(1.0f, 0.0f);
@@ -1019,8 +1088,124 @@ void ObjectSupervisor::DEBUG_DrawZoneOutlines(MAP_CONTEXT context) {
 	for (MapZone* zone : _zones) {
 		zone->DEBUG_DrawZoneOutlines(context);
 	}
-	for (MapZone* zone : _resident_zones) {
-		zone->DEBUG_DrawZoneOutlines(context);
+}
+
+
+
+void ObjectSupervisor::_UpdateZoneIndex() {
+	// End the enter and exit states of the zones that had transitions during the previous update
+	for (uint32 i = 0; i < _transitioned_zones.size(); ++i) {
+		_transitioned_zones[i]->_ClearTransitions();
+		_transitioned_zones[i]->_transitions_pending = false;
+	}
+	_transitioned_zones.clear();
+
+	// When the zones change, every sprite is examined again so that it enters or exits any zones that changed around it
+	bool index_rebuilt = false;
+	if (_zone_index_invalid == true || _zone_layout_version != MapZone::GetLayoutVersion()) {
+		_zone_index.Build(_zones, _num_grid_rows, _num_grid_cols);
+		_updated_zones.clear();
+		for (uint32 i = 0; i < _zones.size(); ++i) {
+			if (_zones[i]->UsesZoneIndex() == false)
+				_updated_zones.push_back(_zones[i]);
+		}
+
+		_zone_index_invalid = false;
+		_zone_layout_version = MapZone::GetLayoutVersion();
+		index_rebuilt = true;
+	}
+
+	for (uint32 i = 0; i < _object_layers.size(); ++i) {
+		vector<MapObject*>* objects = _object_layers[i].GetObjects();
+		for (uint32 j = 0; j < objects->size(); ++j) {
+			MAP_OBJECT_TYPE type = objects->at(j)->GetObjectType();
+			if (type == VIRTUAL_TYPE || type == SPRITE_TYPE || type == ENEMY_TYPE) {
+				_UpdateZoneOccupant(static_cast<VirtualSprite*>(objects->at(j)), index_rebuilt);
+			}
+		}
+	}
+
+	// The virtual focus is not held in any object layer, but the camera may point to it
+	MapMode* map = MapMode::CurrentInstance();
+	if (map->GetVirtualFocus() != nullptr) {
+		_UpdateZoneOccupant(map->GetVirtualFocus(), index_rebuilt);
+	}
+
+	// Camera zones only track the sprites that the camera and player sprite point to, so they must all be re-examined when either changes
+	if (map->GetCamera() != _zone_camera || map->GetPlayerSprite() != _zone_player_sprite) {
+		_zone_camera = map->GetCamera();
+		_zone_player_sprite = map->GetPlayerSprite();
+		for (uint32 i = 0; i < _zones.size(); ++i) {
+			CameraZone* zone = dynamic_cast<CameraZone*>(_zones[i]);
+			if (zone != nullptr) {
+				zone->RefreshInside();
+				_AddTransitionedZone(zone);
+			}
+		}
+	}
+
+	for (uint32 i = 0; i < _transitioned_zones.size(); ++i) {
+		_transitioned_zones[i]->_ProcessTransitions();
+	}
+}
+
+
+
+void ObjectSupervisor::_UpdateZoneOccupant(VirtualSprite* sprite, bool force) {
+	ZoneOccupant& occupant = _zone_occupants[sprite];
+	if (force == false && occupant.initialized == true && occupant.x_position == sprite->x_position &&
+		occupant.y_position == sprite->y_position && occupant.context == sprite->GetContext())
+	{
+		return;
+	}
+
+	occupant.x_position = sprite->x_position;
+	occupant.y_position = sprite->y_position;
+	occupant.context = sprite->GetContext();
+	occupant.initialized = true;
+
+	// Only the zones that are active in the sprite's context are occupied by it
+	_zone_index.FindZones(sprite->x_position, sprite->y_position, _zone_search_results);
+	uint32 active_count = 0;
+	for (uint32 i = 0; i < _zone_search_results.size(); ++i) {
+		if (_zone_search_results[i]->GetActiveContexts() & occupant.context)
+			_zone_search_results[active_count++] = _zone_search_results[i];
+	}
+	_zone_search_results.resize(active_count);
+
+	for (uint32 i = 0; i < occupant.zones.size(); ++i) {
+		if (find(_zone_search_results.begin(), _zone_search_results.end(), occupant.zones[i]) == _zone_search_results.end()) {
+			occupant.zones[i]->_SpriteExited(sprite);
+			_AddTransitionedZone(occupant.zones[i]);
+		}
+	}
+	for (uint32 i = 0; i < _zone_search_results.size(); ++i) {
+		if (find(occupant.zones.begin(), occupant.zones.end(), _zone_search_results[i]) == occupant.zones.end()) {
+			_zone_search_results[i]->_SpriteEntered(sprite);
+			_AddTransitionedZone(_zone_search_results[i]);
+		}
+	}
+
+	occupant.zones.swap(_zone_search_results);
+}
+
+
+
+void ObjectSupervisor::_RemoveZoneOccupant(VirtualSprite* sprite) {
+	// Every zone is examined because zones that do not use the zone index may also retain the sprite
+	for (uint32 i = 0; i < _zones.size(); ++i) {
+		_zones[i]->_SpriteRemoved(sprite);
+	}
+
+	_zone_occupants.erase(sprite);
+}
+
+
+
+void ObjectSupervisor::_AddTransitionedZone(MapZone* zone) {
+	if (zone->_transitions_pending == false) {
+		zone->_transitions_pending = true;
+		_transitioned_zones.push_back(zone);
 	}
 }
 
@@ -1218,13 +1403,13 @@ bool ObjectSupervisor::_MoveSpriteAroundCollisionCorner(VirtualSprite* sprite, C
 	vector<bool> grid_line(end_point - start_point);
 
 	if (horizontal_adjustment == true) {
-		for (uint16 i = start_point, j = 0; i <= end_point && i < _collision_grid[line_axis].size(); i++, j++) {
-			grid_line[j] = (_collision_grid[line_axis][i] & sprite->context);
+		for (uint16 i = start_point, j = 0; i <= end_point && i < _num_grid_cols; i++, j++) {
+			grid_line[j] = _collision_grid.IsElementBlocked(sprite->context, line_axis, i);
 		}
 	}
 	else {
-		for (uint16 i = start_point, j = 0; i <= end_point && i < _collision_grid.size(); i++, j++) {
-			grid_line[j] = (_collision_grid[i][line_axis] & sprite->context);
+		for (uint16 i = start_point, j = 0; i <= end_point && i < _num_grid_rows; i++, j++) {
+			grid_line[j] = _collision_grid.IsElementBlocked(sprite->context, i, line_axis);
 		}
 	}
 
@@ -1401,25 +1586,15 @@ bool ObjectSupervisor::_MoveSpriteAroundCollisionDiagonal(VirtualSprite* sprite,
 		}
 	}
 	else if (coll_type == GRID_COLLISION) {
-		uint32 axis;
+		uint16 axis;
 
-		check_vertical_align = false;
-		axis = (north_or_south == true) ? static_cast<uint32>(mod_sprite_rect.top) : static_cast<uint32>(mod_sprite_rect.bottom);
-		for (uint32 i = static_cast<uint32>(sprite_coll_rect.left); i <= static_cast<uint32>(sprite_coll_rect.right); i++) {
-			if (_collision_grid[axis][i] & sprite->context) {
-				check_vertical_align = true;
-				break;
-			}
-		}
+		axis = (north_or_south == true) ? static_cast<uint16>(mod_sprite_rect.top) : static_cast<uint16>(mod_sprite_rect.bottom);
+		check_vertical_align = _collision_grid.IsAreaBlocked(sprite->context, axis, axis,
+			static_cast<uint16>(sprite_coll_rect.left), static_cast<uint16>(sprite_coll_rect.right));
 
-		check_horizontal_align = false;
-		axis = (east_or_west == true) ? static_cast<uint32>(mod_sprite_rect.right) : static_cast<uint32>(mod_sprite_rect.left);
-		for (uint32 i = static_cast<uint32>(sprite_coll_rect.top); i <= static_cast<uint32>(sprite_coll_rect.bottom); i++) {
-			if (_collision_grid[i][axis] & sprite->context) {
-				check_horizontal_align = true;
-				break;
-			}
-		}
+		axis = (east_or_west == true) ? static_cast<uint16>(mod_sprite_rect.right) : static_cast<uint16>(mod_sprite_rect.left);
+		check_horizontal_align = _collision_grid.IsAreaBlocked(sprite->context, static_cast<uint16>(sprite_coll_rect.top),
+			static_cast<uint16>(sprite_coll_rect.bottom), axis, axis);
 	}
 	else if (coll_type == OBJECT_COLLISION) {
 		if (north_or_south == true) {
@@ -24,6 +24,7 @@
 
 // Local map mode headers
 #include "map_utils.h"
+#include "map_zones.h"
 #include <boost/concept_check.hpp>
 
 namespace hoa_map {
@@ -181,6 +182,26 @@ public:
 		{ return (static_cast<float>(y_position) + y_offset); }
 	//@}
 
+	/** \brief Retains the object's current location as the location it had at the start of the simulation step
+	*** \note Should be called only by ObjectSupervisor class, before any objects are updated
+	**/
+	void SavePreviousLocation()
+		{ _previous_x_location = ComputeXLocation(); _previous_y_location = ComputeYLocation(); }
+
+	/** \brief Computes the location that the object should be drawn at for the current frame
+	*** \return The full x or y coordinate location to draw the object at
+	***
+	*** The game is updated in fixed simulation steps that do not line up with the frames being drawn. These methods
+	*** interpolate between the location the object had before the latest step and its current location, using how
+	*** far the frame lies between that step and the next one. Objects that moved further than MAX_INTERPOLATION_DISTANCE
+	*** in a single step were placed rather than moved there, so they are drawn at their current location instead.
+	**/
+	//@{
+	float ComputeDrawXLocation() const;
+
+	float ComputeDrawYLocation() const;
+	//@}
+
 	/** \brief Modifies the object's position by adding or subtracting numbers from the coordinates
 	*** \param x The amount to move the x position by. Negative moves left, positive moves right
 	*** \param x_offset The amount to modify the x offset by (seldom used, so pass 0 here)
@@ -319,6 +340,11 @@ protected:
 	//! \brief The ID of the object layer that this object exists on
 	uint32 _object_layer_id;
 
+	//! \brief The full x and y coordinate location of the object at the start of the latest simulation step
+	//@{
+	float _previous_x_location, _previous_y_location;
+	//@}
+
 	/** \brief Draws a translucent colored area representing the object's collision rectangle
 	***
 	*** This is only used for debugging to make it easier to visualize things like pathing issues or
@@ -519,6 +545,17 @@ public:
 	**/
 	MapObject* GetObjectByIndex(uint32 index);
 
+	//! \brief Returns the number of zones stored by the supervisor
+	uint32 GetNumberZones() const
+		{ return _zones.size(); }
+
+	/** \brief Retrieves a zone by its position in the _zones container
+	*** \param index The index of the zone to retrieve, which is the value returned by MapMode::AddZone() for the zone
+	*** \return A pointer to the zone at this index, or nullptr if no zone exists at the given index
+	**/
+	MapZone* GetZoneByIndex(uint32 index)
+		{ return (index < _zones.size()) ? _zones[index] : nullptr; }
+
 	/** \brief Retrieves a pointer to an object on this map
 	*** \param object_id The id number of the object to retreive
 	*** \return A pointer to the map object, or nullptr if no object with that ID was found
@@ -547,7 +584,11 @@ public:
 	**/
 	void Load(hoa_script::ReadScriptDescriptor& map_file);
 
-	//! \brief Updates the state of all map zones and objects across all layers
+	/** \brief Updates the state of all map zones and objects across all layers
+	*** Before any object is updated, the location of every object is saved so that objects may be drawn in between
+	*** their locations from this simulation step and the previous one. Zones that use the zone index are only
+	*** informed of sprites that moved to a different grid cell or context during the update.
+	**/
 	void Update();
 
 	/** \brief Draws an object layer to the screen
@@ -592,6 +633,14 @@ public:
 	**/
 	void MoveObjectToLayer(MapObject* object, uint32 layer_id);
 
+	/** \brief Removes an object from the map and deletes it
+	*** \param object A pointer to the object to delete, which must have been added to the map previously
+	***
+	*** Any zones that the object resided in forget about it, so a sprite that is deleted while inside a
+	*** zone does not trigger an exit transition for that zone.
+	**/
+	void DeleteObject(MapObject* object);
+
 	//! \brief Sorts the objects in each object layer
 	void SortObjectLayers();
 
@@ -719,6 +768,10 @@ public:
 	**/
 	void DEBUG_DrawZoneOutlines(MAP_CONTEXT context);
 
+	//! \brief Returns a reference to the map's collision grid
+	const CollisionGrid& GetCollisionGrid() const
+		{ return _collision_grid; }
+
 private:
 	/** \brief The number of rows and columns in the collision gride
 	*** The number of collision grid rows and columns is always equal to twice
@@ -729,11 +782,11 @@ private:
 	//! \brief Holds the most recently generated object ID number
 	uint16 _last_id;
 
-	/** \brief A 2D vector indicating which grid element on the map sprites may be occupied by objects.
-	*** Each bit of each element in this grid corresponds to a context. So all together this entire grid
-	*** stores the collision information for all 32 possible map contexts.
+	/** \brief Indicates which grid elements on the map may be occupied by objects in each context.
+	*** The grid data stored in the map file has one bit per context in each element. The collision grid
+	*** transposes that data into a bit-packed plane for each of the 32 possible map contexts.
 	**/
-	std::vector<std::vector<uint32> > _collision_grid;
+	CollisionGrid _collision_grid;
 
 	/** \brief A map containing pointers to all of the objects on a map.
 	*** The sprite's unique identifier integer is used as the map key.
@@ -747,16 +800,59 @@ private:
 	//! \brief Container for all zones used in this map
 	std::vector<MapZone*> _zones;
 
-	/** \brief Container for all resident zones used in this map
-	***
-	*** Resident zones (and classes derived from resident zones) are stored in an additional container because
-	*** they need to continually check whether sprites have entered them. This is done in the Update() function
-	*** of this class.
-	**/
-	std::vector<ResidentZone*> _resident_zones;
+	//! \brief The zones which do not use the zone index and must be updated on every frame
+	std::vector<MapZone*> _updated_zones;
+
+	//! \brief A lookup of the indexed zones that cover each cell of the collision grid
+	ZoneIndex _zone_index;
+
+	//! \brief Set when a zone is added so that the zone index is rebuilt on the next update
+	bool _zone_index_invalid;
+
+	//! \brief The value of MapZone::GetLayoutVersion() when the zone index was last built
+	uint32 _zone_layout_version;
+
+	//! \brief The last examined location and the occupied zones of every sprite on the map
+	std::map<VirtualSprite*, ZoneOccupant> _zone_occupants;
+
+	//! \brief The zones that had a sprite enter or exit them during the current update
+	std::vector<MapZone*> _transitioned_zones;
+
+	//! \brief The sprites that the camera and player sprite pointed to when zones were last updated
+	VirtualSprite *_zone_camera, *_zone_player_sprite;
+
+	//! \brief Holds the zones found in the index for a sprite so that the container is not reallocated for every sprite
+	std::vector<MapZone*> _zone_search_results;
 
 	// ---------- Methods
 
+	//! \brief Rebuilds the zone index if necessary and informs zones of any sprites that entered or exited them
+	void _UpdateZoneIndex();
+
+	/** \brief Determines which indexed zones a sprite entered or exited since it was last examined
+	*** \param sprite The sprite to examine
+	*** \param force If true, the zones are determined even when the sprite has not changed its cell or context
+	**/
+	void _UpdateZoneOccupant(VirtualSprite* sprite, bool force);
+
+	/** \brief Removes every record of a sprite from the zone occupants and from all zones
+	*** \param sprite The sprite to remove, which may be about to be deleted
+	**/
+	void _RemoveZoneOccupant(VirtualSprite* sprite);
+
+	//! \brief Adds a zone to the list of zones with transitions to process during this update, if it is not in it already
+	void _AddTransitionedZone(MapZone* zone);
+
+	/** \brief Finds the first object that a sprite's collision rectangle overlaps with
+	*** \param sprite A pointer to the map sprite to check
+	*** \param sprite_rect The collision rectangle of the sprite
+	*** \param ignore_sprites If true, collisions with any type of sprite object will be disregarded
+	*** \return A pointer to the obstructing object, or nullptr if no object obstructs the sprite
+	***
+	*** Only objects in the same layer and context as the sprite that have their collidable property enabled are considered.
+	**/
+	MapObject* _FindObjectCollision(const VirtualSprite* sprite, const MapRectangle& sprite_rect, bool ignore_sprites);
+
 	/** \brief Attempts to align a sprite's collision rectangle alongside whatever the sprite has collided against
 	*** \param sprite The sprite to examine for positional alignment
 	*** \param direction The direction in which the alignment should take place (only NORTH, SOUTH, EAST, and WEST are valid values)
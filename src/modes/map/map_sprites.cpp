@@ -119,8 +119,7 @@ void VirtualSprite::Update() {
 		CheckPositionOffsets();
 	}
 	else {
-		MapCollisionNotificationEvent* event = new MapCollisionNotificationEvent(collision_type, this, collision_object);
-		NotificationManager->Notify(event);
+		NotificationManager->CreateNotification<MapCollisionNotificationEvent>(collision_type, this, collision_object);
 
 		// Restore the sprite's position. The _ResolveCollision() call that follows may find an alternative
 		// position to move the sprite to.
@@ -231,8 +230,7 @@ bool VirtualSprite::ModifySpritePosition(uint16 direction, float distance, bool
 	if (collision_type != NO_COLLISION) {
 		// Generate a notification that the collision occurred while the sprite is still in it's collision position
 		if (disable_collision_notification == false) {
-			MapCollisionNotificationEvent* event = new MapCollisionNotificationEvent(GRID_COLLISION, this, collision_object);
-			NotificationManager->Notify(event);
+			MapCollisionNotificationEvent* event = NotificationManager->CreateNotification<MapCollisionNotificationEvent>(GRID_COLLISION, this, collision_object);
 			cout << event->DEBUG_PrintInfo() << endl;
 		}
 
@@ -370,6 +368,12 @@ void VirtualSprite::_ResolveCollision(COLLISION_TYPE coll_type, MapObject* coll_
 
 			BattleMode *BM = new BattleMode();
 
+			// Use the data that the enemy's zone preloaded, loading anything that it has not yet finished loading
+			if (enemy->GetZone() != nullptr && enemy->GetZone()->GetBattlePreload() != nullptr) {
+				enemy->GetZone()->GetBattlePreload()->LoadAll();
+				BM->GetMedia().SetPreload(enemy->GetZone()->GetBattlePreload());
+			}
+
 			string battle_background = enemy->GetBattleBackgroundFile();
 			if (battle_background != "")
 				BM->GetMedia().SetBackgroundImage(battle_background);
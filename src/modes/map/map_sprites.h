@@ -519,6 +519,10 @@ public:
 	//! \brief Returns a reference to a random battle party of enemies
 	const std::vector<uint32>& RetrieveRandomParty();
 
+	//! \brief Returns a reference to every battle party that the sprite may summon
+	const std::vector<std::vector<uint32> >& GetEnemyParties() const
+		{ return _enemy_parties; }
+
 	//! \brief Returns true if the sprite has at least one party
 	bool HasEnemyParties() const
 		{ return !_enemy_parties.empty(); }
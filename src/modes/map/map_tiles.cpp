@@ -180,13 +180,15 @@ void TileSupervisor::Load(ReadScriptDescriptor& map_file) {
 	}
 
 	// Now read in all of the tile data and write it to the correct location in the _tile_grid
-	vector<int32> tile_data;
+	vector<int32> tile_data(map_context_count * tile_layer_count);
 	map_file.OpenTable("map_tiles");
 	for (uint32 y = 0; y < _row_count; ++y) {
 		map_file.OpenTable(y);
 		for (uint32 x = 0; x < _column_count; ++x) {
-			tile_data.clear();
-			map_file.ReadIntVector(x, tile_data);
+			if (map_file.ReadIntArray(x, &tile_data[0], tile_data.size()) != tile_data.size()) {
+				PRINT_ERROR << "map tile data at (" << x << ", " << y << ") did not contain an entry for every layer of every context" << endl;
+				exit(1);
+			}
 			for (uint32 c = 0; c < map_context_count; ++c) {
 				MAP_CONTEXT context = map_contexts[c];
 				for (uint32 l = 0, data_index = c * tile_layer_count; l < tile_layer_count; ++l, ++data_index) {
@@ -507,7 +507,7 @@ void TreasureSupervisor::Update() {
 
 	// Allow the user to go to menu mode at any time when the treasure menu is open
 	if (InputManager->MenuPress()) {
-		MenuMode *MM = new MenuMode();
+		MenuMode *MM = MenuMode::Create();
 		ModeManager->Push(MM);
 		return;
 	}
@@ -37,6 +37,10 @@ bool MAP_DEBUG = false;
 
 namespace private_map {
 
+const uint32 MAP_NOTIFICATION_CATEGORY = hoa_notification::InternNotificationName("map");
+const uint32 MAP_COLLISION_NOTIFICATION = hoa_notification::InternNotificationName("collision");
+const uint32 MAP_CAMERA_ZONE_NOTIFICATION = hoa_notification::InternNotificationName("camera-zone");
+
 uint16 CalculateOppositeDirection(const uint16 direction) {
 	switch (direction) {
 		case NORTH:      return SOUTH;
@@ -125,6 +129,151 @@ bool MapRectangle::CheckIntersection(const MapRectangle& first, const MapRectang
 		return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// CollisionGrid Class Functions
+///////////////////////////////////////////////////////////////////////////////
+
+CollisionGrid::CollisionGrid() :
+	_num_rows(0),
+	_num_cols(0),
+	_words_per_row(0)
+{}
+
+
+
+void CollisionGrid::Initialize(const vector<uint32>& grid, uint16 num_rows, uint16 num_cols) {
+	Clear();
+	if (num_rows == 0 || num_cols == 0) {
+		IF_PRINT_WARNING(MAP_DEBUG) << "collision grid data was empty" << endl;
+		return;
+	}
+	if (grid.size() != static_cast<uint32>(num_rows) * num_cols) {
+		IF_PRINT_WARNING(MAP_DEBUG) << "collision grid data had " << grid.size() << " elements instead of " << (num_rows * num_cols) << endl;
+		return;
+	}
+
+	_num_rows = num_rows;
+	_num_cols = num_cols;
+	_words_per_row = (_num_cols + 31) / 32;
+	_planes.assign(NUMBER_CONTEXTS * _num_rows * _words_per_row, 0);
+
+	for (uint16 r = 0; r < _num_rows; ++r) {
+		const uint32* row_data = &grid[r * _num_cols];
+		for (uint16 c = 0; c < _num_cols; ++c) {
+			uint32 element = row_data[c];
+			for (uint32 i = 0; element != 0; ++i, element >>= 1) {
+				if (element & 0x1) {
+					_planes[(i * _num_rows + r) * _words_per_row + (c >> 5)] |= (0x1u << (c & 31));
+				}
+			}
+		}
+	}
+}
+
+
+
+void CollisionGrid::Clear() {
+	_num_rows = 0;
+	_num_cols = 0;
+	_words_per_row = 0;
+	_planes.clear();
+	for (uint32 i = 0; i < NUMBER_CONTEXTS; ++i) {
+		_area_tables[i].clear();
+	}
+}
+
+
+
+bool CollisionGrid::IsElementBlocked(uint32 context, uint16 row, uint16 col) const {
+	for (uint32 i = 0; context != 0; ++i, context >>= 1) {
+		if ((context & 0x1) && (_GetPlaneRow(i, row)[col >> 5] & (0x1u << (col & 31)))) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
+bool CollisionGrid::IsAreaBlocked(uint32 context, uint16 top, uint16 bottom, uint16 left, uint16 right) const {
+	for (uint32 i = 0; context != 0; ++i, context >>= 1) {
+		if ((context & 0x1) == 0)
+			continue;
+
+		for (uint16 r = top; r <= bottom; ++r) {
+			if (_IsRowSpanBlocked(_GetPlaneRow(i, r), left, right) == true) {
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+
+
+bool CollisionGrid::CanFootprintFit(uint32 context, uint16 top, uint16 left, uint16 width, uint16 height) const {
+	const uint32 stride = _num_cols + 1;
+	const uint32 bottom = top + height;
+	const uint32 right = left + width;
+
+	for (uint32 i = 0; context != 0; ++i, context >>= 1) {
+		if ((context & 0x1) == 0)
+			continue;
+
+		if (_area_tables[i].empty() == true) {
+			_BuildAreaTable(i);
+		}
+
+		const vector<uint32>& table = _area_tables[i];
+		uint32 blocked = table[bottom * stride + right] - table[top * stride + right]
+			- table[bottom * stride + left] + table[top * stride + left];
+		if (blocked != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
+bool CollisionGrid::_IsRowSpanBlocked(const uint32* row_data, uint16 left, uint16 right) const {
+	const uint32 first_word = left >> 5;
+	const uint32 last_word = right >> 5;
+	const uint32 first_mask = 0xFFFFFFFFu << (left & 31);
+	const uint32 last_mask = 0xFFFFFFFFu >> (31 - (right & 31));
+
+	if (first_word == last_word) {
+		return (row_data[first_word] & first_mask & last_mask) != 0;
+	}
+
+	if ((row_data[first_word] & first_mask) != 0) {
+		return true;
+	}
+	for (uint32 w = first_word + 1; w < last_word; ++w) {
+		if (row_data[w] != 0) {
+			return true;
+		}
+	}
+	return (row_data[last_word] & last_mask) != 0;
+}
+
+
+
+void CollisionGrid::_BuildAreaTable(uint32 context_index) const {
+	const uint32 stride = _num_cols + 1;
+	vector<uint32>& table = _area_tables[context_index];
+	table.assign(stride * (_num_rows + 1), 0);
+
+	for (uint16 r = 0; r < _num_rows; ++r) {
+		const uint32* row_data = _GetPlaneRow(context_index, r);
+		uint32 row_sum = 0;
+		for (uint16 c = 0; c < _num_cols; ++c) {
+			row_sum += (row_data[c >> 5] >> (c & 31)) & 0x1;
+			table[(r + 1) * stride + (c + 1)] = table[r * stride + (c + 1)] + row_sum;
+		}
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // MapRecordData Class Functions
 ///////////////////////////////////////////////////////////////////////////////
@@ -191,7 +340,7 @@ bool MapEventData::ValidateEvents() const {
 ///////////////////////////////////////////////////////////////////////////////
 
 const string MapCollisionNotificationEvent::DEBUG_PrintInfo() {
-	string line = "MapCollisionNotificationEvent::" + category + "/" + event + " -";
+	string line = "MapCollisionNotificationEvent::" + GetCategory() + "/" + GetEvent() + " -";
 	line += " Sprite-ID:" + NumberToString(sprite->GetObjectID());
 
 	ostringstream stream;
@@ -242,7 +391,7 @@ void MapCollisionNotificationEvent::_CopySpritePosition() {
 ///////////////////////////////////////////////////////////////////////////////
 
 const string CameraZoneNotificationEvent::DEBUG_PrintInfo() {
-	string line = "CameraZoneNotificationEvent::" + category + "/" + event;
+	string line = "CameraZoneNotificationEvent::" + GetCategory() + "/" + GetEvent();
 	return line;
 }
 
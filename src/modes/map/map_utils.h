@@ -193,6 +193,12 @@ const float FAST_SPEED       = 110.0f;
 const float VERY_FAST_SPEED  = 75.0f;
 //@}
 
+/** \brief The furthest distance, in map grid units, that an object may move in one simulation step and still be drawn interpolated
+*** Even the fastest sprites move only a fraction of a grid unit in a single step. An object that moves further than
+*** this was placed at its new location (for example, by a map event), and drawing it in between would show it sliding there.
+**/
+const float MAX_INTERPOLATION_DISTANCE = 1.0f;
+
 
 /** \name Sprite Direction Constants
 *** \brief Constants used for determining sprite directions
@@ -318,6 +324,15 @@ const uint32 DEFAULT_LAYER_ID = 0;
 //! \brief The default time to wait before enemies spawn on a map
 const uint32 DEFAULT_ENEMY_SPAWN_TIME = 30000;
 
+/** \brief The distances, in collision grid elements, at which an enemy zone preloads and releases its battle data
+*** The release distance is larger so that a player walking along the edge of the neighborhood does not cause the
+*** data to be repeatedly loaded and released.
+**/
+//@{
+const uint16 ENEMY_ZONE_PRELOAD_DISTANCE = 32;
+const uint16 ENEMY_ZONE_RELEASE_DISTANCE = 48;
+//@}
+
 //! \brief Sprite ID for when dialogue has no speaker
 const uint32 NO_SPRITE = 0;
 
@@ -481,6 +496,112 @@ public:
 }; // class PathNode
 
 
+/** ****************************************************************************
+*** \brief A bit-packed representation of the map's collision grid
+***
+*** The map file stores the collision grid as a table of integers where each bit of an element corresponds
+*** to one of the 32 possible map contexts. That layout is convenient for the map editor but poor for collision
+*** detection, since testing a rectangular area requires visiting every element in it. This class transposes that
+*** data into one contiguous bit plane per context, where each row of the grid is packed into 32-bit words. Testing
+*** whether a rectangle is walkable then only requires a couple of AND operations per row of the rectangle.
+***
+*** In addition to the bit planes, this class can construct a summed-area table of unwalkable elements for any
+*** context. These tables are built lazily the first time they are needed and answer the question "can a footprint
+*** of size WxH be placed here" in constant time, regardless of the size of the footprint. They are primarily used
+*** by path finding, which tests the same footprint at many different grid locations.
+***
+*** \note None of the methods in this class perform bounds checking on their row and column arguments for
+*** performance reasons. The caller is responsible for ensuring that all coordinates are within the grid.
+*** ***************************************************************************/
+class CollisionGrid {
+public:
+	CollisionGrid();
+
+	/** \brief Constructs the bit planes from the collision grid data read in from the map file
+	*** \param grid The collision grid data in row-major order, where each bit in each element corresponds to a map context
+	*** \param num_rows The number of rows in the grid
+	*** \param num_cols The number of columns in the grid
+	**/
+	void Initialize(const std::vector<uint32>& grid, uint16 num_rows, uint16 num_cols);
+
+	//! \brief Removes all grid data and any constructed area tables
+	void Clear();
+
+	/** \brief Determines if a single grid element is unwalkable
+	*** \param context The context(s) to check the element in
+	*** \param row The grid row of the element
+	*** \param col The grid column of the element
+	*** \return True if the element is unwalkable in any of the specified contexts
+	**/
+	bool IsElementBlocked(uint32 context, uint16 row, uint16 col) const;
+
+	/** \brief Determines if any grid element in a rectangular area is unwalkable
+	*** \param context The context(s) to check the area in
+	*** \param top The first row of the area
+	*** \param bottom The last row of the area (inclusive)
+	*** \param left The first column of the area
+	*** \param right The last column of the area (inclusive)
+	*** \return True if any element in the area is unwalkable in any of the specified contexts
+	**/
+	bool IsAreaBlocked(uint32 context, uint16 top, uint16 bottom, uint16 left, uint16 right) const;
+
+	/** \brief Determines if a footprint may be placed on the grid in constant time
+	*** \param context The context(s) to check the footprint in
+	*** \param top The row where the top edge of the footprint lies
+	*** \param left The column where the left edge of the footprint lies
+	*** \param width The number of columns that the footprint spans
+	*** \param height The number of rows that the footprint spans
+	*** \return True if every grid element covered by the footprint is walkable
+	***
+	*** The result of this call is identical to negating IsAreaBlocked(). The difference is that this function uses
+	*** the summed-area table of each context, so it costs the same for any footprint size. The first call made for
+	*** a context will construct the table for that context.
+	**/
+	bool CanFootprintFit(uint32 context, uint16 top, uint16 left, uint16 width, uint16 height) const;
+
+	//! \brief Class member accessor functions
+	//@{
+	uint16 GetNumberRows() const
+		{ return _num_rows; }
+
+	uint16 GetNumberColumns() const
+		{ return _num_cols; }
+	//@}
+
+private:
+	//! \brief The number of contexts (and thus bit planes) that the grid supports
+	static const uint32 NUMBER_CONTEXTS = 32;
+
+	//! \brief The dimensions of the grid
+	uint16 _num_rows, _num_cols;
+
+	//! \brief The number of 32-bit words required to store a single row of one bit plane
+	uint32 _words_per_row;
+
+	/** \brief Contains the bit planes for all contexts in a single contiguous block
+	*** The plane for context index i begins at (i * _num_rows * _words_per_row). Bit (c % 32) of word
+	*** (c / 32) in a row is set when column c of that row is unwalkable.
+	**/
+	std::vector<uint32> _planes;
+
+	/** \brief Summed-area tables of unwalkable elements, one for each context
+	*** Each table has (_num_rows + 1) * (_num_cols + 1) entries. The entry at (r, c) holds the number of unwalkable
+	*** elements in the area spanning rows [0, r) and columns [0, c). A table is empty until it is first required.
+	**/
+	mutable std::vector<uint32> _area_tables[NUMBER_CONTEXTS];
+
+	//! \brief Returns a pointer to the first word of a row in the bit plane for a context index
+	const uint32* _GetPlaneRow(uint32 context_index, uint16 row) const
+		{ return &_planes[(context_index * _num_rows + row) * _words_per_row]; }
+
+	//! \brief Returns true if any bit from column left to column right (inclusive) is set in a bit plane row
+	bool _IsRowSpanBlocked(const uint32* row_data, uint16 left, uint16 right) const;
+
+	//! \brief Constructs the summed-area table for a context index
+	void _BuildAreaTable(uint32 context_index) const;
+}; // class CollisionGrid
+
+
 /** ****************************************************************************
 *** \brief A simple class used for holding data to be set into either the global or local map records
 ***
@@ -566,6 +687,14 @@ private:
 }; // class MapEventData
 
 
+//! \name Map Notification IDs
+//! \brief The interned names of the category and events of all notifications that map mode generates
+//@{
+extern const uint32 MAP_NOTIFICATION_CATEGORY;
+extern const uint32 MAP_COLLISION_NOTIFICATION;
+extern const uint32 MAP_CAMERA_ZONE_NOTIFICATION;
+//@}
+
 /** ****************************************************************************
 *** \brief A notification event class describing sprite collisions
 ***
@@ -586,7 +715,7 @@ public:
 	*** \note You should \b not use this constructor for object-type collisions
 	**/
 	MapCollisionNotificationEvent(COLLISION_TYPE type, VirtualSprite* sprite) :
-		NotificationEvent("map", "collision"), collision_type(type), sprite(sprite), object(nullptr) { _CopySpritePosition(); }
+		NotificationEvent(MAP_NOTIFICATION_CATEGORY, MAP_COLLISION_NOTIFICATION), collision_type(type), sprite(sprite), object(nullptr) { _CopySpritePosition(); }
 
 	/** \param type The type of collision that occurred (should be COLLISION_OBJECT)
 	*** \param sprite The sprite that had the collision
@@ -594,7 +723,7 @@ public:
 	*** \note You should \b only use this constructor for object-type collisions
 	**/
 	MapCollisionNotificationEvent(COLLISION_TYPE type, VirtualSprite* sprite, MapObject* object) :
-		NotificationEvent("map", "collision"), collision_type(type), sprite(sprite), object(object) { _CopySpritePosition(); }
+		NotificationEvent(MAP_NOTIFICATION_CATEGORY, MAP_COLLISION_NOTIFICATION), collision_type(type), sprite(sprite), object(object) { _CopySpritePosition(); }
 
 	//! \brief Returns a string representation of the collision data stored in this object
 	const std::string DEBUG_PrintInfo();
@@ -634,7 +763,7 @@ public:
 	*** \note You should \b not use this constructor for object-type collisions
 	**/
 	CameraZoneNotificationEvent(CameraZone* zone) :
-		NotificationEvent("map", "camera-zone"), zone(zone) { }
+		NotificationEvent(MAP_NOTIFICATION_CATEGORY, MAP_CAMERA_ZONE_NOTIFICATION), zone(zone) { }
 
 	//! \brief Returns a string representation of the collision data stored in this object
 	const std::string DEBUG_PrintInfo();
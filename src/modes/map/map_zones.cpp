@@ -13,6 +13,8 @@
 *** \brief   Source file for map mode zones.
 *** ***************************************************************************/
 
+#include <algorithm>
+
 // Allacrost engines
 #include "notification.h"
 #include "video.h"
@@ -24,10 +26,15 @@
 #include "map_transition.h"
 #include "map_zones.h"
 
+// Other game mode headers
+#include "battle.h"
+
 using namespace std;
 using namespace hoa_utils;
 
+using namespace hoa_battle;
 using namespace hoa_notification;
+using namespace hoa_script;
 using namespace hoa_video;
 
 namespace hoa_map {
@@ -40,6 +47,8 @@ namespace private_map {
 
 const Color MapZone::ZONE_OUTLINE_COLOR = Color(0.0f, 0.0f, 1.0f, 0.33f);
 
+uint32 MapZone::_layout_version = 0;
+
 
 
 MapZone::MapZone(uint16 left_col, uint16 right_col, uint16 top_row, uint16 bottom_row) :
@@ -70,6 +79,7 @@ void MapZone::AddSection(uint16 left_col, uint16 right_col, uint16 top_row, uint
 	}
 
 	_sections.push_back(ZoneSection(left_col, right_col, top_row, bottom_row));
+	++_layout_version;
 }
 
 
@@ -88,6 +98,19 @@ bool MapZone::IsInsideZone(uint16 pos_x, uint16 pos_y) const {
 
 
 
+bool MapZone::IsNearZone(uint16 pos_x, uint16 pos_y, uint16 distance) const {
+	for (vector<ZoneSection>::const_iterator i = _sections.begin(); i != _sections.end(); ++i) {
+		if (pos_x + distance >= i->left_col && pos_x <= i->right_col + distance &&
+			pos_y + distance >= i->top_row && pos_y <= i->bottom_row + distance)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+
+
 void MapZone::_RandomPosition(uint16& x, uint16& y) {
 	// Select a random ZoneSection
 	uint16 i = RandomBoundedInteger(0, _sections.size() - 1);
@@ -171,38 +194,75 @@ CameraZone::CameraZone(uint16 left_col, uint16 right_col, uint16 top_row, uint16
 
 
 
-void CameraZone::Update() {
-	_was_camera_inside = _camera_inside;
-	_was_player_sprite_inside = _player_sprite_inside;
+void CameraZone::RefreshInside() {
+	_camera_inside = _IsSpriteInside(MapMode::CurrentInstance()->GetCamera());
+	_player_sprite_inside = _IsSpriteInside(MapMode::CurrentInstance()->GetPlayerSprite());
+}
 
-	VirtualSprite* camera = MapMode::CurrentInstance()->GetCamera();
-	if (camera == nullptr) {
-		_camera_inside = false;
+
+
+bool CameraZone::_IsSpriteInside(const VirtualSprite* sprite) const {
+	// The sprite must share a context with the zone and be within its borders
+	if (sprite == nullptr)
+		return false;
+
+	return ((_active_contexts & sprite->GetContext()) && (IsInsideZone(sprite->x_position, sprite->y_position) == true));
+}
+
+
+
+void CameraZone::_CallTransitionFunction(const ScriptObject& function) {
+	if (function.is_valid() == false)
+		return;
+
+	try {
+		ScriptCallFunction<void>(function, this);
 	}
-	// Camera must share a context with the zone and be within its borders
-	else if ((_active_contexts & camera->GetContext()) && (IsInsideZone(camera->x_position, camera->y_position) == true)) {
-		_camera_inside = true;
+	catch (luabind::error e) {
+		ScriptManager->HandleLuaError(e);
 	}
-	else {
-		_camera_inside = false;
+	catch (luabind::cast_failed e) {
+		ScriptManager->HandleCastError(e);
 	}
+}
 
-	VirtualSprite* player = MapMode::CurrentInstance()->GetPlayerSprite();
-	if (player == nullptr) {
-		_player_sprite_inside = false;
-	}
-	// Camera must share a context with the zone and be within its borders
-	else if ((_active_contexts & player->GetContext()) && (IsInsideZone(player->x_position, player->y_position) == true)) {
+
+
+void CameraZone::_SpriteEntered(VirtualSprite* sprite) {
+	if (sprite == MapMode::CurrentInstance()->GetCamera())
+		_camera_inside = true;
+	if (sprite == MapMode::CurrentInstance()->GetPlayerSprite())
 		_player_sprite_inside = true;
-	}
-	else {
+}
+
+
+
+void CameraZone::_SpriteExited(VirtualSprite* sprite) {
+	if (sprite == MapMode::CurrentInstance()->GetCamera())
+		_camera_inside = false;
+	if (sprite == MapMode::CurrentInstance()->GetPlayerSprite())
 		_player_sprite_inside = false;
-	}
+}
+
+
+
+void CameraZone::_ProcessTransitions() {
+	// Other sprites may have entered or exited the zone without changing the state of the camera or player sprite
+	if (_was_camera_inside == _camera_inside && _was_player_sprite_inside == _player_sprite_inside)
+		return;
 
 	// Generate a notification event for any enter/exit change
-	if (_was_camera_inside != _camera_inside || _was_player_sprite_inside != _player_sprite_inside) {
-		NotificationManager->Notify(new CameraZoneNotificationEvent(this));
-	}
+	NotificationManager->CreateNotification<CameraZoneNotificationEvent>(this);
+
+	if (IsCameraEntering() == true)
+		_CallTransitionFunction(_camera_enter_function);
+	else if (IsCameraExiting() == true)
+		_CallTransitionFunction(_camera_exit_function);
+
+	if (IsPlayerSpriteEntering() == true)
+		_CallTransitionFunction(_player_enter_function);
+	else if (IsPlayerSpriteExiting() == true)
+		_CallTransitionFunction(_player_exit_function);
 }
 
 // -----------------------------------------------------------------------------
@@ -221,47 +281,39 @@ ResidentZone::ResidentZone(uint16 left_col, uint16 right_col, uint16 top_row, ui
 
 
 
-void ResidentZone::Update() {
-	_entering_residents.clear();
-	_exiting_residents.clear();
+void ResidentZone::_SpriteEntered(VirtualSprite* sprite) {
+	if (_residents.insert(sprite).second == true)
+		_entering_residents.insert(sprite);
+}
 
-	// Holds a list of sprites that should be removed from the resident zone. This is necessary because we can't iterate through
-	// the resident list and erase former residents without messing up the set iteration.
-	vector<VirtualSprite*> remove_list;
 
-	// Examine all residents to see if they still reside in the zone. If not, move them to the exiting residents list
-	for (set<VirtualSprite*>::iterator i = _residents.begin(); i != _residents.end(); i++) {
-		// Make sure that the resident is still in a context shared by the zone and located within the zone boundaries
-		if ((((*i)->GetContext() & _active_contexts) == 0x0) || (IsInsideZone((*i)->x_position, (*i)->y_position) == false)) {
-			remove_list.push_back(*i);
-		}
-	}
 
-	for (uint32 i = 0; i < remove_list.size(); i++) {
-		_exiting_residents.insert(remove_list[i]);
-		_residents.erase(remove_list[i]);
-	}
+void ResidentZone::_SpriteExited(VirtualSprite* sprite) {
+	if (_residents.erase(sprite) > 0)
+		_exiting_residents.insert(sprite);
 }
 
 
 
-void ResidentZone::AddPotentialResident(VirtualSprite* sprite) {
-	if (sprite == nullptr) {
-		IF_PRINT_WARNING(MAP_DEBUG) << "function received nullptr argument" << endl;
+void ResidentZone::_ProcessTransitions() {
+	if (_resident_enter_function.is_valid() == false && _resident_exit_function.is_valid() == false)
 		return;
-	}
-
-	// Check that sprite is not already a resident
-	if (IsSpriteResident(sprite) == true) {
-		return;
-	}
 
-	// Check that the sprite's context is compatible with this zone and is located within the zone boundaries
-	if (sprite->GetContext() & _active_contexts) {
-		if (IsInsideZone(sprite->x_position, sprite->y_position) == true) {
-			_entering_residents.insert(sprite);
-			_residents.insert(sprite);
+	try {
+		if (_resident_enter_function.is_valid() == true) {
+			for (set<VirtualSprite*>::iterator i = _entering_residents.begin(); i != _entering_residents.end(); i++)
+				ScriptCallFunction<void>(_resident_enter_function, this, *i);
 		}
+		if (_resident_exit_function.is_valid() == true) {
+			for (set<VirtualSprite*>::iterator i = _exiting_residents.begin(); i != _exiting_residents.end(); i++)
+				ScriptCallFunction<void>(_resident_exit_function, this, *i);
+		}
+	}
+	catch (luabind::error e) {
+		ScriptManager->HandleLuaError(e);
+	}
+	catch (luabind::cast_failed e) {
+		ScriptManager->HandleCastError(e);
 	}
 }
 
@@ -425,7 +477,8 @@ EnemyZone::EnemyZone() :
 	_spawning_disabled(false),
 	_active_enemies(0),
 	_spawn_timer(DEFAULT_ENEMY_SPAWN_TIME),
-	_spawn_zone(nullptr)
+	_spawn_zone(nullptr),
+	_battle_preload(nullptr)
 {
 	_active_contexts = MAP_CONTEXT_ALL;
 	_spawn_timer.Run();
@@ -439,7 +492,8 @@ EnemyZone::EnemyZone(uint16 left_col, uint16 right_col, uint16 top_row, uint16 b
 	_spawning_disabled(false),
 	_active_enemies(0),
 	_spawn_timer(DEFAULT_ENEMY_SPAWN_TIME),
-	_spawn_zone(nullptr)
+	_spawn_zone(nullptr),
+	_battle_preload(nullptr)
 {
 	_active_contexts = MAP_CONTEXT_ALL;
 	_spawn_timer.Run();
@@ -457,6 +511,17 @@ EnemyZone::EnemyZone(const EnemyZone& copy) :
 		_spawn_zone = nullptr;
 	else
 		_spawn_zone = new MapZone(*(copy._spawn_zone));
+	// The copy has no enemies of its own, so it does not share the preloaded battle data
+	_battle_preload = nullptr;
+}
+
+
+
+EnemyZone::~EnemyZone() {
+	if (_spawn_zone != nullptr)
+		delete _spawn_zone;
+	if (_battle_preload != nullptr)
+		_battle_preload->RemoveReference();
 }
 
 
@@ -473,6 +538,10 @@ EnemyZone& EnemyZone::operator=(const EnemyZone& copy) {
 		_spawn_zone = nullptr;
 	else
 		_spawn_zone = new MapZone(*(copy._spawn_zone));
+	if (_battle_preload != nullptr) {
+		_battle_preload->RemoveReference();
+		_battle_preload = nullptr;
+	}
 
 	return *this;
 }
@@ -567,6 +636,8 @@ void EnemyZone::EnemyDead() {
 
 
 void EnemyZone::Update() {
+	_UpdateBattlePreload();
+
 	// Enemy zones only update during the explore state
 	if (MapMode::CurrentInstance()->CurrentState() != STATE_EXPLORE) {
 		return;
@@ -599,6 +670,42 @@ void EnemyZone::Update() {
 
 
 
+void EnemyZone::_UpdateBattlePreload() {
+	VirtualSprite* camera = MapMode::CurrentInstance()->GetCamera();
+	if (camera == nullptr || _enemies.empty() == true)
+		return;
+
+	if (_battle_preload != nullptr) {
+		if (IsNearZone(camera->x_position, camera->y_position, ENEMY_ZONE_RELEASE_DISTANCE) == false) {
+			_battle_preload->RemoveReference();
+			_battle_preload = nullptr;
+		}
+		else if (_battle_preload->IsLoaded() == false) {
+			_battle_preload->LoadNext();
+		}
+		return;
+	}
+
+	if (IsNearZone(camera->x_position, camera->y_position, ENEMY_ZONE_PRELOAD_DISTANCE) == false)
+		return;
+
+	// Copies of an enemy sprite share the same battle data, so the preload set ignores the duplicate additions
+	_battle_preload = new BattlePreload();
+	for (uint32 i = 0; i < _enemies.size(); ++i) {
+		_battle_preload->AddBackground(_enemies[i]->GetBattleBackgroundFile());
+		_battle_preload->AddMusic(_enemies[i]->GetBattleMusicFile());
+
+		const vector<vector<uint32> >& parties = _enemies[i]->GetEnemyParties();
+		for (uint32 j = 0; j < parties.size(); ++j) {
+			for (uint32 k = 0; k < parties[j].size(); ++k) {
+				_battle_preload->AddEnemy(parties[j][k]);
+			}
+		}
+	}
+} // void EnemyZone::_UpdateBattlePreload()
+
+
+
 bool EnemyZone::_SpawnEnemy(uint32 enemy_index) {
 	// When spawning an enemy in a random zone location, sometimes it is occupied by another
 	// object or that section is unwalkable. We try only a few different spawn locations before
@@ -650,6 +757,65 @@ bool EnemyZone::_SpawnEnemy(uint32 enemy_index) {
 	}
 }
 
+// -----------------------------------------------------------------------------
+// ---------- ZoneIndex Class Functions
+// -----------------------------------------------------------------------------
+
+void ZoneIndex::Build(const vector<MapZone*>& zones, uint16 num_rows, uint16 num_cols) {
+	_num_rows = num_rows;
+	_num_cols = num_cols;
+	_cell_offsets.assign(static_cast<uint32>(num_rows) * num_cols + 1, 0);
+	_cell_zones.clear();
+
+	// Sections of the same zone may overlap, so the index of the last zone added to each cell is kept to avoid duplicates.
+	// The first pass counts the zones covering each cell and the second pass places each zone in its cell's range.
+	vector<uint32> last_zone(static_cast<uint32>(num_rows) * num_cols, 0);
+	vector<uint32> cell_fill;
+	for (uint32 pass = 0; pass < 2; ++pass) {
+		for (uint32 z = 0; z < zones.size(); ++z) {
+			if (zones[z]->UsesZoneIndex() == false)
+				continue;
+
+			for (vector<ZoneSection>::const_iterator i = zones[z]->_sections.begin(); i != zones[z]->_sections.end(); ++i) {
+				uint32 bottom_row = min<uint32>(i->bottom_row, static_cast<uint32>(num_rows) - 1);
+				uint32 right_col = min<uint32>(i->right_col, static_cast<uint32>(num_cols) - 1);
+				for (uint32 r = i->top_row; r <= bottom_row && num_rows > 0; ++r) {
+					for (uint32 c = i->left_col; c <= right_col && num_cols > 0; ++c) {
+						uint32 cell = r * num_cols + c;
+						if (last_zone[cell] == z + 1)
+							continue;
+
+						last_zone[cell] = z + 1;
+						if (pass == 0)
+							_cell_offsets[cell + 1]++;
+						else
+							_cell_zones[cell_fill[cell]++] = zones[z];
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint32 i = 1; i < _cell_offsets.size(); ++i)
+				_cell_offsets[i] += _cell_offsets[i - 1];
+			_cell_zones.resize(_cell_offsets.back());
+			cell_fill.assign(_cell_offsets.begin(), _cell_offsets.end() - 1);
+			last_zone.assign(last_zone.size(), 0);
+		}
+	}
+}
+
+
+
+void ZoneIndex::FindZones(uint16 x, uint16 y, vector<MapZone*>& zones) const {
+	zones.clear();
+	if (x >= _num_cols || y >= _num_rows)
+		return;
+
+	uint32 cell = static_cast<uint32>(y) * _num_cols + x;
+	zones.insert(zones.end(), _cell_zones.begin() + _cell_offsets[cell], _cell_zones.begin() + _cell_offsets[cell + 1]);
+}
+
 } // namespace private_map
 
 } // namespace hoa_map
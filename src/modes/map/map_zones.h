@@ -20,6 +20,7 @@
 #include "defs.h"
 
 // Allacrost engine
+#include "script.h"
 #include "system.h"
 #include "video.h"
 
@@ -70,9 +71,12 @@ class MapZone {
 	// This friend declaration is necessary because EnemyZone, although it dervies from MapZone, also keeps a pointer
 	// to a MapZone object and needs to access the protected members and methods of this object pointer.
 	friend class EnemyZone;
+	// The object supervisor invokes the zone index methods of the zone when sprites enter or exit it
+	friend class ObjectSupervisor;
+	friend class ZoneIndex;
 
 public:
-	MapZone() : _zone_id(0), _active_contexts(MAP_CONTEXT_NONE)
+	MapZone() : _zone_id(0), _active_contexts(MAP_CONTEXT_NONE), _transitions_pending(false)
 		{}
 
 	/** \brief Constructs a map zone that is initialized with a single zone section
@@ -107,10 +111,18 @@ public:
 	**/
 	virtual void AddSection(uint16 left_col, uint16 right_col, uint16 top_row, uint16 bottom_row);
 
-	//! \brief Updates the state of the zone
+	//! \brief Updates the state of the zone. This is called every frame for zones that do not use the zone index.
 	virtual void Update()
 		{}
 
+	/** \brief Returns true if the zone learns of sprites entering and exiting it through the ZoneIndex
+	***
+	*** Zones that use the index are not updated every frame. Instead, the ObjectSupervisor informs them whenever
+	*** a sprite moves into or out of their sections.
+	**/
+	virtual bool UsesZoneIndex() const
+		{ return false; }
+
 	/** \brief Returns true if the position coordinates are located inside the zone (inclusive to the zone boundary edges)
 	*** \param pos_x The x position to check
 	*** \param pos_y The y position to check
@@ -121,6 +133,15 @@ public:
 	**/
 	bool IsInsideZone(uint16 pos_x, uint16 pos_y) const;
 
+	/** \brief Returns true if the position coordinates are within a distance of any section of the zone
+	*** \param pos_x The x position to check
+	*** \param pos_y The y position to check
+	*** \param distance The maximum number of collision grid elements between the position and a section edge
+	***
+	*** The distance is measured separately along each axis, so the neighborhood of each section is also rectangular.
+	**/
+	bool IsNearZone(uint16 pos_x, uint16 pos_y, uint16 distance) const;
+
 	/** \brief Draws an outline for each zone section that is visible on the screen
 	*** \param context The active map context that the zone must exist for the outline to be drawn
 	**/
@@ -139,7 +160,11 @@ public:
 		{ _zone_id = id; }
 
 	void SetActiveContexts(MAP_CONTEXT contexts)
-		{ _active_contexts = contexts; }
+		{ _active_contexts = contexts; ++_layout_version; }
+
+	//! \brief Returns a value that changes whenever a section or the active contexts of any zone change
+	static uint32 GetLayoutVersion()
+		{ return _layout_version; }
 	//@}
 
 protected:
@@ -155,6 +180,36 @@ protected:
 	//! \brief The rectangular sections which compose the map zone
 	std::vector<ZoneSection> _sections;
 
+	//! \brief Incremented whenever the sections or active contexts of any zone change, so that the zone index knows to rebuild
+	static uint32 _layout_version;
+
+	//! \brief Set by the object supervisor while the zone has enter or exit transitions that have not yet been cleared
+	bool _transitions_pending;
+
+	//! \name Zone index methods
+	//! \brief Invoked by the object supervisor for zones that use the zone index
+	//@{
+	//! \brief Called when a sprite moves into the zone or changes to a context that the zone is active in
+	virtual void _SpriteEntered(VirtualSprite* /*sprite*/)
+		{}
+
+	//! \brief Called when a sprite moves out of the zone or changes to a context that the zone is not active in
+	virtual void _SpriteExited(VirtualSprite* /*sprite*/)
+		{}
+
+	//! \brief Called once at the end of an update in which any sprite entered or exited the zone
+	virtual void _ProcessTransitions()
+		{}
+
+	//! \brief Called when a sprite is removed from the map so that the zone retains no pointer to it
+	virtual void _SpriteRemoved(VirtualSprite* /*sprite*/)
+		{}
+
+	//! \brief Called at the start of the next update to end the enter and exit states set during the previous update
+	virtual void _ClearTransitions()
+		{}
+	//@}
+
 	/** \brief Returns random x, y position coordinates within the zone
 	*** \param x A reference where to store the value of the x position
 	*** \param y A reference where to store the value of the x position
@@ -177,9 +232,10 @@ protected:
 *** map event. This class makes that common case a little easier to implement in
 *** map scripting code.
 ***
-*** \note An important issue to remember is that the map camera may be changed to point
-*** at any sprite at any given time. This class is not informed of such events, so you
-*** must be cautious about this case.
+*** The zone is not examined every frame. It is informed by the object supervisor through the
+*** zone index whenever a sprite moves into or out of it, and whenever the map camera or player
+*** sprite is changed to point at a different sprite. Scripts may register a function to call on
+*** each kind of transition instead of checking the zone on every update.
 ***
 *** \note This zone is less powerful than the ResidentZone class, which tracks all
 *** sprites status relative to the zone. CameraZone is much simpler than ResidentZone
@@ -188,7 +244,7 @@ protected:
 *** ***************************************************************************/
 class CameraZone : public MapZone {
 public:
-	CameraZone() : MapZone(), _camera_inside(false), _was_camera_inside(false)
+	CameraZone() : MapZone(), _camera_inside(false), _was_camera_inside(false), _player_sprite_inside(false), _was_player_sprite_inside(false)
 		{}
 
 	/** \brief Constructs a camera zone that is initialized with a single zone section
@@ -211,8 +267,8 @@ public:
 	virtual ~CameraZone()
 		{}
 
-	//! \brief Updates the state of the zone by checking the current camera position
-	void Update();
+	bool UsesZoneIndex() const
+		{ return true; }
 
 	//! \brief Returns true if the sprite pointed to by the camera is located within the zone
 	bool IsCameraInside() const
@@ -238,6 +294,30 @@ public:
 	bool IsPlayerSpriteExiting() const
 		{ return ((_player_sprite_inside == false) && (_was_player_sprite_inside == true)); }
 
+	/** \name Transition Callbacks
+	*** \brief Registers a Lua function to call when the camera or player sprite enters or exits the zone
+	*** \param function The function to call, which receives the zone as its only argument
+	**/
+	//@{
+	void OnCameraEnter(ScriptObject function)
+		{ _camera_enter_function = function; }
+
+	void OnCameraExit(ScriptObject function)
+		{ _camera_exit_function = function; }
+
+	void OnPlayerEnter(ScriptObject function)
+		{ _player_enter_function = function; }
+
+	void OnPlayerExit(ScriptObject function)
+		{ _player_exit_function = function; }
+	//@}
+
+	/** \brief Determines whether the camera and player sprite are inside the zone by examining their positions
+	***
+	*** The object supervisor calls this when the camera or player sprite is changed to point at a different sprite.
+	**/
+	void RefreshInside();
+
 protected:
 	//! \brief Set to true when the sprite pointed to by the camera is inside this zone
 	bool _camera_inside;
@@ -250,6 +330,24 @@ protected:
 
 	//! \brief Holds the previous value of _player_sprite_inside
 	bool _was_player_sprite_inside;
+
+	//! \brief Functions registered by a script to call for each type of transition
+	ScriptObject _camera_enter_function, _camera_exit_function, _player_enter_function, _player_exit_function;
+
+	//! \brief Returns true if a sprite is located within the zone and shares one of its contexts
+	bool _IsSpriteInside(const VirtualSprite* sprite) const;
+
+	//! \brief Calls a transition function if it was registered
+	void _CallTransitionFunction(const ScriptObject& function);
+
+	void _SpriteEntered(VirtualSprite* sprite);
+
+	void _SpriteExited(VirtualSprite* sprite);
+
+	void _ProcessTransitions();
+
+	void _ClearTransitions()
+		{ _was_camera_inside = _camera_inside; _was_player_sprite_inside = _player_sprite_inside; }
 }; // class CameraZone : public MapZone
 
 
@@ -263,9 +361,10 @@ protected:
 *** Sprites inhabiting the zone are called "residents", hence the nomenclature for
 *** this class.
 ***
-*** ResidentZones are updated by the ObjectSupervisor. Every time a sprite's position
-*** is changed, it is marked and all zones that share the same context as the sprite
-*** are examined to see if the sprite has entered or left any zones. Because it is
+*** ResidentZones are updated by the ObjectSupervisor. Every time a sprite moves to a
+*** different collision grid cell or changes its context, the zone index is consulted to
+*** find the zones that the sprite has entered or left, and only those zones are informed.
+*** Scripts may register functions to call when a resident enters or exits. Because it is
 *** quite common to want to determine if the sprite pointed to by the camera has interacted
 *** with the zone area, there are specific functions that provide for that ability, to
 *** ease the burden on the map script writers.
@@ -302,17 +401,20 @@ public:
 	~ResidentZone()
 		{}
 
-	//! \brief Refreshes the entering/exiting resident lists
-	void Update();
+	bool UsesZoneIndex() const
+		{ return true; }
 
-	/** \brief Examines a sprite to determine if it has entered this zone and established residency
-	*** \param sprite A pointer to the sprite to examine
-	***
-	*** This function is invoked by the object supervisor for every sprite that has either moved or changed its context.
-	*** If it determines that the sprite is located within the zone, it is added to the residents and entering residents
-	*** sets. This method is not bound to Lua as its use there is unnecessary.
+	/** \name Transition Callbacks
+	*** \brief Registers a Lua function to call when a sprite enters or exits the zone
+	*** \param function The function to call, which receives the zone and the sprite as its arguments
 	**/
-	void AddPotentialResident(VirtualSprite* sprite);
+	//@{
+	void OnResidentEnter(ScriptObject function)
+		{ _resident_enter_function = function; }
+
+	void OnResidentExit(ScriptObject function)
+		{ _resident_exit_function = function; }
+	//@}
 
 	//! \brief Returns true if any sprites have recently entered this zone
 	bool IsResidentEntering() const
@@ -425,6 +527,25 @@ protected:
 	**/
 	std::set<VirtualSprite*> _exiting_residents;
 
+	//! \brief Functions registered by a script to call when a sprite enters or exits the zone
+	ScriptObject _resident_enter_function, _resident_exit_function;
+
+	//! \brief Adds a sprite to the residents and entering residents sets
+	void _SpriteEntered(VirtualSprite* sprite);
+
+	//! \brief Moves a sprite from the residents set to the exiting residents set
+	void _SpriteExited(VirtualSprite* sprite);
+
+	//! \brief Calls the registered functions for all residents that entered or exited during the update
+	void _ProcessTransitions();
+
+	//! \brief Removes a sprite from the residents, entering residents, and exiting residents sets
+	void _SpriteRemoved(VirtualSprite* sprite)
+		{ _residents.erase(sprite); _entering_residents.erase(sprite); _exiting_residents.erase(sprite); }
+
+	void _ClearTransitions()
+		{ _entering_residents.clear(); _exiting_residents.clear(); }
+
 	/** \brief A helper function which retrieves a sprite at a specific index in a std::set of sprites
 	*** \param local_set A reference to the set of sprites to use
 	*** \param index The index into the set of where to retrieve the sprite from
@@ -534,8 +655,7 @@ public:
 	**/
 	EnemyZone(uint16 left_col, uint16 right_col, uint16 top_row, uint16 bottom_row);
 
-	~EnemyZone()
-		{ if (_spawn_zone != nullptr) delete _spawn_zone; }
+	~EnemyZone();
 
 	EnemyZone(const EnemyZone& copy);
 
@@ -585,6 +705,13 @@ public:
 	bool HasSeparateSpawnZone() const
 		{ return (_spawn_zone != nullptr); }
 
+	/** \brief Returns the set of battle data preloaded for this zone's enemies
+	*** \return A pointer to the preload set, or nullptr if the camera is not near the zone
+	*** A battle that uses the set must add its own reference to it.
+	**/
+	hoa_battle::BattlePreload* GetBattlePreload() const
+		{ return _battle_preload; }
+
 	/** \brief Draws an outline for each zone section that is visible on the screen
 	*** \param context The active map context that the zone must exist for the outline to be drawn
 	*** \param color The color to draw the outline (default color == purple)
@@ -647,6 +774,15 @@ private:
 	**/
 	std::vector<EnemySprite*> _enemies;
 
+	/** \brief Holds the battle data for every party that the enemies of this zone may summon
+	*** This is created when the camera comes near the zone, loaded a piece at a time on each update, and
+	*** released when the camera moves away from the zone.
+	**/
+	hoa_battle::BattlePreload* _battle_preload;
+
+	//! \brief Creates, continues loading, or releases the battle preload set depending on the camera's location
+	void _UpdateBattlePreload();
+
 	/** \brief Changes the state of a specified inactive enemy to the spawn state
 	*** \param enemy_index The index into the _enemies container to spawn
 	*** \return True if the enemy successfully spawned
@@ -662,6 +798,71 @@ private:
 	bool _SpawnEnemy(uint32 enemy_index);
 }; // class EnemyZone : public MapZone
 
+
+/** ****************************************************************************
+*** \brief A lookup from each collision grid cell to the zones that cover it
+***
+*** Zones that use the index are never examined on every frame. Instead, the object
+*** supervisor looks up the zones covering a sprite's cell whenever the sprite moves
+*** to a different cell and compares them to the zones covering its previous cell.
+*** The zones for all cells are stored contiguously, with an offset for each cell
+*** into that container.
+***
+*** \note The index must be rebuilt whenever a zone is added or the sections of a zone
+*** change. MapZone::GetLayoutVersion() can be used to detect the latter.
+*** ***************************************************************************/
+class ZoneIndex {
+public:
+	ZoneIndex() :
+		_num_rows(0), _num_cols(0) {}
+
+	/** \brief Constructs the index for a set of zones
+	*** \param zones The zones to index. Zones which do not use the index are ignored.
+	*** \param num_rows The number of rows in the collision grid
+	*** \param num_cols The number of columns in the collision grid
+	**/
+	void Build(const std::vector<MapZone*>& zones, uint16 num_rows, uint16 num_cols);
+
+	/** \brief Finds all indexed zones which cover a collision grid cell
+	*** \param x The column of the cell
+	*** \param y The row of the cell
+	*** \param zones A reference to the container to hold the zones. Any previous contents are removed.
+	**/
+	void FindZones(uint16 x, uint16 y, std::vector<MapZone*>& zones) const;
+
+private:
+	//! \brief The dimensions of the collision grid that the index was built for
+	uint16 _num_rows, _num_cols;
+
+	//! \brief The offset into _cell_zones of the first zone for each cell, plus one final entry holding the total
+	std::vector<uint32> _cell_offsets;
+
+	//! \brief The zones covering each cell, with the zones of each cell stored contiguously
+	std::vector<MapZone*> _cell_zones;
+}; // class ZoneIndex
+
+
+/** ****************************************************************************
+*** \brief The last location of a sprite that the object supervisor examined, along with the indexed zones it occupies
+*** ***************************************************************************/
+class ZoneOccupant {
+public:
+	ZoneOccupant() :
+		x_position(0), y_position(0), context(MAP_CONTEXT_NONE), initialized(false) {}
+
+	//! \brief The collision grid cell that the sprite was located in
+	uint16 x_position, y_position;
+
+	//! \brief The context that the sprite was in
+	MAP_CONTEXT context;
+
+	//! \brief False until the sprite has been examined for the first time
+	bool initialized;
+
+	//! \brief The indexed zones that the sprite is located in and shares a context with
+	std::vector<MapZone*> zones;
+}; // class ZoneOccupant
+
 } // namespace private_map
 
 } // namespace hoa_map
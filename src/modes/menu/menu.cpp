@@ -72,6 +72,9 @@ MenuMode::MenuMode() :
 	_current_window = WINDOW_INVENTORY;
 
 	GlobalParty & characters = *GlobalManager->GetActiveParty();
+	for (uint32 i = 0; i < characters.GetPartySize(); i++) {
+		_party_ids.push_back(characters.GetActorAtIndex(i)->GetID());
+	}
 
 	// Setup character windows based on active party size
 	switch (characters.GetPartySize()) {
@@ -186,6 +189,65 @@ MenuMode::~MenuMode() {
 
 
 
+MenuMode* MenuMode::Create() {
+	MenuMode* menu = dynamic_cast<MenuMode*>(ModeManager->AcquirePooledMode(MENU_MODE));
+	if (menu != nullptr) {
+		// The character, status, skills, and equipment windows are all built for the party that existed at construction
+		GlobalParty* characters = GlobalManager->GetActiveParty();
+		bool party_changed = (characters->GetPartySize() != menu->_party_ids.size());
+		for (uint32 i = 0; party_changed == false && i < menu->_party_ids.size(); i++) {
+			if (characters->GetActorAtIndex(i)->GetID() != menu->_party_ids[i])
+				party_changed = true;
+		}
+
+		if (party_changed == true) {
+			delete menu;
+			menu = nullptr;
+		}
+	}
+
+	if (menu == nullptr)
+		return new MenuMode();
+
+	if (_current_instance != nullptr) {
+		IF_PRINT_WARNING(MENU_DEBUG) << "reusing an instance of MenuMode when one already seems to exist" << endl;
+	}
+	_current_instance = menu;
+
+	// Only the location text is re-rendered, and only when the location has changed
+	if ((menu->_locale_name.GetString() == GlobalManager->GetLocationName()) == false)
+		menu->_locale_name.SetText(GlobalManager->GetLocationName());
+
+	try {
+		menu->_saved_screen = VideoManager->CaptureScreen();
+	}
+	catch(Exception e) {
+		cerr << e.ToString() << endl;
+	}
+
+	menu->_current_window = WINDOW_INVENTORY;
+	menu->_current_menu_showing = SHOW_MAIN;
+	menu->_current_menu = &menu->_main_options;
+	return menu;
+} // MenuMode* MenuMode::Create()
+
+
+
+bool MenuMode::Recycle() {
+	if (_message_window != nullptr) {
+		delete _message_window;
+		_message_window = nullptr;
+	}
+
+	_saved_screen.Clear();
+
+	if (_current_instance == this)
+		_current_instance = nullptr;
+	return true;
+}
+
+
+
 void MenuMode::SetCommandDescriptions() {
 	_command_descriptions[UP_COMMAND] = UTranslate("Move cursor");
 	_command_descriptions[DOWN_COMMAND] = UTranslate("Move cursor");
@@ -234,15 +296,15 @@ void MenuMode::Reset() {
 
 void MenuMode::Update() {
 	if (InputManager->QuitPress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::QUIT));
+		ModeManager->Push(PauseMode::Create(hoa_pause::QUIT));
 		return;
 	}
 	else if (InputManager->PausePress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::PAUSE));
+		ModeManager->Push(PauseMode::Create(hoa_pause::PAUSE));
 		return;
 	}
 	else if (InputManager->HelpPress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::HELP));
+		ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 		return;
 	}
 
@@ -279,6 +279,12 @@ public:
 
 	~MenuMode();
 
+	/** \brief Returns an instance of MenuMode to push onto the game stack, reusing a parked instance if possible
+	*** \note This should be used in place of the constructor. A parked instance is only reused if the characters
+	*** in the active party have not changed since it was constructed, as many of the menu windows are built for them.
+	**/
+	static MenuMode* Create();
+
 	//! \brief Returns a pointer to the active instance of menu mode
 	static MenuMode* CurrentInstance()
 		{ return _current_instance; }
@@ -289,6 +295,9 @@ public:
 	//! \brief Resets the menu mode back to its default setup.
 	void Reset();
 
+	//! \brief Closes any message window and releases the screen snap-shot so that the instance may be reused
+	bool Recycle();
+
 	//! \brief Updates the menu. Calls Update() on active window if there is one
 	void Update();
 
@@ -311,6 +320,9 @@ private:
 	**/
 	hoa_video::StillImage _saved_screen;
 
+	//! \brief The IDs of the characters that were in the active party when the menu windows were built
+	std::vector<uint32> _party_ids;
+
 	/** \name Main Display Windows
 	*** \brief The various menu windows that are displayed in menu mode
 	**/
@@ -42,6 +42,7 @@
 #include "map.h"
 #include "map_dialogue.h"
 #include "map_events.h"
+#include "map_ffi.h"
 #include "map_objects.h"
 #include "map_sprites.h"
 #include "map_sprite_events.h"
@@ -180,7 +181,8 @@ void BindModeCode() {
 			.def("GetEffectActor", &BattleEffect::GetEffectActor),
 
 		class_<StatusEffect, BattleEffect>("StatusEffect")
-			.def("GetDurationTimer", &StatusEffect::GetDurationTimer)
+			.def("GetDuration", &StatusEffect::GetDuration)
+			.def("GetTimeRemaining", &StatusEffect::GetTimeRemaining)
 			.def("GetIntensity", &StatusEffect::GetIntensity)
 			.def("IncrementIntensity", &StatusEffect::IncrementIntensity)
 			.def("DecrementIntensity", &StatusEffect::DecrementIntensity)
@@ -374,7 +376,8 @@ void BindModeCode() {
 			.def("AddObjectLayer", &ObjectSupervisor::AddObjectLayer)
 			.def("AddObject", (void(private_map::ObjectSupervisor::*)(private_map::MapObject*))&ObjectSupervisor::AddObject, adopt(_2))
 			.def("AddObject", (void(private_map::ObjectSupervisor::*)(private_map::MapObject*, uint32))&ObjectSupervisor::AddObject, adopt(_2))
-			.def("MoveObjectToLayer", &ObjectSupervisor::MoveObjectToLayer),
+			.def("MoveObjectToLayer", &ObjectSupervisor::MoveObjectToLayer)
+			.def("DeleteObject", &ObjectSupervisor::DeleteObject),
 
 		class_<MapObject>("MapObject")
 			.def_readwrite("updatable", &MapObject::updatable)
@@ -526,7 +529,11 @@ void BindModeCode() {
 			.def("IsCameraExiting", &CameraZone::IsCameraExiting)
 			.def("IsPlayerSpriteInside", &CameraZone::IsPlayerSpriteInside)
 			.def("IsPlayerSpriteEntering", &CameraZone::IsPlayerSpriteEntering)
-			.def("IsPlayerSpriteExiting", &CameraZone::IsPlayerSpriteExiting),
+			.def("IsPlayerSpriteExiting", &CameraZone::IsPlayerSpriteExiting)
+			.def("OnCameraEnter", &CameraZone::OnCameraEnter)
+			.def("OnCameraExit", &CameraZone::OnCameraExit)
+			.def("OnPlayerEnter", &CameraZone::OnPlayerEnter)
+			.def("OnPlayerExit", &CameraZone::OnPlayerExit),
 
 		class_<ResidentZone, MapZone>("ResidentZone")
 			.def(constructor<>())
@@ -548,7 +555,9 @@ void BindModeCode() {
 			.def("GetExitingResident", &ResidentZone::GetExitingResident)
 			.def("GetNumberResidents", &ResidentZone::GetNumberResidents)
 			.def("GetNumberEnteringResidents", &ResidentZone::GetNumberEnteringResidents)
-			.def("GetNumberExitingResidents", &ResidentZone::GetNumberExitingResidents),
+			.def("GetNumberExitingResidents", &ResidentZone::GetNumberExitingResidents)
+			.def("OnResidentEnter", &ResidentZone::OnResidentEnter)
+			.def("OnResidentExit", &ResidentZone::OnResidentExit),
 
 		class_<EnemyZone, MapZone>("EnemyZone")
 			.def(constructor<>())
@@ -773,6 +782,9 @@ void BindModeCode() {
 			.def("Initialize", (void(TreasureSupervisor::*)(TreasureContainer*))&TreasureSupervisor::Initialize)
 	];
 
+	// Scripts test whether "MapFFI" is nil to determine if the faster FFI accessors are available
+	RegisterMapFFI(hoa_script::ScriptManager->GetGlobalState());
+
 	} // End using map mode namespaces
 
 
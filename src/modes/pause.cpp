@@ -49,27 +49,18 @@ const uint8 QUIT_TO_BOOT   = 1;
 const uint8 QUIT_CANCEL    = 2;
 //@}
 
+//! \brief The number of rows displayed in the help window after the standard commands, including a blank separator row
+const uint32 HELP_ADDITIONAL_COMMAND_COUNT = 6;
+
 
 
 PauseMode::PauseMode(PAUSE_STATE state, bool pause_audio) :
 	GameMode(PAUSE_MODE),
 	_state(state),
-	_audio_paused(pause_audio),
+	_audio_paused(false),
+	_parent_mode_type(INVALID_MODE),
 	_dim_color(0.35f, 0.35f, 0.35f, 1.0f) // A grayish opaque color
 {
-	GameMode* parent = ModeManager->GetTop();
-	if (parent == nullptr) {
-		IF_PRINT_WARNING(PAUSE_DEBUG) << "top of game mode stack returned a nullptr pointer" << endl;
-		_parent_mode_type = INVALID_MODE;
-	}
-	else {
-		_parent_mode_type = parent->GetModeType();
-		_command_descriptions = parent->GetCommandDescriptions();
-	}
-
-	// Determine the type of game mode that instantiated this class (assumed to be at the top of the stack)
-	_parent_mode_type = ModeManager->GetModeType();
-
 	// Render the paused string in white text
 	_paused_text.SetStyle(TextStyle("title28", Color::white, VIDEO_TEXT_SHADOW_BLACK));
 	_paused_text.SetText(UTranslate("Paused"));
@@ -87,15 +78,11 @@ PauseMode::PauseMode(PAUSE_STATE state, bool pause_audio) :
 	_quit_options.AddOption(UTranslate("Quit Game"));
 	_quit_options.AddOption(UTranslate("Quit to Main Menu"));
 	_quit_options.AddOption(UTranslate("Cancel"));
-	_quit_options.SetSelection(QUIT_CANCEL);
 
 	// Initialize help GUI elements
 	_help_window.Create(880.0f, 640.0f);
 	_help_window.SetPosition(512.0f, 384.0f);
 	_help_window.SetAlignment(VIDEO_X_CENTER, VIDEO_Y_CENTER);
-	if (_state == HELP) {
-		_help_window.Show();
-	}
 
 	_help_commands_header.SetOwner(&_help_window);
 	_help_commands_header.SetPosition(40.0f, 600.0f);
@@ -109,48 +96,20 @@ PauseMode::PauseMode(PAUSE_STATE state, bool pause_audio) :
 	_help_commands_header.AddOption(UTranslate("Key"));
 	_help_commands_header.AddOption(UTranslate("Purpose"));
 
-	// Total number of standard commands we will display (-1 because we don't include the "pause" command as a standard)
-	uint32 standard_command_count = COMMAND_TOTAL - 1;
-	// The number of additional commands we intend to display after the standard commands (+1 added for a "blank" command used as a separator)
-	uint32 additional_command_count = 6;
+	// The number of rows is the standard commands (minus the "pause" command) plus the additional commands displayed after them
+	uint32 command_row_count = COMMAND_TOTAL - 1 + HELP_ADDITIONAL_COMMAND_COUNT;
 	_help_commands.SetOwner(&_help_window);
 	_help_commands.SetPosition(40.0f, 560.0f);
-	_help_commands.SetDimensions(620.0f, 480.0f, 3, standard_command_count + additional_command_count, 3, standard_command_count + additional_command_count);
+	_help_commands.SetDimensions(620.0f, 480.0f, 3, command_row_count, 3, command_row_count);
 	_help_commands.SetAlignment(VIDEO_X_LEFT, VIDEO_Y_TOP);
 	_help_commands.SetOptionAlignment(VIDEO_X_LEFT, VIDEO_Y_TOP);
 	_help_commands.SetTextStyle(TextStyle("text22"));
 	_help_commands.SetCursorState(VIDEO_CURSOR_STATE_HIDDEN);
 
-	// Standard commands
-	for (uint32 i = 0; i < standard_command_count; ++i) {
-		INPUT_STANDARD_COMMAND command = static_cast<INPUT_STANDARD_COMMAND>(i);
-		_help_commands.AddOption(InputManager->CommandName(command));
-		_help_commands.AddOption(MakeUnicodeString(InputManager->GetKeyName(command)));
-		_help_commands.AddOption(_command_descriptions.at(command));
-	}
-
-	// Additional commands. Insert a row of blank options to separate
-	_help_commands.AddOption(ustring());
-	_help_commands.AddOption(ustring());
-	_help_commands.AddOption(ustring());
-	_help_commands.AddOption(UTranslate("Pause"));
-	_help_commands.AddOption(UTranslate("Spacebar"));
-	_help_commands.AddOption(UTranslate("Pauses the game"));
-	_help_commands.AddOption(UTranslate("Quit"));
-	_help_commands.AddOption(UTranslate("Esc"));
-	_help_commands.AddOption(UTranslate("Quit the application"));
-	_help_commands.AddOption(UTranslate("Help"));
-	_help_commands.AddOption(UTranslate("F1"));
-	_help_commands.AddOption(UTranslate("Display command help"));
-	_help_commands.AddOption(UTranslate("Fullscreen"));
-	_help_commands.AddOption(UTranslate("Ctrl+F"));
-	_help_commands.AddOption(UTranslate("Toggle between fullscreen or window"));
-	_help_commands.AddOption(UTranslate("Screenshot"));
-	_help_commands.AddOption(UTranslate("Ctrl+S"));
-	_help_commands.AddOption(UTranslate("Save a screenshot of the game"));
-
 	_help_return_text.SetStyle(TextStyle("title24"));
 	_help_return_text.SetText(UTranslate("Press F1 to return to the game."));
+
+	_Arm(state, pause_audio);
 }
 
 
@@ -162,6 +121,30 @@ PauseMode::~PauseMode() {
 
 
 
+PauseMode* PauseMode::Create(PAUSE_STATE state, bool pause_audio) {
+	PauseMode* pause = dynamic_cast<PauseMode*>(ModeManager->AcquirePooledMode(PAUSE_MODE));
+	if (pause == nullptr)
+		return new PauseMode(state, pause_audio);
+
+	pause->_Arm(state, pause_audio);
+	return pause;
+}
+
+
+
+bool PauseMode::Recycle() {
+	if (_audio_paused == true) {
+		AudioManager->ResumeAudio();
+		_audio_paused = false;
+	}
+
+	_help_window.Hide();
+	_screen_capture.Clear();
+	return true;
+}
+
+
+
 void PauseMode::Reset() {
 	if (_audio_paused == true)
 		AudioManager->PauseAudio();
@@ -295,4 +278,70 @@ void PauseMode::Draw() {
 	}
 } // void PauseMode::Draw()
 
+
+
+void PauseMode::_Arm(PAUSE_STATE state, bool pause_audio) {
+	_state = state;
+	_audio_paused = pause_audio;
+
+	// Determine the type of game mode that instantiated this class (assumed to be at the top of the stack)
+	GameMode* parent = ModeManager->GetTop();
+	if (parent == nullptr) {
+		IF_PRINT_WARNING(PAUSE_DEBUG) << "top of game mode stack returned a nullptr pointer" << endl;
+		_parent_mode_type = INVALID_MODE;
+	}
+	else {
+		_parent_mode_type = parent->GetModeType();
+		_command_descriptions = parent->GetCommandDescriptions();
+	}
+
+	_quit_options.SetSelection(QUIT_CANCEL);
+	if (_state == HELP) {
+		_help_window.Show();
+	}
+
+	_SetHelpCommands();
+}
+
+
+
+void PauseMode::_SetHelpCommands() {
+	vector<ustring> command_text;
+
+	// Standard commands (the "pause" command is not included as a standard command)
+	for (uint32 i = 0; i < COMMAND_TOTAL - 1; ++i) {
+		INPUT_STANDARD_COMMAND command = static_cast<INPUT_STANDARD_COMMAND>(i);
+		command_text.push_back(InputManager->CommandName(command));
+		command_text.push_back(MakeUnicodeString(InputManager->GetKeyName(command)));
+		command_text.push_back(_command_descriptions.at(command));
+	}
+
+	// Additional commands. Insert a row of blank options to separate
+	command_text.push_back(ustring());
+	command_text.push_back(ustring());
+	command_text.push_back(ustring());
+	command_text.push_back(UTranslate("Pause"));
+	command_text.push_back(UTranslate("Spacebar"));
+	command_text.push_back(UTranslate("Pauses the game"));
+	command_text.push_back(UTranslate("Quit"));
+	command_text.push_back(UTranslate("Esc"));
+	command_text.push_back(UTranslate("Quit the application"));
+	command_text.push_back(UTranslate("Help"));
+	command_text.push_back(UTranslate("F1"));
+	command_text.push_back(UTranslate("Display command help"));
+	command_text.push_back(UTranslate("Fullscreen"));
+	command_text.push_back(UTranslate("Ctrl+F"));
+	command_text.push_back(UTranslate("Toggle between fullscreen or window"));
+	command_text.push_back(UTranslate("Screenshot"));
+	command_text.push_back(UTranslate("Ctrl+S"));
+	command_text.push_back(UTranslate("Save a screenshot of the game"));
+
+	// Rendering the text is the expensive part, so it is skipped when a reused instance displays the same commands
+	if (command_text == _help_command_text)
+		return;
+
+	_help_command_text = command_text;
+	_help_commands.SetOptions(_help_command_text);
+}
+
 } // namespace hoa_pause
@@ -81,6 +81,13 @@ public:
 
 	~PauseMode();
 
+	/** \brief Returns an instance of PauseMode to push onto the game stack, reusing a parked instance if one exists
+	*** \param state The initial state to set pause mode to
+	*** \param pause_audio If set to true, the audio is paused when PauseMode becomes active and resumes when it exits (default == false)
+	*** \note This should be used in place of the constructor
+	**/
+	static PauseMode* Create(PAUSE_STATE state, bool pause_audio = false);
+
 	/** \brief Leaves command descriptions to their default "(unused)"
 	*** Instead of setting descriptions for this mode, the descriptions are set to the mode that was at the top of the stack when this mode was constructed
 	**/
@@ -89,6 +96,9 @@ public:
 	//! \brief Resets appropriate class members. Called whenever PauseMode is made the active game mode.
 	void Reset();
 
+	//! \brief Resumes the audio if it was paused and releases the screen capture so that the instance may be reused
+	bool Recycle();
+
 	//! \brief Updates the game state by the amount of time that has elapsed
 	void Update();
 
@@ -128,6 +138,21 @@ private:
 
 	//! \brief A line of text explaining how to return to the game
 	hoa_video::TextImage _help_return_text;
+
+	//! \brief The text of every option in _help_commands, retained so that the options are only rebuilt when the text changes
+	std::vector<hoa_utils::ustring> _help_command_text;
+
+	/** \brief Prepares a new or reused instance to be pushed onto the game stack
+	*** \param state The state to set pause mode to
+	*** \param pause_audio If set to true, the audio is paused when PauseMode becomes active and resumes when it exits
+	***
+	*** This takes the command descriptions from the game mode at the top of the stack, which is assumed to be the game
+	*** mode that is pausing.
+	**/
+	void _Arm(PAUSE_STATE state, bool pause_audio);
+
+	//! \brief Sets the options of _help_commands from the command descriptions and current key mappings
+	void _SetHelpCommands();
 }; // class PauseMode : public hoa_mode_manager::GameMode
 
 } // namespace hoa_pause
@@ -234,6 +234,9 @@ void SaveMode::Reset() {
 	VideoManager->SetCoordSys(0.0f, 1023.0f, 0.0f, 767.0f);
 	VideoManager->SetDrawFlags(VIDEO_X_LEFT, VIDEO_Y_BOTTOM, VIDEO_BLEND, 0);
 
+	// Read the preview data of all save slots now so that moving the cursor between slots requires no file access
+	_LoadSlotPreviews();
+
 	_save_music.Play();
 }
 
@@ -296,9 +299,7 @@ void SaveMode::Update() {
 					// note: using int here, because uint8 will NOT work
 					// do not change unless you understand this and can test it properly!
 					int32 id = _file_list.GetSelection();
-					ostringstream f;
-					f << GetUserDataPath(true) + "saved_game_" << id << ".lua";
-					string filename = f.str();
+					string filename = _GetSaveFilename(id);
 					// now, attempt to save the game.  If failure, we need to tell the user that!
 					if (GlobalManager->SaveGame(filename, static_cast<uint32>(id)) == true) {
 						_current_state = SAVE_MODE_SAVE_COMPLETE;
@@ -306,6 +307,8 @@ void SaveMode::Update() {
 					else {
 						_current_state = SAVE_MODE_SAVE_FAILED;
 					}
+					// The contents of this slot have changed, so its preview needs to be read again
+					_LoadSlotPreview(id);
 				}
 				else {
 					_current_state = SAVE_MODE_SAVING;
@@ -437,9 +440,7 @@ void SaveMode::Draw() {
 }
 
 bool SaveMode::_LoadGame(int32 id) {
-	ostringstream f;
-	f << GetUserDataPath(true) + "saved_game_" << id << ".lua";
-	string filename = f.str();
+	string filename = _GetSaveFilename(id);
 
 	if (DoesFileExist(filename)) {
 		_current_state = SAVE_MODE_FADING_OUT;
@@ -459,13 +460,7 @@ bool SaveMode::_LoadGame(int32 id) {
 
 
 bool SaveMode::_PreviewGame(int32 id) {
-	ostringstream f;
-	f << GetUserDataPath(true) + "saved_game_" << id << ".lua";
-	string filename = f.str();
-
-	ReadScriptDescriptor file, map_file;
-
-	if (file.OpenFile(filename, true) == false) {
+	if (id < 1 || id > static_cast<int32>(SAVE_NUMBER_SLOTS) || _slot_previews[id - 1].valid == false) {
 		_location_name_textbox.SetDisplayText("No Data");
 		_time_textbox.SetDisplayText(" ");
 		_drunes_textbox.SetDisplayText(" ");
@@ -475,39 +470,169 @@ bool SaveMode::_PreviewGame(int32 id) {
 		return false;
 	}
 
+	SaveSlotPreview& preview = _slot_previews[id - 1];
+	for (uint32 i = 0; i < 4; i++) {
+		if (i < preview.characters.size())
+			_character_window[i].SetCharacter(preview.characters[i]);
+		else
+			_character_window[i].SetCharacter(nullptr);
+	}
+
+	_location_name_textbox.SetDisplayText(preview.location_name);
+
+	std::ostringstream time_text;
+	time_text << "Time - ";
+	time_text << (preview.play_hours < 10 ? "0" : "") << preview.play_hours << ":";
+	time_text << (preview.play_minutes < 10 ? "0" : "") << preview.play_minutes << ":";
+	time_text << (preview.play_seconds < 10 ? "0" : "") << preview.play_seconds;
+
+	_time_textbox.SetDisplayText( time_text.str() );
+
+	std::ostringstream drunes_text;
+	drunes_text << "Drunes - " << preview.drunes;
+
+	_drunes_textbox.SetDisplayText( drunes_text.str() );
+	return true;
+} // bool SaveMode::_PreviewGame(int32 id)
+
+
+
+string SaveMode::_GetSaveFilename(int32 id) const {
+	ostringstream f;
+	f << GetUserDataPath(true) + "saved_game_" << id << ".lua";
+	return f.str();
+}
+
+
+
+void SaveMode::_LoadSlotPreviews() {
+	for (uint32 i = 1; i <= SAVE_NUMBER_SLOTS; i++) {
+		_LoadSlotPreview(static_cast<int32>(i));
+	}
+}
+
+
+
+void SaveMode::_LoadSlotPreview(int32 id) {
+	if (id < 1 || id > static_cast<int32>(SAVE_NUMBER_SLOTS)) {
+		IF_PRINT_WARNING(SAVE_DEBUG) << "invalid save slot: " << id << endl;
+		return;
+	}
+
+	// The character windows may point to characters of the preview that is about to be deleted
+	for (uint32 i = 0; i < 4; i++) {
+		_character_window[i].SetCharacter(nullptr);
+	}
+
+	SaveSlotPreview& preview = _slot_previews[id - 1];
+	preview.Clear();
+
+	string filename = _GetSaveFilename(id);
+	if (DoesFileExist(filename) == false) {
+		return;
+	}
+
+	string header_filename = GlobalManager->GetSaveHeaderFilename(filename);
+	if (DoesFileExist(header_filename) == true && _LoadSlotHeader(header_filename, preview) == true) {
+		preview.valid = true;
+		return;
+	}
+
+	// Games saved before header files existed have to be previewed from the saved game itself
+	preview.Clear();
+	preview.valid = _LoadLegacySlotPreview(filename, preview);
+}
+
+
+
+bool SaveMode::_LoadSlotHeader(const string& filename, SaveSlotPreview& preview) {
+	ReadScriptDescriptor file;
+	if (file.OpenFile(filename, true) == false) {
+		return false;
+	}
+
+	file.OpenTable("save_header");
+	preview.location_name = MakeUnicodeString(file.ReadString("location_name"));
+	preview.play_hours = file.ReadUInt("play_hours");
+	preview.play_minutes = file.ReadUInt("play_minutes");
+	preview.play_seconds = file.ReadUInt("play_seconds");
+	preview.drunes = file.ReadUInt("drunes");
+
+	file.OpenTable("characters");
+	vector<uint32> char_ids;
+	if (file.DoesTableExist("order") == true) {
+		file.ReadUIntVector("order", char_ids);
+	}
+
+	for (uint32 i = 0; i < char_ids.size(); i++) {
+		// Only the "static" data of the character such as their name is loaded here
+		GlobalCharacter* character = new GlobalCharacter(char_ids[i], false);
+		preview.characters.push_back(character);
+
+		file.OpenTable(char_ids[i]);
+		character->SetExperienceLevel(file.ReadUInt("experience_level"));
+		character->SetMaxHitPoints(file.ReadUInt("max_hit_points"));
+		character->SetHitPoints(file.ReadUInt("hit_points"));
+		character->SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
+		character->SetSkillPoints(file.ReadUInt("skill_points"));
+		file.CloseTable();
+	}
+	file.CloseTable();
+	file.CloseTable();
+
+	bool success = true;
+	if (file.IsErrorDetected()) {
+		if (SAVE_DEBUG) {
+			PRINT_WARNING << "one or more errors occurred while reading the save header file - they are listed below" << endl;
+			cerr << file.GetErrorMessages() << endl;
+		}
+		file.ClearErrors();
+		success = false;
+	}
+
+	file.CloseFile();
+	return success;
+} // bool SaveMode::_LoadSlotHeader(const string& filename, SaveSlotPreview& preview)
+
+
+
+bool SaveMode::_LoadLegacySlotPreview(const string& filename, SaveSlotPreview& preview) {
+	ReadScriptDescriptor file, map_file;
+
+	if (file.OpenFile(filename, true) == false) {
+		return false;
+	}
+
 	// open the namespace that the save game is encapsulated in.
 	file.OpenTable("save_game1");
 
 	string location_filename = file.ReadString("map_script_filename");
 
-	// using ints to store temp data to populate text boxes
-	int hours, minutes, seconds, drunes;
-	hours = file.ReadInt("play_hours");
-	minutes = file.ReadInt("play_minutes");
-	seconds = file.ReadInt("play_seconds");
-	drunes = file.ReadInt("drunes");
-
+	preview.play_hours = file.ReadUInt("play_hours");
+	preview.play_minutes = file.ReadUInt("play_minutes");
+	preview.play_seconds = file.ReadUInt("play_seconds");
+	preview.drunes = file.ReadUInt("drunes");
 
 	file.OpenTable("characters");
 	vector<uint32> char_ids;
 	file.ReadUIntVector("order", char_ids);
-	GlobalCharacter* character[4];
 
 	for (uint32 i = 0; i < char_ids.size(); i++) {
 		// Create a new GlobalCharacter object using the provided id
 		// This loads all of the character's "static" data, such as their name, etc.
-		character[i] = new GlobalCharacter(char_ids[i], false);
+		GlobalCharacter* character = new GlobalCharacter(char_ids[i], false);
+		preview.characters.push_back(character);
 
 		file.OpenTable(char_ids[i]);
 
 		// Read in all of the character's stats data
-		character[i]->SetExperienceLevel(file.ReadUInt("experience_level"));
-		character[i]->SetExperiencePoints(file.ReadUInt("experience_points"));
+		character->SetExperienceLevel(file.ReadUInt("experience_level"));
+		character->SetExperiencePoints(file.ReadUInt("experience_points"));
 
-		character[i]->SetMaxHitPoints(file.ReadUInt("max_hit_points"));
-		character[i]->SetHitPoints(file.ReadUInt("hit_points"));
-		character[i]->SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
-		character[i]->SetSkillPoints(file.ReadUInt("skill_points"));
+		character->SetMaxHitPoints(file.ReadUInt("max_hit_points"));
+		character->SetHitPoints(file.ReadUInt("hit_points"));
+		character->SetMaxSkillPoints(file.ReadUInt("max_skill_points"));
+		character->SetSkillPoints(file.ReadUInt("skill_points"));
 
 		file.CloseTable();
 	}
@@ -525,7 +650,7 @@ bool SaveMode::_PreviewGame(int32 id) {
 
 	file.CloseFile();
 
-	ustring location_name = MakeUnicodeString("");
+	preview.location_name = MakeUnicodeString("");
 
 	// Load map file to get location name
 	if (map_file.OpenFile(location_filename) == false) {
@@ -541,35 +666,35 @@ bool SaveMode::_PreviewGame(int32 id) {
 		map_file.OpenTable(map_tablespace);
 
 		// Read the name of the map
-		location_name = MakeUnicodeString(map_file.ReadString("map_name"));
+		preview.location_name = MakeUnicodeString(map_file.ReadString("map_name"));
 
 		map_file.CloseTable();
 		map_file.CloseFile();
 	}
 
-	for (uint32 i = 0; i < 4; i++) {
-		_character_window[i].SetCharacter(character[i]);
-	}
-
-	_location_name_textbox.SetDisplayText(location_name);
-
-	std::ostringstream time_text;
-	time_text << "Time - ";
-	time_text << (hours < 10 ? "0" : "") << static_cast<uint32>(hours) << ":";
-	time_text << (minutes < 10 ? "0" : "") << static_cast<uint32>(minutes) << ":";
-	time_text << (seconds < 10 ? "0" : "") << static_cast<uint32>(seconds);
+	return true;
+} // bool SaveMode::_LoadLegacySlotPreview(const string& filename, SaveSlotPreview& preview)
 
-	_time_textbox.SetDisplayText( time_text.str() );
 
-	std::ostringstream drunes_text;
-	drunes_text << "Drunes - " << drunes;
 
-	_drunes_textbox.SetDisplayText( drunes_text.str() );
-	return true;
-} // bool SaveMode::_PreviewGame(string& filename)
 
+////////////////////////////////////////////////////////////////////////////////
+// SaveSlotPreview Class
+////////////////////////////////////////////////////////////////////////////////
 
+void SaveSlotPreview::Clear() {
+	valid = false;
+	location_name = MakeUnicodeString("");
+	play_hours = 0;
+	play_minutes = 0;
+	play_seconds = 0;
+	drunes = 0;
 
+	for (uint32 i = 0; i < characters.size(); i++) {
+		delete characters[i];
+	}
+	characters.clear();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // SmallCharacterWindow Class
@@ -29,6 +29,53 @@ namespace hoa_save {
 //! \brief Determines whether the code in the hoa_save namespace should print debug statements or not.
 extern bool SAVE_DEBUG;
 
+//! \brief The number of save slots that the player may save to or load from
+const uint32 SAVE_NUMBER_SLOTS = 6;
+
+/** ****************************************************************************
+*** \brief Holds the data displayed when previewing a single save slot
+***
+*** The preview data for every slot is read once when save mode becomes active, so
+*** that moving the cursor over the list of files does not touch the disk. The data
+*** comes from the header file that is written alongside each saved game, or from
+*** the saved game file itself for games saved before header files existed.
+***
+*** \note This class owns the character objects that it holds and deletes them when
+*** it is cleared or destroyed.
+*** ***************************************************************************/
+class SaveSlotPreview {
+public:
+	SaveSlotPreview()
+		{ Clear(); }
+
+	~SaveSlotPreview()
+		{ Clear(); }
+
+	//! \brief Deletes all characters and marks the slot as containing no saved game
+	void Clear();
+
+	//! \brief True if a saved game exists for this slot and its preview data was read
+	bool valid;
+
+	//! \brief The name of the map where the game was saved
+	hoa_utils::ustring location_name;
+
+	//! \brief The play time and money of the party when the game was saved
+	//@{
+	uint32 play_hours;
+	uint32 play_minutes;
+	uint32 play_seconds;
+	uint32 drunes;
+	//@}
+
+	//! \brief Characters in the order of the party, with only their level, hit points, and skill points set
+	std::vector<hoa_global::GlobalCharacter*> characters;
+
+private:
+	SaveSlotPreview(const SaveSlotPreview&);
+	SaveSlotPreview& operator=(const SaveSlotPreview&);
+}; // class SaveSlotPreview
+
 /** ****************************************************************************
 *** \brief Represents an individual character window
 ***
@@ -87,9 +134,36 @@ private:
 	//! \brief Attempts to load a game. returns true on success, false on fail
 	bool _LoadGame(int32);
 
-	//! \brief Loads preview data for the highlighted game
+	//! \brief Displays the preview data for the highlighted game
 	bool _PreviewGame(int32);
 
+	//! \brief Returns the name of the saved game file for a save slot
+	std::string _GetSaveFilename(int32 id) const;
+
+	//! \brief Reads the preview data of every save slot
+	void _LoadSlotPreviews();
+
+	/** \brief Reads the preview data for a single save slot
+	*** \param id The save slot to read, starting from one
+	***
+	*** The header file of the saved game is used if it exists. Otherwise this falls back
+	*** to executing the saved game file and reading the location name from its map file.
+	**/
+	void _LoadSlotPreview(int32 id);
+
+	/** \brief Reads preview data from a save header file written by GameGlobal::SaveGame()
+	*** \return True if the header was read successfully
+	**/
+	bool _LoadSlotHeader(const std::string& filename, SaveSlotPreview& preview);
+
+	/** \brief Reads preview data from a full saved game file and the map file that it refers to
+	*** \return True if the saved game was read successfully
+	**/
+	bool _LoadLegacySlotPreview(const std::string& filename, SaveSlotPreview& preview);
+
+	//! \brief The preview data for each save slot. Slot N is stored at index N - 1.
+	SaveSlotPreview _slot_previews[SAVE_NUMBER_SLOTS];
+
 	//! \brief The MenuWindow for the backdrop
 	hoa_gui::MenuWindow _window;
 
@@ -123,24 +123,35 @@ ShopMedia::~ShopMedia() {
 
 
 void ShopMedia::Initialize() {
-	_all_category_names.push_back(UTranslate("Items"));
-	_all_category_names.push_back(UTranslate("Weapons"));
-	_all_category_names.push_back(UTranslate("Head Armor"));
-	_all_category_names.push_back(UTranslate("Torso Armor"));
-	_all_category_names.push_back(UTranslate("Arm Armor"));
-	_all_category_names.push_back(UTranslate("Leg Armor"));
-	_all_category_names.push_back(UTranslate("Shards"));
-	_all_category_names.push_back(UTranslate("Key Items"));
-	_all_category_names.push_back(UTranslate("All Wares"));
-
-	if (ImageDescriptor::LoadMultiImageFromElementGrid(_all_category_icons, "img/icons/object_category_icons.png", 3, 4) == false) {
-		IF_PRINT_WARNING(SHOP_DEBUG) << "failed to load object category icon images" << endl;
-		return;
+	// The data for the previous shop is cleared when a recycled instance of ShopMode is initialized for a new shop
+	_sale_category_names.clear();
+	_sale_category_icons.clear();
+	_character_sprites.clear();
+
+	// The names and icons of all categories are the same for every shop, so they are only loaded once
+	if (_all_category_names.empty() == true) {
+		_all_category_names.push_back(UTranslate("Items"));
+		_all_category_names.push_back(UTranslate("Weapons"));
+		_all_category_names.push_back(UTranslate("Head Armor"));
+		_all_category_names.push_back(UTranslate("Torso Armor"));
+		_all_category_names.push_back(UTranslate("Arm Armor"));
+		_all_category_names.push_back(UTranslate("Leg Armor"));
+		_all_category_names.push_back(UTranslate("Shards"));
+		_all_category_names.push_back(UTranslate("Key Items"));
+		_all_category_names.push_back(UTranslate("All Wares"));
+	}
+
+	if (_all_category_icons.empty() == true) {
+		if (ImageDescriptor::LoadMultiImageFromElementGrid(_all_category_icons, "img/icons/object_category_icons.png", 3, 4) == false) {
+			IF_PRINT_WARNING(SHOP_DEBUG) << "failed to load object category icon images" << endl;
+			_all_category_icons.clear();
+			return;
+		}
+		// The last three images in this multi image are blank, so they are removed
+		_all_category_icons.pop_back();
+		_all_category_icons.pop_back();
+		_all_category_icons.pop_back();
 	}
-	// The last three images in this multi image are blank, so they are removed
-	_all_category_icons.pop_back();
-	_all_category_icons.pop_back();
-	_all_category_icons.pop_back();
 
 	// Determine which categories are used in this shop and populate the true containers with that data
 	uint8 deal_types = ShopMode::CurrentInstance()->GetDealTypes();
@@ -1050,13 +1061,7 @@ ShopMode::ShopMode() :
 	UpdateFinances(0, 0);
 
 	_shop_media = new ShopMedia();
-	_object_viewer = new ShopObjectViewer();
-	_root_interface = new RootInterface();
-	_buy_interface = new BuyInterface();
-	_sell_interface = new SellInterface();
-	_trade_interface = new TradeInterface();
-	_confirm_interface = new ConfirmInterface();
-	_leave_interface = new LeaveInterface();
+	_CreateInterfaces();
 
 	try {
 		_screen_backdrop = VideoManager->CaptureScreen();
@@ -1075,13 +1080,7 @@ ShopMode::~ShopMode() {
 	_created_objects.clear();
 
 	delete _shop_media;
-	delete _object_viewer;
-	delete _root_interface;
-	delete _buy_interface;
-	delete _sell_interface;
-	delete _trade_interface;
-	delete _confirm_interface;
-	delete _leave_interface;
+	_DeleteInterfaces();
 
 	_top_window.Destroy();
 	_middle_window.Destroy();
@@ -1094,6 +1093,57 @@ ShopMode::~ShopMode() {
 
 
 
+ShopMode* ShopMode::Create() {
+	ShopMode* shop = dynamic_cast<ShopMode*>(ModeManager->AcquirePooledMode(SHOP_MODE));
+	if (shop == nullptr)
+		return new ShopMode();
+
+	// The interfaces refer to the current instance when they are constructed
+	_current_instance = shop;
+	shop->_CreateInterfaces();
+	shop->_action_options.SetSelection(0);
+	shop->UpdateFinances(0, 0);
+
+	try {
+		shop->_screen_backdrop = VideoManager->CaptureScreen();
+	}
+	catch (Exception e) {
+		IF_PRINT_WARNING(SHOP_DEBUG) << e.ToString() << endl;
+	}
+	return shop;
+}
+
+
+
+bool ShopMode::Recycle() {
+	for (uint32 i = 0; i < _created_objects.size(); i++) {
+		delete(_created_objects[i]);
+	}
+	_created_objects.clear();
+	_shop_objects.clear();
+	_buy_list.clear();
+	_sell_list.clear();
+
+	// The interfaces and object viewer hold the lists and selections of this visit, so they are rebuilt for the next
+	_DeleteInterfaces();
+
+	_initialized = false;
+	_state = SHOP_STATE_ROOT;
+	_deal_types = 0;
+	_buy_price_level = SHOP_PRICE_STANDARD;
+	_sell_price_level = SHOP_PRICE_STANDARD;
+	_total_costs = 0;
+	_total_sales = 0;
+	_screen_backdrop.Clear();
+
+	if (_current_instance == this) {
+		_current_instance = nullptr;
+	}
+	return true;
+}
+
+
+
 void ShopMode::SetCommandDescriptions() {
 	_command_descriptions[UP_COMMAND] = UTranslate("Move cursor");
 	_command_descriptions[DOWN_COMMAND] = UTranslate("Move cursor");
@@ -1196,15 +1246,15 @@ void ShopMode::Initialize() {
 void ShopMode::Update() {
 	// Pause and quit events have highest priority. If either type of event is detected, no other update processing will be done
 	if (InputManager->QuitPress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::QUIT));
+		ModeManager->Push(PauseMode::Create(hoa_pause::QUIT));
 		return;
 	}
 	else if (InputManager->PausePress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::PAUSE));
+		ModeManager->Push(PauseMode::Create(hoa_pause::PAUSE));
 		return;
 	}
 	else if (InputManager->HelpPress()) {
-		ModeManager->Push(new PauseMode(hoa_pause::HELP));
+		ModeManager->Push(PauseMode::Create(hoa_pause::HELP));
 		return;
 	}
 
@@ -1587,6 +1637,38 @@ void ShopMode::ChangeState(SHOP_STATE new_state) {
 
 
 
+void ShopMode::_CreateInterfaces() {
+	_object_viewer = new ShopObjectViewer();
+	_root_interface = new RootInterface();
+	_buy_interface = new BuyInterface();
+	_sell_interface = new SellInterface();
+	_trade_interface = new TradeInterface();
+	_confirm_interface = new ConfirmInterface();
+	_leave_interface = new LeaveInterface();
+}
+
+
+
+void ShopMode::_DeleteInterfaces() {
+	delete _object_viewer;
+	delete _root_interface;
+	delete _buy_interface;
+	delete _sell_interface;
+	delete _trade_interface;
+	delete _confirm_interface;
+	delete _leave_interface;
+
+	_object_viewer = nullptr;
+	_root_interface = nullptr;
+	_buy_interface = nullptr;
+	_sell_interface = nullptr;
+	_trade_interface = nullptr;
+	_confirm_interface = nullptr;
+	_leave_interface = nullptr;
+}
+
+
+
 void ShopMode::SetShopName(ustring name) {
 	if (IsInitialized() == true) {
 		IF_PRINT_WARNING(SHOP_DEBUG) << "function called after shop was already initialized" << endl;
@@ -400,6 +400,12 @@ public:
 
 	~ShopMode();
 
+	/** \brief Returns an instance of ShopMode to push onto the game stack, reusing a parked instance if one exists
+	*** \note This should be used in place of the constructor. The windows, images, and sounds of a reused instance
+	*** are kept, but it has no objects and must be initialized in the same way as a newly constructed instance.
+	**/
+	static ShopMode* Create();
+
 	//! \brief Returns a pointer to the active instance of shop mode
 	static ShopMode* CurrentInstance()
 		{ return _current_instance; }
@@ -424,6 +430,9 @@ public:
 	**/
 	void Initialize();
 
+	//! \brief Removes all objects and destroys the shop interfaces so that the instance may be reused
+	bool Recycle();
+
 	//! \brief Handles user input and updates the shop menu.
 	void Update();
 
@@ -672,6 +681,12 @@ private:
 
 	//! \brief Table-formatted text containing the financial information about the current purchases and sales
 	hoa_gui::OptionBox _finance_table;
+
+	//! \brief Creates the object viewer and all of the shop interfaces
+	void _CreateInterfaces();
+
+	//! \brief Destroys the object viewer and all of the shop interfaces
+	void _DeleteInterfaces();
 }; // class ShopMode : public hoa_mode_manager::GameMode
 
 } // namespace hoa_shop
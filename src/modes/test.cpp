@@ -108,7 +108,7 @@ void TestMode::Reset() {
 
 void TestMode::Update() {
 	if (InputManager->QuitPress() == true) {
-		ModeManager->Push(new PauseMode(hoa_pause::QUIT));
+		ModeManager->Push(PauseMode::Create(hoa_pause::QUIT));
 		return;
 	}
 
@@ -0,0 +1,231 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    mode_pool_test.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Verifies that game modes are created and reused through the mode pool
+***
+*** The engine is initialized without a window or audio, in the same manner as
+*** the benchmark executable. Pause modes are then created while the mode pool
+*** is empty, which must construct new instances, and again after one has been
+*** popped off the stack, which must reuse the parked instance.
+***
+*** The program returns a non-zero exit status if any check fails.
+*** ***************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#ifndef _WIN32
+	#include <unistd.h>
+#endif
+
+#include "utils.h"
+#include "defs.h"
+
+#include "audio.h"
+#include "input.h"
+#include "mode_manager.h"
+#include "notification.h"
+#include "script.h"
+#include "system.h"
+#include "video.h"
+
+#include "global.h"
+#include "gui.h"
+
+#include "pause.h"
+
+using namespace std;
+using namespace hoa_utils;
+using namespace hoa_audio;
+using namespace hoa_video;
+using namespace hoa_gui;
+using namespace hoa_mode_manager;
+using namespace hoa_notification;
+using namespace hoa_input;
+using namespace hoa_system;
+using namespace hoa_global;
+using namespace hoa_script;
+using namespace hoa_pause;
+
+namespace {
+
+//! \brief The number of checks that have failed
+uint32 failure_count = 0;
+
+/** \brief Records a failed check if a condition does not hold
+*** \param condition The result of the check
+*** \param description What was checked, which is printed if the check failed
+**/
+void Check(bool condition, const string& description) {
+	if (condition == false) {
+		cerr << "FAILED: " << description << endl;
+		failure_count++;
+	}
+}
+
+
+
+//! \brief Destroys the engine singletons in the reverse order of their dependencies
+void QuitTest() {
+	ModeEngine::SingletonDestroy();
+	GameGlobal::SingletonDestroy();
+	NotificationEngine::SingletonDestroy();
+	ScriptEngine::SingletonDestroy();
+	GUISystem::SingletonDestroy();
+	AudioEngine::SingletonDestroy();
+	InputEngine::SingletonDestroy();
+	SystemEngine::SingletonDestroy();
+	VideoEngine::SingletonDestroy();
+}
+
+
+
+/** \brief Initializes the engine components needed to construct game modes, without a window or audio
+*** \return False if any component failed to initialize
+**/
+bool InitializeEngine() {
+	if (SDL_Init(SDL_INIT_TIMER) != 0) {
+		PRINT_ERROR << "unable to initialize SDL: " << SDL_GetError() << endl;
+		return false;
+	}
+
+	AUDIO_ENABLE = false;
+
+	ScriptManager = ScriptEngine::SingletonCreate();
+	AudioManager = AudioEngine::SingletonCreate();
+	InputManager = InputEngine::SingletonCreate();
+	VideoManager = VideoEngine::SingletonCreate();
+	SystemManager = SystemEngine::SingletonCreate();
+	ModeManager = ModeEngine::SingletonCreate();
+	NotificationManager = NotificationEngine::SingletonCreate();
+	GUIManager = GUISystem::SingletonCreate();
+	GlobalManager = GameGlobal::SingletonCreate();
+
+	VideoManager->SetTarget(VIDEO_TARGET_NULL);
+
+	if (VideoManager->SingletonInitialize() == false || AudioManager->SingletonInitialize() == false ||
+		ScriptManager->SingletonInitialize() == false)
+	{
+		PRINT_ERROR << "unable to initialize the video, audio, or script engine" << endl;
+		return false;
+	}
+
+	hoa_defs::BindEngineCode();
+	hoa_defs::BindCommonCode();
+	hoa_defs::BindModeCode();
+
+	if (SystemManager->SingletonInitialize() == false || InputManager->SingletonInitialize() == false ||
+		ModeManager->SingletonInitialize() == false || GlobalManager->SingletonInitialize() == false)
+	{
+		PRINT_ERROR << "unable to initialize the system, input, mode, or global manager" << endl;
+		return false;
+	}
+
+	if (VideoManager->ApplySettings() == false || VideoManager->FinalizeInitialization() == false) {
+		PRINT_ERROR << "unable to apply video settings" << endl;
+		return false;
+	}
+
+	if (GUIManager->LoadMenuSkin("black_sleet", "img/menus/black_sleet_skin.png", "img/menus/black_sleet_texture.png") == false) {
+		PRINT_ERROR << "failed to load the 'Black Sleet' MenuSkin images" << endl;
+		return false;
+	}
+
+	// The fonts used by the pause mode windows
+	if (VideoManager->Text()->LoadFont("img/fonts/libertine.ttf", "text22", 22) == false ||
+		VideoManager->Text()->LoadFont("img/fonts/libertine_capitals.ttf", "title24", 24) == false ||
+		VideoManager->Text()->LoadFont("img/fonts/libertine_capitals.ttf", "title28", 28) == false)
+	{
+		PRINT_ERROR << "failed to load the libertine fonts" << endl;
+		return false;
+	}
+	VideoManager->Text()->SetDefaultStyle(TextStyle("text22", Color::white, VIDEO_TEXT_SHADOW_BLACK, 1, -2));
+
+	if (GUIManager->SingletonInitialize() == false) {
+		PRINT_ERROR << "unable to initialize GUIManager" << endl;
+		return false;
+	}
+
+	SystemManager->InitializeTimers();
+	return true;
+}
+
+// -----------------------------------------------------------------------------
+// Tests
+// -----------------------------------------------------------------------------
+
+/** \brief Creates pause modes with an empty mode pool and with a parked instance
+*** A second pause mode is kept at the bottom of the stack throughout, since the mode engine requires that the stack
+*** is never left empty after an update.
+**/
+void TestPauseModePool() {
+	Check(ModeManager->AcquirePooledMode(PAUSE_MODE) == nullptr, "the mode pool is empty before any mode was popped");
+
+	PauseMode* bottom = PauseMode::Create(PAUSE);
+	Check(bottom != nullptr, "PauseMode::Create() constructs a new instance when the mode pool is empty");
+	if (bottom == nullptr)
+		return;
+	ModeManager->Push(bottom);
+	ModeManager->Update();
+
+	PauseMode* top = PauseMode::Create(QUIT);
+	Check(top != nullptr, "PauseMode::Create() constructs a new instance when the mode pool is empty");
+	Check(top != bottom, "PauseMode::Create() does not return an instance that is on the stack");
+	if (top == nullptr || top == bottom)
+		return;
+	ModeManager->Push(top);
+	ModeManager->Update();
+	Check(ModeManager->GetTop() == top, "the created pause mode is the active game mode after it is pushed");
+
+	// Popping the top instance parks it in the pool, and the next instance created must reuse it
+	ModeManager->Pop();
+	ModeManager->Update();
+	Check(ModeManager->GetTop() == bottom, "the first pause mode is active after the second is popped");
+
+	PauseMode* reused = PauseMode::Create(PAUSE);
+	Check(reused == top, "PauseMode::Create() reuses the instance that was parked in the mode pool");
+	GameMode* parked = ModeManager->AcquirePooledMode(PAUSE_MODE);
+	Check(parked == nullptr, "the mode pool is empty after the parked instance is reused");
+	delete parked;
+	delete reused;
+}
+
+} // namespace
+
+int main() {
+	atexit(SDL_Quit);
+	atexit(QuitTest);
+
+#if (defined(__linux__) || defined(__FreeBSD__)) && !defined(RELEASE_BUILD)
+	// Look for data files in DATADIR only if they are not available in the current directory
+	if (!ifstream("lua/data/config/settings.lua")) {
+		if (chdir(DATADIR) != 0) {
+			PRINT_ERROR << "failed to change directory to data location" << endl;
+			return EXIT_FAILURE;
+		}
+	}
+#endif
+
+	if (InitializeEngine() == false)
+		return EXIT_FAILURE;
+
+	TestPauseModePool();
+
+	if (failure_count > 0) {
+		cerr << failure_count << " mode pool checks failed" << endl;
+		return EXIT_FAILURE;
+	}
+
+	cout << "All mode pool checks passed" << endl;
+	return EXIT_SUCCESS;
+}
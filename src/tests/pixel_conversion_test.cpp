@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+//            Copyright (C) 2004-2018 by The Allacrost Project
+//                         All Rights Reserved
+//
+// This code is licensed under the GNU GPL version 2. It is free software
+// and you may modify it and/or redistribute it under the terms of this license.
+// See http://www.gnu.org/copyleft/gpl.html for details.
+///////////////////////////////////////////////////////////////////////////////
+
+/** ****************************************************************************
+*** \file    pixel_conversion_test.cpp
+*** \author  Tyler Olsen (Roots)
+*** \brief   Verifies the pixel format conversion functions of the video engine
+***
+*** Every conversion function is compared against the scalar loop that the
+*** ImageMemory class used before the conversions were vectorized. Each function
+*** is run on random pixels for every pixel count from zero up to a few hundred,
+*** which covers every combination of vector blocks and leftover pixels. The
+*** buffers passed to each function are exactly as large as the pixels they
+*** hold, so reads or writes past the end are detected when the test is built
+*** with a memory checker such as AddressSanitizer.
+***
+*** The program returns a non-zero exit status if any output differs.
+*** ***************************************************************************/
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "utils.h"
+#include "pixel_conversion.h"
+
+using namespace std;
+using namespace hoa_utils;
+using namespace hoa_video::private_video;
+
+namespace {
+
+//! \brief Every pixel count from zero up to and including this one is tested
+const uint32 MAX_PIXEL_COUNT = 300;
+
+//! \brief The number of tests that have failed
+uint32 failure_count = 0;
+
+/** \brief A small deterministic random number generator, so that every run tests the same pixels
+*** A linear congruential generator is plenty for producing test data and is identical on every platform.
+**/
+class TestRandom {
+public:
+	TestRandom() :
+		_state(0x2F6B4C1D) {}
+
+	//! \brief Returns a random byte
+	uint8 NextByte()
+		{ _state = _state * 1664525 + 1013904223; return static_cast<uint8>(_state >> 24); }
+
+	/** \brief Fills a buffer with random bytes
+	*** \param buffer The buffer to fill
+	*** \param transparent_stride When non-zero, every byte at an index of 3 modulo 4 is set to zero with a probability
+	*** of one in this value. This produces fully transparent RGBA pixels far more often than random data would.
+	**/
+	void Fill(vector<uint8>& buffer, uint32 transparent_stride = 0) {
+		for (uint32 i = 0; i < buffer.size(); ++i) {
+			buffer[i] = NextByte();
+			if (transparent_stride != 0 && i % 4 == 3 && NextByte() % transparent_stride == 0)
+				buffer[i] = 0;
+		}
+	}
+
+private:
+	uint32 _state;
+}; // class TestRandom
+
+/** \brief Records a failed test if the output of a conversion differs from the expected output
+*** \param name The name of the conversion function that was tested
+*** \param pixel_count The number of pixels that were converted
+*** \param expected The output of the original scalar loop
+*** \param actual The output of the conversion function
+**/
+void CheckResult(const string& name, uint32 pixel_count, const vector<uint8>& expected, const vector<uint8>& actual) {
+	for (uint32 i = 0; i < expected.size(); ++i) {
+		if (expected[i] != actual[i]) {
+			cerr << "FAILED: " << name << " with " << pixel_count << " pixels differs at byte " << i << ": expected "
+				<< static_cast<uint32>(expected[i]) << ", found " << static_cast<uint32>(actual[i]) << endl;
+			failure_count++;
+			return;
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// The scalar loops that the conversion functions replaced
+// -----------------------------------------------------------------------------
+
+//! \brief The gray value as it was originally computed, with a floating point multiply
+uint8 ReferenceGrayValue(uint32 red, uint32 green, uint32 blue) {
+	return static_cast<uint8>((30 * red + 59 * green + 11 * blue) * 0.01f);
+}
+
+
+
+void ReferenceGrayscale(uint8* pixels, uint32 pixel_count, uint32 format_bytes) {
+	uint8* end_position = pixels + (pixel_count * format_bytes);
+	for (uint8* i = pixels; i < end_position; i += format_bytes) {
+		uint8 value = ReferenceGrayValue(*(i), *(i + 1), *(i + 2));
+		*i = value;
+		*(i + 1) = value;
+		*(i + 2) = value;
+	}
+}
+
+
+
+void ReferenceRGBAToRGB(const uint8* source, uint8* destination, uint32 pixel_count) {
+	for (uint32 i = 0; i < pixel_count; i++) {
+		destination[i * 3] = source[i * 4];
+		destination[i * 3 + 1] = source[i * 4 + 1];
+		destination[i * 3 + 2] = source[i * 4 + 2];
+	}
+}
+
+
+
+void ReferenceRGBToRGBA(const uint8* source, uint8* destination, uint32 pixel_count) {
+	for (uint32 i = 0; i < pixel_count; i++) {
+		destination[i * 4] = source[i * 3];
+		destination[i * 4 + 1] = source[i * 3 + 1];
+		destination[i * 4 + 2] = source[i * 3 + 2];
+		destination[i * 4 + 3] = 0xFF;
+	}
+}
+
+
+
+void ReferenceGrayToRGBA(const uint8* source, uint8* destination, uint32 pixel_count) {
+	for (uint32 i = 0; i < pixel_count; i++) {
+		destination[i * 4] = source[i];
+		destination[i * 4 + 1] = source[i];
+		destination[i * 4 + 2] = source[i];
+		destination[i * 4 + 3] = 0xFF;
+	}
+}
+
+
+
+void ReferenceCopyRGBAClearingTransparent(const uint8* source, uint8* destination, uint32 pixel_count) {
+	for (uint32 i = 0; i < pixel_count; i++) {
+		const uint8* img_pixel = source + i * 4;
+		uint8* dst_pixel = destination + i * 4;
+		if (img_pixel[3] == 0) {
+			dst_pixel[0] = 0;
+			dst_pixel[1] = 0;
+			dst_pixel[2] = 0;
+			dst_pixel[3] = img_pixel[3];
+		}
+		else {
+			dst_pixel[0] = img_pixel[0];
+			dst_pixel[1] = img_pixel[1];
+			dst_pixel[2] = img_pixel[2];
+			dst_pixel[3] = img_pixel[3];
+		}
+	}
+}
+
+// -----------------------------------------------------------------------------
+// Tests
+// -----------------------------------------------------------------------------
+
+//! \brief Compares every conversion function against its original loop on random pixels
+void TestRandomPixels() {
+	TestRandom random;
+
+	for (uint32 count = 0; count <= MAX_PIXEL_COUNT; ++count) {
+		vector<uint8> rgba(count * 4);
+		vector<uint8> rgb(count * 3);
+		vector<uint8> gray(count);
+		random.Fill(rgba, 4);
+		random.Fill(rgb);
+		random.Fill(gray);
+
+		// Grayscale conversion, which also must leave the alpha channel untouched
+		vector<uint8> expected = rgba;
+		vector<uint8> actual = rgba;
+		ReferenceGrayscale(expected.data(), count, 4);
+		ConvertRGBAToGrayscale(actual.data(), count);
+		CheckResult("ConvertRGBAToGrayscale", count, expected, actual);
+
+		expected = rgb;
+		actual = rgb;
+		ReferenceGrayscale(expected.data(), count, 3);
+		ConvertRGBToGrayscale(actual.data(), count);
+		CheckResult("ConvertRGBToGrayscale", count, expected, actual);
+
+		// Alpha removal, into a separate buffer and in place. ImageMemory::RGBAToRGB() converts in place.
+		expected.assign(count * 3, 0);
+		actual.assign(count * 3, 0);
+		ReferenceRGBAToRGB(rgba.data(), expected.data(), count);
+		ConvertRGBAToRGB(rgba.data(), actual.data(), count);
+		CheckResult("ConvertRGBAToRGB", count, expected, actual);
+
+		vector<uint8> in_place = rgba;
+		ConvertRGBAToRGB(in_place.data(), in_place.data(), count);
+		in_place.resize(count * 3);
+		CheckResult("ConvertRGBAToRGB (in place)", count, expected, in_place);
+
+		// Adding an alpha channel. TestRGBToRGBATail() covers the end of the vector loop in more detail.
+		expected.assign(count * 4, 0);
+		actual.assign(count * 4, 0);
+		ReferenceRGBToRGBA(rgb.data(), expected.data(), count);
+		ConvertRGBToRGBA(rgb.data(), actual.data(), count);
+		CheckResult("ConvertRGBToRGBA", count, expected, actual);
+
+		expected.assign(count * 4, 0);
+		actual.assign(count * 4, 0);
+		ReferenceGrayToRGBA(gray.data(), expected.data(), count);
+		ConvertGrayToRGBA(gray.data(), actual.data(), count);
+		CheckResult("ConvertGrayToRGBA", count, expected, actual);
+
+		expected.assign(count * 4, 0);
+		actual.assign(count * 4, 0);
+		ReferenceCopyRGBAClearingTransparent(rgba.data(), expected.data(), count);
+		CopyRGBAClearingTransparent(rgba.data(), actual.data(), count);
+		CheckResult("CopyRGBAClearingTransparent", count, expected, actual);
+	}
+}
+
+
+
+/** \brief Tests the RGB to RGBA conversion around the boundary where its vector loop ends
+*** Each block of four pixels is converted by the vector loop only when a fifth pixel follows it, because the block
+*** reads two bytes beyond its own pixels. Those bytes are discarded, so a loop that ran one block too far would still
+*** produce the right output. The source is allocated with exactly the size of its pixels, which lets the address
+*** sanitizer that this test is built with catch the read past its end.
+**/
+void TestRGBToRGBATail() {
+	TestRandom random;
+
+	for (uint32 count = 1; count <= 13; ++count) {
+		uint8* source = new uint8[count * 3];
+		for (uint32 i = 0; i < count * 3; ++i)
+			source[i] = random.NextByte();
+
+		vector<uint8> expected(count * 4, 0);
+		vector<uint8> actual(count * 4, 0);
+		ReferenceRGBToRGBA(source, expected.data(), count);
+		ConvertRGBToRGBA(source, actual.data(), count);
+		CheckResult("ConvertRGBToRGBA (tail)", count, expected, actual);
+		delete[] source;
+	}
+}
+
+
+
+//! \brief Compares the gray value computed for every possible RGB color against the original floating point computation
+void TestEveryGrayValue() {
+	// Every color with the same red value is converted at once
+	vector<uint8> rgba(256 * 256 * 4);
+	vector<uint8> rgb(256 * 256 * 3);
+
+	for (uint32 red = 0; red < 256; ++red) {
+		for (uint32 green = 0; green < 256; ++green) {
+			for (uint32 blue = 0; blue < 256; ++blue) {
+				uint32 pixel = green * 256 + blue;
+				rgba[pixel * 4] = red;
+				rgba[pixel * 4 + 1] = green;
+				rgba[pixel * 4 + 2] = blue;
+				rgba[pixel * 4 + 3] = 0xFF;
+				rgb[pixel * 3] = red;
+				rgb[pixel * 3 + 1] = green;
+				rgb[pixel * 3 + 2] = blue;
+			}
+		}
+
+		ConvertRGBAToGrayscale(rgba.data(), 256 * 256);
+		ConvertRGBToGrayscale(rgb.data(), 256 * 256);
+
+		for (uint32 green = 0; green < 256; ++green) {
+			for (uint32 blue = 0; blue < 256; ++blue) {
+				uint32 pixel = green * 256 + blue;
+				uint8 expected = ReferenceGrayValue(red, green, blue);
+				if (rgba[pixel * 4] != expected || rgb[pixel * 3] != expected) {
+					cerr << "FAILED: gray value of (" << red << ", " << green << ", " << blue << ") is "
+						<< static_cast<uint32>(rgba[pixel * 4]) << " (RGBA) and " << static_cast<uint32>(rgb[pixel * 3])
+						<< " (RGB), expected " << static_cast<uint32>(expected) << endl;
+					failure_count++;
+					return;
+				}
+			}
+		}
+	}
+}
+
+} // namespace
+
+int main() {
+	TestRandomPixels();
+	TestRGBToRGBATail();
+	TestEveryGrayValue();
+
+	if (failure_count > 0) {
+		cerr << failure_count << " pixel conversion tests failed" << endl;
+		return EXIT_FAILURE;
+	}
+
+	cout << "All pixel conversion tests passed" << endl;
+	return EXIT_SUCCESS;
+}
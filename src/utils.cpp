@@ -209,7 +209,7 @@ ustring& ustring::operator = (const ustring& s) {
 
 
 
-bool ustring::operator == (const ustring& s)
+bool ustring::operator == (const ustring& s) const
 {
     size_t len = length();
     if (s.length() != len)
@@ -299,7 +299,7 @@ public:
 
 	ustring& operator = (const ustring& s);
 
-	bool operator == (const ustring& s);
+	bool operator == (const ustring& s) const;
 
 	uint16& operator [] (size_t pos)
 		{ return _str[pos]; }